@@ -0,0 +1,1102 @@
+/********************************************************************************************************************
+
+                                                     AuditLog.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/AuditLog.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "AuditLog.h"
+
+#include "Common.h"
+#include "MappedFile.h"
+#include "MerkleTree.h"
+#include "Sha256Calculator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+
+namespace
+{
+
+
+char const		SEGMENT_MAGIC[ 4 ]	= { 'C', 'L', 'O', 'G' };
+char const		TREE_MAGIC[ 4 ]		= { 'C', 'T', 'R', 'E' };
+char const		TREE_NAME[]			= "tree.hashes";
+uint32_t const	VERSION				= 1;
+size_t const	HEADER_SIZE			= 8;						// Magic and version
+size_t const	RECORD_HEADER_SIZE	= 4;						// Size
+size_t const	RECORD_TRAILER_SIZE	= Crypto::Sha256::SIZE;		// Chain hash
+uint32_t const	MAX_SEGMENT			= 0xffff;					// Largest segment number in a location
+int const		OFFSET_BITS			= 48;						// Number of bits of the offset in a location
+size_t const	RECOVERY_BATCH		= 4096;						// Number of leaves recomputed at once when opening
+
+// Returns the size of the record holding some data
+
+uint64_t RecordSize( size_t size )
+{
+	return RECORD_HEADER_SIZE + uint64_t( size ) + RECORD_TRAILER_SIZE;
+}
+
+// Packs a segment and offset into a location
+
+uint64_t Location( uint32_t segment, uint64_t offset )
+{
+	return ( uint64_t( segment ) << OFFSET_BITS ) | offset;
+}
+
+// Returns the segment of a location
+
+uint32_t SegmentOf( uint64_t location )
+{
+	return uint32_t( location >> OFFSET_BITS );
+}
+
+// Returns the offset of a location
+
+uint64_t OffsetOf( uint64_t location )
+{
+	return location & ( ( uint64_t( 1 ) << OFFSET_BITS ) - 1 );
+}
+
+// Fills in the header of a segment or tree file
+
+void MakeHeader( char const * magic, uint8_t * header )
+{
+	memcpy( header, magic, 4 );
+	Crypto::StoreLittleEndian32( header + 4, VERSION );
+}
+
+// Returns true if a file holds only the start of a header, which is what is left if the process stopped while the
+// file was being created
+
+bool IsPartialHeader( char const * magic, uint8_t const * data, size_t size )
+{
+	uint8_t	header[ HEADER_SIZE ];
+
+	MakeHeader( magic, header );
+
+	return size < HEADER_SIZE && ( size == 0 || memcmp( data, header, size ) == 0 );
+}
+
+// Returns true if the whole record at an offset is in a mapped file
+
+bool Contains( Crypto::MappedFile const & file, uint64_t offset )
+{
+	return file.Data() != nullptr
+		   && offset + RecordSize( 0 ) <= file.Size()
+		   && offset + RecordSize( Crypto::LoadLittleEndian32( file.Data() + offset ) ) <= file.Size();
+}
+
+// Returns the number of 1 bits
+
+int PopCount( uint64_t x )
+{
+	int	count	= 0;
+
+	for ( ; x != 0; x &= x - 1 )
+	{
+		++count;
+	}
+
+	return count;
+}
+
+// Returns the log2 of a power of 2
+
+int Log2( uint64_t x )
+{
+	int	log	= 0;
+
+	while ( x > 1 )
+	{
+		x >>= 1;
+		++log;
+	}
+
+	return log;
+}
+
+// Returns the largest power of 2 less than n, which must be at least 2
+
+uint64_t Split( uint64_t n )
+{
+	uint64_t	k	= 1;
+
+	while ( k * 2 < n )
+	{
+		k *= 2;
+	}
+
+	return k;
+}
+
+// Returns the number of nodes stored for a number of leaves. Each leaf completes one node at each level up to the
+// number of trailing 1's in its index, so a tree of n leaves has 2n - popcount( n ) complete nodes.
+
+uint64_t NodeCount( uint64_t leaves )
+{
+	return 2 * leaves - PopCount( leaves );
+}
+
+// Returns the position of a complete node in the tree file. The node completes when its last leaf is added, and the
+// nodes completed by a leaf are stored after the leaf, in order of level.
+
+uint64_t Position( int level, uint64_t index )
+{
+	return NodeCount( ( ( index + 1 ) << level ) - 1 ) + level;
+}
+
+// Returns the chain hash that follows a previous one
+
+Crypto::Sha256 NextChain( Crypto::Sha256 const & previous, Crypto::Sha256 const & leaf )
+{
+	uint8_t			message[ 2 * Crypto::Sha256::SIZE ];
+	Crypto::Sha256	chain;
+
+	memcpy( message, previous.m_value, Crypto::Sha256::SIZE );
+	memcpy( message + Crypto::Sha256::SIZE, leaf.m_value, Crypto::Sha256::SIZE );
+	Crypto::Sha256Calculator().Calculate( message, sizeof( message ), chain.m_value );
+
+	return chain;
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+AuditLog::AuditLog()
+	: m_maxSegmentSize( DEFAULT_SEGMENT_SIZE ),
+	m_segmentFile( nullptr ),
+	m_treeFile( nullptr ),
+	m_segment( 0 ),
+	m_segmentSize( 0 ),
+	m_leaves( 0 ),
+	m_dirty( false )
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+AuditLog::~AuditLog()
+{
+	Close();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	directory		Directory holding the files. It must exist.
+//! @param	maxSegmentSize	A new segment file is started when adding a record would make the current one larger than
+//!							this. A record larger than this gets a segment file to itself.
+
+bool AuditLog::Open( char const * directory, uint64_t maxSegmentSize )
+{
+	Close();
+
+	m_directory			= directory;
+	m_maxSegmentSize	= maxSegmentSize;
+
+	// Load the segments until there are no more. Writing resumes at the end of the last one, unless it is full or has
+	// a partially-written record at the end, in which case a new segment is started.
+
+	bool	resume	= false;
+
+	for ( uint32_t segment = 0; ; ++segment )
+	{
+		FILE * const	file	= fopen( SegmentName( segment ).c_str(), "rb" );
+
+		if ( file == nullptr )
+			break;
+
+		uint8_t			header[ HEADER_SIZE ];
+		size_t const	headerSize	= fread( header, 1, sizeof( header ), file );
+
+		fclose( file );
+
+		// If the process was interrupted while the last segment was being started, its header is incomplete and it has
+		// no records, so it is started again
+
+		if ( IsPartialHeader( SEGMENT_MAGIC, header, headerSize ) && !SegmentExists( segment + 1 ) )
+		{
+			resume = false;
+			break;
+		}
+
+		if ( !LoadSegment( segment ) )
+		{
+			Close();
+			return false;
+		}
+
+		resume = ( m_segmentSize == m_segments.back()->Size() && m_segmentSize < m_maxSegmentSize );
+	}
+
+	bool	ok;
+
+	if ( resume )
+	{
+		m_segment		= uint32_t( m_segments.size() - 1 );
+		m_segmentFile	= fopen( SegmentName( m_segment ).c_str(), "ab" );
+		ok				= ( m_segmentFile != nullptr );
+	}
+	else
+	{
+		ok = StartSegment( uint32_t( m_segments.size() ) );
+	}
+
+	if ( ok && !m_records.empty() )
+	{
+		uint32_t				size;
+		uint8_t const * const	record	= Record( m_records.size() - 1, size );
+
+		ok = ( record != nullptr );
+		if ( ok )
+			memcpy( m_chain.m_value, record + RECORD_HEADER_SIZE + size, Sha256::SIZE );
+	}
+
+	ok = ok && LoadTree();
+
+	if ( !ok )
+		Close();
+
+	return ok;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The files are closed even if the buffered data cannot be written.
+
+bool AuditLog::Close()
+{
+	bool	ok	= Flush();
+
+	if ( m_segmentFile != nullptr )
+		ok = fclose( m_segmentFile ) == 0 && ok;
+	if ( m_treeFile != nullptr )
+		ok = fclose( m_treeFile ) == 0 && ok;
+
+	m_segmentFile	= nullptr;
+	m_treeFile		= nullptr;
+	m_dirty			= false;
+	m_segment		= 0;
+	m_segmentSize	= 0;
+	m_leaves		= 0;
+	m_chain			= Sha256();
+	m_segments.clear();
+	m_tree.reset();
+	m_records.clear();
+
+	return ok;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The log stays dirty if the data cannot be written, so a later call tries again.
+
+bool AuditLog::Flush()
+{
+	if ( !m_dirty )
+		return true;
+
+	if ( ( m_segmentFile != nullptr && fflush( m_segmentFile ) != 0 )
+	     || ( m_treeFile != nullptr && fflush( m_treeFile ) != 0 ) )
+		return false;
+
+	m_dirty = false;
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Record
+//! @param	size	Size of the record
+
+bool AuditLog::Append( uint8_t const * data, size_t size )
+{
+	return Append( &data, &size, 1 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Records
+//! @param	sizes	Size of each record
+//! @param	count	Number of records
+//!
+//! All the records are written before the tree is extended, so the nodes completed by the batch are hashed together.
+
+bool AuditLog::Append( uint8_t const * const * data, size_t const * sizes, size_t count )
+{
+	// A failed write leaves the tree behind the records until the log is opened again
+
+	if ( m_segmentFile == nullptr || m_leaves != m_records.size() )
+		return false;
+
+	std::vector< Sha256 >	leaves( count );
+	size_t					written	= 0;
+
+	MerkleTree::HashLeaves( data, sizes, count, leaves.data() );
+	while ( written < count && WriteRecord( data[ written ], sizes[ written ], leaves[ written ] ) )
+	{
+		++written;
+	}
+
+	return AddLeaves( leaves.data(), written ) && written == count;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	index	Index of the record
+//! @param	data	The record (output)
+//!
+//! The record's chain hash is checked against the one before it.
+
+bool AuditLog::Get( uint64_t index, std::vector< uint8_t > & data )
+{
+	if ( index >= m_records.size() )
+		return false;
+
+	Sha256	previous;
+
+	if ( index > 0 )
+	{
+		uint32_t				size;
+		uint8_t const * const	record	= Record( index - 1, size );
+
+		if ( record == nullptr )
+			return false;
+		memcpy( previous.m_value, record + RECORD_HEADER_SIZE + size, Sha256::SIZE );
+	}
+
+	uint32_t				size;
+	uint8_t const * const	record	= Record( index, size );
+
+	if ( record == nullptr )
+		return false;
+
+	uint8_t const * const	contents	= record + RECORD_HEADER_SIZE;
+	Sha256 const			chain		= NextChain( previous, MerkleTree::HashLeaf( contents, size ) );
+
+	if ( memcmp( chain.m_value, contents + size, Sha256::SIZE ) != 0 )
+		return false;
+
+	data.assign( contents, contents + size );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The root is computed from the frontier, folding the smaller subtrees on the right into the larger ones on the left.
+
+Sha256 AuditLog::Root() const
+{
+	if ( m_leaves == 0 )
+		return Sha256::Of( "" );
+
+	Sha256	root;
+	bool	first	= true;
+
+	for ( int level = 0; level < 64; ++level )
+	{
+		if ( ( ( m_leaves >> level ) & 1 ) != 0 )
+		{
+			root	= first ? m_frontier[ level ] : MerkleTree::HashNode( m_frontier[ level ], root );
+			first	= false;
+		}
+	}
+
+	return root;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	size	Number of records
+//! @param	root	The tree head (output)
+
+bool AuditLog::Root( uint64_t size, Sha256 & root )
+{
+	if ( size > m_leaves )
+		return false;
+
+	if ( size == m_leaves )
+	{
+		root = Root();
+		return true;
+	}
+
+	if ( size == 0 )
+	{
+		root = Sha256::Of( "" );
+		return true;
+	}
+
+	return SubtreeRoot( 0, size, root );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	index	Index of the record
+//! @param	size	Number of records in the tree
+//! @param	proof	Hashes of the siblings on the path from the leaf to the root, bottom-up (output)
+
+bool AuditLog::ProveInclusion( uint64_t index, uint64_t size, std::vector< Sha256 > & proof )
+{
+	proof.clear();
+
+	if ( size > m_leaves || index >= size )
+		return false;
+
+	return Path( index, 0, size, proof );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	first	Number of records in the earlier tree. It must be at least 1.
+//! @param	second	Number of records in the later tree
+//! @param	proof	The proof (output). It is empty if the sizes are the same.
+
+bool AuditLog::ProveConsistency( uint64_t first, uint64_t second, std::vector< Sha256 > & proof )
+{
+	proof.clear();
+
+	if ( first == 0 || first > second || second > m_leaves )
+		return false;
+
+	if ( first == second )
+		return true;
+
+	return Subproof( first, 0, second, true, proof );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	first		Number of records in the earlier tree
+//! @param	firstRoot	Root of the earlier tree
+//! @param	second		Number of records in the later tree
+//! @param	secondRoot	Root of the later tree
+//! @param	proof		The proof, as returned by ProveConsistency()
+//! @param	proofSize	Number of hashes in the proof
+//!
+//! Both roots are rebuilt from the proof, and both must match.
+
+bool AuditLog::VerifyConsistency( uint64_t first, Sha256 const & firstRoot, uint64_t second,
+								  Sha256 const & secondRoot, Sha256 const * proof, size_t proofSize )
+{
+	if ( first == 0 || first > second )
+		return false;
+
+	if ( first == second )
+		return proofSize == 0 && firstRoot == secondRoot;
+
+	// If the earlier tree is a complete subtree of the later one, its root is the start of the path
+
+	bool const	complete	= ( first & ( first - 1 ) ) == 0;
+	size_t		next		= complete ? 0 : 1;
+
+	if ( proofSize == 0 || ( !complete && proofSize < 2 ) )
+		return false;
+
+	uint64_t	fn	= first - 1;
+	uint64_t	sn	= second - 1;
+
+	while ( ( fn & 1 ) != 0 )
+	{
+		fn >>= 1;
+		sn >>= 1;
+	}
+
+	Sha256	fr	= complete ? firstRoot : proof[ 0 ];
+	Sha256	sr	= fr;
+
+	for ( ; next < proofSize; ++next )
+	{
+		Sha256 const &	c	= proof[ next ];
+
+		if ( sn == 0 )
+			return false;
+
+		if ( ( fn & 1 ) != 0 || fn == sn )
+		{
+			fr = MerkleTree::HashNode( c, fr );
+			sr = MerkleTree::HashNode( c, sr );
+			while ( ( fn & 1 ) == 0 && fn != 0 )
+			{
+				fn >>= 1;
+				sn >>= 1;
+			}
+		}
+		else
+		{
+			sr = MerkleTree::HashNode( sr, c );
+		}
+
+		fn >>= 1;
+		sn >>= 1;
+	}
+
+	return sn == 0 && fr == firstRoot && sr == secondRoot;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The records are loaded up to the first one that is incomplete. Their chain hashes are not checked here; Get()
+//! checks them.
+
+bool AuditLog::LoadSegment( uint32_t segment )
+{
+	std::unique_ptr< MappedFile >	file( new MappedFile );
+
+	if ( segment > MAX_SEGMENT
+		 || !file->Open( SegmentName( segment ).c_str(), MappedFile::RANDOM )
+		 || file->Size() < HEADER_SIZE
+		 || memcmp( file->Data(), SEGMENT_MAGIC, sizeof( SEGMENT_MAGIC ) ) != 0
+		 || LoadLittleEndian32( file->Data() + 4 ) != VERSION )
+	{
+		return false;
+	}
+
+	uint64_t const	segmentSize	= file->Size();
+	uint64_t		end			= HEADER_SIZE;
+
+	while ( end + RecordSize( 0 ) <= segmentSize )
+	{
+		uint32_t const	size	= LoadLittleEndian32( file->Data() + end );
+
+		if ( end + RecordSize( size ) > segmentSize )
+			break;
+
+		m_records.push_back( Location( segment, end ) );
+		end += RecordSize( size );
+	}
+
+	// Anything past the last complete record is a partially-written record, so the segment cannot be appended to
+
+	m_segmentSize = end;
+	m_segments.push_back( std::move( file ) );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The nodes of leaves without complete records, and any partially-written node, are removed from the file. Then
+//! the leaves of complete records missing from the tree are hashed again and added.
+
+bool AuditLog::LoadTree()
+{
+	std::string const	name	= FileName( TREE_NAME );
+	uint64_t			leaves	= 0;
+
+	m_tree.reset( new MappedFile );
+
+	// A tree file with only part of its header has no nodes, so it is created again like a missing one
+
+	bool const	exists	= m_tree->Open( name.c_str(), MappedFile::RANDOM )
+						  && !IsPartialHeader( TREE_MAGIC, m_tree->Data(), m_tree->Size() );
+
+	if ( exists )
+	{
+		if ( m_tree->Size() < HEADER_SIZE
+			 || memcmp( m_tree->Data(), TREE_MAGIC, sizeof( TREE_MAGIC ) ) != 0
+			 || LoadLittleEndian32( m_tree->Data() + 4 ) != VERSION )
+		{
+			return false;
+		}
+
+		uint64_t const	nodes	= ( m_tree->Size() - HEADER_SIZE ) / Sha256::SIZE;
+
+		leaves = m_records.size();
+		while ( NodeCount( leaves ) > nodes )
+		{
+			--leaves;
+		}
+
+		uint64_t const	size	= HEADER_SIZE + NodeCount( leaves ) * Sha256::SIZE;
+
+		if ( size < m_tree->Size() )
+		{
+			std::error_code	error;
+
+			m_tree->Close();
+			std::filesystem::resize_file( name, size, error );
+			if ( error )
+				return false;
+		}
+
+		m_treeFile = fopen( name.c_str(), "ab" );
+		if ( m_treeFile == nullptr )
+			return false;
+	}
+	else
+	{
+		uint8_t	header[ HEADER_SIZE ];
+
+		MakeHeader( TREE_MAGIC, header );
+
+		m_tree->Close();
+		m_treeFile	= fopen( name.c_str(), "wb" );
+		if ( m_treeFile == nullptr || fwrite( header, 1, sizeof( header ), m_treeFile ) != sizeof( header )
+			 || fflush( m_treeFile ) != 0 )
+		{
+			return false;
+		}
+	}
+
+	// The frontier is the last complete node at each level that has one left over. It is read while the tree is still
+	// empty, so ReadNode() does not take it from the frontier.
+
+	for ( int level = 0; level < 64; ++level )
+	{
+		if ( ( ( leaves >> level ) & 1 ) != 0 && !ReadNode( level, ( leaves >> level ) - 1, m_frontier[ level ] ) )
+			return false;
+	}
+
+	m_leaves = leaves;
+
+	// Add the leaves of the records past the end of the tree
+
+	std::vector< Sha256 >			missing;
+	std::vector< uint8_t const * >	records;
+	std::vector< size_t >			sizes;
+
+	while ( m_leaves < m_records.size() )
+	{
+		size_t const	count	= size_t( std::min( uint64_t( RECOVERY_BATCH ), m_records.size() - m_leaves ) );
+		uint32_t		size;
+
+		// Getting a record may map its segment again, which moves the records already found in it. Once a segment
+		// is mapped far enough for the last record of the batch, it is not mapped again, so the records are found
+		// in a second pass.
+
+		for ( size_t i = 0; i < count; ++i )
+		{
+			if ( Record( m_leaves + i, size ) == nullptr )
+				return false;
+		}
+
+		records.resize( count );
+		sizes.resize( count );
+		missing.resize( count );
+		for ( size_t i = 0; i < count; ++i )
+		{
+			records[i]	= Record( m_leaves + i, size ) + RECORD_HEADER_SIZE;
+			sizes[i]	= size;
+		}
+
+		MerkleTree::HashLeaves( records.data(), sizes.data(), count, missing.data() );
+		if ( !AddLeaves( missing.data(), count ) )
+			return false;
+	}
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool AuditLog::StartSegment( uint32_t segment )
+{
+	if ( m_segmentFile != nullptr )
+		fclose( m_segmentFile );
+
+	m_segment		= segment;
+	m_segmentSize	= HEADER_SIZE;
+	m_segmentFile	= nullptr;
+	m_dirty			= true;
+
+	if ( segment > MAX_SEGMENT )
+		return false;
+
+	m_segmentFile = fopen( SegmentName( segment ).c_str(), "wb" );
+
+	if ( m_segments.size() <= segment )
+		m_segments.resize( segment + 1 );
+	m_segments[ segment ].reset( new MappedFile );
+
+	if ( m_segmentFile == nullptr )
+		return false;
+
+	// The header is flushed right away, so that an interruption cannot leave the segment without one while records
+	// are being added to it
+
+	uint8_t	header[ HEADER_SIZE ];
+
+	MakeHeader( SEGMENT_MAGIC, header );
+
+	return fwrite( header, 1, sizeof( header ), m_segmentFile ) == sizeof( header ) && fflush( m_segmentFile ) == 0;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool AuditLog::WriteRecord( uint8_t const * data, size_t size, Sha256 const & leaf )
+{
+	if ( size > UINT32_MAX )
+		return false;
+
+	uint64_t const	recordSize	= RecordSize( size );
+
+	if ( m_segmentSize > HEADER_SIZE && m_segmentSize + recordSize > m_maxSegmentSize && !StartSegment( m_segment + 1 ) )
+		return false;
+
+	Sha256 const	chain	= NextChain( m_chain, leaf );
+	uint8_t			header[ RECORD_HEADER_SIZE ];
+
+	StoreLittleEndian32( header, uint32_t( size ) );
+
+	bool const	ok	= fwrite( header, 1, sizeof( header ), m_segmentFile ) == sizeof( header )
+					  && ( size == 0 || fwrite( data, 1, size, m_segmentFile ) == size )
+					  && fwrite( chain.m_value, 1, Sha256::SIZE, m_segmentFile ) == Sha256::SIZE;
+
+	if ( !ok )
+		return false;
+
+	m_records.push_back( Location( m_segment, m_segmentSize ) );
+	m_segmentSize	+= recordSize;
+	m_chain			= chain;
+	m_dirty			= true;
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Each level's new nodes are hashed together. The children of a new node are new too, except that its left child
+//! may be the old frontier node at that level.
+
+bool AuditLog::AddLeaves( Sha256 const * leaves, size_t count )
+{
+	if ( count == 0 )
+		return true;
+
+	uint64_t const			first	= m_leaves;
+	uint64_t const			last	= first + count;
+	uint64_t const			base	= NodeCount( first );
+	std::vector< Sha256 >	nodes( NodeCount( last ) - base );
+
+	auto const	node	= [ & ] ( int level, uint64_t index ) -> Sha256 *
+						  {
+							  uint64_t const	position	= Position( level, index );
+							  return ( position >= base ) ? &nodes[ position - base ] : &m_frontier[ level ];
+						  };
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		*node( 0, first + i ) = leaves[i];
+	}
+
+	// A level with no new nodes has none above it either
+
+	std::vector< Sha256 const * >	lefts;
+	std::vector< Sha256 const * >	rights;
+	std::vector< Sha256 * >			parents;
+
+	for ( int level = 1; ( last >> level ) > ( first >> level ); ++level )
+	{
+		lefts.clear();
+		rights.clear();
+		parents.clear();
+		for ( uint64_t j = first >> level; j < ( last >> level ); ++j )
+		{
+			lefts.push_back( node( level - 1, 2 * j ) );
+			rights.push_back( node( level - 1, 2 * j + 1 ) );
+			parents.push_back( node( level, j ) );
+		}
+		MerkleTree::HashNodes( lefts.data(), rights.data(), parents.data(), parents.size() );
+	}
+
+	if ( fwrite( nodes.data(), Sha256::SIZE, nodes.size(), m_treeFile ) != nodes.size() )
+		return false;
+
+	for ( int level = 0; level < 64; ++level )
+	{
+		if ( ( ( last >> level ) & 1 ) != 0 )
+			m_frontier[ level ] = *node( level, ( last >> level ) - 1 );
+	}
+
+	m_leaves	= last;
+	m_dirty		= true;
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The segment being written grows after it is mapped, and a segment mapped while it was being written may have
+//! grown since, so the segment is flushed and mapped again if the record is past the end.
+
+uint8_t const * AuditLog::Record( uint64_t index, uint32_t & size )
+{
+	uint64_t const	location	= m_records[ index ];
+	uint32_t const	segment		= SegmentOf( location );
+	uint64_t const	offset		= OffsetOf( location );
+	MappedFile &	file		= *m_segments[ segment ];
+
+	if ( !Contains( file, offset ) )
+	{
+		if ( segment == m_segment && !Flush() )
+			return nullptr;
+		if ( !file.Open( SegmentName( segment ).c_str(), MappedFile::RANDOM ) || !Contains( file, offset ) )
+			return nullptr;
+	}
+
+	uint8_t const * const	record	= file.Data() + offset;
+
+	size = LoadLittleEndian32( record );
+
+	// The size must agree with the location of the next record
+
+	if ( index + 1 < m_records.size() && SegmentOf( m_records[ index + 1 ] ) == segment
+		 && offset + RecordSize( size ) != OffsetOf( m_records[ index + 1 ] ) )
+	{
+		return nullptr;
+	}
+
+	return record;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The last complete node at each level may be in the frontier, which saves mapping the file again after appending.
+
+bool AuditLog::ReadNode( int level, uint64_t index, Sha256 & hash )
+{
+	if ( ( ( m_leaves >> level ) & 1 ) != 0 && index == ( m_leaves >> level ) - 1 )
+	{
+		hash = m_frontier[ level ];
+		return true;
+	}
+
+	uint64_t const	offset	= HEADER_SIZE + Position( level, index ) * Sha256::SIZE;
+
+	if ( m_tree->Data() == nullptr || offset + Sha256::SIZE > m_tree->Size() )
+	{
+		if ( !Flush() )
+			return false;
+		if ( !m_tree->Open( FileName( TREE_NAME ).c_str(), MappedFile::RANDOM ) || offset + Sha256::SIZE > m_tree->Size() )
+			return false;
+	}
+
+	memcpy( hash.m_value, m_tree->Data() + offset, Sha256::SIZE );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! A subtree whose size is a power of 2 is a complete node. Any other is split at the largest power of 2 less than
+//! its size (RFC 6962).
+
+bool AuditLog::SubtreeRoot( uint64_t first, uint64_t last, Sha256 & root )
+{
+	uint64_t const	n	= last - first;
+
+	if ( ( n & ( n - 1 ) ) == 0 )
+	{
+		int const	level	= Log2( n );
+
+		return ReadNode( level, first >> level, root );
+	}
+
+	uint64_t const	k	= Split( n );
+	Sha256			left;
+	Sha256			right;
+
+	if ( !SubtreeRoot( first, first + k, left ) || !SubtreeRoot( first + k, last, right ) )
+		return false;
+
+	root = MerkleTree::HashNode( left, right );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool AuditLog::Path( uint64_t index, uint64_t first, uint64_t last, std::vector< Sha256 > & proof )
+{
+	uint64_t const	n	= last - first;
+
+	if ( n == 1 )
+		return true;
+
+	uint64_t const	k	= Split( n );
+	Sha256			sibling;
+
+	if ( index < first + k )
+	{
+		if ( !Path( index, first, first + k, proof ) || !SubtreeRoot( first + k, last, sibling ) )
+			return false;
+	}
+	else
+	{
+		if ( !Path( index, first + k, last, proof ) || !SubtreeRoot( first, first + k, sibling ) )
+			return false;
+	}
+
+	proof.push_back( sibling );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! complete is true if the first size leaves are a subtree whose root the verifier already has (RFC 6962 SUBPROOF).
+
+bool AuditLog::Subproof( uint64_t size, uint64_t first, uint64_t last, bool complete, std::vector< Sha256 > & proof )
+{
+	uint64_t const	n	= last - first;
+	Sha256			hash;
+
+	if ( size == n )
+	{
+		if ( complete )
+			return true;
+		if ( !SubtreeRoot( first, last, hash ) )
+			return false;
+		proof.push_back( hash );
+		return true;
+	}
+
+	uint64_t const	k	= Split( n );
+
+	if ( size <= k )
+	{
+		if ( !Subproof( size, first, first + k, complete, proof ) || !SubtreeRoot( first + k, last, hash ) )
+			return false;
+	}
+	else
+	{
+		if ( !Subproof( size - k, first + k, last, false, proof ) || !SubtreeRoot( first, first + k, hash ) )
+			return false;
+	}
+
+	proof.push_back( hash );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::string AuditLog::FileName( char const * name ) const
+{
+	return m_directory + "/" + name;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::string AuditLog::SegmentName( uint32_t segment ) const
+{
+	char	name[ 32 ];
+
+	snprintf( name, sizeof( name ), "segment-%06u.log", unsigned( segment ) );
+
+	return FileName( name );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool AuditLog::SegmentExists( uint32_t segment ) const
+{
+	FILE * const	file	= fopen( SegmentName( segment ).c_str(), "rb" );
+
+	if ( file == nullptr )
+		return false;
+
+	fclose( file );
+
+	return true;
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,251 @@
+/********************************************************************************************************************
+
+                                                      Base32.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Base32.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Base32.h"
+
+#include <cstring>
+
+
+namespace
+{
+
+
+char const	STANDARD_ALPHABET[]	= "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+char const	LOWER_ALPHABET[]	= "abcdefghijklmnopqrstuvwxyz234567";
+
+// Value of each character, or -1 if it is not in the alphabet. Both cases are accepted.
+
+struct CharacterValues
+{
+	constexpr CharacterValues()
+		: m_values()
+	{
+		for ( int i = 0; i < 256; ++i )
+		{
+			m_values[i] = -1;
+		}
+
+		for ( int i = 0; i < 32; ++i )
+		{
+			m_values[ uint8_t( STANDARD_ALPHABET[i] ) ] = int8_t( i );
+			m_values[ uint8_t( LOWER_ALPHABET[i] ) ] = int8_t( i );
+		}
+	}
+
+	int8_t	m_values[ 256 ];
+};
+
+constexpr CharacterValues	VALUES;
+
+
+// Converts each whole group of 5 bytes to 8 characters. The 40 bits of a group are handled as a single integer.
+
+void Encode( uint8_t const * data, size_t size, char * text, char const * alphabet )
+{
+	for ( ; size >= 5; size -= 5, data += 5, text += 8 )
+	{
+		uint64_t	x	= 0;
+
+		for ( int i = 0; i < 5; ++i )
+		{
+			x = ( x << 8 ) | data[i];
+		}
+
+		for ( int i = 7; i >= 0; --i, x >>= 5 )
+		{
+			text[i] = alphabet[ x & 0x1f ];
+		}
+	}
+}
+
+
+// Converts each whole group of 8 characters to 5 bytes. Returns false if any character is not in the alphabet.
+
+bool Decode( char const * text, size_t length, uint8_t * data )
+{
+	int	invalid	= 0;
+
+	for ( ; length >= 8; length -= 8, text += 8, data += 5 )
+	{
+		uint64_t	x	= 0;
+
+		for ( int i = 0; i < 8; ++i )
+		{
+			int const	value	= VALUES.m_values[ uint8_t( text[i] ) ];
+
+			invalid |= value;
+			x = ( x << 5 ) | uint64_t( value & 0x1f );
+		}
+
+		for ( int i = 4; i >= 0; --i, x >>= 8 )
+		{
+			data[i] = uint8_t( x );
+		}
+	}
+
+	return invalid >= 0;
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::to_chars_result Base32::ToChars( uint8_t const * data, size_t size, char * first, char * last,
+									  Alphabet alphabet, bool padding )
+{
+	size_t const	length	= EncodedSize( size, padding );
+
+	if ( size_t( last - first ) < length )
+		return { last, std::errc::value_too_large };
+
+	char const *	characters	= ( alphabet == LOWER ) ? LOWER_ALPHABET : STANDARD_ALPHABET;
+	size_t const	whole		= size / 5 * 5;
+
+	::Encode( data, whole, first, characters );
+
+	// Encode the final partial group by padding it with 0's and then keeping only the needed characters
+
+	size_t const	remainder	= size - whole;
+
+	if ( remainder > 0 )
+	{
+		uint8_t	group[ 5 ]	= { 0 };
+		char		text[ 8 ];
+
+		memcpy( group, data + whole, remainder );
+		::Encode( group, sizeof( group ), text, characters );
+
+		char *			p		= first + whole / 5 * 8;
+		size_t const	used	= EncodedSize( remainder, false );
+
+		memcpy( p, text, used );
+		if ( padding )
+		{
+			memset( p + used, '=', 8 - used );
+		}
+	}
+
+	return { first + length, std::errc() };
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::from_chars_result Base32::FromChars( char const * first, char const * last, uint8_t * data, size_t size )
+{
+	size_t const	length	= EncodedSize( size, false );
+
+	if ( size_t( last - first ) < length )
+		return { first, std::errc::invalid_argument };
+
+	size_t const	whole	= size / 5 * 5;
+	bool			valid	= ::Decode( first, whole / 5 * 8, data );
+
+	// Decode the final partial group by padding it with 'A' (0). The unused bits must be 0.
+
+	size_t const	remainder	= size - whole;
+	char const *	p			= first + length;
+
+	if ( remainder > 0 )
+	{
+		char			text[ 8 ]	= { 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A' };
+		uint8_t			group[ 5 ];
+		size_t const	used		= EncodedSize( remainder, false );
+
+		memcpy( text, first + whole / 5 * 8, used );
+		valid = ::Decode( text, sizeof( text ), group ) && valid;
+		valid = valid && ( group[ remainder ] == 0 );
+		memcpy( data + whole, group, remainder );
+
+		// The padding is optional, but if it is there it must be complete
+
+		size_t const	nPadding	= 8 - used;
+
+		if ( p < last && *p == '=' )
+		{
+			valid = valid && size_t( last - p ) >= nPadding;
+			for ( size_t i = 0; valid && i < nPadding; ++i )
+			{
+				valid = ( p[i] == '=' );
+			}
+			p += nPadding;
+		}
+	}
+
+	if ( !valid )
+		return { first, std::errc::invalid_argument };
+
+	return { p, std::errc() };
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::string Base32::Encode( uint8_t const * data, size_t size, Alphabet alphabet, bool padding )
+{
+	std::string	text( EncodedSize( size, padding ), '=' );
+
+	ToChars( data, size, &text[0], &text[0] + text.size(), alphabet, padding );
+
+	return text;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Base32::Encode( uint8_t const * data, size_t size, size_t count, char * text, Alphabet alphabet, bool padding )
+{
+	size_t const	length	= EncodedSize( size, padding );
+
+	for ( size_t i = 0; i < count; ++i, data += size, text += length )
+	{
+		ToChars( data, size, text, text + length, alphabet, padding );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool Base32::Decode( char const * text, size_t size, size_t count, uint8_t * data, bool padding )
+{
+	size_t const	length	= EncodedSize( size, padding );
+
+	for ( size_t i = 0; i < count; ++i, data += size, text += length )
+	{
+		std::from_chars_result const	result	= FromChars( text, text + length, data, size );
+
+		if ( result.ec != std::errc() || result.ptr != text + length )
+			return false;
+	}
+
+	return true;
+}
+
+
+} // namespace Crypto
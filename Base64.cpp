@@ -0,0 +1,279 @@
+/********************************************************************************************************************
+
+                                                      Base64.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Base64.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Base64.h"
+
+#include "Kernels.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+
+
+// Size of the buffers used to convert several small values in one pass. It is a multiple of 3 and is several times
+// the width of the widest kernel.
+
+size_t const	BATCH_SIZE	= 768;
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::to_chars_result Base64::ToChars( uint8_t const * data, size_t size, char * first, char * last,
+									  Alphabet alphabet, bool padding )
+{
+	size_t const	length	= EncodedSize( size, padding );
+
+	if ( size_t( last - first ) < length )
+		return { last, std::errc::value_too_large };
+
+	bool const		url		= ( alphabet == URL );
+	size_t const	whole	= size / 3 * 3;
+
+	Kernels::GetBase64Encoder()( data, whole, first, url );
+
+	// Encode the final partial group by padding it with 0's and then keeping only the needed characters
+
+	size_t const	remainder	= size - whole;
+
+	if ( remainder > 0 )
+	{
+		uint8_t	group[ 3 ]	= { 0 };
+		char		text[ 4 ];
+
+		memcpy( group, data + whole, remainder );
+		Kernels::Base64EncodeGeneric( group, sizeof( group ), text, url );
+
+		char *	p	= first + whole / 3 * 4;
+
+		memcpy( p, text, remainder + 1 );
+		if ( padding )
+		{
+			memset( p + remainder + 1, '=', 3 - remainder );
+		}
+	}
+
+	return { first + length, std::errc() };
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::from_chars_result Base64::FromChars( char const * first, char const * last, uint8_t * data, size_t size,
+										  Alphabet alphabet )
+{
+	size_t const	length	= EncodedSize( size, false );
+
+	if ( size_t( last - first ) < length )
+		return { first, std::errc::invalid_argument };
+
+	bool const		url		= ( alphabet == URL );
+	size_t const	whole	= size / 3 * 3;
+	bool			valid	= Kernels::GetBase64Decoder()( first, whole / 3 * 4, data, url );
+
+	// Decode the final partial group by padding it with 'A' (0). The unused bits must be 0.
+
+	size_t const	remainder	= size - whole;
+	char const *	p			= first + length;
+
+	if ( remainder > 0 )
+	{
+		char		text[ 4 ]	= { 'A', 'A', 'A', 'A' };
+		uint8_t	group[ 3 ];
+
+		memcpy( text, first + whole / 3 * 4, remainder + 1 );
+		valid = Kernels::Base64DecodeGeneric( text, sizeof( text ), group, url ) && valid;
+		valid = valid && ( group[ remainder ] == 0 );
+		memcpy( data + whole, group, remainder );
+
+		// The padding is optional, but if it is there it must be complete
+
+		size_t const	nPadding	= 3 - remainder;
+
+		if ( p < last && *p == '=' )
+		{
+			valid = valid && size_t( last - p ) >= nPadding && ( nPadding == 1 || p[1] == '=' );
+			p += nPadding;
+		}
+	}
+
+	if ( !valid )
+		return { first, std::errc::invalid_argument };
+
+	return { p, std::errc() };
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::string Base64::Encode( uint8_t const * data, size_t size, Alphabet alphabet, bool padding )
+{
+	std::string	text( EncodedSize( size, padding ), '=' );
+
+	ToChars( data, size, &text[0], &text[0] + text.size(), alphabet, padding );
+
+	return text;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Base64::Encode( uint8_t const * data, size_t size, size_t count, char * text, Alphabet alphabet, bool padding )
+{
+	Kernels::Base64Encoder const	encoder	= Kernels::GetBase64Encoder();
+	bool const						url		= ( alphabet == URL );
+
+	// If the values are whole groups, then the encodings are the encoding of the concatenated values
+
+	if ( size % 3 == 0 )
+	{
+		encoder( data, size * count, text, url );
+		return;
+	}
+
+	// Otherwise, the values are padded with 0's to whole groups and copied into a buffer, so that a batch of them is
+	// encoded in one pass. The unused characters of each encoding are then dropped or replaced with padding.
+
+	size_t const	groups		= ( size + 2 ) / 3;
+	size_t const	length		= EncodedSize( size, padding );
+	size_t const	used		= EncodedSize( size, false );
+	size_t const	perBatch	= BATCH_SIZE / ( groups * 3 );
+
+	if ( perBatch < 2 )
+	{
+		for ( size_t i = 0; i < count; ++i, data += size, text += length )
+		{
+			ToChars( data, size, text, text + length, alphabet, padding );
+		}
+		return;
+	}
+
+	uint8_t	buffer[ BATCH_SIZE ];
+	char	encoded[ BATCH_SIZE / 3 * 4 ];
+
+	while ( count > 0 )
+	{
+		size_t const	n	= std::min( count, perBatch );
+
+		for ( size_t i = 0; i < n; ++i )
+		{
+			uint8_t * const	group	= buffer + i * groups * 3;
+
+			memcpy( group, data + i * size, size );
+			memset( group + size, 0, groups * 3 - size );
+		}
+
+		encoder( buffer, n * groups * 3, encoded, url );
+
+		for ( size_t i = 0; i < n; ++i, text += length )
+		{
+			memcpy( text, encoded + i * groups * 4, used );
+			memset( text + used, '=', length - used );
+		}
+
+		data += n * size;
+		count -= n;
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool Base64::Decode( char const * text, size_t size, size_t count, uint8_t * data, Alphabet alphabet, bool padding )
+{
+	Kernels::Base64Decoder const	decoder	= Kernels::GetBase64Decoder();
+	bool const						url		= ( alphabet == URL );
+
+	// If the values are whole groups, then the encodings have no padding and are decoded together
+
+	if ( size % 3 == 0 )
+		return decoder( text, size / 3 * 4 * count, data, url );
+
+	// Otherwise, the encodings are copied into a buffer with their padding (or the missing characters) replaced by 'A',
+	// so that a batch of them is decoded in one pass. The unused bits of each value must be 0, and the padding must be
+	// '='.
+
+	size_t const	groups		= ( size + 2 ) / 3;
+	size_t const	length		= EncodedSize( size, padding );
+	size_t const	used		= EncodedSize( size, false );
+	size_t const	perBatch	= BATCH_SIZE / ( groups * 3 );
+
+	if ( perBatch < 2 )
+	{
+		for ( size_t i = 0; i < count; ++i, data += size, text += length )
+		{
+			std::from_chars_result const	result	= FromChars( text, text + length, data, size, alphabet );
+
+			if ( result.ec != std::errc() || result.ptr != text + length )
+				return false;
+		}
+		return true;
+	}
+
+	char	encoded[ BATCH_SIZE / 3 * 4 ];
+	uint8_t	buffer[ BATCH_SIZE ];
+	bool	valid	= true;
+
+	while ( count > 0 )
+	{
+		size_t const	n	= std::min( count, perBatch );
+
+		for ( size_t i = 0; i < n; ++i, text += length )
+		{
+			char * const	group	= encoded + i * groups * 4;
+
+			memcpy( group, text, used );
+			memset( group + used, 'A', groups * 4 - used );
+			for ( size_t j = used; j < length; ++j )
+			{
+				valid = valid && text[j] == '=';
+			}
+		}
+
+		valid = decoder( encoded, n * groups * 4, buffer, url ) && valid;
+
+		for ( size_t i = 0; i < n; ++i, data += size )
+		{
+			uint8_t const * const	value	= buffer + i * groups * 3;
+
+			memcpy( data, value, size );
+			valid = valid && value[ size ] == 0;
+		}
+
+		count -= n;
+	}
+
+	return valid;
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,362 @@
+/********************************************************************************************************************
+
+                                                   Base64Kernels.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Base64Kernels.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Kernels.h"
+
+#if CRYPTO_X86
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+
+char const	STANDARD_ALPHABET[]	= "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+char const	URL_ALPHABET[]		= "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Value of each character in an alphabet, or -1 if it is not in the alphabet
+
+struct CharacterValues
+{
+	constexpr CharacterValues( char const * alphabet )
+		: m_values()
+	{
+		for ( int i = 0; i < 256; ++i )
+		{
+			m_values[i] = -1;
+		}
+
+		for ( int i = 0; i < 64; ++i )
+		{
+			m_values[ uint8_t( alphabet[i] ) ] = int8_t( i );
+		}
+	}
+
+	int8_t	m_values[ 256 ];
+};
+
+constexpr CharacterValues	STANDARD_VALUES( STANDARD_ALPHABET );
+constexpr CharacterValues	URL_VALUES( URL_ALPHABET );
+
+
+#if CRYPTO_X86
+
+// Splits 12 bytes (in the low 12 bytes) into 16 6-bit values, one per byte. See Muła and Lemire, "Faster Base64
+// Encoding and Decoding Using AVX2 Instructions", 2018.
+
+CRYPTO_TARGET( "ssse3" )
+inline __m128i Split( __m128i x )
+{
+	x = _mm_shuffle_epi8( x, _mm_set_epi8( 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1 ) );
+
+	__m128i const	t0	= _mm_mulhi_epu16( _mm_and_si128( x, _mm_set1_epi32( 0x0fc0fc00 ) ), _mm_set1_epi32( 0x04000040 ) );
+	__m128i const	t1	= _mm_mullo_epi16( _mm_and_si128( x, _mm_set1_epi32( 0x003f03f0 ) ), _mm_set1_epi32( 0x01000010 ) );
+
+	return _mm_or_si128( t0, t1 );
+}
+
+
+// Converts 16 6-bit values to characters. The offset to add to each value is looked up by range.
+
+CRYPTO_TARGET( "ssse3" )
+inline __m128i ToCharacters( __m128i x, __m128i offsets )
+{
+	__m128i	range	= _mm_subs_epu8( x, _mm_set1_epi8( 51 ) );
+
+	range = _mm_or_si128( range, _mm_and_si128( _mm_cmpgt_epi8( _mm_set1_epi8( 26 ), x ), _mm_set1_epi8( 13 ) ) );
+
+	return _mm_add_epi8( x, _mm_shuffle_epi8( offsets, range ) );
+}
+
+
+// Returns the offsets used by ToCharacters() for the alphabet
+
+CRYPTO_TARGET( "ssse3" )
+inline __m128i Offsets( bool url )
+{
+	char const	c62	= url ? '-' : '+';
+	char const	c63	= url ? '_' : '/';
+
+	return _mm_setr_epi8( 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+						  '0' - 52, '0' - 52, '0' - 52, char( c62 - 62 ), char( c63 - 63 ), 'A', 0, 0 );
+}
+
+
+// Converts 16 characters to 6-bit values. valid is set to all 1's for each character that is in the alphabet.
+
+CRYPTO_TARGET( "ssse3" )
+inline __m128i ToValues( __m128i x, __m128i c62, __m128i c63, __m128i & valid )
+{
+	__m128i const	upper		= _mm_sub_epi8( x, _mm_set1_epi8( 'A' ) );
+	__m128i const	lower		= _mm_sub_epi8( x, _mm_set1_epi8( 'a' ) );
+	__m128i const	digit		= _mm_sub_epi8( x, _mm_set1_epi8( '0' ) );
+	__m128i const	isUpper		= _mm_cmpeq_epi8( _mm_min_epu8( upper, _mm_set1_epi8( 25 ) ), upper );
+	__m128i const	isLower		= _mm_cmpeq_epi8( _mm_min_epu8( lower, _mm_set1_epi8( 25 ) ), lower );
+	__m128i const	isDigit		= _mm_cmpeq_epi8( _mm_min_epu8( digit, _mm_set1_epi8( 9 ) ), digit );
+	__m128i const	is62		= _mm_cmpeq_epi8( x, c62 );
+	__m128i const	is63		= _mm_cmpeq_epi8( x, c63 );
+
+	valid = _mm_or_si128( _mm_or_si128( _mm_or_si128( isUpper, isLower ), _mm_or_si128( isDigit, is62 ) ), is63 );
+
+	__m128i	values	= _mm_and_si128( isUpper, upper );
+	values = _mm_or_si128( values, _mm_and_si128( isLower, _mm_add_epi8( lower, _mm_set1_epi8( 26 ) ) ) );
+	values = _mm_or_si128( values, _mm_and_si128( isDigit, _mm_add_epi8( digit, _mm_set1_epi8( 52 ) ) ) );
+	values = _mm_or_si128( values, _mm_and_si128( is62, _mm_set1_epi8( 62 ) ) );
+	values = _mm_or_si128( values, _mm_and_si128( is63, _mm_set1_epi8( 63 ) ) );
+
+	return values;
+}
+
+
+// Packs 16 6-bit values into 12 bytes (in the low 12 bytes)
+
+CRYPTO_TARGET( "ssse3" )
+inline __m128i Pack( __m128i x )
+{
+	x = _mm_maddubs_epi16( x, _mm_set1_epi32( 0x01400140 ) );
+	x = _mm_madd_epi16( x, _mm_set1_epi32( 0x00011000 ) );
+
+	return _mm_shuffle_epi8( x, _mm_setr_epi8( 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 ) );
+}
+
+
+// AVX2 versions of the above. They work on two independent 128-bit lanes.
+
+CRYPTO_TARGET( "avx2" )
+inline __m256i Split( __m256i x )
+{
+	x = _mm256_shuffle_epi8( x, _mm256_set_epi8( 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+												 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1 ) );
+
+	__m256i const	t0	= _mm256_mulhi_epu16( _mm256_and_si256( x, _mm256_set1_epi32( 0x0fc0fc00 ) ), _mm256_set1_epi32( 0x04000040 ) );
+	__m256i const	t1	= _mm256_mullo_epi16( _mm256_and_si256( x, _mm256_set1_epi32( 0x003f03f0 ) ), _mm256_set1_epi32( 0x01000010 ) );
+
+	return _mm256_or_si256( t0, t1 );
+}
+
+CRYPTO_TARGET( "avx2" )
+inline __m256i ToCharacters( __m256i x, __m256i offsets )
+{
+	__m256i	range	= _mm256_subs_epu8( x, _mm256_set1_epi8( 51 ) );
+
+	range = _mm256_or_si256( range, _mm256_and_si256( _mm256_cmpgt_epi8( _mm256_set1_epi8( 26 ), x ), _mm256_set1_epi8( 13 ) ) );
+
+	return _mm256_add_epi8( x, _mm256_shuffle_epi8( offsets, range ) );
+}
+
+CRYPTO_TARGET( "avx2" )
+inline __m256i ToValues( __m256i x, __m256i c62, __m256i c63, __m256i & valid )
+{
+	__m256i const	upper		= _mm256_sub_epi8( x, _mm256_set1_epi8( 'A' ) );
+	__m256i const	lower		= _mm256_sub_epi8( x, _mm256_set1_epi8( 'a' ) );
+	__m256i const	digit		= _mm256_sub_epi8( x, _mm256_set1_epi8( '0' ) );
+	__m256i const	isUpper		= _mm256_cmpeq_epi8( _mm256_min_epu8( upper, _mm256_set1_epi8( 25 ) ), upper );
+	__m256i const	isLower		= _mm256_cmpeq_epi8( _mm256_min_epu8( lower, _mm256_set1_epi8( 25 ) ), lower );
+	__m256i const	isDigit		= _mm256_cmpeq_epi8( _mm256_min_epu8( digit, _mm256_set1_epi8( 9 ) ), digit );
+	__m256i const	is62		= _mm256_cmpeq_epi8( x, c62 );
+	__m256i const	is63		= _mm256_cmpeq_epi8( x, c63 );
+
+	valid = _mm256_or_si256( _mm256_or_si256( _mm256_or_si256( isUpper, isLower ), _mm256_or_si256( isDigit, is62 ) ), is63 );
+
+	__m256i	values	= _mm256_and_si256( isUpper, upper );
+	values = _mm256_or_si256( values, _mm256_and_si256( isLower, _mm256_add_epi8( lower, _mm256_set1_epi8( 26 ) ) ) );
+	values = _mm256_or_si256( values, _mm256_and_si256( isDigit, _mm256_add_epi8( digit, _mm256_set1_epi8( 52 ) ) ) );
+	values = _mm256_or_si256( values, _mm256_and_si256( is62, _mm256_set1_epi8( 62 ) ) );
+	values = _mm256_or_si256( values, _mm256_and_si256( is63, _mm256_set1_epi8( 63 ) ) );
+
+	return values;
+}
+
+CRYPTO_TARGET( "avx2" )
+inline __m256i Pack( __m256i x )
+{
+	x = _mm256_maddubs_epi16( x, _mm256_set1_epi32( 0x01400140 ) );
+	x = _mm256_madd_epi16( x, _mm256_set1_epi32( 0x00011000 ) );
+	x = _mm256_shuffle_epi8( x, _mm256_setr_epi8( 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+												  2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 ) );
+
+	// Move the 12 bytes from each lane together
+
+	return _mm256_permutevar8x32_epi32( x, _mm256_setr_epi32( 0, 1, 2, 4, 5, 6, 3, 7 ) );
+}
+
+#endif // CRYPTO_X86
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+namespace Kernels
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Base64EncodeGeneric( uint8_t const * data, size_t size, char * text, bool url )
+{
+	char const *	alphabet	= url ? URL_ALPHABET : STANDARD_ALPHABET;
+
+	for ( ; size >= 3; size -= 3, data += 3, text += 4 )
+	{
+		uint32_t const	x	= ( uint32_t( data[0] ) << 16 ) | ( uint32_t( data[1] ) << 8 ) | data[2];
+
+		text[0] = alphabet[ ( x >> 18 ) & 0x3f ];
+		text[1] = alphabet[ ( x >> 12 ) & 0x3f ];
+		text[2] = alphabet[ ( x >>  6 ) & 0x3f ];
+		text[3] = alphabet[ ( x >>  0 ) & 0x3f ];
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool Base64DecodeGeneric( char const * text, size_t length, uint8_t * data, bool url )
+{
+	int8_t const *	values	= url ? URL_VALUES.m_values : STANDARD_VALUES.m_values;
+	int				invalid	= 0;
+
+	for ( ; length >= 4; length -= 4, text += 4, data += 3 )
+	{
+		int const	a	= values[ uint8_t( text[0] ) ];
+		int const	b	= values[ uint8_t( text[1] ) ];
+		int const	c	= values[ uint8_t( text[2] ) ];
+		int const	d	= values[ uint8_t( text[3] ) ];
+
+		invalid |= a | b | c | d;
+
+		uint32_t const	x	= ( uint32_t( a ) << 18 ) | ( uint32_t( b ) << 12 ) | ( uint32_t( c ) << 6 ) | uint32_t( d );
+
+		data[0] = uint8_t( x >> 16 );
+		data[1] = uint8_t( x >>  8 );
+		data[2] = uint8_t( x >>  0 );
+	}
+
+	return invalid >= 0;
+}
+
+
+#if CRYPTO_X86
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Converts 12 bytes at a time. 16 bytes are loaded, so the loop stops while there are at least 4 bytes to spare.
+
+CRYPTO_TARGET( "ssse3" )
+void Base64EncodeSsse3( uint8_t const * data, size_t size, char * text, bool url )
+{
+	__m128i const	offsets	= Offsets( url );
+
+	for ( ; size >= 16; size -= 12, data += 12, text += 16 )
+	{
+		__m128i const	x	= _mm_loadu_si128( reinterpret_cast< __m128i const * >( data ) );
+
+		_mm_storeu_si128( reinterpret_cast< __m128i * >( text ), ToCharacters( Split( x ), offsets ) );
+	}
+
+	Base64EncodeGeneric( data, size, text, url );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Converts 24 bytes at a time, 12 in each lane
+
+CRYPTO_TARGET( "avx2" )
+void Base64EncodeAvx2( uint8_t const * data, size_t size, char * text, bool url )
+{
+	__m256i const	offsets	= _mm256_broadcastsi128_si256( Offsets( url ) );
+
+	for ( ; size >= 28; size -= 24, data += 24, text += 32 )
+	{
+		__m128i const	lo	= _mm_loadu_si128( reinterpret_cast< __m128i const * >( data +  0 ) );
+		__m128i const	hi	= _mm_loadu_si128( reinterpret_cast< __m128i const * >( data + 12 ) );
+		__m256i const	x	= _mm256_inserti128_si256( _mm256_castsi128_si256( lo ), hi, 1 );
+
+		_mm256_storeu_si256( reinterpret_cast< __m256i * >( text ), ToCharacters( Split( x ), offsets ) );
+	}
+
+	Base64EncodeSsse3( data, size, text, url );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Converts 16 characters at a time. 16 bytes are stored, so the loop stops while there are at least 4 bytes to spare.
+
+CRYPTO_TARGET( "ssse3" )
+bool Base64DecodeSsse3( char const * text, size_t length, uint8_t * data, bool url )
+{
+	__m128i const	c62		= _mm_set1_epi8( url ? '-' : '+' );
+	__m128i const	c63		= _mm_set1_epi8( url ? '_' : '/' );
+	__m128i			valid	= _mm_set1_epi8( -1 );
+
+	for ( ; length >= 24; length -= 16, text += 16, data += 12 )
+	{
+		__m128i			validCharacters;
+		__m128i const	x	= ToValues( _mm_loadu_si128( reinterpret_cast< __m128i const * >( text ) ), c62, c63, validCharacters );
+
+		valid = _mm_and_si128( valid, validCharacters );
+		_mm_storeu_si128( reinterpret_cast< __m128i * >( data ), Pack( x ) );
+	}
+
+	bool const	tailValid	= Base64DecodeGeneric( text, length, data, url );
+
+	return _mm_movemask_epi8( valid ) == 0xffff && tailValid;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Converts 32 characters at a time. 32 bytes are stored, so the loop stops while there are at least 8 bytes to spare.
+
+CRYPTO_TARGET( "avx2" )
+bool Base64DecodeAvx2( char const * text, size_t length, uint8_t * data, bool url )
+{
+	__m256i const	c62		= _mm256_set1_epi8( url ? '-' : '+' );
+	__m256i const	c63		= _mm256_set1_epi8( url ? '_' : '/' );
+	__m256i			valid	= _mm256_set1_epi8( -1 );
+
+	for ( ; length >= 44; length -= 32, text += 32, data += 24 )
+	{
+		__m256i			validCharacters;
+		__m256i const	x	= ToValues( _mm256_loadu_si256( reinterpret_cast< __m256i const * >( text ) ), c62, c63, validCharacters );
+
+		valid = _mm256_and_si256( valid, validCharacters );
+		_mm256_storeu_si256( reinterpret_cast< __m256i * >( data ), Pack( x ) );
+	}
+
+	bool const	tailValid	= Base64DecodeSsse3( text, length, data, url );
+
+	return _mm256_movemask_epi8( valid ) == -1 && tailValid;
+}
+
+#endif // CRYPTO_X86
+
+
+} // namespace Kernels
+} // namespace Crypto
@@ -0,0 +1,698 @@
+/********************************************************************************************************************
+
+                                                    ChunkStore.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/ChunkStore.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "ChunkStore.h"
+
+#include "Common.h"
+#include "Crc32Calculator.h"
+#include "MappedFile.h"
+#include "Sha256Calculator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+
+namespace
+{
+
+
+char const		PACK_MAGIC[ 4 ]		= { 'C', 'P', 'A', 'K' };
+uint32_t const	VERSION				= 1;
+size_t const	PACK_HEADER_SIZE	= 8;								// Magic and version
+size_t const	RECORD_HEADER_SIZE	= 4 + Crypto::Sha256::SIZE;			// Size and digest
+size_t const	RECORD_TRAILER_SIZE	= 4;								// CRC-32
+size_t const	ENTRY_SIZE			= Crypto::Sha256::SIZE + 8 + 4 + 4;	// Digest, offset, size and CRC-32
+
+// Returns the size of the record holding a chunk
+
+uint64_t RecordSize( size_t size )
+{
+	return RECORD_HEADER_SIZE + uint64_t( size ) + RECORD_TRAILER_SIZE;
+}
+
+// Returns the CRC-32 of a record's header and chunk
+
+uint32_t RecordCrc( uint8_t const * header, uint8_t const * data, size_t size )
+{
+	Crypto::Crc32Calculator	calculator;
+	uint32_t				crc;
+
+	calculator.Process( header, RECORD_HEADER_SIZE );
+	calculator.Process( data, size );
+	calculator.Finalize( &crc );
+
+	return crc;
+}
+
+// Fills in the header of a pack file
+
+void MakePackHeader( uint8_t * header )
+{
+	memcpy( header, PACK_MAGIC, sizeof( PACK_MAGIC ) );
+	Crypto::StoreLittleEndian32( header + 4, VERSION );
+}
+
+// Fills in an index entry
+
+void MakeEntry( uint8_t * entry, uint8_t const * digest, uint64_t offset, uint32_t size )
+{
+	memcpy( entry, digest, Crypto::Sha256::SIZE );
+	Crypto::StoreLittleEndian64( entry + Crypto::Sha256::SIZE, offset );
+	Crypto::StoreLittleEndian32( entry + Crypto::Sha256::SIZE + 8, size );
+	Crypto::StoreLittleEndian32( entry + ENTRY_SIZE - 4, Crypto::Crc32Calculator().Calculate( entry, ENTRY_SIZE - 4 ) );
+}
+
+// Returns true if an index entry is intact
+
+bool EntryIsValid( uint8_t const * entry )
+{
+	return Crypto::LoadLittleEndian32( entry + ENTRY_SIZE - 4 ) == Crypto::Crc32Calculator().Calculate( entry, ENTRY_SIZE - 4 );
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+ChunkStore::ChunkStore()
+	: m_maxPackSize( DEFAULT_PACK_SIZE ),
+	m_pack( 0 ),
+	m_packSize( 0 ),
+	m_packFile( nullptr ),
+	m_indexFile( nullptr ),
+	m_dirty( false )
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+ChunkStore::~ChunkStore()
+{
+	Close();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	directory		Directory holding the pack files. It must exist.
+//! @param	maxPackSize		A new pack file is started when adding a record would make the current one larger than
+//!							this. A chunk larger than this gets a pack file to itself.
+
+bool ChunkStore::Open( char const * directory, uint64_t maxPackSize )
+{
+	Close();
+
+	m_directory		= directory;
+	m_maxPackSize	= maxPackSize;
+
+	// Load the packs until there are no more. Writing resumes at the end of the last one, unless it is full or has a
+	// partially-written record at the end, in which case a new pack is started.
+
+	bool	resume	= false;
+
+	for ( uint32_t pack = 0; ; ++pack )
+	{
+		FILE * const	file	= fopen( FileName( pack, "pack" ).c_str(), "rb" );
+
+		if ( file == nullptr )
+			break;
+
+		uint8_t			header[ PACK_HEADER_SIZE ];
+		uint8_t			expected[ PACK_HEADER_SIZE ];
+		size_t const	headerSize	= fread( header, 1, sizeof( header ), file );
+
+		fclose( file );
+		MakePackHeader( expected );
+
+		// If the process was interrupted while the last pack was being started, its header is incomplete and it has no
+		// records, so it is started again
+
+		if ( headerSize < PACK_HEADER_SIZE && memcmp( header, expected, headerSize ) == 0 && !PackExists( pack + 1 ) )
+		{
+			resume = false;
+			break;
+		}
+
+		if ( !LoadPack( pack ) )
+		{
+			Close();
+			return false;
+		}
+
+		resume = ( m_packSize == m_packs.back()->Size() && m_packSize < m_maxPackSize );
+	}
+
+	bool	ok;
+
+	if ( resume )
+	{
+		m_pack		= uint32_t( m_packs.size() - 1 );
+		m_packFile	= fopen( FileName( m_pack, "pack" ).c_str(), "ab" );
+		m_indexFile	= fopen( FileName( m_pack, "idx" ).c_str(), "ab" );
+		ok			= ( m_packFile != nullptr && m_indexFile != nullptr );
+	}
+	else
+	{
+		ok = StartPack( uint32_t( m_packs.size() ) );
+	}
+
+	if ( !ok )
+		Close();
+
+	return ok;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The files are closed even if the buffered data cannot be written.
+
+bool ChunkStore::Close()
+{
+	bool	ok	= Flush();
+
+	if ( m_packFile != nullptr )
+		ok = fclose( m_packFile ) == 0 && ok;
+	if ( m_indexFile != nullptr )
+		ok = fclose( m_indexFile ) == 0 && ok;
+
+	m_packFile	= nullptr;
+	m_indexFile	= nullptr;
+	m_dirty		= false;
+	m_pack		= 0;
+	m_packSize	= 0;
+	m_packs.clear();
+	m_index.Clear();
+
+	return ok;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The store stays dirty if the data cannot be written, so a later call tries again.
+
+bool ChunkStore::Flush()
+{
+	if ( !m_dirty )
+		return true;
+
+	if ( fflush( m_packFile ) != 0 || fflush( m_indexFile ) != 0 )
+		return false;
+
+	m_dirty = false;
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Chunk
+//! @param	size	Size of the chunk
+//! @param	digest	Digest of the chunk (output)
+
+bool ChunkStore::Put( uint8_t const * data, size_t size, Sha256 & digest )
+{
+	Sha256Calculator().Calculate( data, size, digest.m_value );
+
+	if ( m_index.Contains( digest ) )
+		return true;
+
+	return Append( data, size, digest );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data		Chunks
+//! @param	sizes		Size of each chunk
+//! @param	count		Number of chunks
+//! @param	digests		Digest of each chunk (output)
+
+bool ChunkStore::Put( uint8_t const * const * data, size_t const * sizes, size_t count, Sha256 * digests )
+{
+	Sha256Calculator	calculator;
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		calculator.Calculate( data[i], sizes[i], digests[i].m_value );
+	}
+
+	// Look up all the chunks at once. A chunk can appear more than once in the batch, so any that were not found are
+	// checked again before they are appended.
+
+	std::vector< Location const * >	found( count );
+
+	m_index.Find( digests, count, found.data() );
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		if ( found[i] == nullptr && !m_index.Contains( digests[i] ) && !Append( data[i], sizes[i], digests[i] ) )
+			return false;
+	}
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	digest	Digest of the chunk
+//! @param	data	Chunk (output)
+
+bool ChunkStore::Get( Sha256 const & digest, std::vector< uint8_t > & data )
+{
+	Location const * const	location	= m_index.Find( digest );
+
+	if ( location == nullptr )
+		return false;
+
+	uint8_t const * const	record	= Record( *location, digest );
+
+	if ( record == nullptr )
+		return false;
+
+	data.assign( record + RECORD_HEADER_SIZE, record + RECORD_HEADER_SIZE + location->size );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	digests		Digests of the chunks
+//! @param	count		Number of digests
+//! @param	receiver	Called with each chunk that is read. Chunks that are missing or corrupt are skipped.
+//!
+//! The chunks are read in the order they are stored, so that each pack is read sequentially.
+
+size_t ChunkStore::Get( Sha256 const * digests, size_t count, Receiver const & receiver )
+{
+	std::vector< Location const * >	found( count );
+
+	m_index.Find( digests, count, found.data() );
+
+	std::vector< std::pair< Location, size_t > >	requests;
+
+	requests.reserve( count );
+	for ( size_t i = 0; i < count; ++i )
+	{
+		if ( found[i] != nullptr )
+			requests.emplace_back( *found[i], i );
+	}
+
+	std::sort( requests.begin(), requests.end(),
+			   []( std::pair< Location, size_t > const & x, std::pair< Location, size_t > const & y )
+			   {
+				   if ( x.first.pack != y.first.pack )
+					   return x.first.pack < y.first.pack;
+				   return x.first.offset < y.first.offset;
+			   } );
+
+	size_t	n	= 0;
+
+	for ( size_t k = 0; k < requests.size(); ++k )
+	{
+		Location const &		location	= requests[k].first;
+		size_t const			i			= requests[k].second;
+		uint8_t const * const	record		= Record( location, digests[i] );
+
+		if ( record != nullptr )
+		{
+			receiver( i, record + RECORD_HEADER_SIZE, location.size );
+			++n;
+		}
+	}
+
+	return n;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data		Object
+//! @param	size		Size of the object
+//! @param	chunks		Digests of the chunks (output)
+
+bool ChunkStore::PutObject( uint8_t const * data, size_t size, std::vector< Sha256 > & chunks )
+{
+	ContentChunker const	chunker( ContentChunker::DEFAULT_MIN_SIZE,
+									 ContentChunker::DEFAULT_AVERAGE_SIZE,
+									 ContentChunker::DEFAULT_MAX_SIZE,
+									 true );
+
+	return PutObject( data, size, chunks, chunker );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data		Object
+//! @param	size		Size of the object
+//! @param	chunks		Digests of the chunks (output)
+//! @param	chunker		Determines the chunk boundaries. If it computes digests, they are used instead of computing them
+//!						again.
+
+bool ChunkStore::PutObject( uint8_t const * data, size_t size, std::vector< Sha256 > & chunks,
+							ContentChunker const & chunker )
+{
+	bool	ok	= true;
+
+	chunks.clear();
+	chunker.Split( data, size,
+				   [ this, &chunks, &ok ]( uint8_t const * chunk, size_t chunkSize, Sha256 const * digest )
+				   {
+					   Sha256	computed;
+
+					   if ( digest == nullptr )
+					   {
+						   Sha256Calculator().Calculate( chunk, chunkSize, computed.m_value );
+						   digest = &computed;
+					   }
+
+					   chunks.push_back( *digest );
+					   ok = ok && ( m_index.Contains( *digest ) || Append( chunk, chunkSize, *digest ) );
+				   } );
+
+	return ok;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	chunks	Digests of the object's chunks, in order
+//! @param	data	Object (output)
+
+bool ChunkStore::GetObject( std::vector< Sha256 > const & chunks, std::vector< uint8_t > & data )
+{
+	// The sizes of the chunks are in the index, so the position of each chunk in the object is known before it is read
+
+	std::vector< size_t >	offsets( chunks.size() + 1, 0 );
+
+	for ( size_t i = 0; i < chunks.size(); ++i )
+	{
+		Location const * const	location	= m_index.Find( chunks[i] );
+
+		if ( location == nullptr )
+			return false;
+
+		offsets[ i + 1 ] = offsets[i] + location->size;
+	}
+
+	data.resize( offsets.back() );
+
+	size_t const	n	= Get( chunks.data(), chunks.size(),
+							   [ &data, &offsets ]( size_t i, uint8_t const * chunk, size_t size )
+							   {
+								   memcpy( data.data() + offsets[i], chunk, size );
+							   } );
+
+	return n == chunks.size();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The index entries are loaded up to the first one that is incomplete or corrupt. Then any intact records in the pack
+//! past the last entry are recovered. If the index was not complete, it is rewritten.
+
+bool ChunkStore::LoadPack( uint32_t pack )
+{
+	std::unique_ptr< MappedFile >	file( new MappedFile );
+
+	if ( !file->Open( FileName( pack, "pack" ).c_str(), MappedFile::RANDOM )
+		 || file->Size() < PACK_HEADER_SIZE
+		 || memcmp( file->Data(), PACK_MAGIC, sizeof( PACK_MAGIC ) ) != 0
+		 || LoadLittleEndian32( file->Data() + 4 ) != VERSION )
+	{
+		return false;
+	}
+
+	uint8_t const * const	packData	= file->Data();
+	uint64_t const			packSize	= file->Size();
+	std::vector< uint8_t >	entries;
+	uint64_t				end			= PACK_HEADER_SIZE;
+	bool					complete	= true;
+
+	{
+		MappedFile	index;
+
+		// An empty index cannot be mapped, but it is not an error
+
+		if ( index.Open( FileName( pack, "idx" ).c_str(), MappedFile::SEQUENTIAL ) )
+		{
+			complete = ( index.Size() % ENTRY_SIZE == 0 );
+
+			for ( uint8_t const * entry = index.Data(); entry + ENTRY_SIZE <= index.Data() + index.Size(); entry += ENTRY_SIZE )
+			{
+				Location const	location	= { pack,
+												LoadLittleEndian32( entry + Sha256::SIZE + 8 ),
+												LoadLittleEndian64( entry + Sha256::SIZE ) };
+
+				if ( !EntryIsValid( entry ) || location.offset != end || end + RecordSize( location.size ) > packSize )
+				{
+					complete = false;
+					break;
+				}
+
+				Sha256	digest;
+
+				memcpy( digest.m_value, entry, Sha256::SIZE );
+				m_index.Insert( digest, location );
+				entries.insert( entries.end(), entry, entry + ENTRY_SIZE );
+				end += RecordSize( location.size );
+			}
+		}
+	}
+
+	// Recover any intact records past the last entry
+
+	while ( end + RecordSize( 0 ) <= packSize )
+	{
+		uint8_t const * const	record	= packData + end;
+		uint32_t const			size	= LoadLittleEndian32( record );
+
+		if ( end + RecordSize( size ) > packSize
+			 || LoadLittleEndian32( record + RECORD_HEADER_SIZE + size ) != RecordCrc( record, record + RECORD_HEADER_SIZE, size ) )
+		{
+			break;
+		}
+
+		Sha256	digest;
+		uint8_t	entry[ ENTRY_SIZE ];
+
+		memcpy( digest.m_value, record + 4, Sha256::SIZE );
+		m_index.Insert( digest, Location{ pack, size, end } );
+		MakeEntry( entry, digest.m_value, end, size );
+		entries.insert( entries.end(), entry, entry + ENTRY_SIZE );
+		end += RecordSize( size );
+		complete = false;
+	}
+
+	if ( !complete )
+	{
+		FILE * const	index	= fopen( FileName( pack, "idx" ).c_str(), "wb" );
+		bool			ok		= ( index != nullptr );
+
+		if ( ok && !entries.empty() )
+			ok = fwrite( entries.data(), 1, entries.size(), index ) == entries.size();
+		if ( index != nullptr )
+			ok = ( fclose( index ) == 0 ) && ok;
+		if ( !ok )
+			return false;
+	}
+
+	// Anything past the last intact record is a partially-written record, so the pack cannot be appended to
+
+	m_packSize = end;
+	m_packs.push_back( std::move( file ) );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool ChunkStore::StartPack( uint32_t pack )
+{
+	if ( m_packFile != nullptr )
+		fclose( m_packFile );
+	if ( m_indexFile != nullptr )
+		fclose( m_indexFile );
+
+	m_pack		= pack;
+	m_packSize	= PACK_HEADER_SIZE;
+	m_packFile	= fopen( FileName( pack, "pack" ).c_str(), "wb" );
+	m_indexFile	= fopen( FileName( pack, "idx" ).c_str(), "wb" );
+	m_dirty		= true;
+
+	if ( m_packs.size() <= pack )
+		m_packs.resize( pack + 1 );
+	m_packs[ pack ].reset( new MappedFile );
+
+	if ( m_packFile == nullptr || m_indexFile == nullptr )
+		return false;
+
+	// The header is flushed right away, so that an interruption cannot leave the pack without one while records are
+	// being added to it
+
+	uint8_t	header[ PACK_HEADER_SIZE ];
+
+	MakePackHeader( header );
+
+	return fwrite( header, 1, sizeof( header ), m_packFile ) == sizeof( header ) && fflush( m_packFile ) == 0;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool ChunkStore::Append( uint8_t const * data, size_t size, Sha256 const & digest )
+{
+	if ( m_packFile == nullptr || size > UINT32_MAX )
+		return false;
+
+	uint64_t const	recordSize	= RecordSize( size );
+
+	if ( m_packSize > PACK_HEADER_SIZE && m_packSize + recordSize > m_maxPackSize && !StartPack( m_pack + 1 ) )
+		return false;
+
+	uint8_t	header[ RECORD_HEADER_SIZE ];
+	uint8_t	trailer[ RECORD_TRAILER_SIZE ];
+	uint8_t	entry[ ENTRY_SIZE ];
+
+	StoreLittleEndian32( header, uint32_t( size ) );
+	memcpy( header + 4, digest.m_value, Sha256::SIZE );
+	StoreLittleEndian32( trailer, RecordCrc( header, data, size ) );
+	MakeEntry( entry, digest.m_value, m_packSize, uint32_t( size ) );
+
+	// The record is written before its index entry, so the index never refers to a record that is not there
+
+	bool const	ok	= fwrite( header, 1, sizeof( header ), m_packFile ) == sizeof( header )
+					  && fwrite( data, 1, size, m_packFile ) == size
+					  && fwrite( trailer, 1, sizeof( trailer ), m_packFile ) == sizeof( trailer )
+					  && fwrite( entry, 1, sizeof( entry ), m_indexFile ) == sizeof( entry );
+
+	if ( !ok )
+		return false;
+
+	m_index.Insert( digest, Location{ m_pack, uint32_t( size ), m_packSize } );
+	m_packSize	+= recordSize;
+	m_dirty		= true;
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The pack being written grows after it is mapped, so it is flushed and mapped again if the record is past the end.
+
+uint8_t const * ChunkStore::Record( Location const & location, Sha256 const & digest )
+{
+	MappedFile &	file	= *m_packs[ location.pack ];
+	uint64_t const	end		= location.offset + RecordSize( location.size );
+
+	if ( file.Data() == nullptr || end > file.Size() )
+	{
+		if ( location.pack == m_pack && !Flush() )
+			return nullptr;
+		if ( !file.Open( FileName( location.pack, "pack" ).c_str(), MappedFile::RANDOM ) || end > file.Size() )
+			return nullptr;
+	}
+
+	uint8_t const * const	record	= file.Data() + location.offset;
+
+	if ( LoadLittleEndian32( record ) != location.size
+		 || memcmp( record + 4, digest.m_value, Sha256::SIZE ) != 0
+		 || LoadLittleEndian32( record + RECORD_HEADER_SIZE + location.size )
+			!= RecordCrc( record, record + RECORD_HEADER_SIZE, location.size ) )
+	{
+		return nullptr;
+	}
+
+	return record;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::string ChunkStore::FileName( uint32_t pack, char const * extension ) const
+{
+	char	name[ 32 ];
+
+	snprintf( name, sizeof( name ), "pack-%06u.%s", unsigned( pack ), extension );
+
+	return m_directory + "/" + name;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool ChunkStore::PackExists( uint32_t pack ) const
+{
+	FILE * const	file	= fopen( FileName( pack, "pack" ).c_str(), "rb" );
+
+	if ( file == nullptr )
+		return false;
+
+	fclose( file );
+
+	return true;
+}
+
+
+} // namespace Crypto
@@ -13,17 +13,42 @@
 
 #include "Common.h"
 
+#include "Kernels.h"
+
+#include <algorithm>
+#include <cassert>
+
 namespace Crypto
 {
 
 
-void HexToBinary( std::string const & text, unsigned __int8 * buffer, size_t size )
+namespace
+{
+
+
+// Decodes size bytes from size * 2 hex digits with the kernel selected by the KernelRegistry
+
+bool Decode( char const * text, size_t size, uint8_t * buffer )
+{
+	return Kernels::GetHexDecoder()( text, size, buffer );
+}
+
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool HexToBinary( std::string_view text, uint8_t * buffer, size_t size )
 {
 	// Initialize leading bytes to 0 in case the text does not have the full number of digits (e.g. no leading 0's).
 
 	memset( buffer, 0, size );
 
-	std::string::const_iterator	pText	= text.begin();
+	char const *	pText	= text.data();
+	bool			valid	= ( text.size() <= size * 2 );
 
 	// Number of text digits to process. Clamp to the max.
 	size_t	ndigits	= std::min<size_t>( text.size(), size * 2 );
@@ -31,75 +56,84 @@ void HexToBinary( std::string const & text, unsigned __int8 * buffer, size_t siz
 	// If the the text does not have the full number of digits then it is assumed that the text contains the
 	// rightmost digits and leading 0's have been dropped.
 
-	unsigned __int8 *	pValue	= &buffer[ size - ( ndigits + 1 ) / 2 ];
+	uint8_t *			pValue	= &buffer[ size - ( ndigits + 1 ) / 2 ];
 
 	// Handle the odd digits case (this can happen if there are no leading 0's)
 
 	if ( ( ndigits & 1 ) != 0 )
 	{
-		*pValue++ = atox( *pText );
+		char const	digits[ 2 ]	= { '0', *pText };
+
+		valid = Kernels::HexDecodeGeneric( digits, 1, pValue ) && valid;
+		++pValue;
 		++pText;
 		--ndigits;
 	}
 
-	// Convert two digits at a time until the end of the value is reached
+	// Convert the rest two digits at a time
 
-	while ( ndigits > 0 )
-	{
-		*pValue++ = atox( pText[0] ) * 16 + atox( pText[1] );
-		pText += 2;
-		ndigits -= 2;
-	}
+	return Decode( pText, ndigits / 2, pValue ) && valid;
 }
 
 
-void HexToBinary( char const * text, unsigned __int8 * buffer, size_t size )
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void BinaryToHex( uint8_t const * buffer, size_t size, char * text )
 {
-	// Initialize leading bytes to 0 in case the text does not have the full
-	// number of digits (e.g. no leading 0's).
+	Kernels::GetHexEncoder()( buffer, size, text );
+}
 
-	memset( buffer, 0, size );
 
-	// Number of text digits to process. Clamp to the max.
-	size_t	ndigits	= std::min<size_t>( strlen( text ), size * 2 );
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
 
-	// If the the text does not have the full number of digits then it is
-	// assumed that the text contains the rightmost digits and leading
-	// 0's have been dropped.
-	unsigned __int8 *	pValue	= &buffer[ size - ( ndigits + 1 ) / 2 ];
+std::string BinaryToHex( uint8_t const * buffer, size_t size )
+{
+	std::string text( size * 2, '0' );
 
-	// Handle the odd digits case (this can happen if there are no leading 0's)
+	BinaryToHex( buffer, size, &text[0] );
 
-	if ( ( ndigits & 1 ) != 0 )
-	{
-		*pValue++ = atox( *text );
-		++text;
-		--ndigits;
-	}
+	return text;
+}
 
-	// Convert two digits at a time until the end of the value is reached
 
-	while ( ndigits > 0 )
-	{
-		*pValue++ = atox( text[0] ) * 16 + atox( text[1] );
-		text += 2;
-		ndigits -= 2;
-	}
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::to_chars_result ToChars( uint8_t const * buffer, size_t size, char * first, char * last )
+{
+	if ( size_t( last - first ) < size * 2 )
+		return { last, std::errc::value_too_large };
+
+	BinaryToHex( buffer, size, first );
+
+	return { first + size * 2, std::errc() };
 }
 
 
-std::string BinaryToHex( unsigned __int8 const * buffer, size_t size )
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::from_chars_result FromChars( char const * first, char const * last, uint8_t * buffer, size_t size )
 {
-	std::string text( size * 2, '0' );
-	std::string::iterator pText = text.begin();
+	// Like std::from_chars, the value is not changed if the text is not valid, so it is decoded into a temporary
+	// first. The largest digest is 32 bytes.
 
-	for ( size_t i = 0; i < size; ++i )
-	{
-		*pText++ = xtoa( buffer[ i ] / 16 );
-		*pText++ = xtoa( buffer[ i ] % 16 );
-	}
+	uint8_t	value[ 32 ];
 
-	return text;
+	assert( size <= sizeof( value ) );
+
+	if ( size_t( last - first ) < size * 2 || !Decode( first, size, value ) )
+		return { first, std::errc::invalid_argument };
+
+	memcpy( buffer, value, size );
+
+	return { first + size * 2, std::errc() };
 }
 
 } // namespace Crypto
\ No newline at end of file
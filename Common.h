@@ -13,16 +13,44 @@
 
 #pragma once
 
+#include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
+
+#if defined( _MSC_VER )
+#include <stdlib.h>
+#endif
+
+#if defined( __has_builtin )
+#define CRYPTO_HAS_BUILTIN( x ) __has_builtin( x )
+#else
+#define CRYPTO_HAS_BUILTIN( x ) 0
+#endif
+
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define CRYPTO_BIG_ENDIAN 1
+#else
+#define CRYPTO_BIG_ENDIAN 0
+#endif
 
 
 namespace Crypto
 {
 
 
-void HexToBinary( std::string const & text, unsigned __int8 * buffer, size_t size );
-void HexToBinary( char const * text, unsigned __int8 * buffer, size_t size );
-std::string BinaryToHex( unsigned __int8 const * buffer, size_t size );
+// Converts text to a value of size bytes. If the text has fewer than size * 2 digits, it is assumed to hold the
+// rightmost digits. Returns false if the text contains a character that is not a hex digit or has too many digits.
+bool HexToBinary( std::string_view text, uint8_t * buffer, size_t size );
+
+// Converts a value of size bytes to text. The text is size * 2 characters and is not 0-terminated.
+void BinaryToHex( uint8_t const * buffer, size_t size, char * text );
+std::string BinaryToHex( uint8_t const * buffer, size_t size );
+
+// Implement ToChars() and FromChars() for the digests. The text is exactly size * 2 hex digits.
+std::to_chars_result ToChars( uint8_t const * buffer, size_t size, char * first, char * last );
+std::from_chars_result FromChars( char const * first, char const * last, uint8_t * buffer, size_t size );
 
 inline int atox( char c )
 {
@@ -51,56 +79,117 @@ inline char xtoa( int x )
 	return ( x < 10 ) ? ( '0' + x ) : ( 'a' - 10 + x );
 }
 
-inline unsigned __int16 endian16( unsigned __int16 x )
+// Byte swapping, rotation, and unaligned loads and stores. These compile to single instructions (bswap/movbe,
+// rol/ror/rorx, and plain unaligned moves) with MSVC, GCC, and Clang. The loads and stores use memcpy, which is the
+// only portable way to access unaligned data, and which the compilers reduce to a single move.
+
+inline uint16_t endian16( uint16_t x )
 {
-	unsigned __int8 const	high	= unsigned __int8( ( ( x & 0xff00 ) >> 8 ) & 0x00ff );
-	unsigned __int8 const	low		= unsigned __int8( x & 0x00ff );
+#if defined( _MSC_VER )
+	return _byteswap_ushort( x );
+#elif defined( __GNUC__ )
+	return __builtin_bswap16( x );
+#else
+	return uint16_t( ( x << 8 ) | ( x >> 8 ) );
+#endif
+}
 
-	return  ( unsigned __int16( low ) << 8 | unsigned __int16( high ) );
+inline uint32_t endian32( uint32_t x )
+{
+#if defined( _MSC_VER )
+	return _byteswap_ulong( x );
+#elif defined( __GNUC__ )
+	return __builtin_bswap32( x );
+#else
+	return ( uint32_t( endian16( uint16_t( x ) ) ) << 16 ) | uint32_t( endian16( uint16_t( x >> 16 ) ) );
+#endif
 }
 
-inline unsigned __int32 endian32( unsigned __int32 x )
+inline uint64_t endian64( uint64_t x )
 {
-	unsigned __int16 const	high	= unsigned __int16( ( ( x & 0xffff0000 ) >> 16 ) & 0x0000ffff );
-	unsigned __int16 const	low		= unsigned __int16( x & 0x0000ffff );
+#if defined( _MSC_VER )
+	return _byteswap_uint64( x );
+#elif defined( __GNUC__ )
+	return __builtin_bswap64( x );
+#else
+	return ( uint64_t( endian32( uint32_t( x ) ) ) << 32 ) | uint64_t( endian32( uint32_t( x >> 32 ) ) );
+#endif
+}
 
-	return  ( unsigned __int32( endian16( low ) ) << 16 | unsigned __int32( endian16( high ) ) );
+inline uint32_t rotl( uint32_t x, int n )
+{
+#if defined( _MSC_VER )
+	return _rotl( x, n );
+#elif CRYPTO_HAS_BUILTIN( __builtin_rotateleft32 )
+	return __builtin_rotateleft32( x, uint32_t( n ) );
+#else
+	// GCC recognizes this idiom and generates a single rotate
+	return ( x << ( n & 31 ) ) | ( x >> ( -n & 31 ) );
+#endif
 }
 
-inline unsigned __int64 endian64( unsigned __int64 x )
+inline uint32_t rotr( uint32_t x, int n )
 {
-	unsigned __int32 const	high	= unsigned __int32( ( ( x & 0xffffffff00000000 ) >> 32 ) & 0x00000000ffffffff );
-	unsigned __int32 const	low		= unsigned __int32( x & 0x00000000ffffffff );
+#if defined( _MSC_VER )
+	return _rotr( x, n );
+#elif CRYPTO_HAS_BUILTIN( __builtin_rotateright32 )
+	return __builtin_rotateright32( x, uint32_t( n ) );
+#else
+	// GCC recognizes this idiom and generates a single rotate
+	return ( x >> ( n & 31 ) ) | ( x << ( -n & 31 ) );
+#endif
+}
 
-	return ( unsigned __int64( endian32( low ) ) << 32 | unsigned __int64( endian32( high ) ) );
+inline uint32_t LoadLittleEndian32( uint8_t const * p )
+{
+	uint32_t	x;
+	memcpy( &x, p, sizeof( x ) );
+	return CRYPTO_BIG_ENDIAN ? endian32( x ) : x;
 }
 
-//template < typename T >
-//inline T rotl( T x, int n )
-//{
-//	int const	SIZE_IN_BITS	= sizeof( T ) * 8;
-//	T carry	= ( x >> ( SIZE_IN_BITS-n ) ) & ( ( 1 << n ) - 1 );
-//	return ( x << n ) | carry;
-//}
-  
-//template < typename T >
-//inline T rotr( T x, int n )
-//{
-//	int const	SIZE_IN_BITS	= sizeof( T ) * 8;
-//	T carry	= ( x & ( ( 1 << n ) - 1 ) ) << ( SIZE_IN_BITS-n );
-//	return ( x >> n ) | carry;
-//}
-
-//template <>
-inline unsigned __int32 rotl( unsigned __int32 x, int n )
+inline uint32_t LoadBigEndian32( uint8_t const * p )
 {
-	return _rotl( x, n );
+	uint32_t	x;
+	memcpy( &x, p, sizeof( x ) );
+	return CRYPTO_BIG_ENDIAN ? x : endian32( x );
 }
 
-//template <>
-inline unsigned __int32 rotr( unsigned __int32 x, int n )
+inline void StoreLittleEndian32( uint8_t * p, uint32_t x )
 {
-	return _rotr( x, n );
+	x = CRYPTO_BIG_ENDIAN ? endian32( x ) : x;
+	memcpy( p, &x, sizeof( x ) );
+}
+
+inline void StoreBigEndian32( uint8_t * p, uint32_t x )
+{
+	x = CRYPTO_BIG_ENDIAN ? x : endian32( x );
+	memcpy( p, &x, sizeof( x ) );
+}
+
+inline uint64_t LoadLittleEndian64( uint8_t const * p )
+{
+	uint64_t	x;
+	memcpy( &x, p, sizeof( x ) );
+	return CRYPTO_BIG_ENDIAN ? endian64( x ) : x;
+}
+
+inline uint64_t LoadBigEndian64( uint8_t const * p )
+{
+	uint64_t	x;
+	memcpy( &x, p, sizeof( x ) );
+	return CRYPTO_BIG_ENDIAN ? x : endian64( x );
+}
+
+inline void StoreLittleEndian64( uint8_t * p, uint64_t x )
+{
+	x = CRYPTO_BIG_ENDIAN ? endian64( x ) : x;
+	memcpy( p, &x, sizeof( x ) );
+}
+
+inline void StoreBigEndian64( uint8_t * p, uint64_t x )
+{
+	x = CRYPTO_BIG_ENDIAN ? x : endian64( x );
+	memcpy( p, &x, sizeof( x ) );
 }
 
 
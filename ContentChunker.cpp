@@ -0,0 +1,395 @@
+/********************************************************************************************************************
+
+                                                  ContentChunker.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/ContentChunker.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "ContentChunker.h"
+
+#include "MappedFile.h"
+#include "Sha256Calculator.h"
+
+#include <algorithm>
+#include <cstdio>
+
+
+namespace
+{
+
+
+size_t const	BLOCK_SIZE	= 8 * 1024;		// The digest is updated after each block is searched
+
+// Table of random values for the gear hash, generated with SplitMix64
+
+struct GearTable
+{
+	constexpr GearTable()
+		: m_table()
+	{
+		uint64_t	x	= 0;
+
+		for ( int i = 0; i < 256; ++i )
+		{
+			x += 0x9e3779b97f4a7c15;
+
+			uint64_t	z	= x;
+
+			z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9;
+			z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111eb;
+
+			m_table[i] = z ^ ( z >> 31 );
+		}
+	}
+
+	uint64_t	m_table[ 256 ];
+};
+
+constexpr GearTable	GEAR;
+
+// Returns the hash of the WINDOW_SIZE - 1 bytes before p. The bits of older bytes are shifted out of the hash.
+
+uint64_t Prime( uint8_t const * p )
+{
+	uint64_t	h	= 0;
+
+	for ( uint8_t const * q = p - ( Crypto::ContentChunker::WINDOW_SIZE - 1 ); q < p; ++q )
+	{
+		h = ( h << 1 ) + GEAR.m_table[ *q ];
+	}
+
+	return h;
+}
+
+// Returns the position of the first boundary in [first, last), or last. The range is split into four streams that are
+// searched at the same time. If a later stream finds a boundary first, the earlier streams must still be searched to
+// the end, since a boundary in an earlier stream comes first.
+
+size_t FindBoundary( uint8_t const * data, size_t first, size_t last, uint64_t mask )
+{
+	size_t const	lane	= ( last - first ) / 4;
+
+	if ( lane >= Crypto::ContentChunker::WINDOW_SIZE )
+	{
+		uint8_t const * const	p0	= data + first;
+		uint8_t const * const	p1	= p0 + lane;
+		uint8_t const * const	p2	= p1 + lane;
+		uint8_t const * const	p3	= p2 + lane;
+		uint64_t				h0	= Prime( p0 );
+		uint64_t				h1	= Prime( p1 );
+		uint64_t				h2	= Prime( p2 );
+		uint64_t				h3	= Prime( p3 );
+		size_t					hit	= 4 * lane;
+
+		for ( size_t j = 0; j < lane; ++j )
+		{
+			h0 = ( h0 << 1 ) + GEAR.m_table[ p0[j] ];
+			h1 = ( h1 << 1 ) + GEAR.m_table[ p1[j] ];
+			h2 = ( h2 << 1 ) + GEAR.m_table[ p2[j] ];
+			h3 = ( h3 << 1 ) + GEAR.m_table[ p3[j] ];
+
+			if ( ( ( h0 & mask ) == 0 ) | ( ( h1 & mask ) == 0 ) | ( ( h2 & mask ) == 0 ) | ( ( h3 & mask ) == 0 ) )
+			{
+				if ( ( h0 & mask ) == 0 )
+					return first + j;
+				if ( ( h1 & mask ) == 0 )
+					hit = std::min( hit, lane + j );
+				if ( ( h2 & mask ) == 0 )
+					hit = std::min( hit, 2 * lane + j );
+				if ( ( h3 & mask ) == 0 )
+					hit = std::min( hit, 3 * lane + j );
+			}
+		}
+
+		if ( hit < 4 * lane )
+			return first + hit;
+
+		first += 4 * lane;
+	}
+
+	// Whatever is left is searched one byte at a time
+
+	uint64_t	h	= Prime( data + first );
+
+	for ( size_t i = first; i < last; ++i )
+	{
+		h = ( h << 1 ) + GEAR.m_table[ data[i] ];
+		if ( ( h & mask ) == 0 )
+			return i;
+	}
+
+	return last;
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	minSize			Minimum chunk size. It is at least WINDOW_SIZE.
+//! @param	averageSize		Average chunk size. It is rounded to a power of 2 that is at least the minimum size.
+//! @param	maxSize			Maximum chunk size. It is at least the average size.
+//! @param	digests			If true, the SHA-256 digest of each chunk is computed and passed to the receiver.
+
+ContentChunker::ContentChunker( size_t minSize, size_t averageSize, size_t maxSize, bool digests )
+	: m_minSize( std::max( minSize, WINDOW_SIZE ) ),
+	m_digests( digests )
+{
+	int	bits	= 0;
+
+	while ( ( size_t( 1 ) << ( bits + 1 ) ) <= averageSize || ( size_t( 1 ) << bits ) < m_minSize )
+	{
+		++bits;
+	}
+
+	// Round to the nearer power of 2
+
+	if ( ( size_t( 1 ) << bits ) < averageSize && averageSize - ( size_t( 1 ) << bits ) > ( size_t( 1 ) << bits ) / 2 )
+		++bits;
+
+	m_averageSize	= size_t( 1 ) << bits;
+	m_maxSize		= std::max( maxSize, m_averageSize );
+
+	// The masks select the high bits of the hash, which depend on the most bytes. A mask of n bits matches at 1 in
+	// 2^n positions.
+
+	m_smallMask	= ~uint64_t( 0 ) << ( 64 - std::min( bits + 2, 63 ) );
+	m_largeMask	= ~uint64_t( 0 ) << ( 64 - std::max( bits - 2, 1 ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Data
+//! @param	size	Size of the data
+
+size_t ContentChunker::Cut( uint8_t const * data, size_t size ) const
+{
+	return Next( data, size, nullptr );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data		Data
+//! @param	size		Size of the data
+//! @param	receiver	Called with each chunk
+
+void ContentChunker::Split( uint8_t const * data, size_t size, Receiver const & receiver ) const
+{
+	while ( size > 0 )
+	{
+		size_t const	n	= Emit( data, size, receiver );
+
+		data += n;
+		size -= n;
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	path		Name of the file
+//! @param	receiver	Called with each chunk
+//!
+//! The file is mapped, so it is not copied.
+
+bool ContentChunker::Split( char const * path, Receiver const & receiver ) const
+{
+	MappedFile	file;
+
+	if ( !file.Open( path, MappedFile::SEQUENTIAL ) )
+	{
+		// An empty file cannot be mapped, but it is not an error. It has no chunks.
+
+		FILE * const	f	= fopen( path, "rb" );
+
+		if ( f == nullptr )
+			return false;
+
+		bool const	empty	= fgetc( f ) == EOF && !ferror( f );
+
+		fclose( f );
+		return empty;
+	}
+
+	Split( file.Data(), file.Size(), receiver );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data		Data
+//! @param	size		Size of the data
+//! @param	receiver	Called with each chunk
+//!
+//! A boundary can only be determined when there is at least a maximum-size chunk of data. Data is only copied when
+//! a chunk spans two calls.
+
+void ContentChunker::Process( uint8_t const * data, size_t size, Receiver const & receiver )
+{
+	while ( size > 0 )
+	{
+		if ( m_buffer.empty() )
+		{
+			while ( size >= m_maxSize )
+			{
+				size_t const	n	= Emit( data, size, receiver );
+
+				data += n;
+				size -= n;
+			}
+
+			m_buffer.assign( data, data + size );
+			return;
+		}
+
+		// Fill the buffer with enough data for a maximum-size chunk, and cut it
+
+		size_t const	n	= std::min( size, m_maxSize - m_buffer.size() );
+
+		m_buffer.insert( m_buffer.end(), data, data + n );
+		data += n;
+		size -= n;
+
+		if ( m_buffer.size() < m_maxSize )
+			return;
+
+		size_t const	cut		= Emit( m_buffer.data(), m_buffer.size(), receiver );
+		size_t const	rest	= m_buffer.size() - cut;
+
+		// If the rest of the buffer came from this call, continue from the data instead of the buffer
+
+		if ( rest <= n )
+		{
+			data -= rest;
+			size += rest;
+			m_buffer.clear();
+		}
+		else
+		{
+			m_buffer.erase( m_buffer.begin(), m_buffer.begin() + cut );
+		}
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	receiver	Called with each chunk
+
+void ContentChunker::Finish( Receiver const & receiver )
+{
+	Split( m_buffer.data(), m_buffer.size(), receiver );
+	m_buffer.clear();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The search is done in blocks, and each block is passed to the hasher after it is searched, while it is still in
+//! the cache.
+
+size_t ContentChunker::Next( uint8_t const * data, size_t size, Sha256Calculator * hasher ) const
+{
+	size_t	end		= size;
+
+	if ( size > m_minSize )
+	{
+		size_t const	last	= std::min( size, m_maxSize );
+		size_t const	normal	= std::min( m_averageSize, last );
+
+		// A boundary after byte i makes a chunk of i + 1 bytes
+
+		size_t	hashed		= 0;
+		size_t	position	= m_minSize - 1;
+
+		end = last;
+
+		while ( position < last - 1 )
+		{
+			size_t const	limit		= ( position < normal - 1 ) ? normal - 1 : last - 1;
+			size_t const	blockEnd	= std::min( position + BLOCK_SIZE, limit );
+			uint64_t const	mask		= ( position < normal - 1 ) ? m_smallMask : m_largeMask;
+			size_t const	boundary	= FindBoundary( data, position, blockEnd, mask );
+
+			if ( boundary < blockEnd )
+			{
+				end = boundary + 1;
+				break;
+			}
+
+			if ( hasher != nullptr )
+			{
+				hasher->Process( data + hashed, blockEnd - hashed );
+				hashed = blockEnd;
+			}
+
+			position = blockEnd;
+		}
+
+		if ( hasher != nullptr )
+			hasher->Process( data + hashed, end - hashed );
+	}
+	else if ( hasher != nullptr )
+	{
+		hasher->Process( data, size );
+	}
+
+	return end;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+size_t ContentChunker::Emit( uint8_t const * data, size_t size, Receiver const & receiver ) const
+{
+	if ( !m_digests )
+	{
+		size_t const	n	= Next( data, size, nullptr );
+
+		receiver( data, n, nullptr );
+		return n;
+	}
+
+	Sha256Calculator	hasher;
+	Sha256				digest;
+	size_t const		n	= Next( data, size, &hasher );
+
+	hasher.Finalize( digest.m_value );
+	receiver( data, n, &digest );
+
+	return n;
+}
+
+
+} // namespace Crypto
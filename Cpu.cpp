@@ -0,0 +1,141 @@
+/********************************************************************************************************************
+
+                                                        Cpu.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Cpu.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Cpu.h"
+
+#if CRYPTO_X86
+#if defined( _MSC_VER )
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+
+namespace
+{
+
+
+#if CRYPTO_X86
+
+// Executes CPUID for the given leaf and sub-leaf. Registers are returned in the order eax, ebx, ecx, edx.
+
+void CpuId( unsigned leaf, unsigned subleaf, unsigned registers[ 4 ] )
+{
+#if defined( _MSC_VER )
+	int r[ 4 ];
+	__cpuidex( r, int( leaf ), int( subleaf ) );
+	for ( int i = 0; i < 4; ++i )
+	{
+		registers[ i ] = unsigned( r[ i ] );
+	}
+#else
+	__cpuid_count( leaf, subleaf, registers[ 0 ], registers[ 1 ], registers[ 2 ], registers[ 3 ] );
+#endif
+}
+
+
+// Returns the state components enabled by the OS in XCR0. Only valid if OSXSAVE is set.
+
+unsigned long long Xcr0()
+{
+#if defined( _MSC_VER )
+	return _xgetbv( 0 );
+#else
+	unsigned	eax;
+	unsigned	edx;
+	__asm__ __volatile__( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+	return ( static_cast< unsigned long long >( edx ) << 32 ) | eax;
+#endif
+}
+
+#endif // CRYPTO_X86
+
+
+unsigned Probe()
+{
+	using namespace Crypto::Cpu;
+
+	unsigned	features	= 0;
+
+#if CRYPTO_X86
+	unsigned	r[ 4 ];
+
+	CpuId( 0, 0, r );
+	unsigned const	maxLeaf	= r[ 0 ];
+
+	if ( maxLeaf < 1 )
+	{
+		return features;
+	}
+
+	CpuId( 1, 0, r );
+	unsigned const	ecx1	= r[ 2 ];
+	unsigned const	edx1	= r[ 3 ];
+
+	if ( edx1 & ( 1u << 26 ) ) features |= SSE2;
+	if ( ecx1 & ( 1u <<  9 ) ) features |= SSSE3;
+	if ( ecx1 & ( 1u << 19 ) ) features |= SSE41;
+	if ( ecx1 & ( 1u << 20 ) ) features |= SSE42;
+	if ( ecx1 & ( 1u <<  1 ) ) features |= PCLMUL;
+	if ( ecx1 & ( 1u << 22 ) ) features |= MOVBE;
+
+	// AVX and later extensions also require the OS to save the extended registers
+
+	bool const	osxsave		= ( ecx1 & ( 1u << 27 ) ) != 0;
+	unsigned long long const	xcr0	= osxsave ? Xcr0() : 0;
+	bool const	osAvx		= ( xcr0 & 0x06 ) == 0x06;
+	bool const	osAvx512	= ( xcr0 & 0xe6 ) == 0xe6;
+
+	if ( osAvx && ( ecx1 & ( 1u << 28 ) ) ) features |= AVX;
+
+	if ( maxLeaf >= 7 )
+	{
+		CpuId( 7, 0, r );
+		unsigned const	ebx7	= r[ 1 ];
+
+		if ( osAvx && ( ebx7 & ( 1u <<  5 ) ) ) features |= AVX2;
+		if ( ebx7 & ( 1u <<  8 ) ) features |= BMI2;
+		if ( ebx7 & ( 1u << 29 ) ) features |= SHA;
+		if ( osAvx512 && ( ebx7 & ( 1u << 16 ) ) ) features |= AVX512F;
+		if ( osAvx512 && ( ebx7 & ( 1u << 30 ) ) ) features |= AVX512BW;
+	}
+#endif // CRYPTO_X86
+
+	return features;
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+namespace Cpu
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+unsigned Features()
+{
+	static unsigned const	features	= Probe();
+
+	return features;
+}
+
+
+} // namespace Cpu
+} // namespace Crypto
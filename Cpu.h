@@ -0,0 +1,70 @@
+/********************************************************************************************************************
+
+                                                         Cpu.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Cpu.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+
+// CRYPTO_X86 is non-zero when compiling for an x86 or x64 processor
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __x86_64__ ) || defined( __i386__ )
+#define CRYPTO_X86	1
+#else
+#define CRYPTO_X86	0
+#endif
+
+// CRYPTO_TARGET( features ) enables instruction set extensions for a single function. MSVC allows intrinsics to be
+// used anywhere, so it is not needed there. Any inline helper function called by such a function must have the same
+// target.
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define CRYPTO_TARGET( features )	__attribute__(( target( features ) ))
+#else
+#define CRYPTO_TARGET( features )
+#endif
+
+
+namespace Crypto
+{
+namespace Cpu
+{
+
+
+//! Processor features that kernels may require
+enum Feature
+{
+	SSE2		= 1 << 0,
+	SSSE3		= 1 << 1,
+	SSE41		= 1 << 2,
+	SSE42		= 1 << 3,
+	PCLMUL		= 1 << 4,
+	MOVBE		= 1 << 5,
+	AVX			= 1 << 6,
+	AVX2		= 1 << 7,
+	BMI2		= 1 << 8,
+	SHA			= 1 << 9,
+	AVX512F		= 1 << 10,
+	AVX512BW	= 1 << 11
+};
+
+//! Returns the set of features supported by the processor and the OS. The processor is only probed once.
+unsigned Features();
+
+//! Returns true if all of the given features are supported
+inline bool Has( unsigned features )
+{
+	return ( Features() & features ) == features;
+}
+
+
+} // namespace Cpu
+} // namespace Crypto
@@ -24,7 +24,7 @@ namespace Crypto
 /*																													*/
 /********************************************************************************************************************/
 
-Crc32::Crc32( unsigned __int8 const * pData, size_t size )
+Crc32::Crc32( uint8_t const * pData, size_t size )
 {
 	m_value = Crc32Calculator().Calculate( pData, size );
 }
@@ -79,13 +79,41 @@ Crc32::Crc32( char const * text )
 
 std::string Crc32::ToString() const
 {
-	std::string	result( 8, '0' );
+	std::string	result( TEXT_SIZE, '0' );
 
-	int	i = 7;
-	for ( unsigned __int32 value = m_value; value != 0; value >>= 4 )
+	ToChars( &result[0], &result[0] + TEXT_SIZE );
+
+	return result;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::to_chars_result Crc32::ToChars( char * first, char * last ) const
+{
+	uint8_t	bytes[ SIZE ];
+
+	StoreBigEndian32( bytes, m_value );
+
+	return Crypto::ToChars( bytes, SIZE, first, last );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::from_chars_result Crc32::FromChars( char const * first, char const * last, Crc32 & value )
+{
+	uint8_t	bytes[ SIZE ];
+
+	std::from_chars_result const	result	= Crypto::FromChars( first, last, bytes, SIZE );
+
+	if ( result.ec == std::errc() )
 	{
-		result[i] = xtoa( value & 0x0000000f );
-		--i;
+		value.m_value = LoadBigEndian32( bytes );
 	}
 
 	return result;
@@ -13,8 +13,84 @@
 
 #include "Crc32Calculator.h"
 
+#include "Kernels.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <istream>
 #include <string>
+#include <vector>
+
+#if !defined( _WIN32 )
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace
+{
+
+uint32_t const	POLYNOMIAL	= 0xEDB88320;
+
+// Returns a * b mod the polynomial. The bits of the CRC register are reversed, so the high bit is the coefficient of
+// x^0 and shifting right multiplies by x.
+
+constexpr uint32_t Multiply( uint32_t a, uint32_t b )
+{
+	uint32_t	product	= 0;
+
+	for ( uint32_t m = 0x80000000; m != 0; m >>= 1 )
+	{
+		if ( ( a & m ) != 0 )
+			product ^= b;
+
+		b = ( ( b & 1 ) != 0 ) ? ( b >> 1 ) ^ POLYNOMIAL : b >> 1;
+	}
+
+	return product;
+}
+
+// Table of x^(8 * 2^k) mod the polynomial. Processing a 0 byte multiplies the CRC register by x^8, so processing n 0's
+// multiplies it by the product of the entries for the bits set in n.
+
+struct PowerTable
+{
+	constexpr PowerTable()
+		: m_table()
+	{
+		uint32_t	x	= 0x00800000;	// x^8
+
+		for ( int k = 0; k < 64; ++k )
+		{
+			m_table[k] = x;
+			x = Multiply( x, x );
+		}
+	}
+
+	uint32_t	m_table[ 64 ];
+};
+
+constexpr PowerTable	POWERS;
+
+// Returns the batch kernel that goes with the active CRC-32 kernel, or nullptr if there is none. The registry's choice
+// (or a forced kernel) is respected.
+
+Crypto::Kernels::BatchFunction SelectBatch( Crypto::Kernels::Function kernel )
+{
+#if CRYPTO_X86
+	if ( kernel == Crypto::Kernels::Crc32Pclmul )
+		return Crypto::Kernels::Crc32x4Pclmul;
+#endif
+	if ( kernel == Crypto::Kernels::Crc32Slice8 )
+		return Crypto::Kernels::Crc32x4Slice8;
+
+	return nullptr;
+}
+
+} // anonymous namespace
 
 
 namespace Crypto
@@ -27,7 +103,7 @@ namespace Crypto
 // Note: This table was computed by the private function GenerateLookupTable(). See the class comments for details.
 //
 
-unsigned __int32	Crc32Calculator::m_lookupTable[ LOOKUP_TABLE_SIZE ] =
+uint32_t			Crc32Calculator::m_lookupTable[ LOOKUP_TABLE_SIZE ] =
 {
 	0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA,0x076DC419, 0x706AF48F, 0xE963A535, 0x9E6495A3,
 	0x0EDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988,0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91,
@@ -90,12 +166,12 @@ Crc32Calculator::~Crc32Calculator()
 //! @param	paData	The buffer.
 //! @param	size	The number of bytes in the buffer.
 
-unsigned __int32 Crc32Calculator::Calculate( unsigned __int8 const * paData, size_t size )
+uint32_t Crc32Calculator::Calculate( uint8_t const * paData, size_t size )
 {
 	Reset();
 	Process( paData, size );
 
-	unsigned __int32	crc;
+	uint32_t			crc;
 
 	Finalize( &crc );
 
@@ -110,16 +186,12 @@ unsigned __int32 Crc32Calculator::Calculate( unsigned __int8 const * paData, siz
 //!
 //! @param	paData	The string. The string must be 0-terminated. The terminator is not included in the CRC.
 
-unsigned __int32 Crc32Calculator::Calculate( char const * paData )
+uint32_t Crc32Calculator::Calculate( char const * paData )
 {
 	Reset();
+	Process( reinterpret_cast< uint8_t const * >( paData ), strlen( paData ) );
 
-	while (	*paData	!= 0 )
-	{
-		Process( *paData++ );
-	}
-
-	unsigned __int32	crc;
+	uint32_t			crc;
 
 	Finalize( &crc );
 
@@ -134,18 +206,12 @@ unsigned __int32 Crc32Calculator::Calculate( char const * paData )
 //!
 //! @param	string	The string.
 
-unsigned __int32 Crc32Calculator::Calculate( std::string const & string )
+uint32_t Crc32Calculator::Calculate( std::string const & string )
 {
-	size_t	size	= string.size();
-
 	Reset();
+	Process( reinterpret_cast< uint8_t const * >( string.data() ), string.size() );
 
-	for	( size_t i	= 0; i < size; ++i )
-	{
-		Process( string[i] );
-	}
-
-	unsigned __int32	crc;
+	uint32_t			crc;
 
 	Finalize( &crc );
 
@@ -160,23 +226,198 @@ unsigned __int32 Crc32Calculator::Calculate( std::string const & string )
 //!
 //! @param	stream	The input stream.
 
-unsigned __int32 Crc32Calculator::Calculate( std::istream & stream	)
+uint32_t Crc32Calculator::Calculate( std::istream & stream	)
+{
+	Reset();
+	Process( stream );
+
+	uint32_t			crc;
+
+	Finalize( &crc );
+
+	return crc;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	path	The name of the file
+//! @param	pCrc	Where to put the result
+//!
+//! The holes in a sparse file are processed as runs of 0's without being read, so the time taken is proportional to
+//! the data actually stored in the file. The result is the same as the CRC-32 of all the contents.
+
+bool Crc32Calculator::CalculateFile( char const * path, uint32_t * pCrc )
 {
 	Reset();
 
-	for ( unsigned char c = stream.get(); !stream.eof(); c = stream.get() )
+	if ( !ProcessFile( path ) )
+		return false;
+
+	Finalize( pCrc );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	crc		The CRC-32 of the buffer before the changes
+//! @param	size	The size of the buffer
+//! @param	edits	The changes. Each one must be within the buffer. If ranges overlap, the old values of each range
+//!					must include the changes made by the ones before it.
+//! @param	count	The number of changes
+//!
+//! A CRC is linear, so changing the data by XORing it with a value changes the CRC by the CRC of the value (without
+//! the initial value and final inversion). The value is 0 outside the edits, so the CRC of each edit only depends on
+//! the bytes that changed, followed by a run of 0's to the end of the buffer. The run of 0's is processed in
+//! logarithmic time by multiplying by powers of x. The time taken is proportional to the size of the edits, and the
+//! rest of the buffer is not needed.
+
+uint32_t Crc32Calculator::Update( uint32_t crc, uint64_t size, Edit const * edits, size_t count )
+{
+	Kernels::Function const	kernel	= Kernels::Get( KernelRegistry::CRC32 );
+	uint8_t					buffer[ STREAM_BUFFER_SIZE ];
+
+	for ( size_t i = 0; i < count; ++i )
 	{
-		Process( c );
-	}
+		Edit const &	edit	= edits[i];
+		uint32_t		change	= 0;
 
-	unsigned __int32	crc;
+		for ( size_t j = 0; j < edit.size; j += sizeof( buffer ) )
+		{
+			size_t const	n	= std::min( edit.size - j, sizeof( buffer ) );
 
-	Finalize( &crc );
+			for ( size_t k = 0; k < n; ++k )
+			{
+				buffer[k] = edit.before[ j + k ] ^ edit.after[ j + k ];
+			}
+
+			kernel( &change, buffer, n );
+		}
+
+		crc ^= Shift( change, size - edit.offset - edit.size );
+	}
 
 	return crc;
 }
 
 
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	crc		The CRC-32 of the buffer before the change
+//! @param	size	The size of the buffer
+//! @param	offset	The offset of the range
+//! @param	before	The old values of the bytes in the range
+//! @param	after	The new values of the bytes in the range
+//! @param	n		The number of bytes in the range
+
+uint32_t Crc32Calculator::Update( uint32_t crc, uint64_t size, uint64_t offset, uint8_t const * before,
+								  uint8_t const * after, size_t n )
+{
+	Edit const	edit	= { offset, before, after, n };
+
+	return Update( crc, size, &edit, 1 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	first		The CRC-32 of the first buffer
+//! @param	second		The CRC-32 of the second buffer
+//! @param	secondSize	The size of the second buffer
+//!
+//! Appending the second buffer to the first is the same as appending that many 0's and then XORing the second
+//! buffer's CRC into the result, because the initial value and final inversion of the two cancel out. The run of 0's
+//! takes time proportional to the log of the size, so neither buffer is needed.
+
+uint32_t Crc32Calculator::Combine( uint32_t first, uint32_t second, uint64_t secondSize )
+{
+	return Shift( first, secondSize ) ^ second;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	buffers		The buffers
+//! @param	size		The size of each buffer
+//! @param	count		The number of buffers
+//! @param	crcs		Where to put the CRC-32 of each buffer
+//!
+//! The buffers are processed four at a time with interleaved kernels, which is much faster than calling Calculate()
+//! for each one when the buffers are small, such as pages or packets.
+
+void Crc32Calculator::CalculateBatch( uint8_t const * const * buffers, size_t size, size_t count, uint32_t * crcs )
+{
+	Batch( buffers, &size, 0, count, crcs );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	buffers		The buffers
+//! @param	sizes		The size of each buffer
+//! @param	count		The number of buffers
+//! @param	crcs		Where to put the CRC-32 of each buffer
+//!
+//! The buffers are processed four at a time with interleaved kernels. The part of each group of four that they all
+//! have in common is processed together, and the rest separately, so the sizes should be similar.
+
+void Crc32Calculator::CalculateBatch( uint8_t const * const * buffers, size_t const * sizes, size_t count,
+									  uint32_t * crcs )
+{
+	Batch( buffers, sizes, 1, count, crcs );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	buffers		The buffers
+//! @param	size		The size of each buffer
+//! @param	count		The number of buffers
+//! @param	expected	The expected CRC-32 of each buffer
+//! @param	failures	Bit i % 64 of failures[i / 64] is set if buffer i fails. There must be ( count + 63 ) / 64
+//!						words.
+
+size_t Crc32Calculator::VerifyBatch( uint8_t const * const * buffers, size_t size, size_t count,
+									 uint32_t const * expected, uint64_t * failures )
+{
+	return Verify( buffers, &size, 0, count, expected, failures );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	buffers		The buffers
+//! @param	sizes		The size of each buffer
+//! @param	count		The number of buffers
+//! @param	expected	The expected CRC-32 of each buffer
+//! @param	failures	Bit i % 64 of failures[i / 64] is set if buffer i fails. There must be ( count + 63 ) / 64
+//!						words.
+
+size_t Crc32Calculator::VerifyBatch( uint8_t const * const * buffers, size_t const * sizes, size_t count,
+									 uint32_t const * expected, uint64_t * failures )
+{
+	return Verify( buffers, sizes, 1, count, expected, failures );
+}
+
+
 /********************************************************************************************************************/
 /*																													*/
 /********************************************************************************************************************/
@@ -187,7 +428,8 @@ unsigned __int32 Crc32Calculator::Calculate( std::istream & stream	)
 
 void Crc32Calculator::Reset()
 {
-	m_crc = 0xFFFFFFFF;
+	m_crc		= 0xFFFFFFFF;
+	m_kernel	= Kernels::Get( KernelRegistry::CRC32 );
 }
 
 
@@ -201,7 +443,7 @@ void Crc32Calculator::Reset()
 //!
 //! @param	c		Value used to update the CRC
 
-void Crc32Calculator::Process( unsigned __int8 c )
+void Crc32Calculator::Process( uint8_t c )
 {
 	m_crc = ( m_crc >> 8 ) ^ m_lookupTable[ ( m_crc ^ c ) & 0xFF ];
 }
@@ -218,15 +460,147 @@ void Crc32Calculator::Process( unsigned __int8 c )
 //! @param	paData	The buffer
 //! @param	size	The number of bytes in the buffer
 
-void Crc32Calculator::Process( unsigned __int8 const * paData, size_t size )
+void Crc32Calculator::Process( uint8_t const * paData, size_t size )
 {
-	for	( size_t i = 0;	i <	size; ++i )
+	m_kernel( &m_crc, paData, size );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The Reset(), Process() and Finalize() functions are used to generate a CRC in a user-defined manner. Reset() must be
+//! called before calculating the CRC using Process(), and Finalize() must be called after all the data is included in
+//! the CRC.
+//!
+//! @param	stream	The input stream. The stream is read until the end.
+
+void Crc32Calculator::Process( std::istream & stream )
+{
+	uint8_t			buffer[ STREAM_BUFFER_SIZE ];
+
+	while ( stream.good() )
 	{
-		Process( paData[i] );
+		stream.read( reinterpret_cast< char * >( buffer ), sizeof( buffer ) );
+		Process( buffer, size_t( stream.gcount() ) );
 	}
 }
 
 
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The Reset(), Process() and Finalize() functions are used to generate a CRC in a user-defined manner. Reset() must be
+//! called before calculating the CRC using Process(), and Finalize() must be called after all the data is included in
+//! the CRC.
+//!
+//! @param	size	The number of 0's
+//!
+//! Processing a 0 multiplies the CRC register by x^8 modulo the polynomial, so n 0's multiply it by x^(8n), which is
+//! computed by squaring.
+
+void Crc32Calculator::ProcessZeros( uint64_t size )
+{
+	m_crc = Shift( m_crc, size );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The Reset(), Process() and Finalize() functions are used to generate a CRC in a user-defined manner. Reset() must be
+//! called before calculating the CRC using Process(), and Finalize() must be called after all the data is included in
+//! the CRC.
+//!
+//! @param	path	The name of the file
+//!
+//! The extents of data are found with SEEK_DATA and SEEK_HOLE, and only they are read. The holes between them are
+//! processed with ProcessZeros(). If the file system does not report holes, the whole file is read.
+
+bool Crc32Calculator::ProcessFile( char const * path )
+{
+	std::vector< uint8_t >	buffer( FILE_BUFFER_SIZE );
+
+#if defined( _WIN32 )
+	FILE * const	file	= fopen( path, "rb" );
+
+	if ( file == nullptr )
+		return false;
+
+	size_t	n;
+
+	while ( ( n = fread( buffer.data(), 1, buffer.size(), file ) ) > 0 )
+	{
+		Process( buffer.data(), n );
+	}
+
+	bool const	ok	= ferror( file ) == 0;
+
+	fclose( file );
+	return ok;
+#else
+	int const	fd	= open( path, O_RDONLY );
+
+	if ( fd < 0 )
+		return false;
+
+	struct stat	status;
+	bool		ok			= fstat( fd, &status ) == 0;
+	off_t const	size		= ok ? status.st_size : 0;
+	off_t		position	= 0;
+
+	while ( ok && position < size )
+	{
+		// Find the next extent of data. Everything before it is a hole.
+
+		off_t	start	= position;
+		off_t	end		= size;
+
+#if defined( SEEK_DATA ) && defined( SEEK_HOLE )
+		start = lseek( fd, position, SEEK_DATA );
+
+		if ( start >= 0 )
+		{
+			end = lseek( fd, start, SEEK_HOLE );
+			end = ( end >= 0 ) ? std::min( end, size ) : size;
+		}
+		else
+		{
+			// ENXIO means there is no more data. Anything else means holes are not supported.
+			start = ( errno == ENXIO ) ? size : position;
+		}
+#endif
+
+		ProcessZeros( uint64_t( start - position ) );
+
+		for ( position = start; position < end; )
+		{
+			size_t const	n		= size_t( std::min( end - position, off_t( buffer.size() ) ) );
+			ssize_t const	result	= pread( fd, buffer.data(), n, position );
+
+			if ( result < 0 && errno == EINTR )
+				continue;
+
+			if ( result <= 0 )
+			{
+				ok = false;
+				break;
+			}
+
+			Process( buffer.data(), size_t( result ) );
+			position += result;
+		}
+	}
+
+	close( fd );
+	return ok;
+#endif
+}
+
+
 /********************************************************************************************************************/
 /*																													*/
 /********************************************************************************************************************/
@@ -240,7 +614,7 @@ void Crc32Calculator::Process( unsigned __int8 const * paData, size_t size )
 //! @note	The CRC is not valid until it is finalized with Finalize(). Once the CRC is finalized, it can no longer
 //!			be updated, and Reset() must be called to compute another Crc.
 
-void Crc32Calculator::Finalize( unsigned __int32 * pCrc )
+void Crc32Calculator::Finalize( uint32_t * pCrc )
 {
 	m_crc ^= 0xFFFFFFFF;
 
@@ -252,13 +626,101 @@ void Crc32Calculator::Finalize( unsigned __int32 * pCrc )
 /*																													*/
 /********************************************************************************************************************/
 
-void Crc32Calculator::GenerateLookupTable( unsigned __int32 aTable[LOOKUP_TABLE_SIZE] )
+uint32_t Crc32Calculator::Shift( uint32_t crc, uint64_t size )
+{
+	for ( int k = 0; size != 0; ++k, size >>= 1 )
+	{
+		if ( ( size & 1 ) != 0 )
+			crc = Multiply( POWERS.m_table[k], crc );
+	}
+
+	return crc;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Crc32Calculator::Batch( uint8_t const * const * buffers, size_t const * sizes, size_t step, size_t count,
+							 uint32_t * crcs )
+{
+	Kernels::Function const			kernel	= Kernels::Get( KernelRegistry::CRC32 );
+	Kernels::BatchFunction const	batch	= SelectBatch( kernel );
+	size_t							i		= 0;
+
+	if ( batch != nullptr )
+	{
+		for ( ; i + 4 <= count; i += 4 )
+		{
+			size_t const	common		= std::min( std::min( sizes[ i * step ], sizes[ ( i + 1 ) * step ] ),
+												std::min( sizes[ ( i + 2 ) * step ], sizes[ ( i + 3 ) * step ] ) );
+			uint32_t		states[ 4 ]	= { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
+
+			batch( states, buffers + i, common );
+
+			for ( size_t j = 0; j < 4; ++j )
+			{
+				kernel( &states[j], buffers[ i + j ] + common, sizes[ ( i + j ) * step ] - common );
+				crcs[ i + j ] = states[j] ^ 0xFFFFFFFF;
+			}
+		}
+	}
+
+	for ( ; i < count; ++i )
+	{
+		uint32_t	state	= 0xFFFFFFFF;
+
+		kernel( &state, buffers[i], sizes[ i * step ] );
+		crcs[i] = state ^ 0xFFFFFFFF;
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+size_t Crc32Calculator::Verify( uint8_t const * const * buffers, size_t const * sizes, size_t step, size_t count,
+								uint32_t const * expected, uint64_t * failures )
+{
+	size_t	failed	= 0;
+
+	for ( size_t i = 0; i < count; i += 64 )
+	{
+		size_t const	n		= std::min( count - i, size_t( 64 ) );
+		uint32_t		crcs[ 64 ];
+		uint64_t		bits	= 0;
+
+		Batch( buffers + i, sizes + i * step, step, n, crcs );
+
+		for ( size_t j = 0; j < n; ++j )
+		{
+			if ( crcs[j] != expected[ i + j ] )
+			{
+				bits |= uint64_t( 1 ) << j;
+				++failed;
+			}
+		}
+
+		failures[ i / 64 ] = bits;
+	}
+
+	return failed;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Crc32Calculator::GenerateLookupTable( uint32_t aTable[LOOKUP_TABLE_SIZE] )
 {
-	unsigned __int32 const	POLYNOMIAL	= 0xEDB88320;	// Note: reversed is 0x04C11DB7
+	uint32_t const			POLYNOMIAL	= 0xEDB88320;	// Note: reversed is 0x04C11DB7
 
 	for	( int i	= 0; i < 256; i++ )
 	{
-		unsigned __int32		x;
+		uint32_t				x;
 
 		x = i;
 
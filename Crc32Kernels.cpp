@@ -0,0 +1,314 @@
+/********************************************************************************************************************
+
+                                                    Crc32Kernels.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Crc32Kernels.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Kernels.h"
+
+#include "Common.h"
+
+#if CRYPTO_X86
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+
+// Lookup tables for slicing-by-8. Table 0 is the standard byte-at-a-time table (see Crc32Calculator.h), and table n
+// gives the CRC of a byte followed by n zero bytes.
+
+class SliceTables
+{
+public:
+
+	SliceTables()
+	{
+		uint32_t const			POLYNOMIAL	= 0xEDB88320;
+
+		for ( int i = 0; i < 256; ++i )
+		{
+			uint32_t			x	= i;
+
+			for ( int j = 0; j < 8; ++j )
+			{
+				x = ( x >> 1 ) ^ ( ( x & 1 ) ? POLYNOMIAL : 0 );
+			}
+
+			m_table[0][i] = x;
+		}
+
+		for ( int n = 1; n < 8; ++n )
+		{
+			for ( int i = 0; i < 256; ++i )
+			{
+				uint32_t const			x	= m_table[n-1][i];
+				m_table[n][i] = ( x >> 8 ) ^ m_table[0][ x & 0xff ];
+			}
+		}
+	}
+
+	uint32_t			m_table[ 8 ][ 256 ];
+};
+
+SliceTables const &	Tables()
+{
+	static SliceTables const	tables;
+
+	return tables;
+}
+
+
+#if CRYPTO_X86
+
+// Folding constants for the reflected polynomial 0xEDB88320. k1/k2 fold 512 bits, k3/k4 fold 128 bits, k5 folds 64
+// bits to 32 bits, and poly holds the polynomial and its Barrett constant u. See Gopal et al., "Fast CRC Computation
+// for Generic Polynomials Using PCLMULQDQ Instruction", Intel, 2009.
+
+CRYPTO_TARGET( "pclmul,sse4.1" )
+inline __m128i Fold( __m128i x, __m128i k, __m128i y )
+{
+	return _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x, k, 0x00 ), _mm_clmulepi64_si128( x, k, 0x11 ) ), y );
+}
+
+// Reduces 128 bits folded with K3K4 to the 32-bit CRC register
+
+CRYPTO_TARGET( "pclmul,sse4.1" )
+inline uint32_t Reduce( __m128i x1 )
+{
+	__m128i const	K3K4	= _mm_set_epi64x( 0x00ccaa009eLL, 0x01751997d0LL );
+	__m128i const	K5		= _mm_set_epi64x( 0, 0x0163cd6124LL );
+	__m128i const	POLY	= _mm_set_epi64x( 0x01f7011641LL, 0x01db710641LL );
+	__m128i const	LOW32	= _mm_setr_epi32( ~0, 0, ~0, 0 );
+
+	// Fold 128 bits to 64 bits
+
+	__m128i	x	= _mm_xor_si128( _mm_srli_si128( x1, 8 ), _mm_clmulepi64_si128( x1, K3K4, 0x10 ) );
+	x = _mm_xor_si128( _mm_clmulepi64_si128( _mm_and_si128( x, LOW32 ), K5, 0x00 ), _mm_srli_si128( x, 4 ) );
+
+	// Barrett reduction to 32 bits
+
+	__m128i	t	= _mm_clmulepi64_si128( _mm_and_si128( x, LOW32 ), POLY, 0x10 );
+	t = _mm_clmulepi64_si128( _mm_and_si128( t, LOW32 ), POLY, 0x00 );
+	x = _mm_xor_si128( x, t );
+
+	return uint32_t( _mm_extract_epi32( x, 1 ) );
+}
+
+#endif // CRYPTO_X86
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+namespace Kernels
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The classic byte-at-a-time table lookup
+
+void Crc32Table( uint32_t * state, uint8_t const * data, size_t size )
+{
+	uint32_t const *			table	= Tables().m_table[0];
+	uint32_t					crc		= *state;
+
+	for ( size_t i = 0; i < size; ++i )
+	{
+		crc = ( crc >> 8 ) ^ table[ ( crc ^ data[i] ) & 0xFF ];
+	}
+
+	*state = crc;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Slicing-by-8: eight bytes are processed per iteration with eight independent table lookups
+
+void Crc32Slice8( uint32_t * state, uint8_t const * data, size_t size )
+{
+	uint32_t const			( *table )[ 256 ]	= Tables().m_table;
+	uint32_t				crc					= *state;
+
+	for ( ; size >= 8; size -= 8, data += 8 )
+	{
+		uint32_t const			one	= LoadLittleEndian32( data ) ^ crc;
+		uint32_t const			two	= LoadLittleEndian32( data + 4 );
+
+		crc =	table[7][ one & 0xff ] ^ table[6][ ( one >> 8 ) & 0xff ] ^ table[5][ ( one >> 16 ) & 0xff ] ^ table[4][ one >> 24 ] ^
+				table[3][ two & 0xff ] ^ table[2][ ( two >> 8 ) & 0xff ] ^ table[1][ ( two >> 16 ) & 0xff ] ^ table[0][ two >> 24 ];
+	}
+
+	for ( ; size > 0; --size, ++data )
+	{
+		crc = ( crc >> 8 ) ^ table[0][ ( crc ^ *data ) & 0xFF ];
+	}
+
+	*state = crc;
+}
+
+
+#if CRYPTO_X86
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Folds 64 bytes at a time using carry-less multiplication, then reduces the remainder with a Barrett reduction.
+// Buffers shorter than 64 bytes and any tail that is not a multiple of 16 bytes are handled by slicing-by-8.
+
+CRYPTO_TARGET( "pclmul,sse4.1" )
+void Crc32Pclmul( uint32_t * state, uint8_t const * data, size_t size )
+{
+	if ( size < 64 )
+	{
+		Crc32Slice8( state, data, size );
+		return;
+	}
+
+	__m128i const	K1K2	= _mm_set_epi64x( 0x01c6e41596LL, 0x0154442bd4LL );
+	__m128i const	K3K4	= _mm_set_epi64x( 0x00ccaa009eLL, 0x01751997d0LL );
+
+	__m128i const *	p	= reinterpret_cast< __m128i const * >( data );
+
+	__m128i	x1	= _mm_xor_si128( _mm_loadu_si128( p + 0 ), _mm_cvtsi32_si128( int( *state ) ) );
+	__m128i	x2	= _mm_loadu_si128( p + 1 );
+	__m128i	x3	= _mm_loadu_si128( p + 2 );
+	__m128i	x4	= _mm_loadu_si128( p + 3 );
+
+	p		+= 4;
+	size	-= 64;
+
+	// Fold 512 bits at a time
+
+	for ( ; size >= 64; size -= 64, p += 4 )
+	{
+		x1 = Fold( x1, K1K2, _mm_loadu_si128( p + 0 ) );
+		x2 = Fold( x2, K1K2, _mm_loadu_si128( p + 1 ) );
+		x3 = Fold( x3, K1K2, _mm_loadu_si128( p + 2 ) );
+		x4 = Fold( x4, K1K2, _mm_loadu_si128( p + 3 ) );
+	}
+
+	// Fold into 128 bits, and then fold any remaining 128-bit blocks
+
+	x1 = Fold( x1, K3K4, x2 );
+	x1 = Fold( x1, K3K4, x3 );
+	x1 = Fold( x1, K3K4, x4 );
+
+	for ( ; size >= 16; size -= 16, ++p )
+	{
+		x1 = Fold( x1, K3K4, _mm_loadu_si128( p ) );
+	}
+
+	*state = Reduce( x1 );
+
+	// Handle the tail
+
+	Crc32Slice8( state, reinterpret_cast< uint8_t const * >( p ), size );
+}
+
+#endif // CRYPTO_X86
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Slicing-by-8 on four buffers at once. A single buffer is limited by the latency of the lookups that feed the next
+// step, and interleaving four buffers keeps the loads busy.
+
+void Crc32x4Slice8( uint32_t * states, uint8_t const * const * data, size_t size )
+{
+	uint32_t const			( *table )[ 256 ]	= Tables().m_table;
+	uint32_t				crc[ 4 ]			= { states[0], states[1], states[2], states[3] };
+	size_t					i					= 0;
+
+	for ( ; i + 8 <= size; i += 8 )
+	{
+		for ( int j = 0; j < 4; ++j )
+		{
+			uint32_t const			one	= LoadLittleEndian32( data[j] + i ) ^ crc[j];
+			uint32_t const			two	= LoadLittleEndian32( data[j] + i + 4 );
+
+			crc[j] =	table[7][ one & 0xff ] ^ table[6][ ( one >> 8 ) & 0xff ] ^ table[5][ ( one >> 16 ) & 0xff ] ^ table[4][ one >> 24 ] ^
+						table[3][ two & 0xff ] ^ table[2][ ( two >> 8 ) & 0xff ] ^ table[1][ ( two >> 16 ) & 0xff ] ^ table[0][ two >> 24 ];
+		}
+	}
+
+	for ( int j = 0; j < 4; ++j )
+	{
+		states[j] = crc[j];
+		Crc32Slice8( &states[j], data[j] + i, size - i );
+	}
+}
+
+
+#if CRYPTO_X86
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Folds four buffers at once, 128 bits at a time each. The folds and the final reductions of the four buffers are
+// independent, so they overlap, and buffers as short as 16 bytes can be folded.
+
+CRYPTO_TARGET( "pclmul,sse4.1" )
+void Crc32x4Pclmul( uint32_t * states, uint8_t const * const * data, size_t size )
+{
+	if ( size < 16 )
+	{
+		Crc32x4Slice8( states, data, size );
+		return;
+	}
+
+	__m128i const	K3K4	= _mm_set_epi64x( 0x00ccaa009eLL, 0x01751997d0LL );
+
+	__m128i	x0	= _mm_xor_si128( _mm_loadu_si128( reinterpret_cast< __m128i const * >( data[0] ) ), _mm_cvtsi32_si128( int( states[0] ) ) );
+	__m128i	x1	= _mm_xor_si128( _mm_loadu_si128( reinterpret_cast< __m128i const * >( data[1] ) ), _mm_cvtsi32_si128( int( states[1] ) ) );
+	__m128i	x2	= _mm_xor_si128( _mm_loadu_si128( reinterpret_cast< __m128i const * >( data[2] ) ), _mm_cvtsi32_si128( int( states[2] ) ) );
+	__m128i	x3	= _mm_xor_si128( _mm_loadu_si128( reinterpret_cast< __m128i const * >( data[3] ) ), _mm_cvtsi32_si128( int( states[3] ) ) );
+	size_t	i	= 16;
+
+	for ( ; i + 16 <= size; i += 16 )
+	{
+		x0 = Fold( x0, K3K4, _mm_loadu_si128( reinterpret_cast< __m128i const * >( data[0] + i ) ) );
+		x1 = Fold( x1, K3K4, _mm_loadu_si128( reinterpret_cast< __m128i const * >( data[1] + i ) ) );
+		x2 = Fold( x2, K3K4, _mm_loadu_si128( reinterpret_cast< __m128i const * >( data[2] + i ) ) );
+		x3 = Fold( x3, K3K4, _mm_loadu_si128( reinterpret_cast< __m128i const * >( data[3] + i ) ) );
+	}
+
+	states[0] = Reduce( x0 );
+	states[1] = Reduce( x1 );
+	states[2] = Reduce( x2 );
+	states[3] = Reduce( x3 );
+
+	// Handle the tails
+
+	for ( int j = 0; j < 4; ++j )
+	{
+		Crc32Slice8( &states[j], data[j] + i, size - i );
+	}
+}
+
+#endif // CRYPTO_X86
+
+
+} // namespace Kernels
+} // namespace Crypto
@@ -0,0 +1,687 @@
+/********************************************************************************************************************
+
+                                                       Delta.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Delta.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Delta.h"
+
+#include "Common.h"
+#include "Kernels.h"
+#include "Md5Calculator.h"
+#include "Sha256Calculator.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+
+namespace
+{
+
+
+char const		SIGNATURE_MAGIC[ 4 ]	= { 'C', 'S', 'I', 'G' };
+char const		DELTA_MAGIC[ 4 ]		= { 'C', 'D', 'L', 'T' };
+uint32_t const	VERSION					= 1;
+size_t const	SIGNATURE_HEADER_SIZE	= 24;	// Magic, version, strong digest, block size and file size
+size_t const	BLOCK_RECORD_SIZE		= 4 + Crypto::BlockSignature::STRONG_SIZE;
+size_t const	DELTA_HEADER_SIZE		= 64;	// Magic, version, block size, reserved, sizes and digest
+size_t const	SHA256_SIZE				= 32;
+size_t const	NOT_FOUND				= ~size_t( 0 );
+
+// Operations in a delta
+
+uint8_t const	END		= 0;	// End of the delta
+uint8_t const	COPY	= 1;	// Copy a run of blocks from the old file. Followed by the first block and the count.
+uint8_t const	LITERAL	= 2;	// Literal data. Followed by the size and the data.
+
+size_t const	SCAN_SIZE				= 256;	// Number of positions scanned at a time
+
+typedef uint32_t ( *Checksummer )( uint8_t const * data, size_t size );
+typedef void ( *Scanner )( uint8_t const * data, size_t window, size_t count, uint32_t weak,
+						   uint32_t const * filter, int filterBits, uint32_t * weaks, uint64_t * candidates );
+
+// Returns the best weak checksum kernel for the processor
+
+Checksummer SelectChecksummer()
+{
+#if CRYPTO_X86
+	if ( Crypto::Cpu::Has( Crypto::Cpu::AVX2 ) )
+		return Crypto::Kernels::RollingChecksumAvx2;
+#endif
+	return Crypto::Kernels::RollingChecksumGeneric;
+}
+
+// Returns the best scan kernel for the processor
+
+Scanner SelectScanner()
+{
+#if CRYPTO_X86
+	if ( Crypto::Cpu::Has( Crypto::Cpu::AVX2 ) )
+		return Crypto::Kernels::RollingChecksumScanAvx2;
+#endif
+	return Crypto::Kernels::RollingChecksumScanGeneric;
+}
+
+// Rolls a weak checksum forward by one byte
+
+uint32_t Roll( uint32_t weak, size_t window, uint32_t out, uint32_t in )
+{
+	uint32_t const	a	= ( weak & 0xffff ) + in - out;
+	uint32_t const	b	= ( weak >> 16 ) + a - uint32_t( window ) * out;
+
+	return ( a & 0xffff ) | ( b << 16 );
+}
+
+// Returns the index of the lowest bit set in bits, which must not be 0
+
+int CountTrailingZeros( uint64_t bits )
+{
+#if defined( _MSC_VER )
+	unsigned long	index;
+
+	_BitScanForward64( &index, bits );
+	return int( index );
+#else
+	return __builtin_ctzll( bits );
+#endif
+}
+
+// Appends an unsigned LEB128 number
+
+void PutNumber( std::vector< uint8_t > & buffer, uint64_t x )
+{
+	while ( x >= 0x80 )
+	{
+		buffer.push_back( uint8_t( x | 0x80 ) );
+		x >>= 7;
+	}
+
+	buffer.push_back( uint8_t( x ) );
+}
+
+// Reads an unsigned LEB128 number. Returns false if it is truncated or too large.
+
+bool GetNumber( uint8_t const * & p, uint8_t const * end, uint64_t & x )
+{
+	x = 0;
+
+	for ( int shift = 0; shift < 64 && p < end; shift += 7 )
+	{
+		uint8_t const	b	= *p++;
+
+		x |= uint64_t( b & 0x7f ) << shift;
+		if ( ( b & 0x80 ) == 0 )
+			return true;
+	}
+
+	return false;
+}
+
+// Finds blocks by their weak checksums. Most positions in the new file do not match any block, so a bit filter that
+// fits in the cache rejects them before the table is touched. With 64 bits per block, about 1 in 64 positions gets
+// past it. The filter is checked by the scan kernels.
+
+class BlockTable
+{
+public:
+
+	BlockTable( Crypto::BlockSignature const & signature, size_t count );
+
+	// Returns the filter
+	uint32_t const * Filter() const		{ return m_filter.data(); }
+
+	// Returns log2 of the number of bits in the filter
+	int FilterBits() const				{ return m_filterBits; }
+
+	// Returns the block that matches the data, or NOT_FOUND. The preferred block is checked first, so that runs of
+	// blocks are kept together when the old file has identical blocks.
+	size_t Find( uint32_t weak, uint8_t const * data, size_t preferred ) const;
+
+private:
+
+	static uint32_t Hash( uint32_t weak )	{ return weak * 0x9e3779b1; }
+
+	Crypto::BlockSignature const &	m_signature;
+	size_t							m_count;		// Number of blocks in the table
+	int								m_filterBits;	// log2 of the number of bits in the filter
+	int								m_bucketBits;	// log2 of the number of buckets
+	std::vector< uint32_t >			m_filter;		// One bit for each value of the filter hash
+	std::vector< uint32_t >			m_start;		// Start of each bucket in m_entries
+	std::vector< uint32_t >			m_entries;		// Blocks, grouped by bucket
+};
+
+BlockTable::BlockTable( Crypto::BlockSignature const & signature, size_t count )
+	: m_signature( signature ),
+	m_count( count ),
+	m_filterBits( 10 ),
+	m_bucketBits( 1 )
+{
+	while ( m_filterBits < 32 && ( size_t( 1 ) << m_filterBits ) < count * 64 )
+	{
+		++m_filterBits;
+	}
+
+	while ( m_bucketBits < 31 && ( size_t( 1 ) << m_bucketBits ) < count )
+	{
+		++m_bucketBits;
+	}
+
+	std::vector< Crypto::BlockSignature::Block > const &	blocks	= signature.Blocks();
+
+	m_filter.assign( ( size_t( 1 ) << m_filterBits ) / 32, 0 );
+	m_start.assign( ( size_t( 1 ) << m_bucketBits ) + 1, 0 );
+	m_entries.resize( count );
+
+	// Group the blocks by bucket with a counting sort
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		uint32_t const	h	= Hash( blocks[i].weak );
+		uint32_t const	bit	= h >> ( 32 - m_filterBits );
+
+		m_filter[ bit >> 5 ] |= uint32_t( 1 ) << ( bit & 31 );
+		++m_start[ ( h >> ( 32 - m_bucketBits ) ) + 1 ];
+	}
+
+	for ( size_t b = 1; b < m_start.size(); ++b )
+	{
+		m_start[b] += m_start[ b - 1 ];
+	}
+
+	std::vector< uint32_t >	next( m_start.begin(), m_start.end() - 1 );
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		m_entries[ next[ Hash( blocks[i].weak ) >> ( 32 - m_bucketBits ) ]++ ] = uint32_t( i );
+	}
+}
+
+size_t BlockTable::Find( uint32_t weak, uint8_t const * data, size_t preferred ) const
+{
+	std::vector< Crypto::BlockSignature::Block > const &	blocks	= m_signature.Blocks();
+
+	// The strong digest is only computed if a weak checksum matches, and only once
+
+	uint8_t	strong[ Crypto::BlockSignature::STRONG_SIZE ];
+	bool	computed	= false;
+
+	auto const	matches	= [ & ]( size_t i )
+	{
+		if ( blocks[i].weak != weak )
+			return false;
+
+		if ( !computed )
+		{
+			m_signature.ComputeStrong( data, m_signature.BlockSize(), strong );
+			computed = true;
+		}
+
+		return memcmp( blocks[i].strong, strong, sizeof( strong ) ) == 0;
+	};
+
+	if ( preferred < m_count && matches( preferred ) )
+		return preferred;
+
+	uint32_t const	bucket	= Hash( weak ) >> ( 32 - m_bucketBits );
+
+	for ( uint32_t i = m_start[ bucket ]; i < m_start[ bucket + 1 ]; ++i )
+	{
+		if ( matches( m_entries[i] ) )
+			return m_entries[i];
+	}
+
+	return NOT_FOUND;
+}
+
+// Writes the operations of a delta. Consecutive blocks are combined into a single copy.
+
+class DeltaWriter
+{
+public:
+
+	DeltaWriter( std::vector< uint8_t > & delta ) : m_delta( delta ), m_first( 0 ), m_count( 0 )	{}
+
+	// Adds a block to copy
+	void Copy( size_t block )
+	{
+		if ( m_count > 0 && block == m_first + m_count )
+		{
+			++m_count;
+			return;
+		}
+
+		Flush();
+		m_first	= block;
+		m_count	= 1;
+	}
+
+	// Adds literal data
+	void Literal( uint8_t const * data, size_t size )
+	{
+		if ( size == 0 )
+			return;
+
+		Flush();
+		m_delta.push_back( LITERAL );
+		PutNumber( m_delta, size );
+		m_delta.insert( m_delta.end(), data, data + size );
+	}
+
+	// Ends the delta
+	void End()
+	{
+		Flush();
+		m_delta.push_back( END );
+	}
+
+	// Returns the block after the last one copied
+	size_t Next() const		{ return ( m_count > 0 ) ? m_first + m_count : NOT_FOUND; }
+
+private:
+
+	// Writes the pending copy
+	void Flush()
+	{
+		if ( m_count == 0 )
+			return;
+
+		m_delta.push_back( COPY );
+		PutNumber( m_delta, m_first );
+		PutNumber( m_delta, m_count );
+		m_count = 0;
+	}
+
+	std::vector< uint8_t > &	m_delta;
+	size_t						m_first;	// First block of the pending copy
+	size_t						m_count;	// Number of blocks in the pending copy
+};
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+BlockSignature::BlockSignature()
+	: m_blockSize( DEFAULT_BLOCK_SIZE ),
+	m_fileSize( 0 ),
+	m_strong( SHA256 )
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data		Contents of the file
+//! @param	size		Size of the file
+//! @param	blockSize	Size of a block. Smaller blocks find more matches but make the signature larger.
+//! @param	strong		Kind of strong digest
+
+void BlockSignature::Generate( uint8_t const * data, size_t size, size_t blockSize, StrongDigest strong )
+{
+	m_blockSize	= std::max( blockSize, size_t( 1 ) );
+	m_fileSize	= size;
+	m_strong	= strong;
+	m_blocks.resize( ( size + m_blockSize - 1 ) / m_blockSize );
+
+	for ( size_t i = 0; i < m_blocks.size(); ++i )
+	{
+		uint8_t const * const	block	= data + i * m_blockSize;
+		size_t const			n		= std::min( m_blockSize, size - i * m_blockSize );
+
+		m_blocks[i].weak = ComputeWeak( block, n );
+		ComputeStrong( block, n, m_blocks[i].strong );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	buffer	Buffer that the signature is appended to
+
+void BlockSignature::Serialize( std::vector< uint8_t > & buffer ) const
+{
+	uint8_t	header[ SIGNATURE_HEADER_SIZE ];
+
+	memcpy( header, SIGNATURE_MAGIC, sizeof( SIGNATURE_MAGIC ) );
+	StoreLittleEndian32( header + 4, VERSION );
+	StoreLittleEndian32( header + 8, uint32_t( m_strong ) );
+	StoreLittleEndian32( header + 12, uint32_t( m_blockSize ) );
+	StoreLittleEndian64( header + 16, m_fileSize );
+
+	buffer.insert( buffer.end(), header, header + sizeof( header ) );
+
+	for ( size_t i = 0; i < m_blocks.size(); ++i )
+	{
+		uint8_t	record[ BLOCK_RECORD_SIZE ];
+
+		StoreLittleEndian32( record, m_blocks[i].weak );
+		memcpy( record + 4, m_blocks[i].strong, STRONG_SIZE );
+		buffer.insert( buffer.end(), record, record + sizeof( record ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Serialized signature
+//! @param	size	Size of the serialized signature
+
+bool BlockSignature::Deserialize( uint8_t const * data, size_t size )
+{
+	if ( size < SIGNATURE_HEADER_SIZE
+		 || memcmp( data, SIGNATURE_MAGIC, sizeof( SIGNATURE_MAGIC ) ) != 0
+		 || LoadLittleEndian32( data + 4 ) != VERSION )
+	{
+		return false;
+	}
+
+	uint32_t const	strong		= LoadLittleEndian32( data + 8 );
+	uint32_t const	blockSize	= LoadLittleEndian32( data + 12 );
+	uint64_t const	fileSize	= LoadLittleEndian64( data + 16 );
+
+	if ( strong > SHA256 || blockSize == 0 )
+		return false;
+
+	uint64_t const	count	= fileSize / blockSize + ( ( fileSize % blockSize != 0 ) ? 1 : 0 );
+
+	if ( count != ( size - SIGNATURE_HEADER_SIZE ) / BLOCK_RECORD_SIZE
+		 || ( size - SIGNATURE_HEADER_SIZE ) % BLOCK_RECORD_SIZE != 0 )
+	{
+		return false;
+	}
+
+	m_blockSize	= blockSize;
+	m_fileSize	= fileSize;
+	m_strong	= StrongDigest( strong );
+	m_blocks.resize( size_t( count ) );
+
+	for ( size_t i = 0; i < m_blocks.size(); ++i )
+	{
+		uint8_t const * const	record	= data + SIGNATURE_HEADER_SIZE + i * BLOCK_RECORD_SIZE;
+
+		m_blocks[i].weak = LoadLittleEndian32( record );
+		memcpy( m_blocks[i].strong, record + 4, STRONG_SIZE );
+	}
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Data
+//! @param	size	Size of the data
+
+uint32_t BlockSignature::ComputeWeak( uint8_t const * data, size_t size )
+{
+	static Checksummer const	checksummer	= SelectChecksummer();
+
+	return checksummer( data, size );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Data
+//! @param	size	Size of the data
+//! @param	digest	Strong digest of STRONG_SIZE bytes (output)
+
+void BlockSignature::ComputeStrong( uint8_t const * data, size_t size, uint8_t * digest ) const
+{
+	if ( m_strong == MD5 )
+	{
+		Md5Calculator().Calculate( data, size, digest );
+	}
+	else
+	{
+		uint8_t	sha256[ SHA256_SIZE ];
+
+		Sha256Calculator().Calculate( data, size, sha256 );
+		memcpy( digest, sha256, STRONG_SIZE );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	signature	Signature of the old file
+//! @param	data		Contents of the new file
+//! @param	size		Size of the new file
+//! @param	delta		Delta (output)
+
+void Delta::Compute( BlockSignature const & signature, uint8_t const * data, size_t size,
+					 std::vector< uint8_t > & delta )
+{
+	size_t const									blockSize	= signature.BlockSize();
+	std::vector< BlockSignature::Block > const &	blocks		= signature.Blocks();
+	size_t const									full		= size_t( signature.FileSize() / blockSize );
+	uint8_t											header[ DELTA_HEADER_SIZE ];
+
+	memcpy( header, DELTA_MAGIC, sizeof( DELTA_MAGIC ) );
+	StoreLittleEndian32( header + 4, VERSION );
+	StoreLittleEndian32( header + 8, uint32_t( blockSize ) );
+	StoreLittleEndian32( header + 12, 0 );
+	StoreLittleEndian64( header + 16, signature.FileSize() );
+	StoreLittleEndian64( header + 24, size );
+	Sha256Calculator().Calculate( data, size, header + 32 );
+
+	delta.assign( header, header + sizeof( header ) );
+
+	DeltaWriter	writer( delta );
+	size_t		literal	= 0;	// Start of the data that has not been matched
+
+	// Slide the window over the new file. Only the full-size blocks can match here. The positions are scanned in
+	// batches by a kernel that rolls the checksum and checks the filter, and only the candidates are looked up.
+
+	if ( full > 0 && size >= blockSize )
+	{
+		static Scanner const	scanner		= SelectScanner();
+
+		BlockTable const	table( signature, full );
+		uint32_t			weaks[ SCAN_SIZE ];
+		uint64_t			candidates[ SCAN_SIZE / 64 ];
+		size_t				i			= 0;
+		size_t const		positions	= size - blockSize + 1;
+		uint32_t			weak		= BlockSignature::ComputeWeak( data, blockSize );
+
+		while ( i < positions )
+		{
+			size_t const	count	= std::min( SCAN_SIZE, positions - i );
+			size_t			match	= NOT_FOUND;
+
+			scanner( data + i, blockSize, count, weak, table.Filter(), table.FilterBits(), weaks, candidates );
+
+			// The scanner only writes the words that hold the count positions, and the positions past the end of the
+			// last batch are not valid, so the tail of the last word is masked
+
+			size_t const	words	= ( count + 63 ) / 64;
+
+			for ( size_t w = 0; w < words && match == NOT_FOUND; ++w )
+			{
+				uint64_t	bits	= candidates[w];
+
+				if ( w == words - 1 && count % 64 != 0 )
+					bits &= ( uint64_t( 1 ) << ( count % 64 ) ) - 1;
+
+				for ( ; bits != 0 && match == NOT_FOUND; bits &= bits - 1 )
+				{
+					size_t const	k		= w * 64 + size_t( CountTrailingZeros( bits ) );
+					size_t const	block	= table.Find( weaks[k], data + i + k, writer.Next() );
+
+					if ( block != NOT_FOUND )
+					{
+						writer.Literal( data + literal, i + k - literal );
+						writer.Copy( block );
+						match = k;
+					}
+				}
+			}
+
+			if ( match != NOT_FOUND )
+			{
+				// Continue after the block
+
+				i		+= match + blockSize;
+				literal	= i;
+
+				if ( i < positions )
+					weak = BlockSignature::ComputeWeak( data + i, blockSize );
+			}
+			else
+			{
+				i += count;
+
+				if ( i < positions )
+					weak = Roll( weaks[ count - 1 ], blockSize, data[ i - 1 ], data[ i - 1 + blockSize ] );
+			}
+		}
+	}
+
+	// If the last block of the old file is short, it can only match the end of the new file
+
+	size_t const	tail	= size_t( signature.FileSize() % blockSize );
+
+	if ( tail > 0 && size - literal >= tail )
+	{
+		BlockSignature::Block const &	last	= blocks.back();
+		uint8_t const * const			p		= data + size - tail;
+		uint8_t							strong[ BlockSignature::STRONG_SIZE ];
+
+		if ( BlockSignature::ComputeWeak( p, tail ) == last.weak )
+		{
+			signature.ComputeStrong( p, tail, strong );
+
+			if ( memcmp( strong, last.strong, sizeof( strong ) ) == 0 )
+			{
+				writer.Literal( data + literal, size - tail - literal );
+				writer.Copy( full );
+				literal = size;
+			}
+		}
+	}
+
+	writer.Literal( data + literal, size - literal );
+	writer.End();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	base		Contents of the old file
+//! @param	baseSize	Size of the old file
+//! @param	delta		Delta
+//! @param	deltaSize	Size of the delta
+//! @param	result		Contents of the new file (output)
+
+bool Delta::Apply( uint8_t const * base, size_t baseSize, uint8_t const * delta, size_t deltaSize,
+				   std::vector< uint8_t > & result )
+{
+	result.clear();
+
+	if ( deltaSize < DELTA_HEADER_SIZE
+		 || memcmp( delta, DELTA_MAGIC, sizeof( DELTA_MAGIC ) ) != 0
+		 || LoadLittleEndian32( delta + 4 ) != VERSION )
+	{
+		return false;
+	}
+
+	uint64_t const	blockSize	= LoadLittleEndian32( delta + 8 );
+	uint64_t const	target		= LoadLittleEndian64( delta + 24 );
+
+	if ( blockSize == 0 || LoadLittleEndian64( delta + 16 ) != baseSize )
+		return false;
+
+	uint64_t const			blocks	= ( baseSize + blockSize - 1 ) / blockSize;
+	uint8_t const *			p		= delta + DELTA_HEADER_SIZE;
+	uint8_t const * const	end		= delta + deltaSize;
+
+	// The size of the result comes from the delta, so it is not trusted when reserving memory
+
+	result.reserve( size_t( std::min( target, uint64_t( baseSize ) + deltaSize ) ) );
+
+	for ( ;; )
+	{
+		if ( p == end )
+			return false;
+
+		uint8_t const	op	= *p++;
+
+		if ( op == END )
+			break;
+
+		if ( op == COPY )
+		{
+			uint64_t	first;
+			uint64_t	count;
+
+			if ( !GetNumber( p, end, first ) || !GetNumber( p, end, count )
+				 || first >= blocks || count == 0 || count > blocks - first )
+			{
+				return false;
+			}
+
+			uint64_t const	offset	= first * blockSize;
+			uint64_t const	n		= std::min( count * blockSize, baseSize - offset );
+
+			if ( n > target - result.size() )
+				return false;
+
+			result.insert( result.end(), base + offset, base + offset + n );
+		}
+		else if ( op == LITERAL )
+		{
+			uint64_t	n;
+
+			if ( !GetNumber( p, end, n ) || n > uint64_t( end - p ) || n > target - result.size() )
+				return false;
+
+			result.insert( result.end(), p, p + n );
+			p += n;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	uint8_t	digest[ SHA256_SIZE ];
+
+	Sha256Calculator().Calculate( result.data(), result.size(), digest );
+
+	return p == end && result.size() == target && memcmp( digest, delta + 32, sizeof( digest ) ) == 0;
+}
+
+
+} // namespace Crypto
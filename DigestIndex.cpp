@@ -0,0 +1,405 @@
+/********************************************************************************************************************
+
+                                                   DigestIndex.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/DigestIndex.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "DigestIndex.h"
+
+#include "Common.h"
+#include "DigestSort.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+
+
+char const		MAGIC[ 4 ]					= { 'C', 'D', 'I', 'X' };
+uint32_t const	VERSION						= 1;
+size_t const	MAX_DIGEST_SIZE				= 64;
+size_t const	HEADER_SIZE					= 24 + 8 * 256;
+int const		MAX_INTERPOLATION_STEPS		= 8;	// After this many steps, the search switches to bisection
+size_t const	LINEAR_SEARCH_THRESHOLD		= 8;	// Ranges this small are searched linearly
+
+// Sorts the digests and removes duplicates
+
+std::vector< uint8_t > SortUnique( uint8_t const * digests, size_t size, size_t count )
+{
+	std::vector< uint8_t >	sorted( digests, digests + count * size );
+
+	Crypto::RadixSort( sorted.data(), size, count );
+
+	size_t	n	= 0;
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		if ( n == 0 || memcmp( &sorted[ i * size ], &sorted[ ( n - 1 ) * size ], size ) != 0 )
+		{
+			memmove( &sorted[ n * size ], &sorted[ i * size ], size );
+			++n;
+		}
+	}
+
+	sorted.resize( n * size );
+
+	return sorted;
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+DigestIndex::DigestIndex()
+	: m_file( nullptr ),
+	m_digests( nullptr ),
+	m_count( 0 ),
+	m_digestSize( 0 ),
+	m_fanOut()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+DigestIndex::~DigestIndex()
+{
+	Close();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	path	Name of the file
+//!
+//! Only the header is read. The digests are not checked to be sorted.
+
+bool DigestIndex::Open( char const * path )
+{
+	Close();
+
+	m_file = new MappedFile;
+
+	if ( !m_file->Open( path, MappedFile::RANDOM ) )
+	{
+		Close();
+		return false;
+	}
+
+	// The lookups jump around the file, so the file is mapped for random access to prevent wasteful read-ahead
+
+	size_t const			size		= m_file->Size();
+	uint8_t const * const	header		= m_file->Data();
+	bool					valid		= size >= HEADER_SIZE;
+	size_t					digestSize	= 0;
+	uint64_t				count		= 0;
+
+	if ( valid )
+	{
+		digestSize	= LoadLittleEndian32( header + 8 );
+		count		= LoadLittleEndian64( header + 16 );
+		valid		= memcmp( header, MAGIC, sizeof( MAGIC ) ) == 0
+					  && LoadLittleEndian32( header + 4 ) == VERSION
+					  && digestSize > 0 && digestSize <= MAX_DIGEST_SIZE
+					  && LoadLittleEndian32( header + 12 ) == 0
+					  && count <= ( size - HEADER_SIZE ) / digestSize
+					  && size == HEADER_SIZE + count * digestSize;
+	}
+
+	// The fan-out table must be non-decreasing and end with the number of digests
+
+	for ( int i = 0; valid && i < 256; ++i )
+	{
+		m_fanOut[i] = LoadLittleEndian64( header + 24 + i * 8 );
+		valid = ( i == 0 || m_fanOut[i] >= m_fanOut[ i - 1 ] );
+	}
+
+	if ( !valid || m_fanOut[ 255 ] != count )
+	{
+		Close();
+		return false;
+	}
+
+	m_digests		= header + HEADER_SIZE;
+	m_count			= size_t( count );
+	m_digestSize	= digestSize;
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestIndex::Close()
+{
+	delete m_file;
+
+	m_file			= nullptr;
+	m_digests		= nullptr;
+	m_count			= 0;
+	m_digestSize	= 0;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	digest	Digest of DigestSize() bytes
+
+size_t DigestIndex::Find( uint8_t const * digest ) const
+{
+	if ( m_digests == nullptr )
+		return NOT_FOUND;
+
+	// The fan-out table gives the range of digests with the same first byte, and the range of their prefixes
+
+	int const		b		= digest[0];
+	size_t const	first	= ( b > 0 ) ? size_t( m_fanOut[ b - 1 ] ) : 0;
+	size_t const	last	= size_t( m_fanOut[b] );
+	uint64_t const	low		= uint64_t( b ) << 56;
+	uint64_t const	high	= low | 0x00ffffffffffffffull;
+	size_t const	i		= LowerBound( digest, first, last, low, high );
+
+	if ( i < last && memcmp( Digest( i ), digest, m_digestSize ) == 0 )
+		return i;
+
+	return NOT_FOUND;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	digests		Digests of DigestSize() bytes each
+//! @param	count		Number of digests
+//! @param	positions	Position of each digest, or NOT_FOUND (output)
+
+size_t DigestIndex::Find( uint8_t const * digests, size_t count, size_t * positions ) const
+{
+	if ( m_digests == nullptr )
+	{
+		std::fill( positions, positions + count, NOT_FOUND );
+		return 0;
+	}
+
+	// The queries are sorted by their prefixes, which are compared directly. The whole digests only need to be compared
+	// when the prefixes are equal.
+
+	typedef std::pair< uint64_t, size_t >	Query;
+
+	size_t const			size	= m_digestSize;
+	std::vector< Query >	order( count );
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		order[i] = Query( Prefix( digests + i * size ), i );
+	}
+
+	std::sort( order.begin(), order.end(),
+			   [ digests, size ]( Query const & x, Query const & y )
+			   {
+				   if ( x.first != y.first )
+					   return x.first < y.first;
+				   return memcmp( digests + x.second * size, digests + y.second * size, size ) < 0;
+			   } );
+
+	// Each search starts where the previous one ended, and the previous digest bounds the prefixes of the range
+
+	size_t			start	= 0;
+	uint64_t		floor	= 0;
+	size_t			found	= 0;
+
+	for ( size_t k = 0; k < count; ++k )
+	{
+		uint8_t const * const	digest	= digests + order[k].second * size;
+		int const				b		= digest[0];
+		size_t const			last	= size_t( m_fanOut[b] );
+		size_t const			first	= std::max( start, ( b > 0 ) ? size_t( m_fanOut[ b - 1 ] ) : size_t( 0 ) );
+		uint64_t const			low		= std::max( floor, uint64_t( b ) << 56 );
+		uint64_t const			high	= ( uint64_t( b ) << 56 ) | 0x00ffffffffffffffull;
+		size_t const			i		= LowerBound( digest, first, last, low, high );
+
+		if ( i < last && memcmp( Digest( i ), digest, size ) == 0 )
+		{
+			positions[ order[k].second ] = i;
+			++found;
+		}
+		else
+		{
+			positions[ order[k].second ] = NOT_FOUND;
+		}
+
+		start = i;
+		floor = order[k].first;
+	}
+
+	return found;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	path		Name of the file
+//! @param	digests		Digests of size bytes each, in any order
+//! @param	size		Size of a digest in bytes
+//! @param	count		Number of digests
+
+bool DigestIndex::Write( char const * path, uint8_t const * digests, size_t size, size_t count )
+{
+	if ( size == 0 || size > MAX_DIGEST_SIZE )
+		return false;
+
+	std::vector< uint8_t > const	sorted	= SortUnique( digests, size, count );
+	size_t const					n		= sorted.size() / size;
+
+	uint8_t		header[ HEADER_SIZE ];
+	uint64_t	fanOut[ 256 ]	= { 0 };
+
+	for ( size_t i = 0; i < n; ++i )
+	{
+		++fanOut[ sorted[ i * size ] ];
+	}
+
+	memcpy( header, MAGIC, sizeof( MAGIC ) );
+	StoreLittleEndian32( header + 4, VERSION );
+	StoreLittleEndian32( header + 8, uint32_t( size ) );
+	StoreLittleEndian32( header + 12, 0 );
+	StoreLittleEndian64( header + 16, n );
+
+	uint64_t	total	= 0;
+
+	for ( int i = 0; i < 256; ++i )
+	{
+		total += fanOut[i];
+		StoreLittleEndian64( header + 24 + i * 8, total );
+	}
+
+	FILE * const	file	= fopen( path, "wb" );
+
+	if ( file == nullptr )
+		return false;
+
+	bool	ok	= fwrite( header, 1, sizeof( header ), file ) == sizeof( header );
+
+	if ( ok && !sorted.empty() )
+		ok = fwrite( sorted.data(), 1, sorted.size(), file ) == sorted.size();
+
+	ok = ( fclose( file ) == 0 ) && ok;
+
+	return ok;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Digests are uniformly distributed, so the position of a digest in a range is estimated from its prefix and the
+//! bounds of the prefixes in the range. Each probe narrows both the range and the bounds. The bounds come from the
+//! fan-out table and previous probes, so no memory is touched except for the probes themselves. If the digests turn
+//! out not to be uniform, the search switches to bisection, so the worst case is still logarithmic.
+
+size_t DigestIndex::LowerBound( uint8_t const * digest, size_t first, size_t last, uint64_t low, uint64_t high ) const
+{
+	uint64_t const	x	= Prefix( digest );
+
+	for ( int step = 0; last - first > LINEAR_SEARCH_THRESHOLD; ++step )
+	{
+		size_t	probe;
+
+		if ( step < MAX_INTERPOLATION_STEPS && x > low && x < high )
+		{
+			double const	fraction	= double( x - low ) / ( double( high - low ) + 1.0 );
+
+			probe = first + std::min( size_t( fraction * double( last - first ) ), last - first - 1 );
+		}
+		else if ( step < MAX_INTERPOLATION_STEPS && x <= low )
+		{
+			probe = first;
+		}
+		else if ( step < MAX_INTERPOLATION_STEPS && x >= high )
+		{
+			probe = last - 1;
+		}
+		else
+		{
+			probe = first + ( last - first ) / 2;
+		}
+
+		uint8_t const * const	p	= Digest( probe );
+
+		if ( memcmp( p, digest, m_digestSize ) < 0 )
+		{
+			first	= probe + 1;
+			low		= Prefix( p );
+		}
+		else
+		{
+			last	= probe;
+			high	= Prefix( p );
+		}
+	}
+
+	while ( first < last && memcmp( Digest( first ), digest, m_digestSize ) < 0 )
+	{
+		++first;
+	}
+
+	return first;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+uint64_t DigestIndex::Prefix( uint8_t const * digest ) const
+{
+	if ( m_digestSize >= 8 )
+		return LoadBigEndian64( digest );
+
+	// Shorter digests are padded with 0's on the right
+
+	uint64_t	x	= 0;
+
+	for ( size_t i = 0; i < 8; ++i )
+	{
+		x = ( x << 8 ) | ( ( i < m_digestSize ) ? digest[i] : 0 );
+	}
+
+	return x;
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,404 @@
+/********************************************************************************************************************
+
+                                                    DigestSort.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/DigestSort.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "DigestSort.h"
+
+#include "Common.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <queue>
+
+#if defined( _WIN32 )
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+
+namespace
+{
+
+
+size_t const	SMALL_SORT_SIZE	= 4096;		// Arrays smaller than this are simply sorted with comparisons
+
+// A digest of a known size, so that it can be moved as a single object. Digests are compared as big-endian words,
+// which gives the same order as memcmp but is much faster. The sizes used are all multiples of 4.
+
+template< size_t SIZE >
+struct Record
+{
+	bool operator <( Record const & y ) const
+	{
+		size_t	i	= 0;
+
+		for ( ; i + 8 <= SIZE; i += 8 )
+		{
+			uint64_t const	a	= Crypto::LoadBigEndian64( bytes + i );
+			uint64_t const	b	= Crypto::LoadBigEndian64( y.bytes + i );
+
+			if ( a != b )
+				return a < b;
+		}
+
+		for ( ; i < SIZE; i += 4 )
+		{
+			uint32_t const	a	= Crypto::LoadBigEndian32( bytes + i );
+			uint32_t const	b	= Crypto::LoadBigEndian32( y.bytes + i );
+
+			if ( a != b )
+				return a < b;
+		}
+
+		return false;
+	}
+
+	uint8_t	bytes[ SIZE ];
+};
+
+// Sorts the digests on their first 16 bits with two LSD radix passes, and then sorts each group of digests with the
+// same first 16 bits with comparisons. Digests are uniform, so the groups are small. Only 256 buckets are filled at a
+// time, which keeps the passes from thrashing the TLB, and after two passes the digests are back in the original array.
+
+template< size_t SIZE >
+void RadixSort( uint8_t * digests, size_t count )
+{
+	typedef Record< SIZE >	R;
+
+	R * const	records	= reinterpret_cast< R * >( digests );
+
+	if ( count < SMALL_SORT_SIZE )
+	{
+		std::sort( records, records + count );
+		return;
+	}
+
+	// Count the digests in each bucket for both passes at once, and then find where each bucket starts
+
+	std::vector< size_t >	start0( 256 + 1, 0 );
+	std::vector< size_t >	start1( 256 + 1, 0 );
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		++start0[ records[i].bytes[0] + 1 ];
+		++start1[ records[i].bytes[1] + 1 ];
+	}
+
+	for ( int b = 0; b < 256; ++b )
+	{
+		start0[ b + 1 ] += start0[b];
+		start1[ b + 1 ] += start1[b];
+	}
+
+	// The buffer is not initialized since every element is written
+
+	std::unique_ptr< R[] > const	buffer( new R[ count ] );
+	std::vector< size_t >			next( start1.begin(), start1.end() - 1 );
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		buffer[ next[ records[i].bytes[1] ]++ ] = records[i];
+	}
+
+	next.assign( start0.begin(), start0.end() - 1 );
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		records[ next[ buffer[i].bytes[0] ]++ ] = buffer[i];
+	}
+
+	// Sort each group of digests with the same first 16 bits
+
+	auto const	group	= []( R const & r ) { return r.bytes[0] << 8 | r.bytes[1]; };
+	size_t		first	= 0;
+
+	for ( size_t i = 1; i <= count; ++i )
+	{
+		if ( i == count || group( records[i] ) != group( records[ first ] ) )
+		{
+			std::sort( records + first, records + i );
+			first = i;
+		}
+	}
+}
+
+// Returns a name for a temporary file that is unique to this process and object
+
+std::string RunName( std::string const & directory, void const * owner, size_t run )
+{
+#if defined( _WIN32 )
+	int const	pid	= _getpid();
+#else
+	int const	pid	= int( getpid() );
+#endif
+
+	char	name[ 64 ];
+
+	snprintf( name, sizeof( name ), "digestsort-%d-%p-%zu.tmp", pid, owner, run );
+
+	return directory.empty() ? std::string( name ) : directory + "/" + name;
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void RadixSort( uint8_t * digests, size_t size, size_t count )
+{
+	switch ( size )
+	{
+	case 4:		::RadixSort< 4 >( digests, count );		return;
+	case 16:	::RadixSort< 16 >( digests, count );	return;
+	case 20:	::RadixSort< 20 >( digests, count );	return;
+	case 32:	::RadixSort< 32 >( digests, count );	return;
+	default:	break;
+	}
+
+	// Other sizes are sorted indirectly and then moved into place
+
+	std::vector< uint8_t const * >	order( count );
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		order[i] = digests + i * size;
+	}
+
+	std::sort( order.begin(), order.end(),
+			   [ size ]( uint8_t const * x, uint8_t const * y ) { return memcmp( x, y, size ) < 0; } );
+
+	std::vector< uint8_t >	sorted( count * size );
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		memcpy( &sorted[ i * size ], order[i], size );
+	}
+
+	if ( count > 0 )
+		memcpy( digests, sorted.data(), sorted.size() );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	size		Size of a digest in bytes
+//! @param	directory	Directory for the temporary files
+//! @param	memory		Amount of memory to use, in bytes. Sorting a run takes twice the size of the run, so each run
+//!						holds up to memory / 2 bytes of digests.
+
+ExternalDigestSort::ExternalDigestSort( size_t size, char const * directory, size_t memory )
+	: m_size( size ),
+	m_directory( directory ),
+	m_capacity( std::max( memory / 2 / size, size_t( 1 ) ) )
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+ExternalDigestSort::~ExternalDigestSort()
+{
+	RemoveRuns();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	digests		Digests of DigestSize() bytes each
+//! @param	count		Number of digests
+
+bool ExternalDigestSort::Add( uint8_t const * digests, size_t count )
+{
+	// The buffer is allocated at its full size once. Letting it grow could allocate up to twice the limit.
+
+	if ( count > 0 && m_buffer.capacity() < m_capacity * m_size )
+		m_buffer.reserve( m_capacity * m_size );
+
+	while ( count > 0 )
+	{
+		// A full buffer is only written when there is more to add, so if everything fits, no run is written
+
+		if ( m_buffer.size() / m_size == m_capacity && !Spill() )
+			return false;
+
+		size_t const	room	= m_capacity - m_buffer.size() / m_size;
+		size_t const	n		= std::min( count, room );
+
+		m_buffer.insert( m_buffer.end(), digests, digests + n * m_size );
+		digests	+= n * m_size;
+		count	-= n;
+	}
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	visitor		Called with each distinct digest in sorted order, and the number of times it was added
+
+bool ExternalDigestSort::Merge( Visitor const & visitor )
+{
+	// If everything fit in the buffer, there is no need for temporary files
+
+	if ( m_runs.empty() )
+	{
+		size_t const	count	= m_buffer.size() / m_size;
+
+		RadixSort( m_buffer.data(), m_size, count );
+
+		for ( size_t i = 0; i < count; )
+		{
+			uint8_t const * const	digest	= &m_buffer[ i * m_size ];
+			size_t					j		= i + 1;
+
+			while ( j < count && memcmp( &m_buffer[ j * m_size ], digest, m_size ) == 0 )
+			{
+				++j;
+			}
+
+			visitor( digest, j - i );
+			i = j;
+		}
+
+		m_buffer.clear();
+		return true;
+	}
+
+	if ( !m_buffer.empty() && !Spill() )
+		return false;
+
+	// Map the runs and merge them through a heap holding the next digest of each run
+
+	struct Cursor
+	{
+		uint8_t const *	next;
+		uint8_t const *	end;
+	};
+
+	size_t const	size	= m_size;
+	auto const		greater	= [ size ]( Cursor const & x, Cursor const & y ) { return memcmp( x.next, y.next, size ) > 0; };
+
+	std::vector< std::unique_ptr< MappedFile > >								files;
+	std::priority_queue< Cursor, std::vector< Cursor >, decltype( greater ) >	heap( greater );
+
+	for ( size_t i = 0; i < m_runs.size(); ++i )
+	{
+		files.emplace_back( new MappedFile );
+
+		if ( !files.back()->Open( m_runs[i].c_str(), MappedFile::SEQUENTIAL ) || files.back()->Size() % m_size != 0 )
+		{
+			RemoveRuns();
+			return false;
+		}
+
+		heap.push( Cursor{ files.back()->Data(), files.back()->Data() + files.back()->Size() } );
+	}
+
+	uint8_t const *	current	= nullptr;
+	uint64_t		count	= 0;
+
+	while ( !heap.empty() )
+	{
+		Cursor	cursor	= heap.top();
+
+		heap.pop();
+
+		if ( current != nullptr && memcmp( cursor.next, current, m_size ) == 0 )
+		{
+			++count;
+		}
+		else
+		{
+			if ( current != nullptr )
+				visitor( current, count );
+			current	= cursor.next;
+			count	= 1;
+		}
+
+		cursor.next += m_size;
+		if ( cursor.next < cursor.end )
+			heap.push( cursor );
+	}
+
+	if ( current != nullptr )
+		visitor( current, count );
+
+	files.clear();
+	RemoveRuns();
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool ExternalDigestSort::Spill()
+{
+	std::string const	name	= RunName( m_directory, this, m_runs.size() );
+	FILE * const		file	= fopen( name.c_str(), "wb" );
+
+	if ( file == nullptr )
+		return false;
+
+	// The name is recorded first, so that the file is deleted even if writing it fails
+
+	m_runs.push_back( name );
+
+	RadixSort( m_buffer.data(), m_size, m_buffer.size() / m_size );
+
+	bool	ok	= fwrite( m_buffer.data(), 1, m_buffer.size(), file ) == m_buffer.size();
+
+	ok = ( fclose( file ) == 0 ) && ok;
+	m_buffer.clear();
+
+	return ok;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ExternalDigestSort::RemoveRuns()
+{
+	for ( size_t i = 0; i < m_runs.size(); ++i )
+	{
+		remove( m_runs[i].c_str() );
+	}
+
+	m_runs.clear();
+}
+
+
+} // namespace Crypto
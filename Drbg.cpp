@@ -0,0 +1,515 @@
+/********************************************************************************************************************
+
+                                                       Drbg.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Drbg.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Drbg.h"
+
+#include "Common.h"
+#include "MultiBufferHash.h"
+#include "Sha256Calculator.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+
+
+using namespace Crypto::MultiBufferHash;
+
+size_t const	SEED_SIZE	= Crypto::HashDrbg::SEED_SIZE;
+size_t const	DIGEST_SIZE	= Crypto::Sha256Calculator::DIGEST_SIZE;
+
+// Adds a big-endian number to V, modulo 2^440
+
+void Add( uint8_t * v, uint8_t const * x, size_t size )
+{
+	unsigned	carry	= 0;
+
+	for ( size_t i = 0; i < SEED_SIZE; ++i )
+	{
+		unsigned const	sum	= v[ SEED_SIZE - 1 - i ] + ( ( i < size ) ? x[ size - 1 - i ] : 0 ) + carry;
+
+		v[ SEED_SIZE - 1 - i ] = uint8_t( sum );
+		carry = sum >> 8;
+	}
+}
+
+// Adds a number to V, modulo 2^440
+
+void Add( uint8_t * v, uint64_t x )
+{
+	uint8_t	bytes[ 8 ];
+
+	Crypto::StoreBigEndian64( bytes, x );
+	Add( v, bytes, sizeof( bytes ) );
+}
+
+// Adds 1 to V, modulo 2^440
+
+void Increment( uint8_t * v )
+{
+	for ( size_t i = SEED_SIZE; i > 0 && ++v[ i - 1 ] == 0; --i )
+	{
+	}
+}
+
+// Computes the SHA-256 digest of a prefix byte followed by up to three pieces of data
+
+void Hash( uint8_t prefix, uint8_t const * a, size_t aSize, uint8_t const * b, size_t bSize, uint8_t const * c,
+		   size_t cSize, uint8_t * digest )
+{
+	Crypto::Sha256Calculator	calculator;
+
+	calculator.Process( &prefix, 1 );
+	calculator.Process( a, aSize );
+	if ( bSize > 0 )
+		calculator.Process( b, bSize );
+	if ( cSize > 0 )
+		calculator.Process( c, cSize );
+	calculator.Finalize( digest );
+}
+
+// Derives SEED_SIZE bytes from up to four pieces of data (Hash_df)
+
+void Derive( uint8_t const * a, size_t aSize, uint8_t const * b, size_t bSize, uint8_t const * c, size_t cSize,
+			 uint8_t const * d, size_t dSize, uint8_t * seed )
+{
+	uint8_t	temp[ 2 * DIGEST_SIZE ];
+
+	for ( int i = 0; i < 2; ++i )
+	{
+		uint8_t						header[ 5 ];
+		Crypto::Sha256Calculator	calculator;
+
+		header[0] = uint8_t( i + 1 );
+		Crypto::StoreBigEndian32( header + 1, uint32_t( SEED_SIZE * 8 ) );
+
+		calculator.Process( header, sizeof( header ) );
+		if ( aSize > 0 )
+			calculator.Process( a, aSize );
+		if ( bSize > 0 )
+			calculator.Process( b, bSize );
+		if ( cSize > 0 )
+			calculator.Process( c, cSize );
+		if ( dSize > 0 )
+			calculator.Process( d, dSize );
+		calculator.Finalize( temp + i * DIGEST_SIZE );
+	}
+
+	memcpy( seed, temp, SEED_SIZE );
+}
+
+// Computes the digests of V + first, V + first + 1, ... V + first + count - 1. Each message is SEED_SIZE bytes, so it
+// is a single block once it is padded, and the blocks are compressed in the lanes of the x8 kernel if they are used
+// (see MultiBufferHash.h).
+
+void Blocks( uint8_t const * v, uint64_t first, size_t count, uint8_t * output )
+{
+	Function const	f					= Select( Crypto::KernelRegistry::SHA256 );
+	uint8_t			block[ BLOCK_SIZE ]	= { 0 };
+	size_t			i					= 0;
+
+	memcpy( block, v, SEED_SIZE );
+	Add( block, first );
+	block[ SEED_SIZE ] = 0x80;
+	Crypto::StoreBigEndian64( block + BLOCK_SIZE - 8, SEED_SIZE * 8 );
+
+	if ( f.lanes != nullptr && count >= size_t( f.minimum ) )
+	{
+		uint32_t	words[ 16 * LANES ];
+		uint32_t	state[ 8 * LANES ];
+
+		for ( ; i < count; i += LANES )
+		{
+			for ( int j = 0; j < LANES; ++j )
+			{
+				for ( int w = 0; w < 16; ++w )
+				{
+					words[ w * LANES + j ] = Crypto::LoadBigEndian32( block + w * 4 );
+				}
+				Increment( block );
+			}
+
+			for ( int w = 0; w < 8; ++w )
+			{
+				std::fill( state + w * LANES, state + ( w + 1 ) * LANES, f.initial[w] );
+			}
+
+			f.lanes( state, words );
+
+			size_t const	n	= std::min( count - i, size_t( LANES ) );
+
+			for ( size_t j = 0; j < n; ++j )
+			{
+				StoreState( state + j, f.words, LANES, output + ( i + j ) * DIGEST_SIZE );
+			}
+		}
+		return;
+	}
+
+	for ( ; i < count; ++i )
+	{
+		uint32_t	state[ 8 ];
+
+		std::copy( f.initial, f.initial + 8, state );
+		f.kernel( state, block, BLOCK_SIZE );
+		Increment( block );
+		StoreState( state, f.words, 1, output + i * DIGEST_SIZE );
+	}
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	entropy					Entropy input
+//! @param	entropySize				Size of the entropy input
+//! @param	nonce					Nonce
+//! @param	nonceSize				Size of the nonce
+//! @param	personalization			Personalization string (optional)
+//! @param	personalizationSize		Size of the personalization string
+
+HashDrbg::HashDrbg( uint8_t const * entropy, size_t entropySize, uint8_t const * nonce, size_t nonceSize,
+					uint8_t const * personalization, size_t personalizationSize )
+{
+	Instantiate( entropy, entropySize, nonce, nonceSize, personalization, personalizationSize );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	entropy					Entropy input
+//! @param	entropySize				Size of the entropy input
+//! @param	nonce					Nonce
+//! @param	nonceSize				Size of the nonce
+//! @param	personalization			Personalization string (optional)
+//! @param	personalizationSize		Size of the personalization string
+
+void HashDrbg::Instantiate( uint8_t const * entropy, size_t entropySize, uint8_t const * nonce, size_t nonceSize,
+							uint8_t const * personalization, size_t personalizationSize )
+{
+	uint8_t const	zero	= 0;
+
+	Derive( entropy, entropySize, nonce, nonceSize, personalization, personalizationSize, nullptr, 0, m_v );
+	Derive( &zero, 1, m_v, SEED_SIZE, nullptr, 0, nullptr, 0, m_c );
+	m_reseedCounter = 1;
+	m_position = 0;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	entropy			Entropy input
+//! @param	entropySize		Size of the entropy input
+//! @param	additional		Additional input (optional)
+//! @param	additionalSize	Size of the additional input
+//!
+//! A request in progress in the stream is finished first.
+
+void HashDrbg::Reseed( uint8_t const * entropy, size_t entropySize, uint8_t const * additional,
+					   size_t additionalSize )
+{
+	uint8_t const	one		= 1;
+	uint8_t const	zero	= 0;
+
+	if ( m_position > 0 )
+		Advance();
+
+	Derive( &one, 1, m_v, SEED_SIZE, entropy, entropySize, additional, additionalSize, m_v );
+	Derive( &zero, 1, m_v, SEED_SIZE, nullptr, 0, nullptr, 0, m_c );
+	m_reseedCounter = 1;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	output			Where to put the output
+//! @param	size			Size of the output. It is at most MAX_REQUEST_SIZE.
+//! @param	additional		Additional input (optional)
+//! @param	additionalSize	Size of the additional input
+//!
+//! A request in progress in the stream is finished first.
+
+bool HashDrbg::Generate( uint8_t * output, size_t size, uint8_t const * additional, size_t additionalSize )
+{
+	if ( size > MAX_REQUEST_SIZE )
+		return false;
+
+	if ( m_position > 0 )
+		Advance();
+
+	if ( m_reseedCounter > RESEED_INTERVAL )
+		return false;
+
+	if ( additionalSize > 0 )
+	{
+		uint8_t	w[ DIGEST_SIZE ];
+
+		Hash( 0x02, m_v, SEED_SIZE, additional, additionalSize, nullptr, 0, w );
+		Add( m_v, w, DIGEST_SIZE );
+	}
+
+	Output( 0, output, size );
+	Advance();
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	output	Where to put the output
+//! @param	size	Size of the output
+
+bool HashDrbg::Fill( uint8_t * output, size_t size )
+{
+	while ( size > 0 )
+	{
+		if ( m_position == MAX_REQUEST_SIZE )
+			Advance();
+
+		if ( m_reseedCounter > RESEED_INTERVAL )
+			return false;
+
+		size_t const	n	= std::min( size, MAX_REQUEST_SIZE - m_position );
+
+		Output( m_position, output, n );
+		m_position += n;
+		output += n;
+		size -= n;
+	}
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	size	Amount of the stream to skip
+
+bool HashDrbg::Skip( uint64_t size )
+{
+	uint64_t	end	= m_position + size;
+
+	while ( end > MAX_REQUEST_SIZE )
+	{
+		if ( m_reseedCounter > RESEED_INTERVAL )
+			return false;
+
+		Advance();
+		end -= MAX_REQUEST_SIZE;
+	}
+
+	if ( end > 0 && m_reseedCounter > RESEED_INTERVAL )
+		return false;
+
+	m_position = size_t( end );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HashDrbg::Advance()
+{
+	uint8_t	h[ DIGEST_SIZE ];
+
+	Hash( 0x03, m_v, SEED_SIZE, nullptr, 0, nullptr, 0, h );
+	Add( m_v, h, DIGEST_SIZE );
+	Add( m_v, m_c, SEED_SIZE );
+	Add( m_v, m_reseedCounter );
+	++m_reseedCounter;
+	m_position = 0;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HashDrbg::Output( size_t offset, uint8_t * output, size_t size ) const
+{
+	size_t const	first	= offset / DIGEST_SIZE;
+	size_t const	last	= ( offset + size - 1 ) / DIGEST_SIZE;
+	size_t const	skip	= offset % DIGEST_SIZE;
+	uint8_t			partial[ DIGEST_SIZE ];
+
+	// A partial first block
+
+	if ( skip > 0 )
+	{
+		size_t const	n	= std::min( size, DIGEST_SIZE - skip );
+
+		Blocks( m_v, first, 1, partial );
+		memcpy( output, partial + skip, n );
+		if ( n == size )
+			return;
+		output += n;
+		size -= n;
+	}
+
+	// The whole blocks go straight into the output, and a partial last block goes through a buffer
+
+	size_t const	start	= first + ( ( skip > 0 ) ? 1 : 0 );
+	size_t const	whole	= size / DIGEST_SIZE;
+
+	Blocks( m_v, start, whole, output );
+
+	if ( size % DIGEST_SIZE > 0 )
+	{
+		Blocks( m_v, last, 1, partial );
+		memcpy( output + whole * DIGEST_SIZE, partial, size % DIGEST_SIZE );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	entropy					Entropy input
+//! @param	entropySize				Size of the entropy input
+//! @param	nonce					Nonce
+//! @param	nonceSize				Size of the nonce
+//! @param	personalization			Personalization string (optional)
+//! @param	personalizationSize		Size of the personalization string
+
+HmacDrbg::HmacDrbg( uint8_t const * entropy, size_t entropySize, uint8_t const * nonce, size_t nonceSize,
+					uint8_t const * personalization, size_t personalizationSize )
+{
+	Instantiate( entropy, entropySize, nonce, nonceSize, personalization, personalizationSize );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	entropy					Entropy input
+//! @param	entropySize				Size of the entropy input
+//! @param	nonce					Nonce
+//! @param	nonceSize				Size of the nonce
+//! @param	personalization			Personalization string (optional)
+//! @param	personalizationSize		Size of the personalization string
+
+void HmacDrbg::Instantiate( uint8_t const * entropy, size_t entropySize, uint8_t const * nonce, size_t nonceSize,
+							uint8_t const * personalization, size_t personalizationSize )
+{
+	uint8_t const	key[ SEED_SIZE ]	= { 0 };
+
+	m_hmac.SetKey( key, SEED_SIZE );
+	memset( m_v, 0x01, SEED_SIZE );
+	Update( entropy, entropySize, nonce, nonceSize, personalization, personalizationSize );
+	m_reseedCounter = 1;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	entropy			Entropy input
+//! @param	entropySize		Size of the entropy input
+//! @param	additional		Additional input (optional)
+//! @param	additionalSize	Size of the additional input
+
+void HmacDrbg::Reseed( uint8_t const * entropy, size_t entropySize, uint8_t const * additional,
+					   size_t additionalSize )
+{
+	Update( entropy, entropySize, additional, additionalSize );
+	m_reseedCounter = 1;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	output			Where to put the output
+//! @param	size			Size of the output. It is at most MAX_REQUEST_SIZE.
+//! @param	additional		Additional input (optional)
+//! @param	additionalSize	Size of the additional input
+
+bool HmacDrbg::Generate( uint8_t * output, size_t size, uint8_t const * additional, size_t additionalSize )
+{
+	if ( size > MAX_REQUEST_SIZE || m_reseedCounter > RESEED_INTERVAL )
+		return false;
+
+	if ( additionalSize > 0 )
+		Update( additional, additionalSize );
+
+	for ( size_t offset = 0; offset < size; offset += SEED_SIZE )
+	{
+		m_hmac.Calculate( m_v, SEED_SIZE, m_v );
+		memcpy( output + offset, m_v, std::min( SEED_SIZE, size - offset ) );
+	}
+
+	Update( additional, additionalSize );
+	++m_reseedCounter;
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HmacDrbg::Update( uint8_t const * a, size_t aSize, uint8_t const * b, size_t bSize, uint8_t const * c,
+					   size_t cSize )
+{
+	bool const	provided	= aSize + bSize + cSize > 0;
+	uint8_t		key[ SEED_SIZE ];
+
+	for ( uint8_t round = 0; round < ( provided ? 2 : 1 ); ++round )
+	{
+		m_hmac.Reset();
+		m_hmac.Process( m_v, SEED_SIZE );
+		m_hmac.Process( &round, 1 );
+		if ( aSize > 0 )
+			m_hmac.Process( a, aSize );
+		if ( bSize > 0 )
+			m_hmac.Process( b, bSize );
+		if ( cSize > 0 )
+			m_hmac.Process( c, cSize );
+		m_hmac.Finalize( key );
+
+		m_hmac.SetKey( key, SEED_SIZE );
+		m_hmac.Calculate( m_v, SEED_SIZE, m_v );
+	}
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,179 @@
+/********************************************************************************************************************
+
+                                                    GitObject.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/GitObject.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "GitObject.h"
+
+#include "MultiBufferHash.h"
+
+#include <cstdio>
+#include <vector>
+
+
+namespace
+{
+
+
+char const * const	TYPE_NAMES[]	= { "blob", "tree", "commit", "tag" };
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	format	Object format
+//! @param	type	Type of the object
+//! @param	size	Size of the contents
+
+GitObject::GitObject( Format format, Type type, uint64_t size )
+	: m_format( format ),
+	m_size( size ),
+	m_processed( 0 )
+{
+	char			header[ MAX_HEADER_SIZE ];
+	size_t const	headerSize	= Header( type, size, header );
+
+	if ( m_format == SHA1 )
+		m_sha1.Process( reinterpret_cast< uint8_t const * >( header ), headerSize );
+	else
+		m_sha256.Process( reinterpret_cast< uint8_t const * >( header ), headerSize );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Next part of the contents
+//! @param	size	Size of the data
+
+void GitObject::Process( uint8_t const * data, size_t size )
+{
+	m_processed += size;
+
+	if ( m_format == SHA1 )
+		m_sha1.Process( data, size );
+	else
+		m_sha256.Process( data, size );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	digest	Where to put the ID, which is DigestSize() bytes
+//!
+//! The ID is computed even if the size does not match.
+
+bool GitObject::Finalize( uint8_t * digest )
+{
+	if ( m_format == SHA1 )
+		m_sha1.Finalize( digest );
+	else
+		m_sha256.Finalize( digest );
+
+	return m_processed == m_size;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	format	Object format
+
+size_t GitObject::DigestSize( Format format )
+{
+	return ( format == SHA1 ) ? Sha1Calculator::DIGEST_SIZE : Sha256Calculator::DIGEST_SIZE;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	type	Type of the object
+//! @param	size	Size of the contents
+//! @param	header	Where to put the header, which is at most MAX_HEADER_SIZE bytes
+//!
+//! The size includes the terminating 0.
+
+size_t GitObject::Header( Type type, uint64_t size, char * header )
+{
+	int const	length	= snprintf( header, MAX_HEADER_SIZE, "%s %llu", TYPE_NAMES[ type ], (unsigned long long)size );
+
+	return size_t( length ) + 1;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	format	Object format
+//! @param	type	Type of the object
+//! @param	data	Contents
+//! @param	size	Size of the contents
+//! @param	digest	Where to put the ID, which is DigestSize() bytes
+
+void GitObject::Hash( Format format, Type type, uint8_t const * data, size_t size, uint8_t * digest )
+{
+	GitObject	object( format, type, size );
+
+	object.Process( data, size );
+	object.Finalize( digest );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	format	Object format
+//! @param	objects	Objects to hash
+//! @param	count	Number of objects
+
+void GitObject::HashBatch( Format format, Object const * objects, size_t count )
+{
+	using namespace MultiBufferHash;
+
+	Function const	f	= Select( ( format == SHA1 ) ? KernelRegistry::SHA1 : KernelRegistry::SHA256 );
+
+	// Each object is a message of two segments, its header and its contents, so the contents are not copied
+
+	std::vector< char >		headers( count * MAX_HEADER_SIZE );
+	std::vector< Segment >	segments( count * 2 );
+	std::vector< Message >	messages( count );
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		char * const	header		= &headers[ i * MAX_HEADER_SIZE ];
+		size_t const	headerSize	= Header( objects[i].type, objects[i].size, header );
+
+		segments[ i * 2 ]		= Segment( reinterpret_cast< uint8_t const * >( header ), headerSize );
+		segments[ i * 2 + 1 ]	= Segment( objects[i].data, objects[i].size );
+		Start( &segments[ i * 2 ], headerSize + objects[i].size, objects[i].digest, messages[i] );
+	}
+
+	MultiBufferHash::Hash( f, messages.data(), count );
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,262 @@
+/********************************************************************************************************************
+
+                                                    HexKernels.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/HexKernels.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Kernels.h"
+
+#if CRYPTO_X86
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+
+char const	DIGITS[]	= "0123456789abcdef";
+
+// Value of each character as a hex digit, or -1 if it is not a hex digit
+
+struct DigitValues
+{
+	constexpr DigitValues()
+		: m_values()
+	{
+		for ( int i = 0; i < 256; ++i )
+		{
+			m_values[i] = -1;
+		}
+
+		for ( int i = 0; i < 10; ++i )
+		{
+			m_values[ '0' + i ] = int8_t( i );
+		}
+
+		for ( int i = 0; i < 6; ++i )
+		{
+			m_values[ 'a' + i ] = int8_t( 10 + i );
+			m_values[ 'A' + i ] = int8_t( 10 + i );
+		}
+	}
+
+	int8_t	m_values[ 256 ];
+};
+
+constexpr DigitValues	DIGIT_VALUES;
+
+
+#if CRYPTO_X86
+
+// Converts 16 hex digits to their values. valid is set to all 1's for each character that is a hex digit.
+
+CRYPTO_TARGET( "ssse3" )
+inline __m128i DigitsToValues( __m128i text, __m128i & valid )
+{
+	__m128i const	digit		= _mm_sub_epi8( text, _mm_set1_epi8( '0' ) );
+	__m128i const	letter		= _mm_sub_epi8( _mm_or_si128( text, _mm_set1_epi8( 0x20 ) ), _mm_set1_epi8( 'a' ) );
+	__m128i const	isDigit		= _mm_cmpeq_epi8( _mm_min_epu8( digit, _mm_set1_epi8( 9 ) ), digit );
+	__m128i const	isLetter	= _mm_cmpeq_epi8( _mm_min_epu8( letter, _mm_set1_epi8( 5 ) ), letter );
+
+	valid = _mm_or_si128( isDigit, isLetter );
+
+	return _mm_or_si128( _mm_and_si128( isDigit, digit ),
+						 _mm_and_si128( isLetter, _mm_add_epi8( letter, _mm_set1_epi8( 10 ) ) ) );
+}
+
+
+// Converts 32 hex digits to their values. valid is set to all 1's for each character that is a hex digit.
+
+CRYPTO_TARGET( "avx2" )
+inline __m256i DigitsToValues( __m256i text, __m256i & valid )
+{
+	__m256i const	digit		= _mm256_sub_epi8( text, _mm256_set1_epi8( '0' ) );
+	__m256i const	letter		= _mm256_sub_epi8( _mm256_or_si256( text, _mm256_set1_epi8( 0x20 ) ), _mm256_set1_epi8( 'a' ) );
+	__m256i const	isDigit		= _mm256_cmpeq_epi8( _mm256_min_epu8( digit, _mm256_set1_epi8( 9 ) ), digit );
+	__m256i const	isLetter	= _mm256_cmpeq_epi8( _mm256_min_epu8( letter, _mm256_set1_epi8( 5 ) ), letter );
+
+	valid = _mm256_or_si256( isDigit, isLetter );
+
+	return _mm256_or_si256( _mm256_and_si256( isDigit, digit ),
+							_mm256_and_si256( isLetter, _mm256_add_epi8( letter, _mm256_set1_epi8( 10 ) ) ) );
+}
+
+#endif // CRYPTO_X86
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+namespace Kernels
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HexEncodeGeneric( uint8_t const * buffer, size_t size, char * text )
+{
+	for ( size_t i = 0; i < size; ++i )
+	{
+		text[ i * 2 + 0 ] = DIGITS[ buffer[i] >> 4 ];
+		text[ i * 2 + 1 ] = DIGITS[ buffer[i] & 0xf ];
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool HexDecodeGeneric( char const * text, size_t size, uint8_t * buffer )
+{
+	int	invalid	= 0;
+
+	for ( size_t i = 0; i < size; ++i )
+	{
+		int const	high	= DIGIT_VALUES.m_values[ uint8_t( text[ i * 2 + 0 ] ) ];
+		int const	low		= DIGIT_VALUES.m_values[ uint8_t( text[ i * 2 + 1 ] ) ];
+
+		invalid |= high | low;
+		buffer[i] = uint8_t( high * 16 + low );
+	}
+
+	return invalid >= 0;
+}
+
+
+#if CRYPTO_X86
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Converts 16 bytes at a time. Each nibble is converted with a single pshufb lookup.
+
+CRYPTO_TARGET( "ssse3" )
+void HexEncodeSsse3( uint8_t const * buffer, size_t size, char * text )
+{
+	__m128i const	digits	= _mm_loadu_si128( reinterpret_cast< __m128i const * >( DIGITS ) );
+	__m128i const	mask	= _mm_set1_epi8( 0x0f );
+
+	for ( ; size >= 16; size -= 16, buffer += 16, text += 32 )
+	{
+		__m128i const	x		= _mm_loadu_si128( reinterpret_cast< __m128i const * >( buffer ) );
+		__m128i const	high	= _mm_shuffle_epi8( digits, _mm_and_si128( _mm_srli_epi16( x, 4 ), mask ) );
+		__m128i const	low		= _mm_shuffle_epi8( digits, _mm_and_si128( x, mask ) );
+
+		_mm_storeu_si128( reinterpret_cast< __m128i * >( text +  0 ), _mm_unpacklo_epi8( high, low ) );
+		_mm_storeu_si128( reinterpret_cast< __m128i * >( text + 16 ), _mm_unpackhi_epi8( high, low ) );
+	}
+
+	HexEncodeGeneric( buffer, size, text );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Converts 32 bytes at a time. The unpacks work within 128-bit lanes, so the lanes are put back in order afterwards.
+
+CRYPTO_TARGET( "avx2" )
+void HexEncodeAvx2( uint8_t const * buffer, size_t size, char * text )
+{
+	__m256i const	digits	= _mm256_broadcastsi128_si256( _mm_loadu_si128( reinterpret_cast< __m128i const * >( DIGITS ) ) );
+	__m256i const	mask	= _mm256_set1_epi8( 0x0f );
+
+	for ( ; size >= 32; size -= 32, buffer += 32, text += 64 )
+	{
+		__m256i const	x		= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( buffer ) );
+		__m256i const	high	= _mm256_shuffle_epi8( digits, _mm256_and_si256( _mm256_srli_epi16( x, 4 ), mask ) );
+		__m256i const	low		= _mm256_shuffle_epi8( digits, _mm256_and_si256( x, mask ) );
+		__m256i const	lo		= _mm256_unpacklo_epi8( high, low );
+		__m256i const	hi		= _mm256_unpackhi_epi8( high, low );
+
+		_mm256_storeu_si256( reinterpret_cast< __m256i * >( text +  0 ), _mm256_permute2x128_si256( lo, hi, 0x20 ) );
+		_mm256_storeu_si256( reinterpret_cast< __m256i * >( text + 32 ), _mm256_permute2x128_si256( lo, hi, 0x31 ) );
+	}
+
+	HexEncodeSsse3( buffer, size, text );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Converts 32 characters at a time. Pairs of digit values are combined with pmaddubsw (high * 16 + low).
+
+CRYPTO_TARGET( "ssse3" )
+bool HexDecodeSsse3( char const * text, size_t size, uint8_t * buffer )
+{
+	__m128i const	weights	= _mm_set1_epi16( 0x0110 );
+	__m128i			valid	= _mm_set1_epi8( -1 );
+
+	for ( ; size >= 16; size -= 16, text += 32, buffer += 16 )
+	{
+		__m128i	valid0;
+		__m128i	valid1;
+
+		__m128i const	x0	= DigitsToValues( _mm_loadu_si128( reinterpret_cast< __m128i const * >( text +  0 ) ), valid0 );
+		__m128i const	x1	= DigitsToValues( _mm_loadu_si128( reinterpret_cast< __m128i const * >( text + 16 ) ), valid1 );
+
+		valid = _mm_and_si128( valid, _mm_and_si128( valid0, valid1 ) );
+
+		__m128i const	bytes	= _mm_packus_epi16( _mm_maddubs_epi16( x0, weights ), _mm_maddubs_epi16( x1, weights ) );
+		_mm_storeu_si128( reinterpret_cast< __m128i * >( buffer ), bytes );
+	}
+
+	bool const	tailValid	= HexDecodeGeneric( text, size, buffer );
+
+	return _mm_movemask_epi8( valid ) == 0xffff && tailValid;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Converts 64 characters at a time. The packs work within 128-bit lanes, so the lanes are put back in order afterwards.
+
+CRYPTO_TARGET( "avx2" )
+bool HexDecodeAvx2( char const * text, size_t size, uint8_t * buffer )
+{
+	__m256i const	weights	= _mm256_set1_epi16( 0x0110 );
+	__m256i			valid	= _mm256_set1_epi8( -1 );
+
+	for ( ; size >= 32; size -= 32, text += 64, buffer += 32 )
+	{
+		__m256i	valid0;
+		__m256i	valid1;
+
+		__m256i const	x0	= DigitsToValues( _mm256_loadu_si256( reinterpret_cast< __m256i const * >( text +  0 ) ), valid0 );
+		__m256i const	x1	= DigitsToValues( _mm256_loadu_si256( reinterpret_cast< __m256i const * >( text + 32 ) ), valid1 );
+
+		valid = _mm256_and_si256( valid, _mm256_and_si256( valid0, valid1 ) );
+
+		__m256i const	bytes	= _mm256_packus_epi16( _mm256_maddubs_epi16( x0, weights ), _mm256_maddubs_epi16( x1, weights ) );
+		_mm256_storeu_si256( reinterpret_cast< __m256i * >( buffer ), _mm256_permute4x64_epi64( bytes, 0xD8 ) );
+	}
+
+	bool const	tailValid	= HexDecodeSsse3( text, size, buffer );
+
+	return _mm256_movemask_epi8( valid ) == -1 && tailValid;
+}
+
+#endif // CRYPTO_X86
+
+
+} // namespace Kernels
+} // namespace Crypto
@@ -0,0 +1,94 @@
+/********************************************************************************************************************
+
+                                                       Hmac.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Hmac.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Hmac.h"
+
+#include "MultiBufferHash.h"
+
+#include <algorithm>
+
+
+namespace Crypto
+{
+namespace Details
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	algorithm	SHA1 or SHA256
+//! @param	key			The key, padded with 0's to a block
+//! @param	data		The messages
+//! @param	sizes		The size of each message
+//! @param	count		The number of messages. It is at most HMAC_BATCH_SIZE.
+//! @param	macs		Where to put the MACs, one after the other
+//!
+//! The inner hash of each message continues from the state after the key XORed with the inner pad, and the outer hash
+//! is a one-block message that continues from the state after the key XORed with the outer pad. Both sets of hashes
+//! are done in the lanes of the x8 kernels.
+
+bool HmacBatch( KernelRegistry::Algorithm algorithm, uint8_t const * key, uint8_t const * const * data,
+				size_t const * sizes, size_t count, uint8_t * macs )
+{
+	using namespace MultiBufferHash;
+
+	Function const	f		= Select( algorithm );
+	size_t const	digest	= f.words * 4;
+
+	if ( f.lanes == nullptr || count > HMAC_BATCH_SIZE )
+		return false;
+
+	uint8_t		block[ BLOCK_SIZE ];
+	uint32_t	inner[ MAX_WORDS ];
+	uint32_t	outer[ MAX_WORDS ];
+
+	for ( int i = 0; i < BLOCK_SIZE; ++i )
+	{
+		block[i] = key[i] ^ 0x36;
+	}
+	std::copy( f.initial, f.initial + f.words, inner );
+	f.kernel( inner, block, BLOCK_SIZE );
+
+	for ( int i = 0; i < BLOCK_SIZE; ++i )
+	{
+		block[i] = key[i] ^ 0x5c;
+	}
+	std::copy( f.initial, f.initial + f.words, outer );
+	f.kernel( outer, block, BLOCK_SIZE );
+
+	Segment		segments[ HMAC_BATCH_SIZE ];
+	Message		messages[ HMAC_BATCH_SIZE ];
+	uint8_t		digests[ HMAC_BATCH_SIZE * MAX_WORDS * 4 ];
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		segments[i] = Segment( data[i], sizes[i] );
+		Start( &segments[i], sizes[i], digests + i * digest, messages[i], inner, BLOCK_SIZE );
+	}
+	Hash( f, messages, count );
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		segments[i] = Segment( digests + i * digest, digest );
+		Start( &segments[i], digest, macs + i * digest, messages[i], outer, BLOCK_SIZE );
+	}
+	Hash( f, messages, count );
+
+	return true;
+}
+
+
+} // namespace Details
+} // namespace Crypto
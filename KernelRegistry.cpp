@@ -0,0 +1,1012 @@
+/** @file *//********************************************************************************************************
+
+                                                  KernelRegistry.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/KernelRegistry.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "KernelRegistry.h"
+
+#include "Common.h"
+#include "Kernels.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+
+
+namespace
+{
+
+using namespace Crypto;
+
+
+// A candidate kernel. Function is the type of the kernel, or a structure of kernels that are selected together.
+
+template< typename Function >
+struct Candidate
+{
+	char const *		name;		// Name used by Force() and the environment variable
+	unsigned			features;	// Processor features required by the kernel
+	Function			function;
+};
+
+// The hex encoder and decoder, which are selected together
+
+struct HexKernels
+{
+	Kernels::HexEncoder	encode;
+	Kernels::HexDecoder	decode;
+};
+
+// The Base64 encoder and decoder, which are selected together
+
+struct Base64Kernels
+{
+	Kernels::Base64Encoder	encode;
+	Kernels::Base64Decoder	decode;
+};
+
+
+// A known-answer test vector
+
+struct Vector
+{
+	char const *	message;
+	char const *	expected;	// Expected digest (or CRC) in hex
+};
+
+
+// Parameters of the Merkle-Damgard digests that are needed to run a kernel by itself
+
+struct DigestParameters
+{
+	int					size;			// Size of the digest in words
+	uint32_t			initial[ 8 ];	// Initial value of the intermediate digest
+	bool				bigEndian;		// True if the words and the length are big-endian
+	Vector const *		vectors;
+	int					nVectors;
+};
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+Candidate< Kernels::Function > const	CRC32_KERNELS[] =
+{
+	{ "table",	0,					Kernels::Crc32Table },
+	{ "slice8",	0,					Kernels::Crc32Slice8 },
+#if CRYPTO_X86
+	{ "pclmul",	Cpu::PCLMUL | Cpu::SSE41,	Kernels::Crc32Pclmul },
+#endif
+};
+
+Candidate< Kernels::Function > const	MD5_KERNELS[] =
+{
+	{ "generic",	0,				Kernels::Md5Generic },
+};
+
+Candidate< Kernels::Function > const	SHA1_KERNELS[] =
+{
+	{ "generic",	0,				Kernels::Sha1Generic },
+#if CRYPTO_X86
+	{ "shani",	Cpu::SHA | Cpu::SSE41 | Cpu::SSSE3,	Kernels::Sha1Shani },
+#endif
+};
+
+Candidate< Kernels::Function > const	SHA256_KERNELS[] =
+{
+	{ "generic",	0,				Kernels::Sha256Generic },
+#if CRYPTO_X86
+	{ "shani",	Cpu::SHA | Cpu::SSE41 | Cpu::SSSE3,	Kernels::Sha256Shani },
+#endif
+};
+
+Candidate< Kernels::LaneFunction > const	SHA1X8_KERNELS[] =
+{
+	{ "generic",	0,				Kernels::Sha1x8Generic },
+#if CRYPTO_X86
+	{ "avx2",	Cpu::AVX2,			Kernels::Sha1x8Avx2 },
+#endif
+};
+
+Candidate< Kernels::LaneFunction > const	SHA256X8_KERNELS[] =
+{
+	{ "generic",	0,				Kernels::Sha256x8Generic },
+#if CRYPTO_X86
+	{ "avx2",	Cpu::AVX2,			Kernels::Sha256x8Avx2 },
+#endif
+};
+
+Candidate< Kernels::RomixFunction > const	SCRYPT_KERNELS[] =
+{
+	{ "generic",	0,				Kernels::ScryptRomixGeneric },
+#if CRYPTO_X86
+	{ "sse2",	Cpu::SSE2,			Kernels::ScryptRomixSse2 },
+#endif
+};
+
+Candidate< HexKernels > const	HEX_KERNELS[] =
+{
+	{ "generic",	0,				{ Kernels::HexEncodeGeneric, Kernels::HexDecodeGeneric } },
+#if CRYPTO_X86
+	{ "ssse3",	Cpu::SSSE3,			{ Kernels::HexEncodeSsse3, Kernels::HexDecodeSsse3 } },
+	{ "avx2",	Cpu::AVX2,			{ Kernels::HexEncodeAvx2, Kernels::HexDecodeAvx2 } },
+#endif
+};
+
+Candidate< Base64Kernels > const	BASE64_KERNELS[] =
+{
+	{ "generic",	0,				{ Kernels::Base64EncodeGeneric, Kernels::Base64DecodeGeneric } },
+#if CRYPTO_X86
+	{ "ssse3",	Cpu::SSSE3,			{ Kernels::Base64EncodeSsse3, Kernels::Base64DecodeSsse3 } },
+	{ "avx2",	Cpu::AVX2,			{ Kernels::Base64EncodeAvx2, Kernels::Base64DecodeAvx2 } },
+#endif
+};
+
+
+// Known-answer tests. The MD5 vectors are the ones from RFC 1321 (test-suite.txt), and the SHA vectors are from
+// FIPS 180-2. Each set includes at least one message that spans more than one chunk.
+
+char const	DIGITS[]	= "12345678901234567890123456789012345678901234567890123456789012345678901234567890";
+char const	FOX[]		= "The quick brown fox jumps over the lazy dog";
+char const	NIST[]		= "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+Vector const	CRC32_VECTORS[] =
+{
+	{ "",			"00000000" },
+	{ "123456789",	"cbf43926" },
+	{ FOX,			"414fa339" },
+	{ DIGITS,		"7ca94a72" },
+};
+
+Vector const	MD5_VECTORS[] =
+{
+	{ "",												"d41d8cd98f00b204e9800998ecf8427e" },
+	{ "a",												"0cc175b9c0f1b6a831c399e269772661" },
+	{ "abc",											"900150983cd24fb0d6963f7d28e17f72" },
+	{ "message digest",									"f96b697d7cb7938d525a2f31aaf161d0" },
+	{ "abcdefghijklmnopqrstuvwxyz",						"c3fcd3d76192e4007dfb496cca67e13b" },
+	{ "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",	"d174ab98d277d9f5a5611c2c9f419d9f" },
+	{ DIGITS,											"57edf4a22be3c955ac49da2e2107b67a" },
+};
+
+Vector const	SHA1_VECTORS[] =
+{
+	{ "",		"da39a3ee5e6b4b0d3255bfef95601890afd80709" },
+	{ "abc",	"a9993e364706816aba3e25717850c26c9cd0d89d" },
+	{ NIST,		"84983e441c3bd26ebaae4aa1f95129e5e54670f1" },
+	{ FOX,		"2fd4e1c67a2d28fced849ee1bb76e7391b93eb12" },
+	{ DIGITS,	"50abf5706a150990a08b2c5ea40fa0e585554732" },
+};
+
+Vector const	SHA256_VECTORS[] =
+{
+	{ "",		"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+	{ "abc",	"ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+	{ NIST,		"248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+	{ DIGITS,	"f371bc4a311f2b009eef952dd83ca80e2b60026c8e935592d0f9c308453c813e" },
+};
+
+DigestParameters const	MD5_PARAMETERS		=
+{
+	4, { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 }, false,
+	MD5_VECTORS, int( sizeof( MD5_VECTORS ) / sizeof( MD5_VECTORS[0] ) )
+};
+
+DigestParameters const	SHA1_PARAMETERS		=
+{
+	5, { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 }, true,
+	SHA1_VECTORS, int( sizeof( SHA1_VECTORS ) / sizeof( SHA1_VECTORS[0] ) )
+};
+
+DigestParameters const	SHA256_PARAMETERS	=
+{
+	8, { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 }, true,
+	SHA256_VECTORS, int( sizeof( SHA256_VECTORS ) / sizeof( SHA256_VECTORS[0] ) )
+};
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Runs the CRC-32 known-answer tests on a kernel. The message is split so that the kernel also sees unaligned data
+// and a second call.
+
+bool TestCrc32( Kernels::Function const & kernel )
+{
+	for ( Vector const & v : CRC32_VECTORS )
+	{
+		uint8_t const *			message	= reinterpret_cast< uint8_t const * >( v.message );
+		size_t const			size	= strlen( v.message );
+		size_t const			split	= size / 3;
+		uint32_t				crc		= 0xFFFFFFFF;
+
+		kernel( &crc, message, split );
+		kernel( &crc, message + split, size - split );
+		crc ^= 0xFFFFFFFF;
+
+		uint8_t			expected[ 4 ];
+		HexToBinary( v.expected, expected, sizeof( expected ) );
+
+		if ( crc != ( uint32_t( expected[0] ) << 24 | uint32_t( expected[1] ) << 16 | uint32_t( expected[2] ) << 8 | expected[3] ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+// Runs the known-answer tests for a digest on a kernel. The padding is done here so that the test does not depend on
+// the calculators (which use the active kernel).
+
+bool TestDigest( DigestParameters const & parameters, Kernels::Function const & kernel )
+{
+	int const	BYTES_PER_CHUNK	= 64;
+
+	for ( int i = 0; i < parameters.nVectors; ++i )
+	{
+		Vector const &	v		= parameters.vectors[ i ];
+		size_t const	size	= strlen( v.message );
+
+		// Pad the message: append the 1 bit, pad with 0's, and append the size in bits
+
+		uint8_t			padded[ 4 * BYTES_PER_CHUNK ];
+		size_t const	paddedSize	= ( size + 1 + 8 + BYTES_PER_CHUNK - 1 ) / BYTES_PER_CHUNK * BYTES_PER_CHUNK;
+
+		if ( paddedSize > sizeof( padded ) )
+		{
+			return false;
+		}
+
+		memset( padded, 0, sizeof( padded ) );
+		memcpy( padded, v.message, size );
+		padded[ size ] = 0x80;
+
+		uint64_t const			bits	= static_cast< uint64_t >( size ) * 8;
+		for ( int j = 0; j < 8; ++j )
+		{
+			int const	shift	= parameters.bigEndian ? ( 7 - j ) * 8 : j * 8;
+			padded[ paddedSize - 8 + j ] = uint8_t( bits >> shift );
+		}
+
+		uint32_t			state[ 8 ];
+		memcpy( state, parameters.initial, sizeof( state ) );
+
+		kernel( state, padded, paddedSize );
+
+		// Compare
+
+		uint8_t			expected[ 32 ];
+		HexToBinary( v.expected, expected, parameters.size * 4 );
+
+		for ( int j = 0; j < parameters.size * 4; ++j )
+		{
+			int const	shift	= parameters.bigEndian ? ( 3 - j % 4 ) * 8 : ( j % 4 ) * 8;
+
+			if ( uint8_t( state[ j / 4 ] >> shift ) != expected[ j ] )
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool TestMd5( Kernels::Function const & kernel )		{ return TestDigest( MD5_PARAMETERS, kernel ); }
+bool TestSha1( Kernels::Function const & kernel )		{ return TestDigest( SHA1_PARAMETERS, kernel ); }
+bool TestSha256( Kernels::Function const & kernel )		{ return TestDigest( SHA256_PARAMETERS, kernel ); }
+
+
+// Runs the tests for an x8 kernel of a digest. Lane j hashes NIST followed by the first 7 * j digits of DIGITS, which
+// is two blocks with the padding, so each lane has a different message and the second block continues from the state
+// left by the first. Lane 0 is checked against the known answer for NIST, and the others against the portable
+// single-message kernel, which has passed its own tests.
+
+bool TestLanes( DigestParameters const & parameters, Kernels::Function reference, Kernels::LaneFunction const & kernel )
+{
+	int const	LANES			= 8;
+	int const	BYTES_PER_CHUNK	= 64;
+	uint8_t		padded[ LANES ][ 2 * BYTES_PER_CHUNK ];
+	uint32_t	state[ 8 * LANES ];
+	uint32_t	words[ 16 * LANES ];
+
+	for ( int j = 0; j < LANES; ++j )
+	{
+		size_t const	size	= strlen( NIST ) + 7 * j;
+
+		memset( padded[j], 0, sizeof( padded[j] ) );
+		memcpy( padded[j], NIST, strlen( NIST ) );
+		memcpy( padded[j] + strlen( NIST ), DIGITS, 7 * j );
+		padded[j][ size ] = 0x80;
+		StoreBigEndian64( padded[j] + 2 * BYTES_PER_CHUNK - 8, uint64_t( size ) * 8 );
+
+		for ( int i = 0; i < parameters.size; ++i )
+		{
+			state[ i * LANES + j ] = parameters.initial[i];
+		}
+	}
+
+	for ( int block = 0; block < 2; ++block )
+	{
+		for ( int j = 0; j < LANES; ++j )
+		{
+			for ( int i = 0; i < 16; ++i )
+			{
+				words[ i * LANES + j ] = LoadBigEndian32( padded[j] + block * BYTES_PER_CHUNK + i * 4 );
+			}
+		}
+
+		kernel( state, words );
+	}
+
+	for ( int j = 0; j < LANES; ++j )
+	{
+		uint32_t	expected[ 8 ];
+		uint8_t		digest[ 32 ]	= { 0 };
+
+		memcpy( expected, parameters.initial, sizeof( expected ) );
+		reference( expected, padded[j], 2 * BYTES_PER_CHUNK );
+
+		for ( int v = 0; j == 0 && v < parameters.nVectors; ++v )
+		{
+			if ( parameters.vectors[v].message == NIST )
+				HexToBinary( parameters.vectors[v].expected, digest, parameters.size * 4 );
+		}
+
+		for ( int i = 0; j == 0 && i < parameters.size; ++i )
+		{
+			if ( state[ i * LANES ] != LoadBigEndian32( digest + i * 4 ) )
+				return false;
+		}
+
+		for ( int i = 0; i < parameters.size; ++i )
+		{
+			if ( state[ i * LANES + j ] != expected[i] )
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool TestSha1x8( Kernels::LaneFunction const & kernel )
+{
+	return TestLanes( SHA1_PARAMETERS, Kernels::Sha1Generic, kernel );
+}
+
+bool TestSha256x8( Kernels::LaneFunction const & kernel )
+{
+	return TestLanes( SHA256_PARAMETERS, Kernels::Sha256Generic, kernel );
+}
+
+
+// Runs the ROMix tests on a kernel. A block with r = 1 is mixed with n = 16 and checked against the known answer,
+// which was computed by an independent implementation of scrypt that matches the vectors of RFC 7914. Then a block
+// with r = 3 and n = 64 is checked against the portable kernel, which has passed the first test, so that BlockMix is
+// also tested with more than one pair of Salsa20/8 blocks.
+
+bool TestRomix( Kernels::RomixFunction const & kernel )
+{
+	char const	EXPECTED[]	=
+		"f1c3f9e7943a92713b73df5fa3b911178ce59549aa197c04dfafe9cb6fe9ba22d7a76b6dbe2dabcfdfd0a19666b52e13"
+		"247c71bdc2f68b5d3b2a45fa8262279d22c83adba3175cad4e474e4d6c66253ff3d4fda3f7cad56130292e008966c20d"
+		"cc24a9cec69e37ab08e59c4412edf0ea03ef3ba365a4383298f1c5037460159a";
+
+	alignas( 64 ) static uint32_t	v[ 32 * 3 * ( 64 + 2 ) ];
+	alignas( 64 ) uint32_t			block[ 32 * 3 ];
+	alignas( 64 ) uint32_t			reference[ 32 * 3 ];
+	uint8_t							expected[ 128 ];
+
+	for ( int i = 0; i < 32; ++i )
+	{
+		uint8_t	bytes[ 4 ];
+
+		for ( int j = 0; j < 4; ++j )
+		{
+			bytes[j] = uint8_t( ( i * 4 + j ) * 167 + 13 );
+		}
+		block[i] = LoadLittleEndian32( bytes );
+	}
+
+	kernel( block, 1, 16, v );
+
+	HexToBinary( EXPECTED, expected, sizeof( expected ) );
+	for ( int i = 0; i < 32; ++i )
+	{
+		if ( block[i] != LoadLittleEndian32( expected + i * 4 ) )
+			return false;
+	}
+
+	for ( int i = 0; i < 32 * 3; ++i )
+	{
+		block[i] = reference[i] = uint32_t( i ) * 0x9e3779b9;
+	}
+
+	kernel( block, 3, 64, v );
+	Kernels::ScryptRomixGeneric( reference, 3, 64, v );
+
+	return memcmp( block, reference, sizeof( block ) ) == 0;
+}
+
+
+// Runs the hex tests on a pair of kernels. Every byte value is encoded and decoded at each length up to 256, so the
+// SIMD kernels are tested on their wide loops and on their tails. Then each invalid character next to the ranges of
+// digits is put at each position, and upper-case digits are decoded. The reference values are computed here because
+// the library's own hex functions use the active kernels.
+
+bool TestHex( HexKernels const & kernels )
+{
+	char const	DIGITS[]	= "0123456789abcdef";
+	char const	INVALID[]	= "/:@G`g \x80";
+	uint8_t		data[ 256 ];
+	char		expected[ 512 ];
+	char		text[ 512 ];
+	uint8_t		decoded[ 256 ];
+
+	for ( int i = 0; i < 256; ++i )
+	{
+		data[i] = uint8_t( i * 167 + 13 );
+		expected[ i * 2 + 0 ] = DIGITS[ data[i] >> 4 ];
+		expected[ i * 2 + 1 ] = DIGITS[ data[i] & 0xf ];
+	}
+
+	for ( size_t size = 0; size <= sizeof( data ); ++size )
+	{
+		kernels.encode( data, size, text );
+		if ( memcmp( text, expected, size * 2 ) != 0 || !kernels.decode( text, size, decoded ) ||
+			 memcmp( decoded, data, size ) != 0 )
+		{
+			return false;
+		}
+	}
+
+	for ( size_t i = 0; i < 80; ++i )
+	{
+		for ( char const * c = INVALID; *c != 0; ++c )
+		{
+			memcpy( text, expected, 80 );
+			text[i] = *c;
+			if ( kernels.decode( text, 40, decoded ) )
+				return false;
+		}
+	}
+
+	if ( !kernels.decode( "0A1b2C3d4E5f6A7b8C9dAeBfCaDbEcFd", 16, decoded ) || decoded[0] != 0x0a || decoded[15] != 0xfd )
+		return false;
+
+	return true;
+}
+
+
+// Runs the Base64 tests on a pair of kernels. The RFC 4648 vector is converted, and then every whole number of groups
+// up to 192 bytes is encoded and decoded with both alphabets against a reference computed here. Then each character
+// that is not in the alphabet is put at each position.
+
+bool TestBase64( Base64Kernels const & kernels )
+{
+	char const	STANDARD[]	= "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	char const	URL[]		= "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+	uint8_t		data[ 192 ];
+	char		expected[ 256 ];
+	char		text[ 256 ];
+	uint8_t		decoded[ 192 ];
+
+	kernels.encode( reinterpret_cast< uint8_t const * >( "foobar" ), 6, text, false );
+	if ( memcmp( text, "Zm9vYmFy", 8 ) != 0 || !kernels.decode( "Zm9vYmFy", 8, decoded, false ) ||
+		 memcmp( decoded, "foobar", 6 ) != 0 )
+	{
+		return false;
+	}
+
+	for ( int i = 0; i < 192; ++i )
+	{
+		data[i] = uint8_t( i * 167 + 13 );
+	}
+
+	for ( int url = 0; url < 2; ++url )
+	{
+		char const *	alphabet	= url ? URL : STANDARD;
+		char const *	invalid		= url ? "=./+*\x80" : "=.-_*\x80";
+
+		for ( int i = 0; i < 64; ++i )
+		{
+			uint32_t const	x	= ( uint32_t( data[ i * 3 ] ) << 16 ) | ( uint32_t( data[ i * 3 + 1 ] ) << 8 ) | data[ i * 3 + 2 ];
+
+			expected[ i * 4 + 0 ] = alphabet[ ( x >> 18 ) & 0x3f ];
+			expected[ i * 4 + 1 ] = alphabet[ ( x >> 12 ) & 0x3f ];
+			expected[ i * 4 + 2 ] = alphabet[ ( x >>  6 ) & 0x3f ];
+			expected[ i * 4 + 3 ] = alphabet[ ( x >>  0 ) & 0x3f ];
+		}
+
+		for ( size_t size = 0; size <= sizeof( data ); size += 3 )
+		{
+			kernels.encode( data, size, text, url != 0 );
+			if ( memcmp( text, expected, size / 3 * 4 ) != 0 || !kernels.decode( text, size / 3 * 4, decoded, url != 0 ) ||
+				 memcmp( decoded, data, size ) != 0 )
+			{
+				return false;
+			}
+		}
+
+		for ( size_t i = 0; i < 96; ++i )
+		{
+			for ( char const * c = invalid; *c != 0; ++c )
+			{
+				memcpy( text, expected, 96 );
+				text[i] = *c;
+				if ( kernels.decode( text, 96, decoded, url != 0 ) )
+					return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+// Runs a hash kernel over a 16 KB buffer
+
+void RunHash( Kernels::Function const & kernel )
+{
+	static uint8_t const	buffer[ 16 * 1024 ]	= { 0 };
+	uint32_t				state[ 8 ]			= { 0 };
+
+	kernel( state, buffer, sizeof( buffer ) );
+}
+
+
+// Runs an x8 kernel on 32 blocks in each lane, which is 16 KB in all
+
+void RunLanes( Kernels::LaneFunction const & kernel )
+{
+	static uint32_t const	words[ 16 * 8 ]	= { 0 };
+	uint32_t				state[ 8 * 8 ]	= { 0 };
+
+	for ( int i = 0; i < 32; ++i )
+	{
+		kernel( state, words );
+	}
+}
+
+
+// Mixes a block with r = 8 and n = 16, which is 16 KB of scratch space
+
+void RunRomix( Kernels::RomixFunction const & kernel )
+{
+	alignas( 64 ) static uint32_t	v[ 32 * 8 * ( 16 + 2 ) ];
+	alignas( 64 ) uint32_t			block[ 32 * 8 ]	= { 0 };
+
+	kernel( block, 8, 16, v );
+}
+
+
+// Encodes 8 KB and decodes the 16 KB of text
+
+void RunHex( HexKernels const & kernels )
+{
+	static uint8_t	buffer[ 8 * 1024 ];
+	static char		text[ 16 * 1024 ];
+
+	kernels.encode( buffer, sizeof( buffer ), text );
+	kernels.decode( text, sizeof( buffer ), buffer );
+}
+
+
+// Encodes 12 KB and decodes the 16 KB of text
+
+void RunBase64( Base64Kernels const & kernels )
+{
+	static uint8_t	buffer[ 12 * 1024 ];
+	static char		text[ 16 * 1024 ];
+
+	kernels.encode( buffer, sizeof( buffer ), text, false );
+	kernels.decode( text, sizeof( text ), buffer, false );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The kernels for an algorithm and the result of selecting one. The candidates are an array of Candidate< Function >,
+// where the type of the function depends on the algorithm, so they are reached through the functions of a Family.
+
+struct Selection
+{
+	char const *		name;					// Name of the algorithm
+	void const *		candidates;
+	int					nCandidates;
+	char const *		( *nameOf )( void const * candidates, int i );
+	unsigned			( *featuresOf )( void const * candidates, int i );
+	bool				( *test )( void const * candidates, int i );		// Runs the known-answer tests
+	void				( *run )( void const * candidates, int i );		// Runs the kernel once, to time it
+
+	std::once_flag		once;
+	unsigned			available;				// Bit n is set if candidate n is supported and passed the tests
+	int					automatic;				// Index of the automatically-selected candidate
+	std::atomic< int >	active;					// Index of the candidate in use
+	std::string			rejected;				// Kernel named by the environment variable if it is not available
+};
+
+// Accesses the candidates of a selection whose kernels have a given type
+
+template< typename Function, bool ( *TEST )( Function const & ), void ( *RUN )( Function const & ) >
+struct Family
+{
+	static Candidate< Function > const & At( void const * candidates, int i )
+	{
+		return static_cast< Candidate< Function > const * >( candidates )[ i ];
+	}
+
+	static char const * Name( void const * candidates, int i )		{ return At( candidates, i ).name; }
+	static unsigned Features( void const * candidates, int i )		{ return At( candidates, i ).features; }
+	static bool Test( void const * candidates, int i )				{ return TEST( At( candidates, i ).function ); }
+	static void Run( void const * candidates, int i )				{ RUN( At( candidates, i ).function ); }
+};
+
+#define SELECTION( name, a, test, run )														\
+	{																						\
+		name, a, int( sizeof( a ) / sizeof( a[0] ) ),										\
+		Family< decltype( a[0].function ), test, run >::Name,								\
+		Family< decltype( a[0].function ), test, run >::Features,							\
+		Family< decltype( a[0].function ), test, run >::Test,								\
+		Family< decltype( a[0].function ), test, run >::Run,								\
+		{}, 0, 0, { 0 }, std::string()														\
+	}
+
+Selection	s_selections[ KernelRegistry::NUMBER_OF_ALGORITHMS ] =
+{
+	SELECTION( "CRC32",		CRC32_KERNELS,	TestCrc32,	RunHash ),
+	SELECTION( "MD5",		MD5_KERNELS,	TestMd5,	RunHash ),
+	SELECTION( "SHA1",		SHA1_KERNELS,	TestSha1,	RunHash ),
+	SELECTION( "SHA256",	SHA256_KERNELS,	TestSha256,	RunHash ),
+	SELECTION( "HEX",		HEX_KERNELS,	TestHex,	RunHex ),
+	SELECTION( "BASE64",	BASE64_KERNELS,	TestBase64,	RunBase64 ),
+	SELECTION( "SHA1X8",	SHA1X8_KERNELS,	TestSha1x8,	RunLanes ),
+	SELECTION( "SHA256X8",	SHA256X8_KERNELS,	TestSha256x8,	RunLanes ),
+	SELECTION( "SCRYPT",	SCRYPT_KERNELS,	TestRomix,	RunRomix ),
+};
+
+#undef SELECTION
+
+
+// Returns the best time (in seconds) of several runs of a candidate
+
+double Time( Selection const & selection, int i )
+{
+	int const	RUNS	= 5;
+	double		best	= 1.0e30;
+
+	for ( int run = 0; run < RUNS; ++run )
+	{
+		std::chrono::steady_clock::time_point const	start	= std::chrono::steady_clock::now();
+		selection.run( selection.candidates, i );
+		std::chrono::duration< double > const		elapsed	= std::chrono::steady_clock::now() - start;
+
+		if ( elapsed.count() < best )
+		{
+			best = elapsed.count();
+		}
+	}
+
+	return best;
+}
+
+
+// Returns the candidate in use for an algorithm whose kernels have a given type
+
+template< typename Function >
+Function const & Active( Selection const & selection )
+{
+	return static_cast< Candidate< Function > const * >( selection.candidates )
+		[ selection.active.load( std::memory_order_relaxed ) ].function;
+}
+
+
+// Returns the index of the named candidate if it is available, or -1 otherwise
+
+int Find( Selection const & selection, char const * name )
+{
+	for ( int i = 0; i < selection.nCandidates; ++i )
+	{
+		if ( ( selection.available & ( 1u << i ) ) != 0 && strcmp( selection.nameOf( selection.candidates, i ), name ) == 0 )
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+
+// Makes the automatically-selected candidate active unless the environment names another available one. An override
+// that does not name an available kernel is recorded and reported on stderr, so that a mistyped name is not mistaken
+// for a forced kernel.
+
+void Select( Selection & selection )
+{
+	int	active	= selection.automatic;
+
+	std::string const	variable	= std::string( "CRYPTO_KERNEL_" ) + selection.name;
+	char const *		forced		= getenv( variable.c_str() );
+
+	selection.rejected.clear();
+	if ( forced != 0 )
+	{
+		int const	i	= Find( selection, forced );
+		if ( i >= 0 )
+		{
+			active = i;
+		}
+		else
+		{
+			selection.rejected = forced;
+			fprintf( stderr, "%s=%s is not an available kernel. Using \"%s\" instead.\n", variable.c_str(), forced,
+					 selection.nameOf( selection.candidates, active ) );
+		}
+	}
+
+	selection.active.store( active );
+}
+
+
+// Tests and times the candidates, picks the fastest, and then applies any override in the environment. The first
+// candidate is the portable reference and it is used if nothing passes.
+
+void Probe( Selection & selection )
+{
+	double	bestTime	= 0.0;
+
+	selection.available	= 0;
+	selection.automatic	= 0;
+
+	for ( int i = 0; i < selection.nCandidates; ++i )
+	{
+		if ( !Cpu::Has( selection.featuresOf( selection.candidates, i ) ) || !selection.test( selection.candidates, i ) )
+		{
+			continue;
+		}
+
+		double const	time	= Time( selection, i );
+
+		if ( selection.available == 0 || time < bestTime )
+		{
+			selection.automatic	= i;
+			bestTime			= time;
+		}
+
+		selection.available |= 1u << i;
+	}
+
+	Select( selection );
+}
+
+
+// Returns the selection for an algorithm, probing the candidates the first time
+
+Selection & Get( KernelRegistry::Algorithm algorithm )
+{
+	Selection &	selection	= s_selections[ algorithm ];
+
+	std::call_once( selection.once, Probe, std::ref( selection ) );
+
+	return selection;
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	algorithm	Algorithm
+
+char const * KernelRegistry::Name( Algorithm algorithm )
+{
+	return s_selections[ algorithm ].name;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	algorithm	Algorithm
+
+char const * KernelRegistry::Active( Algorithm algorithm )
+{
+	Selection const &	selection	= Get( algorithm );
+
+	return selection.nameOf( selection.candidates, selection.active.load() );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	algorithm	Algorithm
+//!
+//! @return	The kernels in the order they are registered (the portable kernel is first)
+
+std::vector< std::string > KernelRegistry::Available( Algorithm algorithm )
+{
+	Selection const &			selection	= Get( algorithm );
+	std::vector< std::string >	names;
+
+	for ( int i = 0; i < selection.nCandidates; ++i )
+	{
+		if ( ( selection.available & ( 1u << i ) ) != 0 )
+		{
+			names.push_back( selection.nameOf( selection.candidates, i ) );
+		}
+	}
+
+	return names;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	algorithm	Algorithm
+//!
+//! @return	The value of CRYPTO_KERNEL_<name> if it does not name an available kernel, or nullptr
+
+char const * KernelRegistry::RejectedOverride( Algorithm algorithm )
+{
+	Selection const &	selection	= Get( algorithm );
+
+	return selection.rejected.empty() ? nullptr : selection.rejected.c_str();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	algorithm	Algorithm
+//! @param	kernel		Name of the kernel (one of the names returned by Available())
+//!
+//! @return	true if the kernel is now in use
+
+bool KernelRegistry::Force( Algorithm algorithm, char const * kernel )
+{
+	Selection &	selection	= Get( algorithm );
+	int const	i			= Find( selection, kernel );
+
+	if ( i < 0 )
+	{
+		return false;
+	}
+
+	selection.active.store( i );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	algorithm	Algorithm
+//!
+//! @note	This also overrides a kernel forced by the environment variable.
+
+void KernelRegistry::Automatic( Algorithm algorithm )
+{
+	Selection &	selection	= Get( algorithm );
+
+	selection.active.store( selection.automatic );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	algorithm	Algorithm
+//!
+//! The kernels are not tested and timed again. Only the environment variable is read again.
+
+void KernelRegistry::Reselect( Algorithm algorithm )
+{
+	Select( Get( algorithm ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+Kernels::Function Kernels::Get( KernelRegistry::Algorithm algorithm )
+{
+	return Active< Function >( ::Get( algorithm ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+Kernels::LaneFunction Kernels::GetLanes( KernelRegistry::Algorithm algorithm )
+{
+	return Active< LaneFunction >( ::Get( algorithm ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+Kernels::RomixFunction Kernels::GetRomix()
+{
+	return Active< RomixFunction >( ::Get( KernelRegistry::SCRYPT ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+Kernels::HexEncoder Kernels::GetHexEncoder()
+{
+	return Active< HexKernels >( ::Get( KernelRegistry::HEX ) ).encode;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+Kernels::HexDecoder Kernels::GetHexDecoder()
+{
+	return Active< HexKernels >( ::Get( KernelRegistry::HEX ) ).decode;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+Kernels::Base64Encoder Kernels::GetBase64Encoder()
+{
+	return Active< Base64Kernels >( ::Get( KernelRegistry::BASE64 ) ).encode;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+Kernels::Base64Decoder Kernels::GetBase64Decoder()
+{
+	return Active< Base64Kernels >( ::Get( KernelRegistry::BASE64 ) ).decode;
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,151 @@
+/********************************************************************************************************************
+
+                                                       Kernels.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Kernels.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "Cpu.h"
+#include "KernelRegistry.h"
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Crypto
+{
+namespace Kernels
+{
+
+
+// A kernel updates an intermediate state with a buffer of data.
+//
+// For CRC-32, state[0] is the CRC register (before the final inversion) and size can be anything. For the digests,
+// state is the intermediate digest and size must be a multiple of the 64-byte chunk size.
+
+typedef void ( *Function )( uint32_t * state, uint8_t const * data, size_t size );
+
+// Returns the kernel currently selected by the KernelRegistry for an algorithm
+Function Get( KernelRegistry::Algorithm algorithm );
+
+// CRC-32 kernels (Crc32Kernels.cpp)
+void Crc32Table( uint32_t * state, uint8_t const * data, size_t size );
+void Crc32Slice8( uint32_t * state, uint8_t const * data, size_t size );
+#if CRYPTO_X86
+void Crc32Pclmul( uint32_t * state, uint8_t const * data, size_t size );
+#endif
+
+// Batch CRC-32 kernels (Crc32Kernels.cpp). They update the states of four buffers of the same size at once, so that
+// the four independent chains hide each other's latency.
+
+typedef void ( *BatchFunction )( uint32_t * states, uint8_t const * const * data, size_t size );
+
+void Crc32x4Slice8( uint32_t * states, uint8_t const * const * data, size_t size );
+#if CRYPTO_X86
+void Crc32x4Pclmul( uint32_t * states, uint8_t const * const * data, size_t size );
+#endif
+
+// The x8 kernels compress one block for each of eight independent messages. The state and the message words are
+// interleaved, so word i of lane j is at [ i * 8 + j ], and the message words are already converted from big-endian.
+
+typedef void ( *LaneFunction )( uint32_t * state, uint32_t const * words );
+
+// Returns the x8 kernel currently selected by the KernelRegistry for SHA1X8 or SHA256X8
+LaneFunction GetLanes( KernelRegistry::Algorithm algorithm );
+
+// MD5 kernels (Md5Kernels.cpp)
+void Md5Generic( uint32_t * state, uint8_t const * data, size_t size );
+
+// SHA-1 kernels (Sha1Kernels.cpp)
+void Sha1Generic( uint32_t * state, uint8_t const * data, size_t size );
+void Sha1x8Generic( uint32_t * state, uint32_t const * words );
+#if CRYPTO_X86
+void Sha1Shani( uint32_t * state, uint8_t const * data, size_t size );
+void Sha1x8Avx2( uint32_t * state, uint32_t const * words );
+#endif
+
+// SHA-256 kernels (Sha256Kernels.cpp)
+void Sha256Generic( uint32_t * state, uint8_t const * data, size_t size );
+void Sha256x8Generic( uint32_t * state, uint32_t const * words );
+#if CRYPTO_X86
+void Sha256Shani( uint32_t * state, uint8_t const * data, size_t size );
+void Sha256x8Avx2( uint32_t * state, uint32_t const * words );
+#endif
+
+// Hex kernels (HexKernels.cpp). The encoders write size * 2 characters. The decoders read size * 2 characters and
+// return false if any of them is not a hex digit.
+void HexEncodeGeneric( uint8_t const * buffer, size_t size, char * text );
+bool HexDecodeGeneric( char const * text, size_t size, uint8_t * buffer );
+#if CRYPTO_X86
+void HexEncodeSsse3( uint8_t const * buffer, size_t size, char * text );
+void HexEncodeAvx2( uint8_t const * buffer, size_t size, char * text );
+bool HexDecodeSsse3( char const * text, size_t size, uint8_t * buffer );
+bool HexDecodeAvx2( char const * text, size_t size, uint8_t * buffer );
+#endif
+
+typedef void ( *HexEncoder )( uint8_t const * buffer, size_t size, char * text );
+typedef bool ( *HexDecoder )( char const * text, size_t size, uint8_t * buffer );
+
+// Return the hex kernels currently selected by the KernelRegistry
+HexEncoder GetHexEncoder();
+HexDecoder GetHexDecoder();
+
+// Base64 kernels (Base64Kernels.cpp). The encoders convert each whole group of 3 bytes to 4 characters and ignore the
+// rest. The decoders convert each whole group of 4 characters to 3 bytes and return false if any character is not
+// in the alphabet. url selects the URL-safe alphabet.
+void Base64EncodeGeneric( uint8_t const * data, size_t size, char * text, bool url );
+bool Base64DecodeGeneric( char const * text, size_t length, uint8_t * data, bool url );
+#if CRYPTO_X86
+void Base64EncodeSsse3( uint8_t const * data, size_t size, char * text, bool url );
+void Base64EncodeAvx2( uint8_t const * data, size_t size, char * text, bool url );
+bool Base64DecodeSsse3( char const * text, size_t length, uint8_t * data, bool url );
+bool Base64DecodeAvx2( char const * text, size_t length, uint8_t * data, bool url );
+#endif
+
+typedef void ( *Base64Encoder )( uint8_t const * data, size_t size, char * text, bool url );
+typedef bool ( *Base64Decoder )( char const * text, size_t length, uint8_t * data, bool url );
+
+// Return the Base64 kernels currently selected by the KernelRegistry
+Base64Encoder GetBase64Encoder();
+Base64Decoder GetBase64Decoder();
+
+// Rolling checksum kernels (RollingChecksumKernels.cpp). The checksum kernels return the rsync weak checksum of a
+// block: the sum of the bytes in the low 16 bits and the sum of the running sums in the high 16 bits.
+//
+// The scan kernels roll a window of window bytes along data, starting with the window at data[0] whose checksum is
+// weak, and write the checksums of the windows at data[0] to data[count - 1] to weaks. They read data[0] to
+// data[count + window - 2]. Each checksum is hashed ((weak * 0x9e3779b1) >> (32 - filterBits)) and looked up in a
+// bit filter, and bit k of candidates is set if the filter bit for weaks[k] is set. candidates has a bit for each
+// position, rounded up to 64.
+uint32_t RollingChecksumGeneric( uint8_t const * data, size_t size );
+void RollingChecksumScanGeneric( uint8_t const * data, size_t window, size_t count, uint32_t weak,
+								 uint32_t const * filter, int filterBits, uint32_t * weaks, uint64_t * candidates );
+#if CRYPTO_X86
+uint32_t RollingChecksumAvx2( uint8_t const * data, size_t size );
+void RollingChecksumScanAvx2( uint8_t const * data, size_t window, size_t count, uint32_t weak,
+							  uint32_t const * filter, int filterBits, uint32_t * weaks, uint64_t * candidates );
+#endif
+
+// scrypt kernels (ScryptKernels.cpp). The ROMix kernels mix one 128 * r byte block of little-endian words in place
+// with n iterations, where n is a power of 2. v is scratch space for 32 * r * ( n + 2 ) words, aligned to 64 bytes.
+
+typedef void ( *RomixFunction )( uint32_t * block, size_t r, uint64_t n, uint32_t * v );
+
+// Returns the ROMix kernel currently selected by the KernelRegistry
+RomixFunction GetRomix();
+
+void ScryptRomixGeneric( uint32_t * block, size_t r, uint64_t n, uint32_t * v );
+#if CRYPTO_X86
+void ScryptRomixSse2( uint32_t * block, size_t r, uint64_t n, uint32_t * v );
+#endif
+
+} // namespace Kernels
+} // namespace Crypto
@@ -1,438 +0,0 @@
-/** @file *//********************************************************************************************************
-
-                                                  MD5Calculator.cpp
-
-						                    Copyright 2004, John J. Bolton
-	--------------------------------------------------------------------------------------------------------------
-
-	$Header: //depot/Libraries/Crypto/MD5Calculator.cpp#3 $
-
-	$NoKeywords: $
-
- ********************************************************************************************************************/
-
-#include "MD5Calculator.h"
-
-
-// MD5.CC - source code for the C++/object oriented translation and
-//			modification of MD5.
-
-// Translation and modification ( c ) 1995 by Mordechai T. Abzug
-
-// This translation/ modification is provided "as is," without express or
-// implied warranty of any kind.
-
-// The translator/ modifier does not claim ( 1 ) that MD5 will do what you think
-// it does; ( 2 ) that this translation/ modification is accurate; or ( 3 ) that
-// this software is "merchantible."  ( Language for this disclaimer partially
-// copied from the disclaimer below ).
-
-/* based on:
-
-  MD5C.C - RSA Data Security, Inc., MD5 message-digest algorithm
-  MDDRIVER.C - test driver for MD2, MD4 and MD5
-
-
-	Copyright ( C ) 1991-2, RSA Data Security, Inc. Created 1991. All
-	rights reserved.
-
-	License to copy and use this software is granted provided that it
-	is identified as the "RSA Data Security, Inc. MD5 Message-Digest
-	Algorithm" in all material mentioning or referencing this software
-	or this function.
-
-	License is also granted to make and use derivative works provided
-	that such works are identified as "derived from the RSA Data
-	Security, Inc. MD5 Message-Digest Algorithm" in all material
-	mentioning or referencing the derived work.
-
-	RSA Data Security, Inc. makes no representations concerning either
-	the merchantability of this software or the suitability of this
-	software for any particular purpose. It is provided "as is"
-	without express or implied warranty of any kind.
-
-	These notices must be retained in any copies of any part of this
-	documentation and/or software.
-
-*/
-
-#include "Md5Calculator.h"
-
-#include "Common.h"
-
-#include <xutility>
-#include <istream>
-
-namespace
-{
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-inline unsigned __int32 F( unsigned __int32 x, unsigned __int32 y, unsigned __int32 z )
-{
-	return ( x & y ) | ( ~x & z );
-}
-
-inline unsigned __int32 G( unsigned __int32 x, unsigned __int32 y, unsigned __int32 z )
-{
-	return ( x & z ) | ( y & ~z );
-}
-
-inline unsigned __int32 H( unsigned __int32 x, unsigned __int32 y, unsigned __int32 z )
-{
-	return x ^ y ^ z;
-}
-
-inline unsigned __int32 I( unsigned __int32 x, unsigned __int32 y, unsigned __int32 z )
-{
-	return y ^ ( x | ~z );
-}
-
-
-
-// FF, GG, HH, and II transformations for rounds 1, 2, 3, and 4.
-// Rotation is separate from addition to prevent recomputation.
-
-
-void FF( unsigned __int32 * pa, unsigned __int32 b, unsigned __int32 c, unsigned __int32 d, unsigned __int32 x, unsigned __int32  s, unsigned __int32 ac )
-{
-	*pa += F( b, c, d ) + x + ac;
-	*pa = Crypto::rotl( *pa, s ) + b;
-}
-
-void GG( unsigned __int32 * pa, unsigned __int32 b, unsigned __int32 c, unsigned __int32 d, unsigned __int32 x, unsigned __int32 s, unsigned __int32 ac )
-{
-	*pa += G( b, c, d ) + x + ac;
-	*pa = Crypto::rotl( *pa, s ) + b;
-}
-
-void HH( unsigned __int32 * pa, unsigned __int32 b, unsigned __int32 c, unsigned __int32 d, unsigned __int32 x, unsigned __int32 s, unsigned __int32 ac )
-{
-	*pa += H( b, c, d ) + x + ac;
-	*pa = Crypto::rotl( *pa, s ) + b;
-}
-
-void II( unsigned __int32 * pa, unsigned __int32 b, unsigned __int32 c, unsigned __int32 d, unsigned __int32 x, unsigned __int32 s, unsigned __int32 ac )
-{
-	*pa += I( b, c, d ) + x + ac;
-	*pa = Crypto::rotl( *pa, s ) + b;
-}
-
-} // anonymous namespace
-
-
-namespace Crypto
-{
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-Md5Calculator::Md5Calculator()
-{
-	Reset();
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-void Md5Calculator::Calculate( std::istream & stream, unsigned __int8 * digest )
-{
-	Reset();  // must called by all constructors
-	Process( stream );
-	Finalize( digest );
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-void Md5Calculator::Calculate( unsigned __int8 const * string, size_t size, unsigned __int8 * digest )
-{
-
-	Reset();  // must called by all constructors
-	Process( string, size );
-	Finalize( digest );
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-void Md5Calculator::Process( unsigned __int8 const * data, size_t size )
-{
-	// If there is already data in the buffer, then fill it.
-
-	if ( m_tail > 0 )
-	{
-		size_t	n	= std::min( sizeof( m_buffer ) - m_tail, size );
-		memcpy( &m_buffer[ m_tail ], data, n );
-
-		m_tail += int( n );
-		size -= n;
-		data += n;
-	}
-
-	// If the buffer is full, then process it first
-
-	if ( m_tail == sizeof( m_buffer ) )
-	{
-		ProcessChunk( m_buffer );
-		m_nProcessed += sizeof( m_buffer );
-
-		m_tail = 0;
-	}
-
-	// Process one chunk at a time
-
-	while ( size > sizeof( m_buffer ) )
-	{
-		ProcessChunk( data );
-		m_nProcessed += sizeof( m_buffer );
-
-		size -= sizeof( m_buffer );
-		data += sizeof( m_buffer );
-	}
-
-	// Put the leftover data in the buffer
-
-	if ( size > 0 )
-	{
-		memcpy( m_buffer, data, size );
-		m_tail = int( size );
-	}
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-void Md5Calculator::Process( std::istream & stream )
-{
-	// Append to any data already in the buffer
-
-	if ( stream.good() )
-	{
-		stream.read( reinterpret_cast<char*>( &m_buffer[m_tail] ), sizeof( m_buffer ) - m_tail );
-		m_tail += stream.gcount();
-	}
-
-	// Repeatedly process and reload the buffer until the end of the file is reached. If the buffer is not full
-	// when the end is reached, then just leave the data in it.
-
-	while ( m_tail == sizeof( m_buffer ) )
-	{
-		// Process the buffer
-
-		ProcessChunk( m_buffer );
-		m_nProcessed += sizeof( m_buffer );
-		m_tail = 0;
-
-		// Reload the buffer
-
-		if ( stream.good() )
-		{
-			stream.read( reinterpret_cast<char*>( m_buffer ), sizeof( m_buffer ) );
-			m_tail = stream.gcount();
-		}
-	}
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-void Md5Calculator::Finalize( unsigned __int8 * digest )
-{
-	// Process the last chunk. The last chunk has a 1 bit (0x80 byte) appended, then is padded to 448 bits,
-	// and then has a 64-bit size (of the data in bits) appended.
-
-	// Append the 1 bit
-
-	m_buffer[ m_tail ] = 0x80;
-	++m_tail;
-
-	// If the buffer has more than 56 bytes (including the appended 1 bit), it must be processed in two chunks
-	// because there is not enough room for the appended size.
-
-	// If the buffer has more than 56 bytes (including the appended 1 bit), process the first chunk.
-
-	if ( m_tail > sizeof( m_buffer )-sizeof( unsigned __int64 ) )
-	{
-		// Pad to the end of the chunk
-		memset( &m_buffer[ m_tail ], 0, sizeof( m_buffer )-m_tail );
-
-		ProcessChunk( m_buffer );
-		m_nProcessed += m_tail-1;	// -1 because we don't want to include the appended 1 bit
-
-		m_tail = 0;
-	}
-	else
-	{
-		m_nProcessed += m_tail-1;	// -1 because we don't want to include the appended 1 bit
-	}
-
-	// Pad to the end of the chunk
-	memset( &m_buffer[ m_tail ], 0, sizeof( m_buffer ) - m_tail );
-
-	// Append the size (of the data in bits) 
-
-	unsigned __int64 *	pEnd	= reinterpret_cast< unsigned __int64 * >( m_buffer + sizeof( m_buffer ) );
-	pEnd[-1] = static_cast< unsigned __int64 >( m_nProcessed ) * 8;
-
-	// Process the final chunk
-
-	ProcessChunk( m_buffer );
-
-	memcpy( digest, m_digest, sizeof( m_digest ) );
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-void Md5Calculator::Reset()
-{
-	m_digest[ 0 ] = 0x67452301;
-	m_digest[ 1 ] = 0xefcdab89;
-	m_digest[ 2 ] = 0x98badcfe;
-	m_digest[ 3 ] = 0x10325476;
-
-	m_tail			= 0;
-	m_nProcessed	= 0;
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-// Constants for MD5Transform routine.
-// Although we could use C++ style constants, defines are actually better,
-// since they let us easily evade scope clashes.
-
-#define S11 7
-#define S12 12
-#define S13 17
-#define S14 22
-#define S21 5
-#define S22 9
-#define S23 14
-#define S24 20
-#define S31 4
-#define S32 11
-#define S33 16
-#define S34 23
-#define S41 6
-#define S42 10
-#define S43 15
-#define S44 21
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-void Md5Calculator::ProcessChunk( unsigned __int8 const * block )
-{
-	// MD5 basic transformation. Transforms m_digest based on block.
-
-	unsigned __int32 a = m_digest[ 0 ];
-	unsigned __int32 b = m_digest[ 1 ];
-	unsigned __int32 c = m_digest[ 2 ];
-	unsigned __int32 d = m_digest[ 3 ];
-	unsigned __int32 x[ WORDS_PER_CHUNK ];
-
-	memcpy( x, block, BYTES_PER_CHUNK );
-
-	/* Round 1 */
-	FF( &a, b, c, d, x[  0 ], S11, 0xd76aa478 ); /*  1 */
-	FF( &d, a, b, c, x[  1 ], S12, 0xe8c7b756 ); /*  2 */
-	FF( &c, d, a, b, x[  2 ], S13, 0x242070db ); /*  3 */
-	FF( &b, c, d, a, x[  3 ], S14, 0xc1bdceee ); /*  4 */
-	FF( &a, b, c, d, x[  4 ], S11, 0xf57c0faf ); /*  5 */
-	FF( &d, a, b, c, x[  5 ], S12, 0x4787c62a ); /*  6 */
-	FF( &c, d, a, b, x[  6 ], S13, 0xa8304613 ); /*  7 */
-	FF( &b, c, d, a, x[  7 ], S14, 0xfd469501 ); /*  8 */
-	FF( &a, b, c, d, x[  8 ], S11, 0x698098d8 ); /*  9 */
-	FF( &d, a, b, c, x[  9 ], S12, 0x8b44f7af ); /* 10 */
-	FF( &c, d, a, b, x[ 10 ], S13, 0xffff5bb1 ); /* 11 */
-	FF( &b, c, d, a, x[ 11 ], S14, 0x895cd7be ); /* 12 */
-	FF( &a, b, c, d, x[ 12 ], S11, 0x6b901122 ); /* 13 */
-	FF( &d, a, b, c, x[ 13 ], S12, 0xfd987193 ); /* 14 */
-	FF( &c, d, a, b, x[ 14 ], S13, 0xa679438e ); /* 15 */
-	FF( &b, c, d, a, x[ 15 ], S14, 0x49b40821 ); /* 16 */
-
-	/* Round 2 */
-	GG( &a, b, c, d, x[  1 ], S21, 0xf61e2562 ); /* 17 */
-	GG( &d, a, b, c, x[  6 ], S22, 0xc040b340 ); /* 18 */
-	GG( &c, d, a, b, x[ 11 ], S23, 0x265e5a51 ); /* 19 */
-	GG( &b, c, d, a, x[  0 ], S24, 0xe9b6c7aa ); /* 20 */
-	GG( &a, b, c, d, x[  5 ], S21, 0xd62f105d ); /* 21 */
-	GG( &d, a, b, c, x[ 10 ], S22, 0x02441453 ); /* 22 */
-	GG( &c, d, a, b, x[ 15 ], S23, 0xd8a1e681 ); /* 23 */
-	GG( &b, c, d, a, x[  4 ], S24, 0xe7d3fbc8 ); /* 24 */
-	GG( &a, b, c, d, x[  9 ], S21, 0x21e1cde6 ); /* 25 */
-	GG( &d, a, b, c, x[ 14 ], S22, 0xc33707d6 ); /* 26 */
-	GG( &c, d, a, b, x[  3 ], S23, 0xf4d50d87 ); /* 27 */
-	GG( &b, c, d, a, x[  8 ], S24, 0x455a14ed ); /* 28 */
-	GG( &a, b, c, d, x[ 13 ], S21, 0xa9e3e905 ); /* 29 */
-	GG( &d, a, b, c, x[  2 ], S22, 0xfcefa3f8 ); /* 30 */
-	GG( &c, d, a, b, x[  7 ], S23, 0x676f02d9 ); /* 31 */
-	GG( &b, c, d, a, x[ 12 ], S24, 0x8d2a4c8a ); /* 32 */
-
-	/* Round 3 */
-	HH( &a, b, c, d, x[  5 ], S31, 0xfffa3942 ); /* 33 */
-	HH( &d, a, b, c, x[  8 ], S32, 0x8771f681 ); /* 34 */
-	HH( &c, d, a, b, x[ 11 ], S33, 0x6d9d6122 ); /* 35 */
-	HH( &b, c, d, a, x[ 14 ], S34, 0xfde5380c ); /* 36 */
-	HH( &a, b, c, d, x[  1 ], S31, 0xa4beea44 ); /* 37 */
-	HH( &d, a, b, c, x[  4 ], S32, 0x4bdecfa9 ); /* 38 */
-	HH( &c, d, a, b, x[  7 ], S33, 0xf6bb4b60 ); /* 39 */
-	HH( &b, c, d, a, x[ 10 ], S34, 0xbebfbc70 ); /* 40 */
-	HH( &a, b, c, d, x[ 13 ], S31, 0x289b7ec6 ); /* 41 */
-	HH( &d, a, b, c, x[  0 ], S32, 0xeaa127fa ); /* 42 */
-	HH( &c, d, a, b, x[  3 ], S33, 0xd4ef3085 ); /* 43 */
-	HH( &b, c, d, a, x[  6 ], S34, 0x04881d05 ); /* 44 */
-	HH( &a, b, c, d, x[  9 ], S31, 0xd9d4d039 ); /* 45 */
-	HH( &d, a, b, c, x[ 12 ], S32, 0xe6db99e5 ); /* 46 */
-	HH( &c, d, a, b, x[ 15 ], S33, 0x1fa27cf8 ); /* 47 */
-	HH( &b, c, d, a, x[  2 ], S34, 0xc4ac5665 ); /* 48 */
-
-	/* Round 4 */
-	II( &a, b, c, d, x[  0 ], S41, 0xf4292244 ); /* 49 */
-	II( &d, a, b, c, x[  7 ], S42, 0x432aff97 ); /* 50 */
-	II( &c, d, a, b, x[ 14 ], S43, 0xab9423a7 ); /* 51 */
-	II( &b, c, d, a, x[  5 ], S44, 0xfc93a039 ); /* 52 */
-	II( &a, b, c, d, x[ 12 ], S41, 0x655b59c3 ); /* 53 */
-	II( &d, a, b, c, x[  3 ], S42, 0x8f0ccc92 ); /* 54 */
-	II( &c, d, a, b, x[ 10 ], S43, 0xffeff47d ); /* 55 */
-	II( &b, c, d, a, x[  1 ], S44, 0x85845dd1 ); /* 56 */
-	II( &a, b, c, d, x[  8 ], S41, 0x6fa87e4f ); /* 57 */
-	II( &d, a, b, c, x[ 15 ], S42, 0xfe2ce6e0 ); /* 58 */
-	II( &c, d, a, b, x[  6 ], S43, 0xa3014314 ); /* 59 */
-	II( &b, c, d, a, x[ 13 ], S44, 0x4e0811a1 ); /* 60 */
-	II( &a, b, c, d, x[  4 ], S41, 0xf7537e82 ); /* 61 */
-	II( &d, a, b, c, x[ 11 ], S42, 0xbd3af235 ); /* 62 */
-	II( &c, d, a, b, x[  2 ], S43, 0x2ad7d2bb ); /* 63 */
-	II( &b, c, d, a, x[  9 ], S44, 0xeb86d391 ); /* 64 */
-
-	m_digest[ 0 ] += a;
-	m_digest[ 1 ] += b;
-	m_digest[ 2 ] += c;
-	m_digest[ 3 ] += d;
-}
-
-
-} // namespace Crypto
\ No newline at end of file
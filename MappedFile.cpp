@@ -0,0 +1,109 @@
+/********************************************************************************************************************
+
+                                                    MappedFile.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/MappedFile.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "MappedFile.h"
+
+#if defined( _WIN32 )
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool MappedFile::Open( char const * path, Access access )
+{
+	Close();
+
+#if defined( _WIN32 )
+	DWORD const		flags	= ( access == SEQUENTIAL ) ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+	HANDLE const	file	= CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr );
+
+	if ( file == INVALID_HANDLE_VALUE )
+		return false;
+
+	LARGE_INTEGER	fileSize;
+
+	if ( GetFileSizeEx( file, &fileSize ) && fileSize.QuadPart > 0 )
+	{
+		HANDLE const	mapping	= CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+		if ( mapping != nullptr )
+		{
+			// The view keeps the mapping open after the handle is closed
+			m_data = static_cast< uint8_t const * >( MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) );
+			m_size = ( m_data != nullptr ) ? size_t( fileSize.QuadPart ) : 0;
+			CloseHandle( mapping );
+		}
+	}
+
+	CloseHandle( file );
+#else
+	int const	fd	= open( path, O_RDONLY );
+
+	if ( fd < 0 )
+		return false;
+
+	struct stat	status;
+
+	if ( fstat( fd, &status ) == 0 && status.st_size > 0 )
+	{
+		void * const	base	= mmap( nullptr, size_t( status.st_size ), PROT_READ, MAP_SHARED, fd, 0 );
+
+		if ( base != MAP_FAILED )
+		{
+			m_data = static_cast< uint8_t const * >( base );
+			m_size = size_t( status.st_size );
+			madvise( base, m_size, ( access == SEQUENTIAL ) ? MADV_SEQUENTIAL : MADV_RANDOM );
+		}
+	}
+
+	// The mapping stays valid after the file is closed
+	close( fd );
+#endif
+
+	return m_data != nullptr;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void MappedFile::Close()
+{
+	if ( m_data != nullptr )
+	{
+#if defined( _WIN32 )
+		UnmapViewOfFile( m_data );
+#else
+		munmap( const_cast< uint8_t * >( m_data ), m_size );
+#endif
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+}
+
+
+} // namespace Crypto
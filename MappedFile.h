@@ -0,0 +1,63 @@
+/********************************************************************************************************************
+
+                                                     MappedFile.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/MappedFile.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Crypto
+{
+
+
+// A file mapped read-only into memory
+
+class MappedFile
+{
+public:
+
+	// How the file will be accessed. This only affects read-ahead.
+	enum Access
+	{
+		RANDOM,
+		SEQUENTIAL
+	};
+
+	MappedFile() : m_data( nullptr ), m_size( 0 )	{}
+	~MappedFile()									{ Close(); }
+
+	// Maps a file. Returns false if the file cannot be opened or mapped, or is empty.
+	bool Open( char const * path, Access access );
+
+	// Unmaps the file
+	void Close();
+
+	// Returns the contents of the file, or nullptr if no file is mapped
+	uint8_t const * Data() const					{ return m_data; }
+
+	// Returns the size of the file
+	size_t Size() const								{ return m_size; }
+
+private:
+
+	// Non-copyable
+	MappedFile( MappedFile const & ) = delete;
+	MappedFile & operator =( MappedFile const & ) = delete;
+
+	uint8_t const *	m_data;
+	size_t			m_size;
+};
+
+
+} // namespace Crypto
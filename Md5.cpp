@@ -17,7 +17,7 @@
 #include "Common.h"
 
 #include <cstring>
-#include <xutility>
+#include <algorithm>
 
 
 namespace Crypto
@@ -28,18 +28,9 @@ namespace Crypto
 /*																													*/
 /********************************************************************************************************************/
 
-Md5::Md5()
-{
-	memset( &m_digest, 0, sizeof( m_digest ) );
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-Md5::~Md5()
+Md5::Md5( uint8_t const * pData, size_t size )
 {
+	Md5Calculator().Calculate( pData, size, m_digest );
 }
 
 
@@ -47,9 +38,9 @@ Md5::~Md5()
 /*																													*/
 /********************************************************************************************************************/
 
-Md5::Md5( unsigned __int8 const * pData, size_t size )
+Md5::Md5( std::string const & text )
 {
-	Md5Calculator().Calculate( pData, size, m_digest );
+	HexToBinary( text, m_digest, SIZE );
 }
 
 
@@ -57,7 +48,7 @@ Md5::Md5( unsigned __int8 const * pData, size_t size )
 /*																													*/
 /********************************************************************************************************************/
 
-Md5::Md5( std::string const & text )
+Md5::Md5( char const * text )
 {
 	HexToBinary( text, m_digest, SIZE );
 }
@@ -67,9 +58,9 @@ Md5::Md5( std::string const & text )
 /*																													*/
 /********************************************************************************************************************/
 
-Md5::Md5( char const * text )
+std::string Md5::ToString() const
 {
-	HexToBinary( text, m_digest, SIZE );
+	return BinaryToHex( m_digest, SIZE );
 }
 
 
@@ -77,9 +68,9 @@ Md5::Md5( char const * text )
 /*																													*/
 /********************************************************************************************************************/
 
-std::string Md5::ToString() const
+std::to_chars_result Md5::ToChars( char * first, char * last ) const
 {
-	return BinaryToHex( m_digest, SIZE );
+	return Crypto::ToChars( m_digest, SIZE, first, last );
 }
 
 
@@ -87,9 +78,9 @@ std::string Md5::ToString() const
 /*																													*/
 /********************************************************************************************************************/
 
-bool Md5::operator == ( Md5 const & y ) const
+std::from_chars_result Md5::FromChars( char const * first, char const * last, Md5 & value )
 {
-	return ( memcmp( m_digest, y.m_digest, sizeof( m_digest ) ) == 0 );
+	return Crypto::FromChars( first, last, value.m_digest, SIZE );
 }
 
 
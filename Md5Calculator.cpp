@@ -0,0 +1,263 @@
+/** @file *//********************************************************************************************************
+
+                                                  Md5Calculator.cpp
+
+						                    Copyright 2004, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Md5Calculator.cpp#3 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+// MD5.CC - source code for the C++/object oriented translation and
+//			modification of MD5.
+
+// Translation and modification ( c ) 1995 by Mordechai T. Abzug
+
+// This translation/ modification is provided "as is," without express or
+// implied warranty of any kind.
+
+// The translator/ modifier does not claim ( 1 ) that MD5 will do what you think
+// it does; ( 2 ) that this translation/ modification is accurate; or ( 3 ) that
+// this software is "merchantible."  ( Language for this disclaimer partially
+// copied from the disclaimer below ).
+
+/* based on:
+
+  MD5C.C - RSA Data Security, Inc., MD5 message-digest algorithm
+  MDDRIVER.C - test driver for MD2, MD4 and MD5
+
+
+	Copyright ( C ) 1991-2, RSA Data Security, Inc. Created 1991. All
+	rights reserved.
+
+	License to copy and use this software is granted provided that it
+	is identified as the "RSA Data Security, Inc. MD5 Message-Digest
+	Algorithm" in all material mentioning or referencing this software
+	or this function.
+
+	License is also granted to make and use derivative works provided
+	that such works are identified as "derived from the RSA Data
+	Security, Inc. MD5 Message-Digest Algorithm" in all material
+	mentioning or referencing the derived work.
+
+	RSA Data Security, Inc. makes no representations concerning either
+	the merchantability of this software or the suitability of this
+	software for any particular purpose. It is provided "as is"
+	without express or implied warranty of any kind.
+
+	These notices must be retained in any copies of any part of this
+	documentation and/or software.
+
+*/
+
+#include "Md5Calculator.h"
+
+#include "Common.h"
+#include "Kernels.h"
+
+#include <algorithm>
+#include <istream>
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+Md5Calculator::Md5Calculator()
+{
+	Reset();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Md5Calculator::Calculate( std::istream & stream, uint8_t * digest )
+{
+	Reset();  // must called by all constructors
+	Process( stream );
+	Finalize( digest );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Md5Calculator::Calculate( uint8_t const * string, size_t size, uint8_t * digest )
+{
+
+	Reset();  // must called by all constructors
+	Process( string, size );
+	Finalize( digest );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Md5Calculator::Process( uint8_t const * data, size_t size )
+{
+	// If there is already data in the buffer, then fill it.
+
+	if ( m_tail > 0 )
+	{
+		size_t	n	= std::min( sizeof( m_buffer ) - m_tail, size );
+		memcpy( &m_buffer[ m_tail ], data, n );
+
+		m_tail += int( n );
+		size -= n;
+		data += n;
+	}
+
+	// If the buffer is full, then process it first
+
+	if ( m_tail == sizeof( m_buffer ) )
+	{
+		ProcessChunks( m_buffer, 1 );
+		m_nProcessed += sizeof( m_buffer );
+
+		m_tail = 0;
+	}
+
+	// Process the whole chunks with a single call to the kernel. Less than a full chunk is left over, so Finalize()
+	// always has room to append the 1 bit.
+
+	if ( size >= sizeof( m_buffer ) )
+	{
+		size_t const	n	= size / sizeof( m_buffer );
+
+		ProcessChunks( data, n );
+		m_nProcessed += n * sizeof( m_buffer );
+
+		size -= n * sizeof( m_buffer );
+		data += n * sizeof( m_buffer );
+	}
+
+	// Put the leftover data in the buffer
+
+	if ( size > 0 )
+	{
+		memcpy( m_buffer, data, size );
+		m_tail = int( size );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Md5Calculator::Process( std::istream & stream )
+{
+	// Append to any data already in the buffer
+
+	if ( stream.good() )
+	{
+		stream.read( reinterpret_cast<char*>( &m_buffer[m_tail] ), sizeof( m_buffer ) - m_tail );
+		m_tail += stream.gcount();
+	}
+
+	// Repeatedly process and reload the buffer until the end of the file is reached. If the buffer is not full
+	// when the end is reached, then just leave the data in it.
+
+	while ( m_tail == sizeof( m_buffer ) )
+	{
+		// Process the buffer
+
+		ProcessChunks( m_buffer, 1 );
+		m_nProcessed += sizeof( m_buffer );
+		m_tail = 0;
+
+		// Reload the buffer
+
+		if ( stream.good() )
+		{
+			stream.read( reinterpret_cast<char*>( m_buffer ), sizeof( m_buffer ) );
+			m_tail = stream.gcount();
+		}
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Md5Calculator::Finalize( uint8_t * digest )
+{
+	// Process the last chunk. The last chunk has a 1 bit (0x80 byte) appended, then is padded to 448 bits,
+	// and then has a 64-bit size (of the data in bits) appended.
+
+	// Append the 1 bit
+
+	m_buffer[ m_tail ] = 0x80;
+	++m_tail;
+
+	// If the buffer has more than 56 bytes (including the appended 1 bit), it must be processed in two chunks
+	// because there is not enough room for the appended size.
+
+	// If the buffer has more than 56 bytes (including the appended 1 bit), process the first chunk.
+
+	if ( m_tail > int( sizeof( m_buffer ) - sizeof( uint64_t ) ) )
+	{
+		// Pad to the end of the chunk
+		memset( &m_buffer[ m_tail ], 0, sizeof( m_buffer )-m_tail );
+
+		ProcessChunks( m_buffer, 1 );
+		m_nProcessed += m_tail-1;	// -1 because we don't want to include the appended 1 bit
+
+		m_tail = 0;
+	}
+	else
+	{
+		m_nProcessed += m_tail-1;	// -1 because we don't want to include the appended 1 bit
+	}
+
+	// Pad to the end of the chunk
+	memset( &m_buffer[ m_tail ], 0, sizeof( m_buffer ) - m_tail );
+
+	// Append the size (of the data in bits) 
+
+	StoreLittleEndian64( m_buffer + sizeof( m_buffer ) - sizeof( uint64_t ), static_cast< uint64_t >( m_nProcessed ) * 8 );
+
+	// Process the final chunk
+
+	ProcessChunks( m_buffer, 1 );
+
+	// Return the digest as little-endian words
+
+	for ( int i = 0; i < DIGEST_SIZE_IN_WORDS; ++i )
+	{
+		StoreLittleEndian32( digest + i * 4, m_digest[i] );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Md5Calculator::Reset()
+{
+	m_digest[ 0 ] = 0x67452301;
+	m_digest[ 1 ] = 0xefcdab89;
+	m_digest[ 2 ] = 0x98badcfe;
+	m_digest[ 3 ] = 0x10325476;
+
+	m_tail			= 0;
+	m_nProcessed	= 0;
+
+	m_kernel		= Kernels::Get( KernelRegistry::MD5 );
+}
+
+
+} // namespace Crypto
\ No newline at end of file
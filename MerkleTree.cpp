@@ -0,0 +1,437 @@
+/********************************************************************************************************************
+
+                                                    MerkleTree.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/MerkleTree.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "MerkleTree.h"
+
+#include "Common.h"
+#include "MultiBufferHash.h"
+#include "Sha256Calculator.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+
+using namespace Crypto::MultiBufferHash;
+
+
+size_t const	NODE_SIZE	= 1 + 2 * Crypto::Sha256::SIZE;	// Size of the message of an interior node
+
+// Writes the padded message of an interior node, which is two blocks
+
+void PadNode( Crypto::Sha256 const & left, Crypto::Sha256 const & right, uint8_t * message )
+{
+	memset( message, 0, 2 * BLOCK_SIZE );
+	message[0] = 0x01;
+	memcpy( message + 1, left.m_value, Crypto::Sha256::SIZE );
+	memcpy( message + 1 + Crypto::Sha256::SIZE, right.m_value, Crypto::Sha256::SIZE );
+	message[ NODE_SIZE ] = 0x80;
+	Crypto::StoreBigEndian64( message + 2 * BLOCK_SIZE - 8, NODE_SIZE * 8 );
+}
+
+// Hashes up to eight interior nodes, in the lanes if there are enough of them
+
+void HashGroup( Crypto::Sha256 const * const * lefts, Crypto::Sha256 const * const * rights,
+				Crypto::Sha256 * const * parents, size_t count, Function const & f )
+{
+	uint8_t	message[ 2 * BLOCK_SIZE ];
+
+	if ( f.lanes != nullptr && count >= size_t( f.minimum ) )
+	{
+		uint32_t	words[ 2 ][ 16 * LANES ];
+		uint32_t	state[ 8 * LANES ];
+
+		// Unused lanes hash the first node again
+
+		for ( size_t j = 0; j < size_t( LANES ); ++j )
+		{
+			size_t const	k	= ( j < count ) ? j : 0;
+
+			PadNode( *lefts[k], *rights[k], message );
+			for ( int w = 0; w < 16; ++w )
+			{
+				words[0][ w * LANES + j ] = Crypto::LoadBigEndian32( message + w * 4 );
+				words[1][ w * LANES + j ] = Crypto::LoadBigEndian32( message + BLOCK_SIZE + w * 4 );
+			}
+		}
+
+		for ( int w = 0; w < 8; ++w )
+		{
+			std::fill( state + w * LANES, state + ( w + 1 ) * LANES, f.initial[w] );
+		}
+
+		f.lanes( state, words[0] );
+		f.lanes( state, words[1] );
+
+		for ( size_t j = 0; j < count; ++j )
+		{
+			StoreState( state + j, 8, LANES, parents[j]->m_value );
+		}
+		return;
+	}
+
+	for ( size_t j = 0; j < count; ++j )
+	{
+		uint32_t	state[ 8 ];
+
+		PadNode( *lefts[j], *rights[j], message );
+		std::copy( f.initial, f.initial + 8, state );
+		f.kernel( state, message, sizeof( message ) );
+		StoreState( state, 8, 1, parents[j]->m_value );
+	}
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+MerkleTree::MerkleTree()
+	: m_size( 0 )
+{
+	Allocate( 0 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	leaves	Hashes of the leaves, as returned by HashLeaf()
+//! @param	count	Number of leaves
+
+void MerkleTree::Build( Sha256 const * leaves, size_t count )
+{
+	Allocate( count );
+	std::copy( leaves, leaves + count, m_nodes.begin() );
+
+	for ( size_t level = 1; level + 1 < m_offsets.size(); ++level )
+	{
+		Recompute( level, nullptr, m_offsets[ level + 1 ] - m_offsets[ level ] );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	index	Index of the leaf
+//! @param	data	Record
+//! @param	size	Size of the record
+
+void MerkleTree::SetLeaf( size_t index, uint8_t const * data, size_t size )
+{
+	SetLeaf( index, HashLeaf( data, size ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	index	Index of the leaf
+//! @param	hash	Hash of the leaf, as returned by HashLeaf()
+
+void MerkleTree::SetLeaf( size_t index, Sha256 const & hash )
+{
+	m_nodes[ index ] = hash;
+	m_dirty.push_back( index );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The parents of the changed nodes of one level are the changed nodes of the next level. Since the list is sorted,
+//! it shrinks in place as the paths merge.
+
+void MerkleTree::Update()
+{
+	std::sort( m_dirty.begin(), m_dirty.end() );
+	m_dirty.erase( std::unique( m_dirty.begin(), m_dirty.end() ), m_dirty.end() );
+
+	for ( size_t level = 1; level + 1 < m_offsets.size() && !m_dirty.empty(); ++level )
+	{
+		for ( size_t & index : m_dirty )
+		{
+			index /= 2;
+		}
+		m_dirty.erase( std::unique( m_dirty.begin(), m_dirty.end() ), m_dirty.end() );
+
+		Recompute( level, m_dirty.data(), m_dirty.size() );
+	}
+
+	m_dirty.clear();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+Sha256 MerkleTree::Root() const
+{
+	if ( m_size == 0 )
+		return Sha256::Of( "" );
+
+	return m_nodes.back();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	index	Index of the leaf
+//! @param	proof	Where to put the hashes of the siblings. A node without a sibling adds nothing.
+
+bool MerkleTree::Prove( size_t index, std::vector< Sha256 > & proof ) const
+{
+	if ( index >= m_size || !m_dirty.empty() )
+		return false;
+
+	proof.clear();
+
+	for ( size_t level = 0; level + 2 < m_offsets.size(); ++level )
+	{
+		size_t const	sibling	= index ^ 1;
+
+		if ( sibling < m_offsets[ level + 1 ] - m_offsets[ level ] )
+			proof.push_back( m_nodes[ m_offsets[ level ] + sibling ] );
+		index /= 2;
+	}
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	root		Root of the tree
+//! @param	size		Number of leaves in the tree
+//! @param	index		Index of the leaf
+//! @param	leaf		Hash of the leaf
+//! @param	proof		Hashes of the siblings, as returned by Prove()
+//! @param	proofSize	Number of hashes in the proof
+//!
+//! This is the verification algorithm of RFC 9162. index and last follow the path up the tree, and a level is
+//! skipped when the node is the last one of its level and has no sibling.
+
+bool MerkleTree::Verify( Sha256 const & root, size_t size, size_t index, Sha256 const & leaf, Sha256 const * proof,
+						 size_t proofSize )
+{
+	if ( index >= size )
+		return false;
+
+	size_t	last	= size - 1;
+	Sha256	hash	= leaf;
+
+	for ( size_t i = 0; i < proofSize; ++i )
+	{
+		if ( last == 0 )
+			return false;
+
+		if ( ( index & 1 ) != 0 || index == last )
+		{
+			hash = HashNode( proof[i], hash );
+			while ( ( index & 1 ) == 0 && index != 0 )
+			{
+				index /= 2;
+				last /= 2;
+			}
+		}
+		else
+		{
+			hash = HashNode( hash, proof[i] );
+		}
+
+		index /= 2;
+		last /= 2;
+	}
+
+	return last == 0 && hash == root;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Record
+//! @param	size	Size of the record
+
+Sha256 MerkleTree::HashLeaf( uint8_t const * data, size_t size )
+{
+	uint8_t const		prefix	= 0x00;
+	Sha256Calculator	calculator;
+	Sha256				hash;
+
+	calculator.Process( &prefix, 1 );
+	calculator.Process( data, size );
+	calculator.Finalize( hash.m_value );
+
+	return hash;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Records
+//! @param	sizes	Size of each record
+//! @param	count	Number of records
+//! @param	leaves	Where to put the hash of each leaf
+//!
+//! Each leaf is a message of two segments, the prefix and the record, so the records are not copied.
+
+void MerkleTree::HashLeaves( uint8_t const * const * data, size_t const * sizes, size_t count, Sha256 * leaves )
+{
+	static uint8_t const	PREFIX	= 0x00;
+	Function const			f		= Select( KernelRegistry::SHA256 );
+	std::vector< Segment >	segments( count * 2 );
+	std::vector< Message >	messages( count );
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		segments[ i * 2 ]		= Segment( &PREFIX, 1 );
+		segments[ i * 2 + 1 ]	= Segment( data[i], sizes[i] );
+		Start( &segments[ i * 2 ], 1 + sizes[i], leaves[i].m_value, messages[i] );
+	}
+
+	MultiBufferHash::Hash( f, messages.data(), count );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	left	Hash of the left child
+//! @param	right	Hash of the right child
+
+Sha256 MerkleTree::HashNode( Sha256 const & left, Sha256 const & right )
+{
+	Sha256 const *	pLeft	= &left;
+	Sha256 const *	pRight	= &right;
+	Sha256			parent;
+	Sha256 *		pParent	= &parent;
+
+	HashGroup( &pLeft, &pRight, &pParent, 1, Select( KernelRegistry::SHA256 ) );
+
+	return parent;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	lefts		Hashes of the left children
+//! @param	rights		Hashes of the right children
+//! @param	parents		Where to put the hashes of the nodes
+//! @param	count		Number of nodes
+//!
+//! The nodes are hashed in groups of eight, like the levels of a MerkleTree.
+
+void MerkleTree::HashNodes( Sha256 const * const * lefts, Sha256 const * const * rights, Sha256 * const * parents,
+							size_t count )
+{
+	Function const	f	= Select( KernelRegistry::SHA256 );
+
+	for ( size_t i = 0; i < count; i += LANES )
+	{
+		HashGroup( lefts + i, rights + i, parents + i, std::min( count - i, size_t( LANES ) ), f );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void MerkleTree::Allocate( size_t size )
+{
+	m_size = size;
+	m_offsets.assign( 1, 0 );
+	m_dirty.clear();
+
+	size_t	total	= size;
+
+	for ( size_t n = size; n > 1; n = ( n + 1 ) / 2 )
+	{
+		m_offsets.push_back( total );
+		total += ( n + 1 ) / 2;
+	}
+
+	m_offsets.push_back( total );
+	m_nodes.resize( total );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void MerkleTree::Recompute( size_t level, size_t const * parents, size_t count )
+{
+	Function const		f			= Select( KernelRegistry::SHA256 );
+	Sha256 * const		above		= &m_nodes[ m_offsets[ level ] ];
+	Sha256 const *		below		= &m_nodes[ m_offsets[ level - 1 ] ];
+	size_t const		belowSize	= m_offsets[ level ] - m_offsets[ level - 1 ];
+	Sha256 const *		lefts[ LANES ];
+	Sha256 const *		rights[ LANES ];
+	Sha256 *			group[ LANES ];
+	size_t				n			= 0;
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		size_t const	parent	= ( parents != nullptr ) ? parents[i] : i;
+
+		// A node without a sibling is moved up unchanged
+
+		if ( 2 * parent + 1 >= belowSize )
+		{
+			above[ parent ] = below[ 2 * parent ];
+			continue;
+		}
+
+		lefts[n] = &below[ 2 * parent ];
+		rights[n] = &below[ 2 * parent + 1 ];
+		group[n] = &above[ parent ];
+		if ( ++n == size_t( LANES ) )
+		{
+			HashGroup( lefts, rights, group, n, f );
+			n = 0;
+		}
+	}
+
+	if ( n > 0 )
+		HashGroup( lefts, rights, group, n, f );
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,324 @@
+/********************************************************************************************************************
+
+                                                 MultiBufferHash.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/MultiBufferHash.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "MultiBufferHash.h"
+
+#include "Common.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+
+
+using namespace Crypto::MultiBufferHash;
+
+// Returns true if the active kernel of an algorithm is a given one
+
+bool IsActive( Crypto::KernelRegistry::Algorithm algorithm, char const * kernel )
+{
+	return strcmp( Crypto::KernelRegistry::Active( algorithm ), kernel ) == 0;
+}
+
+// Returns the active x8 kernel of an algorithm, or nullptr if it is the portable one
+
+Crypto::Kernels::LaneFunction Lanes( Crypto::KernelRegistry::Algorithm algorithm )
+{
+	return IsActive( algorithm, "generic" ) ? nullptr : Crypto::Kernels::GetLanes( algorithm );
+}
+
+// Moves past the bytes of a message that were just used, stepping to the next segment at the end of one
+
+void Advance( Message & message, size_t size )
+{
+	message.offset += size;
+	if ( message.offset == message.segment->second )
+	{
+		++message.segment;
+		message.offset = 0;
+	}
+}
+
+// Copies the next bytes of a message, which may span segments
+
+void Read( Message & message, uint8_t * buffer, size_t size )
+{
+	while ( size > 0 )
+	{
+		size_t const	n	= std::min( size, message.segment->second - message.offset );
+
+		memcpy( buffer, message.segment->first + message.offset, n );
+		buffer += n;
+		size -= n;
+		Advance( message, n );
+	}
+}
+
+// Returns the next block of a message and moves past it. It is read straight from the segment if it is all there,
+// and otherwise it is put together in the buffer from the segments and the padding.
+
+uint8_t const * Block( Message & message, uint8_t * buffer )
+{
+	uint64_t const	offset	= message.next * BLOCK_SIZE;
+
+	++message.next;
+
+	if ( offset + BLOCK_SIZE <= message.size )
+	{
+		if ( message.segment->second - message.offset >= size_t( BLOCK_SIZE ) )
+		{
+			uint8_t const * const	block	= message.segment->first + message.offset;
+
+			Advance( message, BLOCK_SIZE );
+			return block;
+		}
+
+		Read( message, buffer, BLOCK_SIZE );
+		return buffer;
+	}
+
+	memset( buffer, 0, BLOCK_SIZE );
+
+	// The padding is 0x80, 0's and the size in bits, which may be in the block after the 0x80
+
+	if ( message.size >= offset )
+	{
+		Read( message, buffer, size_t( message.size - offset ) );
+		buffer[ message.size - offset ] = 0x80;
+	}
+	if ( message.next == message.blocks )
+		Crypto::StoreBigEndian64( buffer + BLOCK_SIZE - 8, ( message.prefix + message.size ) * 8 );
+
+	return buffer;
+}
+
+// Returns the state a message starts from
+
+uint32_t const * Initial( Function const & f, Message const & message )
+{
+	return ( message.initial != nullptr ) ? message.initial : f.initial;
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+namespace MultiBufferHash
+{
+
+
+uint32_t const	SHA1_INITIAL[ 5 ]	= { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+uint32_t const	SHA256_INITIAL[ 8 ]	=
+{
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The lanes are used as described in MultiBufferHash.h
+
+Function Select( KernelRegistry::Algorithm algorithm )
+{
+	Function	f;
+
+	if ( algorithm == KernelRegistry::SHA1 )
+	{
+		f.kernel	= Kernels::Get( KernelRegistry::SHA1 );
+		f.lanes		= Lanes( KernelRegistry::SHA1X8 );
+		f.initial	= SHA1_INITIAL;
+		f.words		= 5;
+		f.minimum	= IsActive( KernelRegistry::SHA1, "shani" ) ? LANES / 2 : 2;
+	}
+	else
+	{
+		f.kernel	= Kernels::Get( KernelRegistry::SHA256 );
+		f.lanes		= IsActive( KernelRegistry::SHA256, "shani" ) ? nullptr : Lanes( KernelRegistry::SHA256X8 );
+		f.initial	= SHA256_INITIAL;
+		f.words		= 8;
+		f.minimum	= 2;
+	}
+
+	return f;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Start( Segment const * segments, uint64_t size, uint8_t * digest, Message & message, uint32_t const * initial,
+			uint64_t prefix )
+{
+	message.segment	= segments;
+	message.offset	= 0;
+	message.size	= size;
+	message.prefix	= prefix;
+	message.blocks	= ( size + 8 ) / BLOCK_SIZE + 1;
+	message.next	= 0;
+	message.initial	= initial;
+	message.digest	= digest;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Hash( Function const & f, Message * messages, size_t count )
+{
+	size_t	next	= 0;
+
+	if ( f.lanes != nullptr && count >= size_t( f.minimum ) )
+	{
+		Message *	lanes[ LANES ]					= { nullptr };
+		uint32_t	state[ MAX_WORDS * LANES ];
+		uint32_t	words[ 16 * LANES ]				= { 0 };
+		uint8_t		buffer[ BLOCK_SIZE ];
+		int			running							= 0;
+
+		auto const	start	= [ & ] ( int lane )
+							  {
+								  uint32_t const * const	initial	= Initial( f, messages[ next ] );
+
+								  lanes[ lane ] = &messages[ next++ ];
+								  for ( int i = 0; i < f.words; ++i )
+								  {
+									  state[ i * LANES + lane ] = initial[i];
+								  }
+							  };
+
+		for ( int lane = 0; lane < LANES && next < count; ++lane )
+		{
+			start( lane );
+			++running;
+		}
+
+		while ( running >= f.minimum )
+		{
+			for ( int lane = 0; lane < LANES; ++lane )
+			{
+				if ( lanes[ lane ] != nullptr )
+				{
+					uint8_t const * const	block	= Block( *lanes[ lane ], buffer );
+
+					for ( int i = 0; i < 16; ++i )
+					{
+						words[ i * LANES + lane ] = LoadBigEndian32( block + i * 4 );
+					}
+				}
+			}
+
+			f.lanes( state, words );
+
+			for ( int lane = 0; lane < LANES; ++lane )
+			{
+				if ( lanes[ lane ] != nullptr && lanes[ lane ]->next == lanes[ lane ]->blocks )
+				{
+					StoreState( state + lane, f.words, LANES, lanes[ lane ]->digest );
+					if ( next < count )
+					{
+						start( lane );
+					}
+					else
+					{
+						lanes[ lane ] = nullptr;
+						--running;
+					}
+				}
+			}
+		}
+
+		// Finish the messages left in the lanes one at a time
+
+		for ( int lane = 0; lane < LANES; ++lane )
+		{
+			if ( lanes[ lane ] != nullptr )
+			{
+				uint32_t	single[ MAX_WORDS ];
+
+				for ( int i = 0; i < f.words; ++i )
+				{
+					single[i] = state[ i * LANES + lane ];
+				}
+				Finish( f, single, *lanes[ lane ] );
+				StoreState( single, f.words, 1, lanes[ lane ]->digest );
+			}
+		}
+	}
+
+	for ( ; next < count; ++next )
+	{
+		uint32_t			single[ MAX_WORDS ];
+		uint32_t const *	initial	= Initial( f, messages[ next ] );
+
+		std::copy( initial, initial + f.words, single );
+		Finish( f, single, messages[ next ] );
+		StoreState( single, f.words, 1, messages[ next ].digest );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A run of whole blocks in one segment is hashed with one call to the kernel
+
+void Finish( Function const & f, uint32_t * state, Message & message )
+{
+	uint8_t	buffer[ BLOCK_SIZE ];
+
+	while ( message.next < message.blocks )
+	{
+		uint64_t const	offset	= message.next * BLOCK_SIZE;
+		uint64_t		n		= 0;
+
+		if ( offset < message.size )
+			n = std::min( uint64_t( message.segment->second - message.offset ), message.size - offset ) / BLOCK_SIZE;
+
+		if ( n > 0 )
+		{
+			f.kernel( state, message.segment->first + message.offset, size_t( n * BLOCK_SIZE ) );
+			Advance( message, size_t( n * BLOCK_SIZE ) );
+			message.next += n;
+		}
+		else
+		{
+			f.kernel( state, Block( message, buffer ), BLOCK_SIZE );
+		}
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void StoreState( uint32_t const * state, int words, size_t step, uint8_t * digest )
+{
+	for ( int i = 0; i < words; ++i )
+	{
+		StoreBigEndian32( digest + i * 4, state[ i * step ] );
+	}
+}
+
+
+} // namespace MultiBufferHash
+} // namespace Crypto
@@ -0,0 +1,94 @@
+/********************************************************************************************************************
+
+                                                  MultiBufferHash.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/MultiBufferHash.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "Kernels.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+
+namespace Crypto
+{
+namespace MultiBufferHash
+{
+
+
+// Hashes many SHA-1 or SHA-256 messages at once with the x8 kernels, which compress one block for each of eight
+// independent messages.
+//
+// Each lane hashes one message, and a lane that finishes its message starts the next one, so messages of different
+// sizes keep the lanes busy. Once there are not enough messages left to fill the lanes, the rest are finished one at
+// a time with the regular kernel.
+//
+// The x8 kernels are selected by the KernelRegistry (SHA1X8 and SHA256X8). The lanes are only worth using if the
+// regular kernel is slower than them, so they are not used with the portable x8 kernel, which hashes the lanes one at
+// a time. The SHA extensions are about as fast on one message as AVX2 is on eight SHA-256 messages or four SHA-1
+// messages, so with them the SHA-256 lanes are not used and the SHA-1 lanes are only used while at least four are
+// busy.
+
+int const		BLOCK_SIZE	= 64;	// Size of a block of the compression function
+int const		LANES		= 8;	// Number of lanes in the x8 kernels
+int const		MAX_WORDS	= 8;	// Size of the largest digest in words
+
+extern uint32_t const	SHA1_INITIAL[ 5 ];		// Initial state of SHA-1
+extern uint32_t const	SHA256_INITIAL[ 8 ];	// Initial state of SHA-256
+
+typedef std::pair< uint8_t const *, size_t >	Segment;	// Part of a message and its size
+
+// The parts of a hash function used for a batch
+
+struct Function
+{
+	Kernels::Function		kernel;		// Compresses blocks of one message
+	Kernels::LaneFunction	lanes;		// Compresses one block in each of eight lanes, or nullptr
+	uint32_t const *		initial;	// Initial state
+	int						words;		// Size of the digest in words
+	int						minimum;	// Smallest number of messages worth hashing in the lanes
+};
+
+// A message being hashed, which is made of one or more segments
+
+struct Message
+{
+	Segment const *		segment;	// Segment being read
+	size_t				offset;		// Offset of the next byte in the segment
+	uint64_t			size;		// Size of the message, not counting the prefix
+	uint64_t			prefix;		// Size of the data already hashed into the initial state
+	uint64_t			blocks;		// Number of blocks, with the padding
+	uint64_t			next;		// Next block to hash
+	uint32_t const *	initial;	// Initial state, or nullptr for the initial state of the hash
+	uint8_t *			digest;		// Where to put the digest
+};
+
+// Returns the functions for SHA-1 or SHA-256
+Function Select( KernelRegistry::Algorithm algorithm );
+
+// Sets up a message. A message can continue a hash whose state after prefix bytes is initial. The prefix must be a
+// multiple of the block size.
+void Start( Segment const * segments, uint64_t size, uint8_t * digest, Message & message,
+			uint32_t const * initial = nullptr, uint64_t prefix = 0 );
+
+// Hashes the messages
+void Hash( Function const & f, Message * messages, size_t count );
+
+// Hashes the rest of a message with the regular kernel
+void Finish( Function const & f, uint32_t * state, Message & message );
+
+// Stores a state as a digest. step is the distance between the words.
+void StoreState( uint32_t const * state, int words, size_t step, uint8_t * digest );
+
+} // namespace MultiBufferHash
+} // namespace Crypto
@@ -0,0 +1,294 @@
+/********************************************************************************************************************
+
+                                                  MultipartETag.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/MultipartETag.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "MultipartETag.h"
+
+#include "Crc32Calculator.h"
+#include "Md5Calculator.h"
+
+#include <algorithm>
+
+
+namespace
+{
+
+
+size_t const	SLICE_SIZE	= 64 * 1024;	// Amount of a part hashed by both hashes before moving on
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	threads		Number of threads hashing parts. It is at least 1.
+
+MultipartETag::MultipartETag( unsigned threads )
+	: m_pending( 0 ),
+	m_stop( false )
+{
+	for ( unsigned i = 0; i < std::max( threads, 1u ); ++i )
+	{
+		m_threads.emplace_back( &MultipartETag::Work, this );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+MultipartETag::~MultipartETag()
+{
+	{
+		std::lock_guard< std::mutex >	lock( m_mutex );
+
+		m_stop = true;
+	}
+
+	m_queued.notify_all();
+	for ( std::thread & thread : m_threads )
+	{
+		thread.join();
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	number	Part number, from 1 to MAX_PART_NUMBER. The numbers do not have to be consecutive.
+//! @param	data	Contents of the part
+//! @param	size	Size of the part
+
+bool MultipartETag::AddPart( uint32_t number, uint8_t const * data, size_t size )
+{
+	if ( number == 0 || number > MAX_PART_NUMBER )
+		return false;
+
+	{
+		std::lock_guard< std::mutex >	lock( m_mutex );
+
+		if ( m_parts.size() < number )
+			m_parts.resize( number, Part{ Md5(), 0, 0, false } );
+
+		Part &	part	= m_parts[ number - 1 ];
+
+		if ( part.added )
+			return false;
+
+		part.added	= true;
+		part.size	= size;
+		m_jobs.push_back( Job{ number, data, size } );
+		++m_pending;
+	}
+
+	m_queued.notify_one();
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void MultipartETag::Wait()
+{
+	std::unique_lock< std::mutex >	lock( m_mutex );
+
+	m_finished.wait( lock, [ this ] { return m_pending == 0; } );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	number	Part number
+//! @param	digest	MD5 digest of the part (output)
+
+bool MultipartETag::PartMd5( uint32_t number, Md5 & digest )
+{
+	Wait();
+
+	std::lock_guard< std::mutex >	lock( m_mutex );
+
+	if ( number == 0 || number > m_parts.size() || !m_parts[ number - 1 ].added )
+		return false;
+
+	digest = m_parts[ number - 1 ].md5;
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! An object uploaded in parts has at least one part, so there is no ETag if no parts have been added.
+
+std::string MultipartETag::ETag()
+{
+	Wait();
+
+	std::lock_guard< std::mutex >	lock( m_mutex );
+	Md5Calculator					calculator;
+	uint32_t						count		= 0;
+	Md5								digest;
+
+	for ( Part const & part : m_parts )
+	{
+		if ( part.added )
+		{
+			calculator.Process( part.md5.m_digest, Md5::SIZE );
+			++count;
+		}
+	}
+
+	if ( count == 0 )
+		return std::string();
+
+	calculator.Finalize( digest.m_digest );
+
+	return digest.ToString() + "-" + std::to_string( count );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The CRC-32 of each part is appended to the CRC-32 of the parts before it.
+
+uint32_t MultipartETag::Crc32()
+{
+	Wait();
+
+	std::lock_guard< std::mutex >	lock( m_mutex );
+	uint32_t						crc		= 0;
+
+	for ( Part const & part : m_parts )
+	{
+		if ( part.added )
+			crc = Crc32Calculator::Combine( crc, part.crc, part.size );
+	}
+
+	return crc;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+uint64_t MultipartETag::Size()
+{
+	std::lock_guard< std::mutex >	lock( m_mutex );
+	uint64_t						size	= 0;
+
+	for ( Part const & part : m_parts )
+	{
+		size += part.size;
+	}
+
+	return size;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+uint32_t MultipartETag::PartCount()
+{
+	std::lock_guard< std::mutex >	lock( m_mutex );
+
+	return uint32_t( std::count_if( m_parts.begin(), m_parts.end(), []( Part const & part ) { return part.added; } ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void MultipartETag::Reset()
+{
+	Wait();
+
+	std::lock_guard< std::mutex >	lock( m_mutex );
+
+	m_parts.clear();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Each part is hashed outside the lock, so the threads only hold it to take a job and to store its result.
+
+void MultipartETag::Work()
+{
+	std::unique_lock< std::mutex >	lock( m_mutex );
+
+	for ( ;; )
+	{
+		m_queued.wait( lock, [ this ] { return m_stop || !m_jobs.empty(); } );
+
+		if ( m_jobs.empty() )
+			return;
+
+		Job const	job	= m_jobs.front();
+
+		m_jobs.pop_front();
+		lock.unlock();
+
+		Md5Calculator	md5;
+		Crc32Calculator	crc;
+		Md5				digest;
+		uint32_t		value;
+
+		for ( size_t offset = 0; offset < job.size; offset += SLICE_SIZE )
+		{
+			size_t const	n	= std::min( job.size - offset, SLICE_SIZE );
+
+			md5.Process( job.data + offset, n );
+			crc.Process( job.data + offset, n );
+		}
+
+		md5.Finalize( digest.m_digest );
+		crc.Finalize( &value );
+
+		lock.lock();
+
+		Part &	part	= m_parts[ job.number - 1 ];
+
+		part.md5	= digest;
+		part.crc	= value;
+
+		if ( --m_pending == 0 )
+			m_finished.notify_all();
+	}
+}
+
+
+} // namespace Crypto
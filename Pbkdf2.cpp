@@ -0,0 +1,350 @@
+/********************************************************************************************************************
+
+                                                      Pbkdf2.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Pbkdf2.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Pbkdf2.h"
+
+#include "Common.h"
+#include "MultiBufferHash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+
+
+using namespace Crypto::MultiBufferHash;
+
+// One block of a derived key
+
+struct Job
+{
+	Crypto::Pbkdf2::Request const *	request;
+	size_t							index;					// Index of the block in the key
+	uint32_t						inner[ MAX_WORDS ];		// State after the password XORed with the inner pad
+	uint32_t						outer[ MAX_WORDS ];		// State after the password XORed with the outer pad
+	uint32_t						u[ MAX_WORDS ];			// Output of the latest iteration
+	uint32_t						t[ MAX_WORDS ];			// XOR of the outputs of all the iterations
+};
+
+// Processes the rest of a message and its padding. total is the size of the whole message, including any blocks that
+// were already processed.
+
+void Finish( Function const & f, uint32_t * state, uint8_t const * data, size_t size, uint64_t total )
+{
+	size_t const	whole	= size - size % BLOCK_SIZE;
+	uint8_t			block[ 2 * BLOCK_SIZE ]	= { 0 };
+
+	f.kernel( state, data, whole );
+	data += whole;
+	size -= whole;
+
+	// The padding is 0x80, 0's and the size in bits, which spills into a second block if it does not fit
+
+	size_t const	n	= ( size + 9 <= size_t( BLOCK_SIZE ) ) ? BLOCK_SIZE : 2 * BLOCK_SIZE;
+
+	memcpy( block, data, size );
+	block[ size ] = 0x80;
+	Crypto::StoreBigEndian64( block + n - 8, total * 8 );
+
+	f.kernel( state, block, n );
+}
+
+// Computes the states after the password XORed with the inner and outer pads. A password longer than a block is
+// hashed first.
+
+void Pads( Function const & f, uint8_t const * password, size_t size, uint32_t * inner, uint32_t * outer )
+{
+	uint8_t	block[ BLOCK_SIZE ]	= { 0 };
+
+	if ( size > size_t( BLOCK_SIZE ) )
+	{
+		uint32_t	state[ MAX_WORDS ];
+
+		std::copy( f.initial, f.initial + f.words, state );
+		Finish( f, state, password, size, size );
+		StoreState( state, f.words, 1, block );
+	}
+	else if ( size > 0 )
+	{
+		memcpy( block, password, size );
+	}
+
+	for ( int i = 0; i < BLOCK_SIZE; ++i )
+	{
+		block[i] ^= 0x36;
+	}
+
+	std::copy( f.initial, f.initial + f.words, inner );
+	f.kernel( inner, block, BLOCK_SIZE );
+
+	for ( int i = 0; i < BLOCK_SIZE; ++i )
+	{
+		block[i] ^= 0x36 ^ 0x5c;
+	}
+
+	std::copy( f.initial, f.initial + f.words, outer );
+	f.kernel( outer, block, BLOCK_SIZE );
+}
+
+// Does the first iteration, U1 = HMAC( password, salt || index ), where the index starts at 1
+
+void First( Function const & f, Job & job )
+{
+	Crypto::Pbkdf2::Request const &	request	= *job.request;
+	std::vector< uint8_t >			message( request.saltSize + 4 );
+	uint8_t							digest[ MAX_WORDS * 4 ];
+	uint32_t						state[ MAX_WORDS ];
+
+	std::copy( request.salt, request.salt + request.saltSize, message.begin() );
+	Crypto::StoreBigEndian32( message.data() + request.saltSize, uint32_t( job.index + 1 ) );
+
+	std::copy( job.inner, job.inner + f.words, state );
+	Finish( f, state, message.data(), message.size(), BLOCK_SIZE + message.size() );
+	StoreState( state, f.words, 1, digest );
+
+	std::copy( job.outer, job.outer + f.words, job.u );
+	Finish( f, job.u, digest, f.words * 4, BLOCK_SIZE + f.words * 4 );
+
+	std::copy( job.u, job.u + f.words, job.t );
+}
+
+// Does the rest of the iterations for one job. The message of each hash is the digest of the previous one, so the
+// block's padding is set up once.
+
+void Iterate( Function const & f, Job & job, uint32_t count )
+{
+	uint8_t			block[ BLOCK_SIZE ]	= { 0 };
+	size_t const	size				= f.words * 4;
+	uint32_t		state[ MAX_WORDS ];
+
+	block[ size ] = 0x80;
+	Crypto::StoreBigEndian64( block + BLOCK_SIZE - 8, ( BLOCK_SIZE + size ) * 8 );
+
+	for ( uint32_t n = 0; n < count; ++n )
+	{
+		StoreState( job.u, f.words, 1, block );
+		std::copy( job.inner, job.inner + f.words, state );
+		f.kernel( state, block, BLOCK_SIZE );
+
+		StoreState( state, f.words, 1, block );
+		std::copy( job.outer, job.outer + f.words, job.u );
+		f.kernel( job.u, block, BLOCK_SIZE );
+
+		for ( int i = 0; i < f.words; ++i )
+		{
+			job.t[i] ^= job.u[i];
+		}
+	}
+}
+
+// Does the rest of the iterations for eight jobs at once, one in each lane. The words of the message are kept as
+// words, so the state of each hash is copied straight into the message of the next.
+
+void IterateLanes( Function const & f, Job * const * jobs, uint32_t count )
+{
+	uint32_t	inner[ MAX_WORDS * LANES ];
+	uint32_t	outer[ MAX_WORDS * LANES ];
+	uint32_t	t[ MAX_WORDS * LANES ];
+	uint32_t	state[ MAX_WORDS * LANES ];
+	uint32_t	words[ 16 * LANES ]	= { 0 };
+	size_t const	size			= f.words * LANES;
+
+	for ( int j = 0; j < LANES; ++j )
+	{
+		for ( int i = 0; i < f.words; ++i )
+		{
+			inner[ i * LANES + j ]	= jobs[j]->inner[i];
+			outer[ i * LANES + j ]	= jobs[j]->outer[i];
+			t[ i * LANES + j ]		= jobs[j]->t[i];
+			words[ i * LANES + j ]	= jobs[j]->u[i];
+		}
+
+		words[ f.words * LANES + j ]	= 0x80000000;
+		words[ 15 * LANES + j ]			= uint32_t( ( BLOCK_SIZE + f.words * 4 ) * 8 );
+	}
+
+	for ( uint32_t n = 0; n < count; ++n )
+	{
+		std::copy( inner, inner + size, state );
+		f.lanes( state, words );
+		std::copy( state, state + size, words );
+
+		std::copy( outer, outer + size, state );
+		f.lanes( state, words );
+		std::copy( state, state + size, words );
+
+		for ( size_t i = 0; i < size; ++i )
+		{
+			t[i] ^= state[i];
+		}
+	}
+
+	for ( int j = 0; j < LANES; ++j )
+	{
+		for ( int i = 0; i < f.words; ++i )
+		{
+			jobs[j]->t[i] = t[ i * LANES + j ];
+		}
+	}
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	hash			Hash function
+//! @param	password		Password
+//! @param	passwordSize	Size of the password
+//! @param	salt			Salt
+//! @param	saltSize		Size of the salt
+//! @param	iterations		Number of iterations. It is at least 1.
+//! @param	key				Where to put the derived key
+//! @param	keySize			Size of the derived key
+//!
+//! A key longer than the digest is made of several blocks, which are computed in separate lanes.
+
+void Pbkdf2::Derive( Hash hash, uint8_t const * password, size_t passwordSize, uint8_t const * salt,
+					 size_t saltSize, uint32_t iterations, uint8_t * key, size_t keySize )
+{
+	Request const	request	= { password, passwordSize, salt, saltSize, key, keySize };
+
+	DeriveBatch( hash, &request, 1, iterations );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	hash		Hash function
+//! @param	requests	Passwords, salts and keys
+//! @param	count		Number of requests
+//! @param	iterations	Number of iterations. It is at least 1.
+//!
+//! Each block of each key is a separate job, and the jobs are done eight at a time in the lanes of the x8 kernels. Jobs
+//! left over at the end are done one at a time with the regular kernel if that is faster.
+
+void Pbkdf2::DeriveBatch( Hash hash, Request const * requests, size_t count, uint32_t iterations )
+{
+	Function const		f		= Select( ( hash == SHA1 ) ? KernelRegistry::SHA1 : KernelRegistry::SHA256 );
+	size_t const		digest	= f.words * 4;
+	std::vector< Job >	jobs;
+	size_t				total	= 0;
+
+	for ( size_t r = 0; r < count; ++r )
+	{
+		total += ( requests[r].keySize + digest - 1 ) / digest;
+	}
+	jobs.reserve( total );
+
+	for ( size_t r = 0; r < count; ++r )
+	{
+		Request const &	request	= requests[r];
+		size_t const	blocks	= ( request.keySize + digest - 1 ) / digest;
+		Job				job;
+
+		job.request = &request;
+		Pads( f, request.password, request.passwordSize, job.inner, job.outer );
+
+		for ( size_t i = 0; i < blocks; ++i )
+		{
+			job.index = i;
+			First( f, job );
+			jobs.push_back( job );
+		}
+	}
+
+	uint32_t const	rest	= ( iterations > 1 ) ? iterations - 1 : 0;
+	size_t			i		= 0;
+
+	if ( f.lanes != nullptr )
+	{
+		// Unused lanes repeat the first job of the group and their results are discarded
+
+		for ( ; jobs.size() - i >= size_t( f.minimum ); i += LANES )
+		{
+			Job		copies[ LANES ];
+			Job *	group[ LANES ];
+			size_t const	n	= std::min( jobs.size() - i, size_t( LANES ) );
+
+			for ( size_t j = 0; j < size_t( LANES ); ++j )
+			{
+				if ( j < n )
+				{
+					group[j] = &jobs[ i + j ];
+				}
+				else
+				{
+					copies[j] = jobs[i];
+					group[j] = &copies[j];
+				}
+			}
+
+			IterateLanes( f, group, rest );
+
+			if ( n < size_t( LANES ) )
+			{
+				i += n;
+				break;
+			}
+		}
+	}
+
+	for ( ; i < jobs.size(); ++i )
+	{
+		Iterate( f, jobs[i], rest );
+	}
+
+	// Each block of the key is the big-endian XOR of the iterations. The last one may be cut short.
+
+	for ( Job const & job : jobs )
+	{
+		uint8_t			block[ MAX_WORDS * 4 ];
+		size_t const	offset	= job.index * digest;
+
+		StoreState( job.t, f.words, 1, block );
+		memcpy( job.request->key + offset, block, std::min( digest, job.request->keySize - offset ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	hash		Hash function
+//! @param	saltSize	Size of the salt
+//! @param	keySize		Size of the derived key
+//!
+//! Each block of the key is a job, and the salt is copied once with the index of a block appended to it.
+
+size_t Pbkdf2::ScratchSize( Hash hash, size_t saltSize, size_t keySize )
+{
+	size_t const	digest	= ( hash == SHA1 ) ? 20 : 32;
+
+	return ( keySize + digest - 1 ) / digest * sizeof( Job ) + saltSize + 4;
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,237 @@
+/********************************************************************************************************************
+
+                                              RollingChecksumKernels.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/RollingChecksumKernels.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Kernels.h"
+
+#if CRYPTO_X86
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+
+// Rolls the window from position first to position count - 1 one byte at a time. a and b are the sums for the window
+// at first. candidates must already be cleared.
+
+void Scan( uint8_t const * data, size_t window, size_t first, size_t count, uint32_t a, uint32_t b,
+		   uint32_t const * filter, int filterBits, uint32_t * weaks, uint64_t * candidates )
+{
+	for ( size_t k = first; k < count; ++k )
+	{
+		uint32_t const	weak	= ( a & 0xffff ) | ( b << 16 );
+		uint32_t const	bit		= ( weak * 0x9e3779b1 ) >> ( 32 - filterBits );
+
+		weaks[k] = weak;
+		candidates[ k / 64 ] |= uint64_t( ( filter[ bit >> 5 ] >> ( bit & 31 ) ) & 1 ) << ( k % 64 );
+
+		if ( k + 1 < count )
+		{
+			uint32_t const	out	= data[k];
+			uint32_t const	in	= data[ k + window ];
+
+			a += in - out;
+			b += a - uint32_t( window ) * out;
+		}
+	}
+}
+
+#if CRYPTO_X86
+
+// Returns the inclusive prefix sums of the 8 32-bit lanes
+
+CRYPTO_TARGET( "avx2" )
+inline __m256i PrefixSum( __m256i x )
+{
+	x = _mm256_add_epi32( x, _mm256_slli_si256( x, 4 ) );
+	x = _mm256_add_epi32( x, _mm256_slli_si256( x, 8 ) );
+
+	// Add the total of the low half to the high half
+
+	__m256i const	low	= _mm256_permutevar8x32_epi32( x, _mm256_set1_epi32( 3 ) );
+
+	return _mm256_add_epi32( x, _mm256_blend_epi32( _mm256_setzero_si256(), low, 0xf0 ) );
+}
+
+#endif // CRYPTO_X86
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+namespace Kernels
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The sums are only needed modulo 2^16, so they are allowed to wrap
+
+uint32_t RollingChecksumGeneric( uint8_t const * data, size_t size )
+{
+	uint32_t	a	= 0;
+	uint32_t	b	= 0;
+
+	for ( size_t i = 0; i < size; ++i )
+	{
+		a += data[i];
+		b += a;
+	}
+
+	return ( a & 0xffff ) | ( b << 16 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void RollingChecksumScanGeneric( uint8_t const * data, size_t window, size_t count, uint32_t weak,
+								 uint32_t const * filter, int filterBits, uint32_t * weaks, uint64_t * candidates )
+{
+	for ( size_t i = 0; i < ( count + 63 ) / 64; ++i )
+	{
+		candidates[i] = 0;
+	}
+
+	Scan( data, window, 0, count, weak & 0xffff, weak >> 16, filter, filterBits, weaks, candidates );
+}
+
+
+#if CRYPTO_X86
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Processes 32 bytes at a time. Over 32 bytes, a grows by the sum of the bytes and b grows by 32 times the previous a
+// plus the bytes weighted 32, 31, ..., 1. The previous values of a are summed separately and multiplied by 32 at the
+// end.
+
+CRYPTO_TARGET( "avx2" )
+uint32_t RollingChecksumAvx2( uint8_t const * data, size_t size )
+{
+	__m256i const	weights		= _mm256_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+													16, 15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1 );
+	__m256i const	ones		= _mm256_set1_epi16( 1 );
+	__m256i const	zero		= _mm256_setzero_si256();
+	__m256i			sums		= zero;		// a, in 64-bit lanes
+	__m256i			previous	= zero;		// Sum of the values of a before each group, in 64-bit lanes
+	__m256i			weighted	= zero;		// Weighted sums, in 32-bit lanes
+
+	for ( ; size >= 32; size -= 32, data += 32 )
+	{
+		__m256i const	x	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( data ) );
+
+		previous	= _mm256_add_epi64( previous, sums );
+		sums		= _mm256_add_epi64( sums, _mm256_sad_epu8( x, zero ) );
+		weighted	= _mm256_add_epi32( weighted, _mm256_madd_epi16( _mm256_maddubs_epi16( x, weights ), ones ) );
+	}
+
+	// Add up the lanes
+
+	__m128i const	s	= _mm_add_epi64( _mm256_castsi256_si128( sums ), _mm256_extracti128_si256( sums, 1 ) );
+	__m128i const	p	= _mm_add_epi64( _mm256_castsi256_si128( previous ), _mm256_extracti128_si256( previous, 1 ) );
+	__m128i			w	= _mm_add_epi32( _mm256_castsi256_si128( weighted ), _mm256_extracti128_si256( weighted, 1 ) );
+
+	w = _mm_add_epi32( w, _mm_shuffle_epi32( w, 0x4e ) );
+	w = _mm_add_epi32( w, _mm_shuffle_epi32( w, 0xb1 ) );
+
+	uint32_t	a	= uint32_t( _mm_cvtsi128_si32( s ) ) + uint32_t( _mm_extract_epi32( s, 2 ) );
+	uint32_t	b	= ( uint32_t( _mm_cvtsi128_si32( p ) ) + uint32_t( _mm_extract_epi32( p, 2 ) ) ) * 32
+					  + uint32_t( _mm_cvtsi128_si32( w ) );
+
+	// Finish the rest one byte at a time
+
+	for ( size_t i = 0; i < size; ++i )
+	{
+		a += data[i];
+		b += a;
+	}
+
+	return ( a & 0xffff ) | ( b << 16 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Rolls the window 8 bytes at a time. With d[m] = in[m] - out[m] and P its prefix sums, the sum of the bytes in the
+// window at m is a + P[m] - d[m]. Each step adds the new sum of the bytes minus window * out[m] to the running sum,
+// so with Q the prefix sums of P - window * out, the running sum at m is b + m * a + Q[m] - ( P[m] - window * out[m] ).
+// The sums for the next group only depend on the previous sums through two additions, and the filter is looked up
+// with a gather.
+
+CRYPTO_TARGET( "avx2" )
+void RollingChecksumScanAvx2( uint8_t const * data, size_t window, size_t count, uint32_t weak,
+							  uint32_t const * filter, int filterBits, uint32_t * weaks, uint64_t * candidates )
+{
+	for ( size_t i = 0; i < ( count + 63 ) / 64; ++i )
+	{
+		candidates[i] = 0;
+	}
+
+	__m256i const	steps		= _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+	__m256i const	last		= _mm256_set1_epi32( 7 );
+	__m256i const	size		= _mm256_set1_epi32( int( window ) );
+	__m256i const	low			= _mm256_set1_epi32( 0xffff );
+	__m256i const	one			= _mm256_set1_epi32( 1 );
+	__m256i const	multiplier	= _mm256_set1_epi32( int( 0x9e3779b1 ) );
+	__m128i const	shift		= _mm_cvtsi32_si128( 32 - filterBits );
+	__m256i			a			= _mm256_set1_epi32( int( weak & 0xffff ) );
+	__m256i			b			= _mm256_set1_epi32( int( weak >> 16 ) );
+	size_t			k			= 0;
+
+	// Each group also reads the byte that rolls the window to the next group, so the last group is done one byte at a
+	// time
+
+	for ( ; k + 8 < count; k += 8 )
+	{
+		__m256i const	out		= _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast< __m128i const * >( data + k ) ) );
+		__m256i const	in		= _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast< __m128i const * >( data + k + window ) ) );
+		__m256i const	d		= _mm256_sub_epi32( in, out );
+		__m256i const	p		= PrefixSum( d );
+		__m256i const	e		= _mm256_sub_epi32( p, _mm256_mullo_epi32( out, size ) );
+		__m256i const	q		= PrefixSum( e );
+		__m256i const	sums	= _mm256_add_epi32( a, _mm256_sub_epi32( p, d ) );
+		__m256i const	running	= _mm256_add_epi32( b, _mm256_add_epi32( _mm256_mullo_epi32( steps, a ), _mm256_sub_epi32( q, e ) ) );
+		__m256i const	weaks8	= _mm256_or_si256( _mm256_and_si256( sums, low ), _mm256_slli_epi32( running, 16 ) );
+
+		_mm256_storeu_si256( reinterpret_cast< __m256i * >( weaks + k ), weaks8 );
+
+		__m256i const	bit		= _mm256_srl_epi32( _mm256_mullo_epi32( weaks8, multiplier ), shift );
+		__m256i const	words	= _mm256_i32gather_epi32( reinterpret_cast< int const * >( filter ), _mm256_srli_epi32( bit, 5 ), 4 );
+		__m256i const	found	= _mm256_and_si256( _mm256_srlv_epi32( words, _mm256_and_si256( bit, _mm256_set1_epi32( 31 ) ) ), one );
+		int const		mask	= _mm256_movemask_ps( _mm256_castsi256_ps( _mm256_slli_epi32( found, 31 ) ) );
+
+		candidates[ k / 64 ] |= uint64_t( mask ) << ( k % 64 );
+
+		b = _mm256_add_epi32( b, _mm256_add_epi32( _mm256_permutevar8x32_epi32( q, last ), _mm256_slli_epi32( a, 3 ) ) );
+		a = _mm256_add_epi32( a, _mm256_permutevar8x32_epi32( p, last ) );
+	}
+
+	Scan( data, window, k, count, uint32_t( _mm256_cvtsi256_si32( a ) ), uint32_t( _mm256_cvtsi256_si32( b ) ),
+		  filter, filterBits, weaks, candidates );
+}
+
+#endif // CRYPTO_X86
+
+
+} // namespace Kernels
+} // namespace Crypto
@@ -0,0 +1,214 @@
+/********************************************************************************************************************
+
+                                                      Scrypt.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Scrypt.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Scrypt.h"
+
+#include "Common.h"
+#include "Kernels.h"
+#include "Pbkdf2.h"
+
+#include <algorithm>
+#include <new>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+
+
+size_t const	ALIGNMENT	= 64;	// Alignment of the arena
+
+// Mixes blocks first, first + step, first + 2 * step, ... of the p blocks
+
+void Mix( Crypto::Kernels::RomixFunction romix, uint32_t * blocks, uint32_t r, uint64_t n, uint32_t p, size_t first,
+		  size_t step, uint32_t * v )
+{
+	for ( size_t i = first; i < p; i += step )
+	{
+		romix( blocks + i * 32 * r, r, n, v );
+	}
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	maxMemory	Maximum memory allocated during a call, including the arena
+//! @param	threads		Maximum number of threads mixing blocks at once. It is at least 1.
+
+Scrypt::Scrypt( size_t maxMemory, unsigned threads )
+	: m_maxMemory( maxMemory )
+	, m_threads( std::max( threads, 1u ) )
+	, m_arena( nullptr )
+	, m_arenaSize( 0 )
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+Scrypt::~Scrypt()
+{
+	Release();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	password		Password
+//! @param	passwordSize	Size of the password
+//! @param	salt			Salt
+//! @param	saltSize		Size of the salt
+//! @param	n				CPU/memory cost. It must be a power of 2 greater than 1 and less than 2^( 16 * r ).
+//! @param	r				Block size
+//! @param	p				Parallelization
+//! @param	key				Where to put the derived key
+//! @param	keySize			Size of the derived key
+//!
+//! The arena is kept for the next call. It is enlarged if it is too small for the number of threads used, and it is
+//! made smaller if it no longer fits in the limit along with the 256 * r * p bytes of the blocks being mixed and the
+//! scratch space of PBKDF2.
+
+bool Scrypt::Derive( uint8_t const * password, size_t passwordSize, uint8_t const * salt, size_t saltSize, uint64_t n,
+					 uint32_t r, uint32_t p, uint8_t * key, size_t keySize )
+{
+	size_t const	perBlock	= MemoryPerBlock( n, r );
+
+	if ( perBlock == 0 || p == 0 || uint64_t( r ) * p >= ( uint64_t( 1 ) << 30 ) )
+		return false;
+
+	// The p blocks are held twice (as bytes and as words) besides the arena, and PBKDF2 needs scratch space while it
+	// expands the password into the blocks and while it derives the key from them. They count against the limit too.
+
+	uint64_t const	blocksSize	= uint64_t( 128 ) * r * p;
+	uint64_t const	scratch		= std::max( Pbkdf2::ScratchSize( Pbkdf2::SHA256, saltSize, size_t( blocksSize ) ),
+											Pbkdf2::ScratchSize( Pbkdf2::SHA256, size_t( blocksSize ), keySize ) );
+	uint64_t const	fixed		= 2 * blocksSize + scratch;
+
+	if ( fixed > m_maxMemory || perBlock > m_maxMemory - fixed )
+		return false;
+
+	// Use as many threads as the rest of the memory limit allows
+
+	size_t const	available	= size_t( m_maxMemory - fixed );
+	size_t const	threads		= std::min( { size_t( m_threads ), size_t( p ), available / perBlock } );
+	size_t const	needed		= threads * perBlock;
+
+	if ( m_arenaSize < needed || m_arenaSize > available )
+	{
+		Release();
+		m_arena = ::operator new( needed, std::align_val_t( ALIGNMENT ) );
+		m_arenaSize = needed;
+	}
+
+	// B = PBKDF2( password, salt, 1, p * 128 * r ), as little-endian words
+
+	size_t const			words	= 32 * size_t( r );
+	std::vector< uint8_t >	b( p * words * 4 );
+	std::vector< uint32_t >	blocks( p * words );
+
+	Pbkdf2::Derive( Pbkdf2::SHA256, password, passwordSize, salt, saltSize, 1, b.data(), b.size() );
+	for ( size_t i = 0; i < blocks.size(); ++i )
+	{
+		blocks[i] = LoadLittleEndian32( &b[ i * 4 ] );
+	}
+
+	// Thread t mixes blocks t, t + threads, t + 2 * threads, ... in its part of the arena
+
+	Kernels::RomixFunction const	romix	= Kernels::GetRomix();
+	uint8_t * const					arena	= static_cast< uint8_t * >( m_arena );
+	std::vector< std::thread >		workers;
+
+	for ( size_t t = 1; t < threads; ++t )
+	{
+		workers.emplace_back( Mix, romix, blocks.data(), r, n, p, t, threads,
+							  reinterpret_cast< uint32_t * >( arena + t * perBlock ) );
+	}
+	Mix( romix, blocks.data(), r, n, p, 0, threads, reinterpret_cast< uint32_t * >( arena ) );
+	for ( std::thread & worker : workers )
+	{
+		worker.join();
+	}
+
+	// DK = PBKDF2( password, B, 1, keySize )
+
+	for ( size_t i = 0; i < blocks.size(); ++i )
+	{
+		StoreLittleEndian32( &b[ i * 4 ], blocks[i] );
+	}
+
+	Pbkdf2::Derive( Pbkdf2::SHA256, password, passwordSize, b.data(), b.size(), 1, key, keySize );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	n	CPU/memory cost. It must be a power of 2 greater than 1 and less than 2^( 16 * r ).
+//! @param	r	Block size. It must be at least 1.
+//!
+//! The size is a multiple of 128 bytes, so each thread's part of the arena stays aligned.
+
+size_t Scrypt::MemoryPerBlock( uint64_t n, uint32_t r )
+{
+	if ( n < 2 || ( n & ( n - 1 ) ) != 0 || r == 0 )
+		return 0;
+
+	// RFC 7914 requires n < 2^( 128 * r / 8 ), which only limits n if r < 4
+
+	if ( r < 4 && n >= ( uint64_t( 1 ) << ( 16 * r ) ) )
+		return 0;
+
+	// 128 * r * ( n + 2 ) must fit in a size_t
+
+	uint64_t const	blockSize	= uint64_t( 128 ) * r;
+
+	if ( n + 2 > uint64_t( SIZE_MAX ) / blockSize )
+		return 0;
+
+	return size_t( blockSize * ( n + 2 ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Scrypt::Release()
+{
+	if ( m_arena != nullptr )
+	{
+		::operator delete( m_arena, std::align_val_t( ALIGNMENT ) );
+		m_arena = nullptr;
+		m_arenaSize = 0;
+	}
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,287 @@
+/********************************************************************************************************************
+
+                                                  ScryptKernels.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/ScryptKernels.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Kernels.h"
+
+#include "Common.h"
+
+#include <cstring>
+#include <utility>
+
+#if CRYPTO_X86
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+
+// Does one quarter of a Salsa20 double round
+
+inline void Quarter( uint32_t * x, int a, int b, int c, int d )
+{
+	x[b] ^= Crypto::rotl( x[a] + x[d], 7 );
+	x[c] ^= Crypto::rotl( x[b] + x[a], 9 );
+	x[d] ^= Crypto::rotl( x[c] + x[b], 13 );
+	x[a] ^= Crypto::rotl( x[d] + x[c], 18 );
+}
+
+// Replaces a 64-byte block with its Salsa20/8 hash
+
+void Salsa208( uint32_t * b )
+{
+	uint32_t	x[ 16 ];
+
+	memcpy( x, b, sizeof( x ) );
+
+	for ( int i = 0; i < 8; i += 2 )
+	{
+		Quarter( x, 0, 4, 8, 12 );
+		Quarter( x, 5, 9, 13, 1 );
+		Quarter( x, 10, 14, 2, 6 );
+		Quarter( x, 15, 3, 7, 11 );
+
+		Quarter( x, 0, 1, 2, 3 );
+		Quarter( x, 5, 6, 7, 4 );
+		Quarter( x, 10, 11, 8, 9 );
+		Quarter( x, 15, 12, 13, 14 );
+	}
+
+	for ( int i = 0; i < 16; ++i )
+	{
+		b[i] += x[i];
+	}
+}
+
+// Computes y = BlockMix( a ). The even blocks of the result go in the first half of y and the odd blocks in the
+// second half.
+
+void BlockMix( uint32_t const * a, uint32_t * y, size_t r )
+{
+	uint32_t	x[ 16 ];
+
+	memcpy( x, a + ( 2 * r - 1 ) * 16, sizeof( x ) );
+
+	for ( size_t i = 0; i < 2 * r; ++i )
+	{
+		for ( int k = 0; k < 16; ++k )
+		{
+			x[k] ^= a[ i * 16 + k ];
+		}
+
+		Salsa208( x );
+		memcpy( y + ( ( i & 1 ) * r + i / 2 ) * 16, x, sizeof( x ) );
+	}
+}
+
+#if CRYPTO_X86
+
+// The SSE2 kernel keeps each 64-byte block with its words in the order 0, 5, 10, 15, 4, 9, 14, 3, 8, 13, 2, 7, 12, 1,
+// 6, 11 (word i * 5 % 16 at position i). In that order, the columns and rows of the Salsa20 matrix line up with the
+// four registers after a rotation of three of them, so each step of a quarter round is done on four words at once.
+
+CRYPTO_TARGET( "sse2" )
+inline __m128i RotateLeft( __m128i x, int n )
+{
+	return _mm_or_si128( _mm_slli_epi32( x, n ), _mm_srli_epi32( x, 32 - n ) );
+}
+
+// Computes y = BlockMix( a ^ b ) in the SSE2 order. b may be nullptr.
+
+CRYPTO_TARGET( "sse2" )
+void BlockMixSse2( __m128i const * a, __m128i const * b, __m128i * y, size_t r )
+{
+	size_t const	last	= ( 2 * r - 1 ) * 4;
+	__m128i			x0		= a[ last + 0 ];
+	__m128i			x1		= a[ last + 1 ];
+	__m128i			x2		= a[ last + 2 ];
+	__m128i			x3		= a[ last + 3 ];
+
+	if ( b != nullptr )
+	{
+		x0 = _mm_xor_si128( x0, b[ last + 0 ] );
+		x1 = _mm_xor_si128( x1, b[ last + 1 ] );
+		x2 = _mm_xor_si128( x2, b[ last + 2 ] );
+		x3 = _mm_xor_si128( x3, b[ last + 3 ] );
+	}
+
+	for ( size_t i = 0; i < 2 * r; ++i )
+	{
+		x0 = _mm_xor_si128( x0, a[ i * 4 + 0 ] );
+		x1 = _mm_xor_si128( x1, a[ i * 4 + 1 ] );
+		x2 = _mm_xor_si128( x2, a[ i * 4 + 2 ] );
+		x3 = _mm_xor_si128( x3, a[ i * 4 + 3 ] );
+
+		if ( b != nullptr )
+		{
+			x0 = _mm_xor_si128( x0, b[ i * 4 + 0 ] );
+			x1 = _mm_xor_si128( x1, b[ i * 4 + 1 ] );
+			x2 = _mm_xor_si128( x2, b[ i * 4 + 2 ] );
+			x3 = _mm_xor_si128( x3, b[ i * 4 + 3 ] );
+		}
+
+		__m128i const	t0	= x0;
+		__m128i const	t1	= x1;
+		__m128i const	t2	= x2;
+		__m128i const	t3	= x3;
+
+		for ( int k = 0; k < 8; k += 2 )
+		{
+			// Columns
+
+			x1 = _mm_xor_si128( x1, RotateLeft( _mm_add_epi32( x0, x3 ), 7 ) );
+			x2 = _mm_xor_si128( x2, RotateLeft( _mm_add_epi32( x1, x0 ), 9 ) );
+			x3 = _mm_xor_si128( x3, RotateLeft( _mm_add_epi32( x2, x1 ), 13 ) );
+			x0 = _mm_xor_si128( x0, RotateLeft( _mm_add_epi32( x3, x2 ), 18 ) );
+
+			x1 = _mm_shuffle_epi32( x1, 0x93 );
+			x2 = _mm_shuffle_epi32( x2, 0x4e );
+			x3 = _mm_shuffle_epi32( x3, 0x39 );
+
+			// Rows
+
+			x3 = _mm_xor_si128( x3, RotateLeft( _mm_add_epi32( x0, x1 ), 7 ) );
+			x2 = _mm_xor_si128( x2, RotateLeft( _mm_add_epi32( x3, x0 ), 9 ) );
+			x1 = _mm_xor_si128( x1, RotateLeft( _mm_add_epi32( x2, x3 ), 13 ) );
+			x0 = _mm_xor_si128( x0, RotateLeft( _mm_add_epi32( x1, x2 ), 18 ) );
+
+			x1 = _mm_shuffle_epi32( x1, 0x39 );
+			x2 = _mm_shuffle_epi32( x2, 0x4e );
+			x3 = _mm_shuffle_epi32( x3, 0x93 );
+		}
+
+		x0 = _mm_add_epi32( x0, t0 );
+		x1 = _mm_add_epi32( x1, t1 );
+		x2 = _mm_add_epi32( x2, t2 );
+		x3 = _mm_add_epi32( x3, t3 );
+
+		__m128i * const	out	= y + ( ( i & 1 ) * r + i / 2 ) * 4;
+
+		out[0] = x0;
+		out[1] = x1;
+		out[2] = x2;
+		out[3] = x3;
+	}
+}
+
+#endif // CRYPTO_X86
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+namespace Kernels
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// V[0] is a copy of the block and each following entry is BlockMix of the previous one, so the first loop needs no
+// other copies.
+
+void ScryptRomixGeneric( uint32_t * block, size_t r, uint64_t n, uint32_t * v )
+{
+	size_t const	words	= 32 * r;
+	uint32_t *		x		= v + n * words;
+	uint32_t *		y		= x + words;
+
+	memcpy( v, block, words * sizeof( uint32_t ) );
+	for ( uint64_t i = 0; i + 1 < n; ++i )
+	{
+		BlockMix( v + i * words, v + ( i + 1 ) * words, r );
+	}
+	BlockMix( v + ( n - 1 ) * words, x, r );
+
+	for ( uint64_t i = 0; i < n; ++i )
+	{
+		uint32_t const *	last	= x + words - 16;
+		uint64_t const		j		= ( last[0] | ( uint64_t( last[1] ) << 32 ) ) & ( n - 1 );
+		uint32_t const *	vj		= v + j * words;
+
+		for ( size_t k = 0; k < words; ++k )
+		{
+			x[k] ^= vj[k];
+		}
+
+		BlockMix( x, y, r );
+		std::swap( x, y );
+	}
+
+	memcpy( block, x, words * sizeof( uint32_t ) );
+}
+
+
+#if CRYPTO_X86
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The block is converted to the SSE2 order on the way in and back on the way out. The XOR with V[j] is folded into
+// BlockMix.
+
+CRYPTO_TARGET( "sse2" )
+void ScryptRomixSse2( uint32_t * block, size_t r, uint64_t n, uint32_t * v )
+{
+	size_t const	words	= 32 * r;
+	uint32_t *		x		= v + n * words;
+	__m128i *		vv		= reinterpret_cast< __m128i * >( v );
+	__m128i *		xx		= reinterpret_cast< __m128i * >( x );
+	__m128i *		yy		= xx + words / 4;
+
+	for ( size_t k = 0; k < 2 * r; ++k )
+	{
+		for ( int i = 0; i < 16; ++i )
+		{
+			v[ k * 16 + i ] = block[ k * 16 + i * 5 % 16 ];
+		}
+	}
+
+	for ( uint64_t i = 0; i + 1 < n; ++i )
+	{
+		BlockMixSse2( vv + i * words / 4, nullptr, vv + ( i + 1 ) * words / 4, r );
+	}
+	BlockMixSse2( vv + ( n - 1 ) * words / 4, nullptr, xx, r );
+
+	// Word 0 of the last block is at position 0 and word 1 is at position 13
+
+	for ( uint64_t i = 0; i < n; ++i )
+	{
+		uint32_t const *	last	= reinterpret_cast< uint32_t const * >( xx ) + words - 16;
+		uint64_t const		j		= ( last[0] | ( uint64_t( last[13] ) << 32 ) ) & ( n - 1 );
+
+		BlockMixSse2( xx, vv + j * words / 4, yy, r );
+		std::swap( xx, yy );
+	}
+
+	uint32_t const *	result	= reinterpret_cast< uint32_t const * >( xx );
+
+	for ( size_t k = 0; k < 2 * r; ++k )
+	{
+		for ( int i = 0; i < 16; ++i )
+		{
+			block[ k * 16 + i * 5 % 16 ] = result[ k * 16 + i ];
+		}
+	}
+}
+
+#endif // CRYPTO_X86
+
+
+} // namespace Kernels
+} // namespace Crypto
@@ -17,7 +17,7 @@
 #include "Common.h"
 
 #include <cstring>
-#include <xutility>
+#include <algorithm>
 
 
 namespace Crypto
@@ -28,26 +28,7 @@ namespace Crypto
 /*																													*/
 /********************************************************************************************************************/
 
-Sha1::Sha1()
-{
-	memset( &m_value, 0, sizeof m_value );
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-Sha1::~Sha1()
-{
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-Sha1::Sha1( unsigned __int8 const * pData, size_t size )
+Sha1::Sha1( uint8_t const * pData, size_t size )
 {
 	Sha1Calculator().Calculate( pData, size, m_value );
 }
@@ -97,9 +78,19 @@ std::string Sha1::ToString() const
 /*																													*/
 /********************************************************************************************************************/
 
-bool Sha1::operator == ( Sha1 const & y ) const
+std::to_chars_result Sha1::ToChars( char * first, char * last ) const
+{
+	return Crypto::ToChars( m_value, SIZE, first, last );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::from_chars_result Sha1::FromChars( char const * first, char const * last, Sha1 & value )
 {
-	return ( memcmp( m_value, y.m_value, sizeof( m_value ) ) == 0 );
+	return Crypto::FromChars( first, last, value.m_value, SIZE );
 }
 
 
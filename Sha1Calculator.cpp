@@ -14,7 +14,8 @@
 #include "Sha1Calculator.h"
 
 #include "Common.h"
-#include <xutility>
+#include "Kernels.h"
+#include <algorithm>
 #include <istream>
 
 //	SHA-256 computation algorithm as documented by Wikipedia: http://en.wikipedia.org/wiki/SHA
@@ -123,7 +124,7 @@ Sha1Calculator::Sha1Calculator()
 /*																													*/
 /********************************************************************************************************************/
 
-void Sha1Calculator::Calculate( unsigned __int8 const * data, size_t size, unsigned __int8 * digest )
+void Sha1Calculator::Calculate( uint8_t const * data, size_t size, uint8_t * digest )
 {
 	Reset();
 	Process( data, size );
@@ -135,7 +136,7 @@ void Sha1Calculator::Calculate( unsigned __int8 const * data, size_t size, unsig
 /*																													*/
 /********************************************************************************************************************/
 
-void Sha1Calculator::Calculate( std::istream & stream, unsigned __int8 * digest )
+void Sha1Calculator::Calculate( std::istream & stream, uint8_t * digest )
 {
 	Reset();
 	Process( stream );
@@ -157,6 +158,8 @@ void Sha1Calculator::Reset()
 
 	m_tail			= 0;
 	m_nProcessed	= 0;
+
+	m_kernel		= Kernels::Get( KernelRegistry::SHA1 );
 }
 
 
@@ -164,7 +167,7 @@ void Sha1Calculator::Reset()
 /*																													*/
 /********************************************************************************************************************/
 
-void Sha1Calculator::Process( unsigned __int8 const * data, size_t size )
+void Sha1Calculator::Process( uint8_t const * data, size_t size )
 {
 	// If there is already data in the buffer, then fill it.
 
@@ -182,21 +185,24 @@ void Sha1Calculator::Process( unsigned __int8 const * data, size_t size )
 
 	if ( m_tail == sizeof( m_buffer ) )
 	{
-		ProcessChunk( m_buffer );
+		ProcessChunks( m_buffer, 1 );
 		m_nProcessed += sizeof( m_buffer );
 
 		m_tail = 0;
 	}
 
-	// Process one chunk at a time
+	// Process the whole chunks with a single call to the kernel. Less than a full chunk is left over, so Finalize()
+	// always has room to append the 1 bit.
 
-	while ( size > sizeof( m_buffer ) )
+	if ( size >= sizeof( m_buffer ) )
 	{
-		ProcessChunk( data );
-		m_nProcessed += sizeof( m_buffer );
+		size_t const	n	= size / sizeof( m_buffer );
+
+		ProcessChunks( data, n );
+		m_nProcessed += n * sizeof( m_buffer );
 
-		size -= sizeof( m_buffer );
-		data += sizeof( m_buffer );
+		size -= n * sizeof( m_buffer );
+		data += n * sizeof( m_buffer );
 	}
 
 	// Put the leftover data in the buffer
@@ -230,7 +236,7 @@ void Sha1Calculator::Process( std::istream & stream )
 	{
 		// Process the buffer
 
-		ProcessChunk( m_buffer );
+		ProcessChunks( m_buffer, 1 );
 		m_nProcessed += sizeof( m_buffer );
 		m_tail = 0;
 
@@ -249,7 +255,7 @@ void Sha1Calculator::Process( std::istream & stream )
 /*																													*/
 /********************************************************************************************************************/
 
-void Sha1Calculator::Finalize( unsigned __int8 * digest )
+void Sha1Calculator::Finalize( uint8_t * digest )
 {
 	// Process the last chunk. The last chunk has a 1 bit (0x80 byte) appended, then is padded to 448 bits,
 	// and then has a 64-bit size (of the data in bits) appended.
@@ -264,12 +270,12 @@ void Sha1Calculator::Finalize( unsigned __int8 * digest )
 
 	// If the buffer has more than 56 bytes (including the appended 1 bit), process the first chunk.
 
-	if ( m_tail > sizeof( m_buffer )-sizeof( unsigned __int64 ) )
+	if ( m_tail > int( sizeof( m_buffer ) - sizeof( uint64_t ) ) )
 	{
 		// Pad to the end of the chunk
 		memset( &m_buffer[ m_tail ], 0, sizeof( m_buffer )-m_tail );
 
-		ProcessChunk( m_buffer );
+		ProcessChunks( m_buffer, 1 );
 		m_nProcessed += m_tail-1;	// -1 because we don't want to include the appended 1 bit
 
 		m_tail = 0;
@@ -284,96 +290,18 @@ void Sha1Calculator::Finalize( unsigned __int8 * digest )
 
 	// Append the size (of the data in bits) 
 
-	unsigned __int64 *	pEnd	= reinterpret_cast< unsigned __int64 * >( m_buffer + sizeof( m_buffer ) );
-	pEnd[-1] = endian64( static_cast< unsigned __int64 >( m_nProcessed ) * 8 );
+	StoreBigEndian64( m_buffer + sizeof( m_buffer ) - sizeof( uint64_t ), static_cast< uint64_t >( m_nProcessed ) * 8 );
 
 	// Process the final chunk
 
-	ProcessChunk( m_buffer );
+	ProcessChunks( m_buffer, 1 );
 
-	// Endian-swap the digest before returning it
+	// Return the digest as big-endian words
 
 	for ( int i = 0; i < DIGEST_SIZE_IN_WORDS; ++i )
 	{
-		m_digest[i] = endian32( m_digest[i] );
-	}
-
-	memcpy( digest, m_digest, sizeof( m_digest ) );
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-void Sha1Calculator::ProcessChunk( unsigned __int8 const * data )
-{
-	unsigned __int32	w[ NUMBER_OF_ROUNDS ];
-
-	memcpy( w, data, WORDS_PER_CHUNK * sizeof( unsigned __int32 ) );
-
-	// Endian-swap the input data
-
-	for ( int i = 0; i < WORDS_PER_CHUNK; ++i )
-	{
-		w[i] = endian32( w[i] );
-	}
-
-	// Extend the sixteen 32-bit words into eighty 32-bit words:
-
-	for ( int i = WORDS_PER_CHUNK; i < NUMBER_OF_ROUNDS; ++i )
-	{
-		w[i] = rotl( w[i-3] ^ w[i-8] ^ w[i-14] ^ w[i-16], 1 );
+		StoreBigEndian32( digest + i * 4, m_digest[i] );
 	}
-
-	// Do the 80 rounds
-
-	unsigned __int32 a	= m_digest[0];
-	unsigned __int32 b	= m_digest[1];
-	unsigned __int32 c	= m_digest[2];
-	unsigned __int32 d	= m_digest[3];
-	unsigned __int32 e	= m_digest[4];
-
-
-	for ( int i = 0; i < NUMBER_OF_ROUNDS; ++i )
-	{
-		unsigned __int32 f;
-		unsigned __int32 k;
-
-		if ( i < 20 )
-		{
-            f = d ^ (b & (c ^ d));
-            k = 0x5A827999;
-		}
-		else if ( i < 40 )
-		{
-            f = b ^ c ^ d;
-            k = 0x6ED9EBA1;
-		}
-		else if ( i < 60 )
-		{
-            f = (b & c) | (d & (b | c));
-            k = 0x8F1BBCDC;
-		}
-		else
-		{
-            f = b ^ c ^ d;
-            k = 0xCA62C1D6;
-		}
-
-		unsigned __int32	temp = rotl( a, 5 ) + f + e + k + w[i];
-		e = d;
-		d = c;
-		c = rotl( b, 30 );
-		b = a;
-		a = temp;
-	}
-
-	m_digest[0] += a;
-	m_digest[1] += b;
-	m_digest[2] += c;
-	m_digest[3] += d;
-	m_digest[4] += e;
 }
 
 
@@ -0,0 +1,332 @@
+/********************************************************************************************************************
+
+                                                    Sha1Kernels.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Sha1Kernels.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Kernels.h"
+
+#include "Common.h"
+
+#if CRYPTO_X86
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+
+int const	BYTES_PER_CHUNK		= 64;
+int const	WORDS_PER_CHUNK		= BYTES_PER_CHUNK / 4;
+int const	NUMBER_OF_ROUNDS	= 80;
+
+
+#if CRYPTO_X86
+
+// Computes the next four message schedule words from the previous sixteen
+
+CRYPTO_TARGET( "sha,sse4.1" )
+inline __m128i Schedule( __m128i w0, __m128i w4, __m128i w8, __m128i w12 )
+{
+	return _mm_sha1msg2_epu32( _mm_xor_si128( _mm_sha1msg1_epu32( w0, w4 ), w8 ), w12 );
+}
+
+
+// Does four rounds. F selects the round function and constant.
+
+template < int F >
+CRYPTO_TARGET( "sha,sse4.1" )
+inline void Rounds( __m128i & abcd, __m128i & e, __m128i & eSaved, __m128i w )
+{
+	e		= _mm_sha1nexte_epu32( eSaved, w );
+	eSaved	= abcd;
+	abcd	= _mm_sha1rnds4_epu32( abcd, e, F );
+}
+
+// Rotates each 32-bit lane left
+
+CRYPTO_TARGET( "avx2" )
+inline __m256i RotateLeft( __m256i x, int n )
+{
+	return _mm256_or_si256( _mm256_slli_epi32( x, n ), _mm256_srli_epi32( x, 32 - n ) );
+}
+
+#endif // CRYPTO_X86
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+namespace Kernels
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Portable implementation of SHA-1 (see Sha1Calculator.cpp for a description of the algorithm)
+
+void Sha1Generic( uint32_t * digest, uint8_t const * data, size_t size )
+{
+	for ( ; size >= BYTES_PER_CHUNK; size -= BYTES_PER_CHUNK, data += BYTES_PER_CHUNK )
+	{
+		uint32_t			w[ NUMBER_OF_ROUNDS ];
+
+		// Load the input data as big-endian words
+
+		for ( int i = 0; i < WORDS_PER_CHUNK; ++i )
+		{
+			w[i] = LoadBigEndian32( data + i * 4 );
+		}
+
+		// Extend the sixteen 32-bit words into eighty 32-bit words:
+
+		for ( int i = WORDS_PER_CHUNK; i < NUMBER_OF_ROUNDS; ++i )
+		{
+			w[i] = rotl( w[i-3] ^ w[i-8] ^ w[i-14] ^ w[i-16], 1 );
+		}
+
+		// Do the 80 rounds
+
+		uint32_t a			= digest[0];
+		uint32_t b			= digest[1];
+		uint32_t c			= digest[2];
+		uint32_t d			= digest[3];
+		uint32_t e			= digest[4];
+
+
+		for ( int i = 0; i < NUMBER_OF_ROUNDS; ++i )
+		{
+			uint32_t f;
+			uint32_t k;
+
+			if ( i < 20 )
+			{
+				f = d ^ (b & (c ^ d));
+				k = 0x5A827999;
+			}
+			else if ( i < 40 )
+			{
+				f = b ^ c ^ d;
+				k = 0x6ED9EBA1;
+			}
+			else if ( i < 60 )
+			{
+				f = (b & c) | (d & (b | c));
+				k = 0x8F1BBCDC;
+			}
+			else
+			{
+				f = b ^ c ^ d;
+				k = 0xCA62C1D6;
+			}
+
+			uint32_t			temp = rotl( a, 5 ) + f + e + k + w[i];
+			e = d;
+			d = c;
+			c = rotl( b, 30 );
+			b = a;
+			a = temp;
+		}
+
+		digest[0] += a;
+		digest[1] += b;
+		digest[2] += c;
+		digest[3] += d;
+		digest[4] += e;
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Portable version of Sha1x8Avx2(), which compresses the block of each lane in turn. It is only used to check the
+// others, since it is no faster than hashing the messages one at a time.
+
+void Sha1x8Generic( uint32_t * state, uint32_t const * words )
+{
+	for ( int lane = 0; lane < 8; ++lane )
+	{
+		uint8_t		block[ BYTES_PER_CHUNK ];
+		uint32_t	digest[ 5 ];
+
+		for ( int i = 0; i < WORDS_PER_CHUNK; ++i )
+		{
+			StoreBigEndian32( block + i * 4, words[ i * 8 + lane ] );
+		}
+
+		for ( int i = 0; i < 5; ++i )
+		{
+			digest[i] = state[ i * 8 + lane ];
+		}
+
+		Sha1Generic( digest, block, BYTES_PER_CHUNK );
+
+		for ( int i = 0; i < 5; ++i )
+		{
+			state[ i * 8 + lane ] = digest[i];
+		}
+	}
+}
+
+
+#if CRYPTO_X86
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Implementation of SHA-1 using the Intel SHA extensions. Each group of four rounds is done by a single sha1rnds4
+// instruction, and the message schedule is computed four words at a time by sha1msg1/sha1msg2.
+
+CRYPTO_TARGET( "sha,sse4.1" )
+void Sha1Shani( uint32_t * digest, uint8_t const * data, size_t size )
+{
+	__m128i const	BYTE_SWAP	= _mm_set_epi64x( 0x0001020304050607LL, 0x08090a0b0c0d0e0fLL );
+
+	// The instructions want A in the high word of abcd and E in the high word of e
+
+	__m128i	abcd	= _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast< __m128i const * >( digest ) ), 0x1B );
+	__m128i	e0		= _mm_set_epi32( int( digest[4] ), 0, 0, 0 );
+
+	for ( ; size >= BYTES_PER_CHUNK; size -= BYTES_PER_CHUNK, data += BYTES_PER_CHUNK )
+	{
+		__m128i const	abcdSaved	= abcd;
+		__m128i const	e0Saved		= e0;
+
+		__m128i	w0	= _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast< __m128i const * >( data +  0 ) ), BYTE_SWAP );
+		__m128i	w1	= _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast< __m128i const * >( data + 16 ) ), BYTE_SWAP );
+		__m128i	w2	= _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast< __m128i const * >( data + 32 ) ), BYTE_SWAP );
+		__m128i	w3	= _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast< __m128i const * >( data + 48 ) ), BYTE_SWAP );
+
+		// Rounds 0-3 add E directly, the rest derive it from A four rounds earlier with sha1nexte.
+
+		__m128i	e		= _mm_add_epi32( e0, w0 );
+		__m128i	eSaved	= abcd;
+		abcd = _mm_sha1rnds4_epu32( abcd, e, 0 );
+
+		Rounds< 0 >( abcd, e, eSaved, w1 );										// Rounds 4-7
+		Rounds< 0 >( abcd, e, eSaved, w2 );										// Rounds 8-11
+		Rounds< 0 >( abcd, e, eSaved, w3 );										// Rounds 12-15
+		w0 = Schedule( w0, w1, w2, w3 );	Rounds< 0 >( abcd, e, eSaved, w0 );	// Rounds 16-19
+		w1 = Schedule( w1, w2, w3, w0 );	Rounds< 1 >( abcd, e, eSaved, w1 );	// Rounds 20-23
+		w2 = Schedule( w2, w3, w0, w1 );	Rounds< 1 >( abcd, e, eSaved, w2 );	// Rounds 24-27
+		w3 = Schedule( w3, w0, w1, w2 );	Rounds< 1 >( abcd, e, eSaved, w3 );	// Rounds 28-31
+		w0 = Schedule( w0, w1, w2, w3 );	Rounds< 1 >( abcd, e, eSaved, w0 );	// Rounds 32-35
+		w1 = Schedule( w1, w2, w3, w0 );	Rounds< 1 >( abcd, e, eSaved, w1 );	// Rounds 36-39
+		w2 = Schedule( w2, w3, w0, w1 );	Rounds< 2 >( abcd, e, eSaved, w2 );	// Rounds 40-43
+		w3 = Schedule( w3, w0, w1, w2 );	Rounds< 2 >( abcd, e, eSaved, w3 );	// Rounds 44-47
+		w0 = Schedule( w0, w1, w2, w3 );	Rounds< 2 >( abcd, e, eSaved, w0 );	// Rounds 48-51
+		w1 = Schedule( w1, w2, w3, w0 );	Rounds< 2 >( abcd, e, eSaved, w1 );	// Rounds 52-55
+		w2 = Schedule( w2, w3, w0, w1 );	Rounds< 2 >( abcd, e, eSaved, w2 );	// Rounds 56-59
+		w3 = Schedule( w3, w0, w1, w2 );	Rounds< 3 >( abcd, e, eSaved, w3 );	// Rounds 60-63
+		w0 = Schedule( w0, w1, w2, w3 );	Rounds< 3 >( abcd, e, eSaved, w0 );	// Rounds 64-67
+		w1 = Schedule( w1, w2, w3, w0 );	Rounds< 3 >( abcd, e, eSaved, w1 );	// Rounds 68-71
+		w2 = Schedule( w2, w3, w0, w1 );	Rounds< 3 >( abcd, e, eSaved, w2 );	// Rounds 72-75
+		w3 = Schedule( w3, w0, w1, w2 );	Rounds< 3 >( abcd, e, eSaved, w3 );	// Rounds 76-79
+
+		// Add this chunk's hash to the result so far
+
+		e0		= _mm_sha1nexte_epu32( eSaved, e0Saved );
+		abcd	= _mm_add_epi32( abcd, abcdSaved );
+	}
+
+	_mm_storeu_si128( reinterpret_cast< __m128i * >( digest ), _mm_shuffle_epi32( abcd, 0x1B ) );
+	digest[4] = uint32_t( _mm_extract_epi32( e0, 3 ) );
+}
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Compresses eight independent blocks at once, one in each 32-bit lane. The message words are already converted from
+// big-endian and interleaved with the state (see Kernels.h).
+
+CRYPTO_TARGET( "avx2" )
+void Sha1x8Avx2( uint32_t * state, uint32_t const * words )
+{
+	__m256i	w[ WORDS_PER_CHUNK ];
+
+	for ( int i = 0; i < WORDS_PER_CHUNK; ++i )
+	{
+		w[i] = _mm256_loadu_si256( reinterpret_cast< __m256i const * >( words + i * 8 ) );
+	}
+
+	__m256i	a	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 0 * 8 ) );
+	__m256i	b	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 1 * 8 ) );
+	__m256i	c	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 2 * 8 ) );
+	__m256i	d	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 3 * 8 ) );
+	__m256i	e	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 4 * 8 ) );
+
+	for ( int i = 0; i < NUMBER_OF_ROUNDS; ++i )
+	{
+		// The message schedule is kept in a ring of sixteen words
+
+		if ( i >= WORDS_PER_CHUNK )
+		{
+			w[ i & 15 ] = RotateLeft( _mm256_xor_si256( _mm256_xor_si256( w[ ( i - 3 ) & 15 ], w[ ( i - 8 ) & 15 ] ),
+														_mm256_xor_si256( w[ ( i - 14 ) & 15 ], w[ i & 15 ] ) ), 1 );
+		}
+
+		__m256i	f;
+		int		k;
+
+		if ( i < 20 )
+		{
+			f = _mm256_xor_si256( d, _mm256_and_si256( b, _mm256_xor_si256( c, d ) ) );
+			k = 0x5A827999;
+		}
+		else if ( i < 40 )
+		{
+			f = _mm256_xor_si256( _mm256_xor_si256( b, c ), d );
+			k = 0x6ED9EBA1;
+		}
+		else if ( i < 60 )
+		{
+			f = _mm256_or_si256( _mm256_and_si256( b, c ), _mm256_and_si256( d, _mm256_or_si256( b, c ) ) );
+			k = int( 0x8F1BBCDC );
+		}
+		else
+		{
+			f = _mm256_xor_si256( _mm256_xor_si256( b, c ), d );
+			k = int( 0xCA62C1D6 );
+		}
+
+		__m256i const	temp	= _mm256_add_epi32( _mm256_add_epi32( RotateLeft( a, 5 ), f ),
+												_mm256_add_epi32( _mm256_add_epi32( e, _mm256_set1_epi32( k ) ), w[ i & 15 ] ) );
+
+		e = d;
+		d = c;
+		c = RotateLeft( b, 30 );
+		b = a;
+		a = temp;
+	}
+
+	__m256i const	result[ 5 ]	= { a, b, c, d, e };
+
+	for ( int i = 0; i < 5; ++i )
+	{
+		__m256i * const	p	= reinterpret_cast< __m256i * >( state + i * 8 );
+
+		_mm256_storeu_si256( p, _mm256_add_epi32( _mm256_loadu_si256( p ), result[i] ) );
+	}
+}
+
+#endif // CRYPTO_X86
+
+
+} // namespace Kernels
+} // namespace Crypto
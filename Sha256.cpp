@@ -17,7 +17,7 @@
 #include "Common.h"
 
 #include <cstring>
-#include <xutility>
+#include <algorithm>
 
 namespace Crypto
 {
@@ -27,26 +27,7 @@ namespace Crypto
 /*																													*/
 /********************************************************************************************************************/
 
-Sha256::Sha256()
-{
-	memset( &m_value, 0, sizeof m_value );
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-Sha256::~Sha256()
-{
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-Sha256::Sha256( unsigned __int8 const * pData, size_t size )
+Sha256::Sha256( uint8_t const * pData, size_t size )
 {
 	Sha256Calculator().Calculate( pData, size, m_value );
 }
@@ -96,9 +77,19 @@ std::string Sha256::ToString() const
 /*																													*/
 /********************************************************************************************************************/
 
-bool Sha256::operator == ( Sha256 const & y ) const
+std::to_chars_result Sha256::ToChars( char * first, char * last ) const
+{
+	return Crypto::ToChars( m_value, SIZE, first, last );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::from_chars_result Sha256::FromChars( char const * first, char const * last, Sha256 & value )
 {
-	return ( memcmp( m_value, y.m_value, sizeof( m_value ) ) == 0 );
+	return Crypto::FromChars( first, last, value.m_value, SIZE );
 }
 
 
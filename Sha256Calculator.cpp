@@ -14,7 +14,8 @@
 #include "Sha256Calculator.h"
 
 #include "Common.h"
-#include <xutility>
+#include "Kernels.h"
+#include <algorithm>
 
 
 //	SHA-256 computation algorithm as documented by Wikipedia: http://en.wikipedia.org/wiki/SHA
@@ -120,7 +121,7 @@ Sha256Calculator::Sha256Calculator()
 /*																													*/
 /********************************************************************************************************************/
 
-void Sha256Calculator::Calculate( unsigned __int8 const * data, size_t size, unsigned __int8 * digest )
+void Sha256Calculator::Calculate( uint8_t const * data, size_t size, uint8_t * digest )
 {
 	Reset();
 	Process( data, size );
@@ -132,7 +133,7 @@ void Sha256Calculator::Calculate( unsigned __int8 const * data, size_t size, uns
 /*																													*/
 /********************************************************************************************************************/
 
-void Sha256Calculator::Calculate( std::istream & stream, unsigned __int8 * digest )
+void Sha256Calculator::Calculate( std::istream & stream, uint8_t * digest )
 {
 	Reset();
 	Process( stream );
@@ -157,6 +158,8 @@ void Sha256Calculator::Reset()
 
 	m_tail			= 0;
 	m_nProcessed	= 0;
+
+	m_kernel		= Kernels::Get( KernelRegistry::SHA256 );
 }
 
 
@@ -164,7 +167,7 @@ void Sha256Calculator::Reset()
 /*																													*/
 /********************************************************************************************************************/
 
-void Sha256Calculator::Process( unsigned __int8 const * data, size_t size )
+void Sha256Calculator::Process( uint8_t const * data, size_t size )
 {
 	// If there is already data in the buffer, then fill it.
 
@@ -182,21 +185,24 @@ void Sha256Calculator::Process( unsigned __int8 const * data, size_t size )
 
 	if ( m_tail == sizeof( m_buffer ) )
 	{
-		ProcessChunk( m_buffer );
+		ProcessChunks( m_buffer, 1 );
 		m_nProcessed += sizeof( m_buffer );
 
 		m_tail = 0;
 	}
 
-	// Process one chunk at a time
+	// Process the whole chunks with a single call to the kernel. Less than a full chunk is left over, so Finalize()
+	// always has room to append the 1 bit.
 
-	while ( size > sizeof( m_buffer ) )
+	if ( size >= sizeof( m_buffer ) )
 	{
-		ProcessChunk( data );
-		m_nProcessed += sizeof( m_buffer );
+		size_t const	n	= size / sizeof( m_buffer );
 
-		size -= sizeof( m_buffer );
-		data += sizeof( m_buffer );
+		ProcessChunks( data, n );
+		m_nProcessed += n * sizeof( m_buffer );
+
+		size -= n * sizeof( m_buffer );
+		data += n * sizeof( m_buffer );
 	}
 
 	// Put the leftover data in the buffer
@@ -230,7 +236,7 @@ void Sha256Calculator::Process( std::istream & stream )
 	{
 		// Process the buffer
 
-		ProcessChunk( m_buffer );
+		ProcessChunks( m_buffer, 1 );
 		m_nProcessed += sizeof( m_buffer );
 		m_tail = 0;
 
@@ -250,7 +256,7 @@ void Sha256Calculator::Process( std::istream & stream )
 /*																													*/
 /********************************************************************************************************************/
 
-void Sha256Calculator::Finalize( unsigned __int8 * digest )
+void Sha256Calculator::Finalize( uint8_t * digest )
 {
 	// Process the last chunk. The last chunk has a 1 bit (0x80 byte) appended, then is padded to 448 bytes,
 	// and then has a 64-bit size (of the data in bits) appended.
@@ -265,12 +271,12 @@ void Sha256Calculator::Finalize( unsigned __int8 * digest )
 
 	// If the buffer has more than 56 bytes (including the appended 1 bit), process the first chunk.
 
-	if ( m_tail > sizeof( m_buffer )-sizeof( unsigned __int64 ) )
+	if ( m_tail > int( sizeof( m_buffer ) - sizeof( uint64_t ) ) )
 	{
 		// Pad to the end of the chunk
 		memset( &m_buffer[ m_tail ], 0, sizeof( m_buffer )-m_tail );
 
-		ProcessChunk( m_buffer );
+		ProcessChunks( m_buffer, 1 );
 		m_nProcessed += m_tail-1;	// -1 because we don't want to include the appended 1 bit
 
 		m_tail = 0;
@@ -285,101 +291,16 @@ void Sha256Calculator::Finalize( unsigned __int8 * digest )
 
 	// Append the size (of the data in bits)
 
-	unsigned __int64 *	pEnd	= reinterpret_cast< unsigned __int64 * >( m_buffer + sizeof( m_buffer ) );
-	pEnd[-1] = endian64( static_cast< unsigned __int64 >( m_nProcessed ) * 8 );
+	StoreBigEndian64( m_buffer + sizeof( m_buffer ) - sizeof( uint64_t ), static_cast< uint64_t >( m_nProcessed ) * 8 );
 
-	ProcessChunk( m_buffer );
+	ProcessChunks( m_buffer, 1 );
 
-	// Endian-swap the digest before returning it
+	// Return the digest as big-endian words
 
 	for ( int i = 0; i < DIGEST_SIZE_IN_WORDS; ++i )
 	{
-		m_digest[i] = endian32( m_digest[i] );
-	}
-
-	memcpy( digest, m_digest, sizeof( m_digest ) );
-}
-
-
-/********************************************************************************************************************/
-/*																													*/
-/********************************************************************************************************************/
-
-void Sha256Calculator::ProcessChunk( unsigned __int8 const * data )
-{
-	static unsigned __int32 const	k[ NUMBER_OF_ROUNDS ] =
-	{
-		0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-		0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-		0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-		0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-		0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-		0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-		0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-		0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-	};
-
-	unsigned __int32	w[ NUMBER_OF_ROUNDS ];
-
-	memcpy( w, data, WORDS_PER_CHUNK * sizeof( unsigned __int32 ) );
-
-	// Endian-swap the input data
-
-	for ( int i = 0; i < WORDS_PER_CHUNK; ++i )
-	{
-		w[i] = endian32( w[i] );
-	}
-
-
-	// Extend the sixteen 32-bit words into 64 32-bit words:
-
-	for ( int i = WORDS_PER_CHUNK; i < NUMBER_OF_ROUNDS; ++i )
-	{
-		unsigned __int32	s0 = rotr( w[i-15],  7 ) ^ rotr( w[i-15], 18 ) ^ ( w[i-15] >>  3 );
-		unsigned __int32	s1 = rotr( w[i- 2], 17 ) ^ rotr( w[i- 2], 19 ) ^ ( w[i- 2] >> 10 );
-
-		w[i] = w[i-16] + s0 + w[i-7] + s1;
-	}
-
-	// Do the 64 rounds
-
-	unsigned __int32 a	= m_digest[0];
-	unsigned __int32 b	= m_digest[1];
-	unsigned __int32 c	= m_digest[2];
-	unsigned __int32 d	= m_digest[3];
-	unsigned __int32 e	= m_digest[4];
-	unsigned __int32 f	= m_digest[5];
-	unsigned __int32 g	= m_digest[6];
-	unsigned __int32 h	= m_digest[7];
-
-
-	for ( int i = 0; i < NUMBER_OF_ROUNDS; ++i )
-	{
-		unsigned __int32 s0		= rotr( a, 2 ) ^ rotr( a, 13 ) ^ rotr( a, 22 );
-		unsigned __int32 maj	= ( a & b ) | ( b & c ) | ( c & a );
-		unsigned __int32 t0		= s0 + maj;
-		unsigned __int32 s1		= rotr( e, 6 ) ^ rotr( e, 11 ) ^ rotr( e, 25 );
-		unsigned __int32 ch		= ( e & f ) | ( ~e & g );
-		unsigned __int32 t1		= h + s1 + ch + k[i] + w[i];
-		
-		h = g;
-		g = f;
-		f = e;
-		e = d + t1;
-		d = c;
-		c = b;
-		b = a;
-		a = t0 + t1;
+		StoreBigEndian32( digest + i * 4, m_digest[i] );
 	}
-
-	m_digest[0] += a;
-	m_digest[1] += b;
-	m_digest[2] += c;
-	m_digest[3] += d;
-	m_digest[4] += e;
-	m_digest[5] += f;
-	m_digest[6] += g;
-	m_digest[7] += h;
 }
 
 
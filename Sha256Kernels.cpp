@@ -0,0 +1,330 @@
+/********************************************************************************************************************
+
+                                                   Sha256Kernels.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Sha256Kernels.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Kernels.h"
+
+#include "Common.h"
+
+#if CRYPTO_X86
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+
+int const	BYTES_PER_CHUNK		= 64;
+int const	WORDS_PER_CHUNK		= BYTES_PER_CHUNK / 4;
+int const	NUMBER_OF_ROUNDS	= 64;
+
+uint32_t const			K[ NUMBER_OF_ROUNDS ] =
+{
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+
+#if CRYPTO_X86
+
+// Computes the next four message schedule words from the previous sixteen
+
+CRYPTO_TARGET( "sha,sse4.1" )
+inline __m128i Schedule( __m128i w0, __m128i w4, __m128i w8, __m128i w12 )
+{
+	__m128i const	w	= _mm_add_epi32( _mm_sha256msg1_epu32( w0, w4 ), _mm_alignr_epi8( w12, w8, 4 ) );
+
+	return _mm_sha256msg2_epu32( w, w12 );
+}
+
+
+// Does four rounds using the message words w and the round constants k
+
+CRYPTO_TARGET( "sha,sse4.1" )
+inline void Rounds( __m128i & abef, __m128i & cdgh, __m128i w, uint32_t const * k )
+{
+	__m128i	wk	= _mm_add_epi32( w, _mm_loadu_si128( reinterpret_cast< __m128i const * >( k ) ) );
+
+	cdgh	= _mm_sha256rnds2_epu32( cdgh, abef, wk );
+	wk		= _mm_shuffle_epi32( wk, 0x0E );
+	abef	= _mm_sha256rnds2_epu32( abef, cdgh, wk );
+}
+
+// Rotates each 32-bit lane right
+
+CRYPTO_TARGET( "avx2" )
+inline __m256i RotateRight( __m256i x, int n )
+{
+	return _mm256_or_si256( _mm256_srli_epi32( x, n ), _mm256_slli_epi32( x, 32 - n ) );
+}
+
+#endif // CRYPTO_X86
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+namespace Kernels
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Portable implementation of SHA-256 (see Sha256Calculator.cpp for a description of the algorithm)
+
+void Sha256Generic( uint32_t * digest, uint8_t const * data, size_t size )
+{
+	for ( ; size >= BYTES_PER_CHUNK; size -= BYTES_PER_CHUNK, data += BYTES_PER_CHUNK )
+	{
+		uint32_t			w[ NUMBER_OF_ROUNDS ];
+
+		// Load the input data as big-endian words
+
+		for ( int i = 0; i < WORDS_PER_CHUNK; ++i )
+		{
+			w[i] = LoadBigEndian32( data + i * 4 );
+		}
+
+
+		// Extend the sixteen 32-bit words into 64 32-bit words:
+
+		for ( int i = WORDS_PER_CHUNK; i < NUMBER_OF_ROUNDS; ++i )
+		{
+			uint32_t			s0 = rotr( w[i-15],  7 ) ^ rotr( w[i-15], 18 ) ^ ( w[i-15] >>  3 );
+			uint32_t			s1 = rotr( w[i- 2], 17 ) ^ rotr( w[i- 2], 19 ) ^ ( w[i- 2] >> 10 );
+
+			w[i] = w[i-16] + s0 + w[i-7] + s1;
+		}
+
+		// Do the 64 rounds
+
+		uint32_t a			= digest[0];
+		uint32_t b			= digest[1];
+		uint32_t c			= digest[2];
+		uint32_t d			= digest[3];
+		uint32_t e			= digest[4];
+		uint32_t f			= digest[5];
+		uint32_t g			= digest[6];
+		uint32_t h			= digest[7];
+
+
+		for ( int i = 0; i < NUMBER_OF_ROUNDS; ++i )
+		{
+			uint32_t s0				= rotr( a, 2 ) ^ rotr( a, 13 ) ^ rotr( a, 22 );
+			uint32_t maj			= ( a & b ) | ( b & c ) | ( c & a );
+			uint32_t t0				= s0 + maj;
+			uint32_t s1				= rotr( e, 6 ) ^ rotr( e, 11 ) ^ rotr( e, 25 );
+			uint32_t ch				= ( e & f ) | ( ~e & g );
+			uint32_t t1				= h + s1 + ch + K[i] + w[i];
+
+			h = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t0 + t1;
+		}
+
+		digest[0] += a;
+		digest[1] += b;
+		digest[2] += c;
+		digest[3] += d;
+		digest[4] += e;
+		digest[5] += f;
+		digest[6] += g;
+		digest[7] += h;
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Portable version of Sha256x8Avx2(), which compresses the block of each lane in turn. It is only used to check the
+// others, since it is no faster than hashing the messages one at a time.
+
+void Sha256x8Generic( uint32_t * state, uint32_t const * words )
+{
+	for ( int lane = 0; lane < 8; ++lane )
+	{
+		uint8_t		block[ BYTES_PER_CHUNK ];
+		uint32_t	digest[ 8 ];
+
+		for ( int i = 0; i < WORDS_PER_CHUNK; ++i )
+		{
+			StoreBigEndian32( block + i * 4, words[ i * 8 + lane ] );
+		}
+
+		for ( int i = 0; i < 8; ++i )
+		{
+			digest[i] = state[ i * 8 + lane ];
+		}
+
+		Sha256Generic( digest, block, BYTES_PER_CHUNK );
+
+		for ( int i = 0; i < 8; ++i )
+		{
+			state[ i * 8 + lane ] = digest[i];
+		}
+	}
+}
+
+
+#if CRYPTO_X86
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Implementation of SHA-256 using the Intel SHA extensions. sha256rnds2 does two rounds at a time on the state held
+// as ABEF/CDGH, and the message schedule is computed four words at a time by sha256msg1/sha256msg2.
+
+CRYPTO_TARGET( "sha,sse4.1" )
+void Sha256Shani( uint32_t * digest, uint8_t const * data, size_t size )
+{
+	__m128i const	BYTE_SWAP	= _mm_set_epi64x( 0x0c0d0e0f08090a0bLL, 0x0405060700010203LL );
+
+	// Rearrange the state from ABCD/EFGH to ABEF/CDGH
+
+	__m128i	dcba	= _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast< __m128i const * >( digest + 0 ) ), 0xB1 );
+	__m128i	efgh	= _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast< __m128i const * >( digest + 4 ) ), 0x1B );
+	__m128i	abef	= _mm_alignr_epi8( dcba, efgh, 8 );
+	__m128i	cdgh	= _mm_blend_epi16( efgh, dcba, 0xF0 );
+
+	for ( ; size >= BYTES_PER_CHUNK; size -= BYTES_PER_CHUNK, data += BYTES_PER_CHUNK )
+	{
+		__m128i const	abefSaved	= abef;
+		__m128i const	cdghSaved	= cdgh;
+
+		__m128i	w0	= _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast< __m128i const * >( data +  0 ) ), BYTE_SWAP );
+		__m128i	w1	= _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast< __m128i const * >( data + 16 ) ), BYTE_SWAP );
+		__m128i	w2	= _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast< __m128i const * >( data + 32 ) ), BYTE_SWAP );
+		__m128i	w3	= _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast< __m128i const * >( data + 48 ) ), BYTE_SWAP );
+
+		Rounds( abef, cdgh, w0, &K[  0 ] );
+		Rounds( abef, cdgh, w1, &K[  4 ] );
+		Rounds( abef, cdgh, w2, &K[  8 ] );
+		Rounds( abef, cdgh, w3, &K[ 12 ] );
+
+		for ( int i = 16; i < NUMBER_OF_ROUNDS; i += 16 )
+		{
+			w0 = Schedule( w0, w1, w2, w3 );	Rounds( abef, cdgh, w0, &K[ i +  0 ] );
+			w1 = Schedule( w1, w2, w3, w0 );	Rounds( abef, cdgh, w1, &K[ i +  4 ] );
+			w2 = Schedule( w2, w3, w0, w1 );	Rounds( abef, cdgh, w2, &K[ i +  8 ] );
+			w3 = Schedule( w3, w0, w1, w2 );	Rounds( abef, cdgh, w3, &K[ i + 12 ] );
+		}
+
+		// Add this chunk's hash to the result so far
+
+		abef = _mm_add_epi32( abef, abefSaved );
+		cdgh = _mm_add_epi32( cdgh, cdghSaved );
+	}
+
+	// Rearrange the state from ABEF/CDGH back to ABCD/EFGH
+
+	__m128i const	feba	= _mm_shuffle_epi32( abef, 0x1B );
+	__m128i const	dchg	= _mm_shuffle_epi32( cdgh, 0xB1 );
+
+	_mm_storeu_si128( reinterpret_cast< __m128i * >( digest + 0 ), _mm_blend_epi16( feba, dchg, 0xF0 ) );
+	_mm_storeu_si128( reinterpret_cast< __m128i * >( digest + 4 ), _mm_alignr_epi8( dchg, feba, 8 ) );
+}
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Compresses eight independent blocks at once, one in each 32-bit lane. The message words are already converted from
+// big-endian and interleaved with the state (see Kernels.h), so that callers such as PBKDF2 that hash their own
+// output can feed it back without rearranging it.
+
+CRYPTO_TARGET( "avx2" )
+void Sha256x8Avx2( uint32_t * state, uint32_t const * words )
+{
+	__m256i	w[ WORDS_PER_CHUNK ];
+
+	for ( int i = 0; i < WORDS_PER_CHUNK; ++i )
+	{
+		w[i] = _mm256_loadu_si256( reinterpret_cast< __m256i const * >( words + i * 8 ) );
+	}
+
+	__m256i	a	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 0 * 8 ) );
+	__m256i	b	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 1 * 8 ) );
+	__m256i	c	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 2 * 8 ) );
+	__m256i	d	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 3 * 8 ) );
+	__m256i	e	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 4 * 8 ) );
+	__m256i	f	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 5 * 8 ) );
+	__m256i	g	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 6 * 8 ) );
+	__m256i	h	= _mm256_loadu_si256( reinterpret_cast< __m256i const * >( state + 7 * 8 ) );
+
+	for ( int i = 0; i < NUMBER_OF_ROUNDS; ++i )
+	{
+		// The message schedule is kept in a ring of sixteen words
+
+		if ( i >= WORDS_PER_CHUNK )
+		{
+			__m256i const	w15	= w[ ( i - 15 ) & 15 ];
+			__m256i const	w2	= w[ ( i - 2 ) & 15 ];
+			__m256i const	s0	= _mm256_xor_si256( _mm256_xor_si256( RotateRight( w15, 7 ), RotateRight( w15, 18 ) ),
+													_mm256_srli_epi32( w15, 3 ) );
+			__m256i const	s1	= _mm256_xor_si256( _mm256_xor_si256( RotateRight( w2, 17 ), RotateRight( w2, 19 ) ),
+													_mm256_srli_epi32( w2, 10 ) );
+
+			w[ i & 15 ] = _mm256_add_epi32( _mm256_add_epi32( w[ i & 15 ], s0 ), _mm256_add_epi32( w[ ( i - 7 ) & 15 ], s1 ) );
+		}
+
+		__m256i const	s1	= _mm256_xor_si256( _mm256_xor_si256( RotateRight( e, 6 ), RotateRight( e, 11 ) ), RotateRight( e, 25 ) );
+		__m256i const	ch	= _mm256_xor_si256( _mm256_and_si256( e, f ), _mm256_andnot_si256( e, g ) );
+		__m256i const	t1	= _mm256_add_epi32( _mm256_add_epi32( _mm256_add_epi32( h, s1 ), ch ),
+											_mm256_add_epi32( _mm256_set1_epi32( int( K[i] ) ), w[ i & 15 ] ) );
+		__m256i const	s0	= _mm256_xor_si256( _mm256_xor_si256( RotateRight( a, 2 ), RotateRight( a, 13 ) ), RotateRight( a, 22 ) );
+		__m256i const	maj	= _mm256_or_si256( _mm256_and_si256( a, b ), _mm256_and_si256( c, _mm256_or_si256( a, b ) ) );
+		__m256i const	t0	= _mm256_add_epi32( s0, maj );
+
+		h = g;
+		g = f;
+		f = e;
+		e = _mm256_add_epi32( d, t1 );
+		d = c;
+		c = b;
+		b = a;
+		a = _mm256_add_epi32( t0, t1 );
+	}
+
+	__m256i const	result[ 8 ]	= { a, b, c, d, e, f, g, h };
+
+	for ( int i = 0; i < 8; ++i )
+	{
+		__m256i * const	p	= reinterpret_cast< __m256i * >( state + i * 8 );
+
+		_mm256_storeu_si256( p, _mm256_add_epi32( _mm256_loadu_si256( p ), result[i] ) );
+	}
+}
+
+#endif // CRYPTO_X86
+
+
+} // namespace Kernels
+} // namespace Crypto
@@ -0,0 +1,559 @@
+/********************************************************************************************************************
+
+                                                  TorrentPieces.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/TorrentPieces.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "TorrentPieces.h"
+
+#include "Common.h"
+#include "MappedFile.h"
+#include "MultiBufferHash.h"
+#include "Sha256Calculator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+
+namespace
+{
+
+
+using namespace Crypto::MultiBufferHash;
+
+int const		MAX_HEIGHT			= 64;	// Largest height of a v2 Merkle tree
+size_t const	PIECES_PER_BATCH	= 64;	// Number of v1 pieces hashed in a batch
+size_t const	LEAVES_PER_BATCH	= 512;	// Number of v2 blocks hashed in a batch, unless a piece has more
+
+// The hash of an empty subtree of each height. The leaves are 0's.
+
+struct PadTable
+{
+	PadTable()
+	{
+		Crypto::Sha256Calculator	calculator;
+		uint8_t						children[ 2 * Crypto::Sha256::SIZE ];
+
+		for ( int i = 1; i < MAX_HEIGHT; ++i )
+		{
+			memcpy( children, m_pads[ i - 1 ].m_value, Crypto::Sha256::SIZE );
+			memcpy( children + Crypto::Sha256::SIZE, m_pads[ i - 1 ].m_value, Crypto::Sha256::SIZE );
+			calculator.Calculate( children, sizeof( children ), m_pads[i].m_value );
+		}
+	}
+
+	Crypto::Sha256		m_pads[ MAX_HEIGHT ];
+};
+
+Crypto::Sha256 const *	Pads()
+{
+	static PadTable const	table;
+
+	return table.m_pads;
+}
+
+// Hashes the nodes of a level of a Merkle tree in pairs until it reaches a height. A node without a sibling is paired
+// with the hash of an empty subtree.
+
+void Reduce( std::vector< Crypto::Sha256 > & level, int height, int target )
+{
+	Function const					f		= Select( Crypto::KernelRegistry::SHA256 );
+	Crypto::Sha256 const * const	pads	= Pads();
+	std::vector< Crypto::Sha256 >	above;
+	std::vector< Segment >			segments;
+	std::vector< Message >			messages;
+
+	for ( ; height < target; ++height )
+	{
+		if ( level.size() % 2 != 0 )
+			level.push_back( pads[ height ] );
+
+		size_t const	n	= level.size() / 2;
+
+		above.resize( n );
+		segments.resize( n );
+		messages.resize( n );
+		for ( size_t i = 0; i < n; ++i )
+		{
+			segments[i] = Segment( level[ 2 * i ].m_value, 2 * Crypto::Sha256::SIZE );
+			Start( &segments[i], 2 * Crypto::Sha256::SIZE, above[i].m_value, messages[i] );
+		}
+		Hash( f, messages.data(), n );
+		level.swap( above );
+	}
+}
+
+// Returns the height of the smallest complete tree with at least count leaves
+
+int Height( uint64_t count )
+{
+	int	height	= 0;
+
+	while ( ( uint64_t( 1 ) << height ) < count )
+	{
+		++height;
+	}
+
+	return height;
+}
+
+// Computes the root of a file's Merkle tree from its piece layer
+
+Crypto::Sha256 LayerRoot( std::vector< Crypto::Sha256 > layer, int pieceHeight )
+{
+	Reduce( layer, pieceHeight, pieceHeight + Height( layer.size() ) );
+
+	return layer[0];
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	pieceSize	Size of a piece. For v2, it must be a power of two at least BLOCK_SIZE.
+
+TorrentPieces::TorrentPieces( size_t pieceSize )
+	: m_pieceSize( pieceSize ),
+	m_size( 0 ),
+	m_mapped( 0 )
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+TorrentPieces::~TorrentPieces()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	path	Path of the file
+
+bool TorrentPieces::AddFile( std::string const & path )
+{
+	std::error_code		error;
+	uintmax_t const		size	= std::filesystem::file_size( path, error );
+
+	if ( error )
+		return false;
+
+	AddFile( path, size );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	path	Path of the file
+//! @param	size	Size of the file in the torrent
+
+void TorrentPieces::AddFile( std::string const & path, uint64_t size )
+{
+	m_files.push_back( File{ path, size, m_size, nullptr, false } );
+	m_size += size;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	version		Version of the torrent format
+//!
+//! A v1 piece may span files, and a v2 piece is in one file.
+
+size_t TorrentPieces::PieceCount( Version version ) const
+{
+	if ( m_pieceSize == 0 )
+		return 0;
+
+	if ( version == V1 )
+		return size_t( ( m_size + m_pieceSize - 1 ) / m_pieceSize );
+
+	size_t	count	= 0;
+
+	for ( File const & file : m_files )
+	{
+		count += size_t( ( file.size + m_pieceSize - 1 ) / m_pieceSize );
+	}
+
+	return count;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	pieces	Hash of each piece (output)
+
+bool TorrentPieces::HashV1( std::vector< Sha1 > & pieces )
+{
+	size_t const		count	= PieceCount( V1 );
+	std::vector< bool >	available( count, false );
+
+	pieces.assign( count, Sha1() );
+	if ( m_pieceSize == 0 )
+		return false;
+
+	m_mapped = 0;
+	for ( size_t first = 0; first < count; first += PIECES_PER_BATCH )
+	{
+		HashPieces( first, std::min( first + PIECES_PER_BATCH, count ), pieces, available );
+	}
+	Unmap( m_size );
+
+	return std::find( available.begin(), available.end(), false ) == available.end();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	files	Hashes of each file, in the order they were added (output)
+
+bool TorrentPieces::HashV2( std::vector< FileHashes > & files )
+{
+	files.assign( m_files.size(), FileHashes() );
+	if ( !ValidV2() )
+		return false;
+
+	int const		pieceHeight	= Height( m_pieceSize / TorrentPieces::BLOCK_SIZE );
+	size_t const	batch		= std::max( LEAVES_PER_BATCH >> pieceHeight, size_t( 1 ) );
+	bool			complete	= true;
+
+	m_mapped = 0;
+	for ( size_t i = 0; i < m_files.size(); ++i )
+	{
+		File const &	file	= m_files[i];
+		FileHashes &	hashes	= files[i];
+		uint64_t const	pieces	= ( file.size + m_pieceSize - 1 ) / m_pieceSize;
+
+		if ( file.size > m_pieceSize )
+		{
+			hashes.layer.resize( size_t( pieces ) );
+			for ( uint64_t first = 0; first < pieces; first += batch )
+			{
+				complete &= HashPieces( i, first, std::min( first + batch, pieces ), &hashes.layer[ size_t( first ) ] );
+			}
+			hashes.root = LayerRoot( hashes.layer, pieceHeight );
+		}
+		else if ( file.size > 0 )
+		{
+			complete &= HashPieces( i, 0, 1, &hashes.root );
+		}
+
+		Unmap( file.offset + file.size );
+	}
+
+	return complete;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	pieces	Hash of each piece
+//! @param	valid	True for each piece that is valid (output)
+
+bool TorrentPieces::VerifyV1( std::vector< Sha1 > const & pieces, std::vector< bool > & valid )
+{
+	size_t const		count	= PieceCount( V1 );
+	std::vector< Sha1 >	hashes( count );
+
+	valid.assign( count, false );
+	if ( m_pieceSize == 0 || pieces.size() != count )
+		return false;
+
+	m_mapped = 0;
+	for ( size_t first = 0; first < count; first += PIECES_PER_BATCH )
+	{
+		size_t const	last	= std::min( first + PIECES_PER_BATCH, count );
+
+		HashPieces( first, last, hashes, valid );
+		for ( size_t i = first; i < last; ++i )
+		{
+			valid[i] = valid[i] && hashes[i] == pieces[i];
+		}
+	}
+	Unmap( m_size );
+
+	return std::find( valid.begin(), valid.end(), false ) == valid.end();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	files	Hashes of each file, in the order they were added
+//! @param	valid	True for each piece that is valid (output)
+//!
+//! A batch of pieces with missing data is checked again one piece at a time, so the pieces that are present are found.
+
+bool TorrentPieces::VerifyV2( std::vector< FileHashes > const & files, std::vector< bool > & valid )
+{
+	valid.assign( PieceCount( V2 ), false );
+	if ( !ValidV2() || files.size() != m_files.size() )
+		return false;
+
+	int const			pieceHeight	= Height( m_pieceSize / TorrentPieces::BLOCK_SIZE );
+	size_t const		batch		= std::max( LEAVES_PER_BATCH >> pieceHeight, size_t( 1 ) );
+	std::vector< Sha256 >	hashes( batch );
+	size_t				piece		= 0;
+
+	m_mapped = 0;
+	for ( size_t i = 0; i < m_files.size(); ++i )
+	{
+		File const &		file		= m_files[i];
+		FileHashes const &	expected	= files[i];
+		uint64_t const		pieces		= ( file.size + m_pieceSize - 1 ) / m_pieceSize;
+
+		if ( file.size > m_pieceSize )
+		{
+			if ( expected.layer.size() == pieces && LayerRoot( expected.layer, pieceHeight ) == expected.root )
+			{
+				for ( uint64_t first = 0; first < pieces; first += batch )
+				{
+					uint64_t const	last	= std::min( first + batch, pieces );
+
+					if ( HashPieces( i, first, last, hashes.data() ) )
+					{
+						for ( uint64_t j = first; j < last; ++j )
+						{
+							valid[ piece + size_t( j ) ] = hashes[ size_t( j - first ) ] == expected.layer[ size_t( j ) ];
+						}
+					}
+					else
+					{
+						for ( uint64_t j = first; j < last; ++j )
+						{
+							valid[ piece + size_t( j ) ] = HashPieces( i, j, j + 1, hashes.data() ) &&
+														   hashes[0] == expected.layer[ size_t( j ) ];
+						}
+					}
+				}
+			}
+		}
+		else if ( file.size > 0 )
+		{
+			valid[ piece ] = HashPieces( i, 0, 1, hashes.data() ) && hashes[0] == expected.root;
+		}
+
+		piece += size_t( pieces );
+		Unmap( file.offset + file.size );
+	}
+
+	return std::find( valid.begin(), valid.end(), false ) == valid.end();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	begin		Offset of the range in the set
+//! @param	end			Offset of the end of the range
+//! @param	segments	Data and size of each part of the range (output)
+
+bool TorrentPieces::Segments( uint64_t begin, uint64_t end,
+							  std::vector< std::pair< uint8_t const *, size_t > > & segments )
+{
+	// Find the last file starting at or before the beginning. Empty files are skipped below.
+
+	size_t	i	= size_t( std::upper_bound( m_files.begin(), m_files.end(), begin,
+										   []( uint64_t offset, File const & file ) { return offset < file.offset; } )
+						  - m_files.begin() ) - 1;
+
+	for ( ; begin < end; ++i )
+	{
+		File const &	file	= m_files[i];
+
+		if ( file.offset + file.size <= begin )
+			continue;
+
+		uint8_t const * const	data	= Map( i );
+
+		if ( data == nullptr )
+			return false;
+
+		uint64_t const	n	= std::min( end, file.offset + file.size ) - begin;
+
+		segments.emplace_back( data + ( begin - file.offset ), size_t( n ) );
+		begin += n;
+	}
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	file	Index of the file
+//!
+//! Mapping is only attempted once until the file is unmapped.
+
+uint8_t const * TorrentPieces::Map( size_t file )
+{
+	File &	f	= m_files[ file ];
+
+	if ( !f.opened )
+	{
+		f.opened = true;
+		f.mapping.reset( new MappedFile );
+		if ( !f.mapping->Open( f.path.c_str(), MappedFile::SEQUENTIAL ) || f.mapping->Size() < f.size )
+			f.mapping.reset();
+	}
+
+	return ( f.mapping != nullptr ) ? f.mapping->Data() : nullptr;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	offset	Offset in the set
+
+void TorrentPieces::Unmap( uint64_t offset )
+{
+	for ( ; m_mapped < m_files.size() && m_files[ m_mapped ].offset + m_files[ m_mapped ].size <= offset; ++m_mapped )
+	{
+		m_files[ m_mapped ].mapping.reset();
+		m_files[ m_mapped ].opened = false;
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	first		Index of the first piece
+//! @param	last		Index of the piece after the last one
+//! @param	hashes		Hash of each piece (output)
+//! @param	available	True for each piece whose data is all present (output)
+
+void TorrentPieces::HashPieces( size_t first, size_t last, std::vector< Sha1 > & hashes,
+								std::vector< bool > & available )
+{
+	std::vector< Segment >	segments;
+	std::vector< size_t >	starts;
+	std::vector< Message >	messages;
+
+	// The segments of every piece are found before any message is set up, since adding them may move them
+
+	for ( size_t i = first; i < last; ++i )
+	{
+		uint64_t const	begin	= uint64_t( i ) * m_pieceSize;
+
+		starts.push_back( segments.size() );
+		available[i] = Segments( begin, std::min( begin + m_pieceSize, m_size ), segments );
+		if ( !available[i] )
+			segments.resize( starts.back() );
+	}
+
+	for ( size_t i = first; i < last; ++i )
+	{
+		if ( available[i] )
+		{
+			uint64_t const	begin	= uint64_t( i ) * m_pieceSize;
+
+			messages.emplace_back();
+			Start( &segments[ starts[ i - first ] ], std::min( begin + m_pieceSize, m_size ) - begin, hashes[i].m_value,
+				   messages.back() );
+		}
+	}
+
+	Hash( Select( KernelRegistry::SHA1 ), messages.data(), messages.size() );
+	Unmap( uint64_t( last ) * m_pieceSize );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	file	Index of the file
+//! @param	first	Index of the first piece in the file
+//! @param	last	Index of the piece after the last one
+//! @param	hashes	Hash of each piece, or the root of the file's tree if it is no larger than a piece (output)
+//!
+//! Every piece but the file's last one is complete, so the leaves of the pieces can be reduced together: only the
+//! last piece has a node without a sibling at any level.
+
+bool TorrentPieces::HashPieces( size_t file, uint64_t first, uint64_t last, Sha256 * hashes )
+{
+	File const &			f		= m_files[ file ];
+	uint64_t const			begin	= f.offset + first * m_pieceSize;
+	uint64_t const			end		= std::min( f.offset + last * m_pieceSize, f.offset + f.size );
+	std::vector< Segment >	data;
+
+	if ( !Segments( begin, end, data ) )
+		return false;
+
+	size_t const					count	= size_t( ( end - begin + TorrentPieces::BLOCK_SIZE - 1 ) / TorrentPieces::BLOCK_SIZE );
+	std::vector< Segment >			blocks( count );
+	std::vector< Message >			messages( count );
+	std::vector< Sha256 >			leaves( count );
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		size_t const	offset	= i * TorrentPieces::BLOCK_SIZE;
+
+		blocks[i] = Segment( data[0].first + offset, std::min( data[0].second - offset, TorrentPieces::BLOCK_SIZE ) );
+		Start( &blocks[i], blocks[i].second, leaves[i].m_value, messages[i] );
+	}
+	Hash( Select( KernelRegistry::SHA256 ), messages.data(), count );
+
+	if ( f.size > m_pieceSize )
+		Reduce( leaves, 0, Height( m_pieceSize / TorrentPieces::BLOCK_SIZE ) );
+	else
+		Reduce( leaves, 0, Height( count ) );
+
+	std::copy( leaves.begin(), leaves.end(), hashes );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool TorrentPieces::ValidV2() const
+{
+	return m_pieceSize >= TorrentPieces::BLOCK_SIZE && ( m_pieceSize & ( m_pieceSize - 1 ) ) == 0;
+}
+
+
+} // namespace Crypto
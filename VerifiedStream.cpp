@@ -0,0 +1,552 @@
+/********************************************************************************************************************
+
+                                                  VerifiedStream.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/VerifiedStream.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "VerifiedStream.h"
+
+#include "Common.h"
+#include "MerkleTree.h"
+#include "Sha256Calculator.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+
+
+uint64_t const	CHUNK_SIZE	= Crypto::VerifiedStream::CHUNK_SIZE;
+uint64_t const	HEADER_SIZE	= Crypto::VerifiedStream::HEADER_SIZE;
+uint64_t const	NODE_SIZE	= Crypto::VerifiedStream::NODE_SIZE;
+uint64_t const	MAX_SIZE	= uint64_t( 1 ) << 62;	// Largest object, so the size of an encoding fits
+
+// An encoded object in memory
+
+struct Encoding
+{
+	uint64_t		size;		// Size of the object
+	uint64_t		chunks;		// Number of chunks
+	uint8_t const *	tree;		// Tree, after the header
+	uint8_t const *	data;		// Object for an outboard tree, or nullptr if the tree is combined
+};
+
+// Returns the number of chunks in an object
+
+uint64_t ChunkCount( uint64_t size )
+{
+	return std::max( ( size + CHUNK_SIZE - 1 ) / CHUNK_SIZE, uint64_t( 1 ) );
+}
+
+// Returns the number of bytes in chunks [first, first + count) of an object
+
+uint64_t ChunkBytes( uint64_t size, uint64_t first, uint64_t count )
+{
+	return std::min( ( first + count ) * CHUNK_SIZE, size ) - first * CHUNK_SIZE;
+}
+
+// Returns the number of chunks in the left subtree of a node with count chunks, which is at least 2. It is the
+// largest power of 2 less than count.
+
+uint64_t LeftCount( uint64_t count )
+{
+	uint64_t	k	= 1;
+
+	while ( k * 2 < count )
+	{
+		k *= 2;
+	}
+
+	return k;
+}
+
+// Returns the size of the encoding of chunks [first, first + count) of an object
+
+uint64_t SubtreeSize( uint64_t size, uint64_t first, uint64_t count, bool outboard )
+{
+	return NODE_SIZE * ( count - 1 ) + ( outboard ? 0 : ChunkBytes( size, first, count ) );
+}
+
+// Returns the hash of an object from the root of its tree
+
+Crypto::Sha256 Finalize( Crypto::Sha256 const & root, uint64_t size )
+{
+	uint8_t			message[ 1 + Crypto::Sha256::SIZE + 8 ];
+	Crypto::Sha256	hash;
+
+	message[ 0 ] = 0x02;
+	memcpy( message + 1, root.m_value, Crypto::Sha256::SIZE );
+	Crypto::StoreLittleEndian64( message + 1 + Crypto::Sha256::SIZE, size );
+	Crypto::Sha256Calculator().Calculate( message, sizeof( message ), hash.m_value );
+
+	return hash;
+}
+
+// Returns the hash of the subtree of chunks [first, first + count), or the hash of the object if the subtree is the
+// whole tree
+
+Crypto::Sha256 SubtreeHash( Crypto::Sha256 const & root, uint64_t size, uint64_t count )
+{
+	return ( count == ChunkCount( size ) ) ? Finalize( root, size ) : root;
+}
+
+// Computes the hash of the subtree of chunks [first, first + count) and writes its encoding if there is somewhere to
+// write it
+
+Crypto::Sha256 EncodeSubtree( uint8_t const * data, uint64_t size, uint64_t first, uint64_t count, uint8_t * encoded,
+							  bool outboard )
+{
+	if ( count == 1 )
+	{
+		uint8_t const * const	chunk		= data + first * CHUNK_SIZE;
+		size_t const			chunkSize	= size_t( ChunkBytes( size, first, 1 ) );
+
+		if ( encoded != nullptr && !outboard && chunkSize > 0 )
+			memcpy( encoded, chunk, chunkSize );
+
+		return Crypto::MerkleTree::HashLeaf( chunk, chunkSize );
+	}
+
+	uint64_t const			k		= LeftCount( count );
+	uint8_t * const			left	= ( encoded != nullptr ) ? encoded + NODE_SIZE : nullptr;
+	uint8_t * const			right	= ( encoded != nullptr ) ? left + SubtreeSize( size, first, k, outboard ) : nullptr;
+	Crypto::Sha256 const	l		= EncodeSubtree( data, size, first, k, left, outboard );
+	Crypto::Sha256 const	r		= EncodeSubtree( data, size, first + k, count - k, right, outboard );
+
+	if ( encoded != nullptr )
+	{
+		memcpy( encoded, l.m_value, Crypto::Sha256::SIZE );
+		memcpy( encoded + Crypto::Sha256::SIZE, r.m_value, Crypto::Sha256::SIZE );
+	}
+
+	return Crypto::MerkleTree::HashNode( l, r );
+}
+
+// Writes an encoding and returns the hash of the object
+
+Crypto::Sha256 EncodeObject( uint8_t const * data, size_t size, uint8_t * encoded, bool outboard )
+{
+	if ( encoded != nullptr )
+	{
+		Crypto::StoreLittleEndian64( encoded, size );
+		encoded += HEADER_SIZE;
+	}
+
+	return Finalize( EncodeSubtree( data, size, 0, ChunkCount( size ), encoded, outboard ), size );
+}
+
+// Verifies the subtree of chunks [first, first + count) at a position in the tree, and copies the part of
+// [offset, offset + size) in it to the output
+
+bool ReadSubtree( Encoding const & encoding, uint64_t position, Crypto::Sha256 const & hash, uint64_t first,
+				  uint64_t count, uint64_t offset, uint64_t size, uint8_t * output )
+{
+	if ( count == 1 )
+	{
+		uint64_t const			start		= first * CHUNK_SIZE;
+		uint8_t const * const	chunk		= ( encoding.data != nullptr ) ? encoding.data + start : encoding.tree + position;
+		size_t const			chunkSize	= size_t( ChunkBytes( encoding.size, first, 1 ) );
+
+		if ( SubtreeHash( Crypto::MerkleTree::HashLeaf( chunk, chunkSize ), encoding.size, count ) != hash )
+			return false;
+
+		uint64_t const	begin	= std::max( offset, start );
+		uint64_t const	end		= std::min( offset + size, start + chunkSize );
+
+		memcpy( output + ( begin - offset ), chunk + ( begin - start ), size_t( end - begin ) );
+		return true;
+	}
+
+	uint8_t const * const	node	= encoding.tree + position;
+	Crypto::Sha256			left;
+	Crypto::Sha256			right;
+
+	memcpy( left.m_value, node, Crypto::Sha256::SIZE );
+	memcpy( right.m_value, node + Crypto::Sha256::SIZE, Crypto::Sha256::SIZE );
+
+	if ( SubtreeHash( Crypto::MerkleTree::HashNode( left, right ), encoding.size, count ) != hash )
+		return false;
+
+	// Only the children that overlap the range are read
+
+	uint64_t const	k			= LeftCount( count );
+	uint64_t const	middle		= ( first + k ) * CHUNK_SIZE;
+	uint64_t const	rightStart	= position + NODE_SIZE + SubtreeSize( encoding.size, first, k, encoding.data != nullptr );
+
+	if ( offset < middle && !ReadSubtree( encoding, position + NODE_SIZE, left, first, k, offset, size, output ) )
+		return false;
+	if ( offset + size > middle && !ReadSubtree( encoding, rightStart, right, first + k, count - k, offset, size, output ) )
+		return false;
+
+	return true;
+}
+
+// Verifies and copies a range of an encoded object
+
+bool ReadRange( Crypto::Sha256 const & hash, uint8_t const * tree, size_t treeSize, uint8_t const * data,
+				uint64_t offset, size_t size, uint8_t * output )
+{
+	if ( treeSize < HEADER_SIZE )
+		return false;
+
+	Encoding const	encoding	= { Crypto::LoadLittleEndian64( tree ),
+									ChunkCount( Crypto::LoadLittleEndian64( tree ) ),
+									tree + HEADER_SIZE,
+									data };
+
+	if ( encoding.size > MAX_SIZE
+		 || HEADER_SIZE + SubtreeSize( encoding.size, 0, encoding.chunks, data != nullptr ) != treeSize
+		 || offset > encoding.size || size > encoding.size - offset )
+	{
+		return false;
+	}
+
+	if ( size == 0 )
+		return true;
+
+	return ReadSubtree( encoding, 0, hash, 0, encoding.chunks, offset, size, output );
+}
+
+
+} // anonymous namespace
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	hash		Hash of the object
+//! @param	receiver	Called with each verified chunk
+
+VerifiedStream::VerifiedStream( Sha256 const & hash, Receiver const & receiver )
+	: m_hash( hash ),
+	m_receiver( receiver ),
+	m_outboard( nullptr ),
+	m_outboardSize( 0 ),
+	m_outboardPosition( 0 ),
+	m_size( 0 ),
+	m_chunks( 0 ),
+	m_verified( 0 ),
+	m_started( false ),
+	m_failed( false )
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	hash			Hash of the object
+//! @param	outboard		Outboard tree of the object
+//! @param	outboardSize	Size of the outboard tree
+//! @param	receiver		Called with each verified chunk
+//!
+//! The size in the header is trusted only as far as it gives the shape of the tree. If it is wrong, the root does not
+//! match the hash and the stream fails.
+
+VerifiedStream::VerifiedStream( Sha256 const & hash, uint8_t const * outboard, size_t outboardSize,
+								Receiver const & receiver )
+	: m_hash( hash ),
+	m_receiver( receiver ),
+	m_outboard( outboard ),
+	m_outboardSize( outboardSize ),
+	m_outboardPosition( HEADER_SIZE ),
+	m_size( 0 ),
+	m_chunks( 0 ),
+	m_verified( 0 ),
+	m_started( true ),
+	m_failed( false )
+{
+	if ( outboardSize < HEADER_SIZE
+		 || LoadLittleEndian64( outboard ) > MAX_SIZE
+		 || outboardSize != OutboardSize( LoadLittleEndian64( outboard ) ) )
+	{
+		m_failed = true;
+		return;
+	}
+
+	m_size		= LoadLittleEndian64( outboard );
+	m_chunks	= ChunkCount( m_size );
+	m_pending.push_back( Subtree{ m_hash, 0, m_chunks } );
+	m_failed	= !( ( m_size > 0 ) ? Expand() : Consume( outboard ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Next part of the encoding, or of the object if there is an outboard tree
+//! @param	size	Size of the data
+//!
+//! Each complete part of the encoding is verified straight from the data if it is all there, and otherwise the pieces
+//! are held until the rest arrives.
+
+bool VerifiedStream::Write( uint8_t const * data, size_t size )
+{
+	while ( !m_failed && size > 0 )
+	{
+		size_t const	needed	= Needed();
+
+		if ( needed == 0 )
+		{
+			m_failed = true;
+			break;
+		}
+
+		uint8_t const *	part;
+
+		if ( m_buffer.empty() && size >= needed )
+		{
+			part	= data;
+			data	+= needed;
+			size	-= needed;
+		}
+		else
+		{
+			size_t const	n	= std::min( needed - m_buffer.size(), size );
+
+			m_buffer.insert( m_buffer.end(), data, data + n );
+			data	+= n;
+			size	-= n;
+			if ( m_buffer.size() < needed )
+				break;
+			part	= m_buffer.data();
+		}
+
+		m_failed = !Consume( part );
+		m_buffer.clear();
+	}
+
+	return !m_failed;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool VerifiedStream::Finish() const
+{
+	return !m_failed && m_started && m_pending.empty();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	size	Size of the object
+
+uint64_t VerifiedStream::EncodedSize( uint64_t size )
+{
+	return HEADER_SIZE + SubtreeSize( size, 0, ChunkCount( size ), false );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	size	Size of the object
+
+uint64_t VerifiedStream::OutboardSize( uint64_t size )
+{
+	return HEADER_SIZE + SubtreeSize( size, 0, ChunkCount( size ), true );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Object
+//! @param	size	Size of the object
+
+Sha256 VerifiedStream::Hash( uint8_t const * data, size_t size )
+{
+	return EncodeObject( data, size, nullptr, false );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data		Object
+//! @param	size		Size of the object
+//! @param	encoded		Where to put the encoding
+
+Sha256 VerifiedStream::Encode( uint8_t const * data, size_t size, uint8_t * encoded )
+{
+	return EncodeObject( data, size, encoded, false );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data		Object
+//! @param	size		Size of the object
+//! @param	outboard	Where to put the outboard tree
+
+Sha256 VerifiedStream::EncodeOutboard( uint8_t const * data, size_t size, uint8_t * outboard )
+{
+	return EncodeObject( data, size, outboard, true );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	hash			Hash of the object
+//! @param	encoded			Combined encoding of the object
+//! @param	encodedSize		Size of the encoding
+//! @param	offset			Offset of the range in the object
+//! @param	size			Size of the range
+//! @param	output			Where to put the range
+
+bool VerifiedStream::Read( Sha256 const & hash, uint8_t const * encoded, size_t encodedSize, uint64_t offset,
+						   size_t size, uint8_t * output )
+{
+	return ReadRange( hash, encoded, encodedSize, nullptr, offset, size, output );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	hash			Hash of the object
+//! @param	outboard		Outboard tree of the object
+//! @param	outboardSize	Size of the outboard tree
+//! @param	data			Object. Only the chunks that overlap the range are read.
+//! @param	offset			Offset of the range in the object
+//! @param	size			Size of the range
+//! @param	output			Where to put the range
+
+bool VerifiedStream::ReadOutboard( Sha256 const & hash, uint8_t const * outboard, size_t outboardSize,
+								   uint8_t const * data, uint64_t offset, size_t size, uint8_t * output )
+{
+	return ReadRange( hash, outboard, outboardSize, data, offset, size, output );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+size_t VerifiedStream::Needed() const
+{
+	if ( !m_started )
+		return HEADER_SIZE;
+
+	if ( m_pending.empty() )
+		return 0;
+
+	Subtree const &	next	= m_pending.back();
+
+	return ( next.count > 1 ) ? NODE_SIZE : size_t( ChunkBytes( m_size, next.first, 1 ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! An empty object has an empty chunk, which never arrives, so it is verified as soon as the size is known.
+
+bool VerifiedStream::Consume( uint8_t const * data )
+{
+	if ( !m_started )
+	{
+		m_started	= true;
+		m_size		= LoadLittleEndian64( data );
+		m_chunks	= ChunkCount( m_size );
+		if ( m_size > MAX_SIZE )
+			return false;
+		m_pending.push_back( Subtree{ m_hash, 0, m_chunks } );
+		return m_size > 0 || Consume( data );
+	}
+
+	Subtree const	next	= m_pending.back();
+
+	if ( next.count > 1 )
+		return Split( data );
+
+	size_t const	size	= size_t( ChunkBytes( m_size, next.first, 1 ) );
+
+	if ( SubtreeHash( MerkleTree::HashLeaf( data, size ), m_size, next.count ) != next.hash )
+		return false;
+
+	m_pending.pop_back();
+	m_receiver( next.first * CHUNK_SIZE, data, size );
+	m_verified += size;
+
+	return Expand();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool VerifiedStream::Split( uint8_t const * node )
+{
+	Subtree const	next	= m_pending.back();
+	uint64_t const	k		= LeftCount( next.count );
+	Sha256			left;
+	Sha256			right;
+
+	memcpy( left.m_value, node, Sha256::SIZE );
+	memcpy( right.m_value, node + Sha256::SIZE, Sha256::SIZE );
+
+	if ( SubtreeHash( MerkleTree::HashNode( left, right ), m_size, next.count ) != next.hash )
+		return false;
+
+	// The left subtree arrives first, so it goes on top
+
+	m_pending.back() = Subtree{ right, next.first + k, next.count - k };
+	m_pending.push_back( Subtree{ left, next.first, k } );
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+bool VerifiedStream::Expand()
+{
+	if ( m_outboard == nullptr )
+		return true;
+
+	while ( !m_pending.empty() && m_pending.back().count > 1 )
+	{
+		if ( !Split( m_outboard + m_outboardPosition ) )
+			return false;
+		m_outboardPosition += NODE_SIZE;
+	}
+
+	return true;
+}
+
+
+} // namespace Crypto
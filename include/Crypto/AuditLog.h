@@ -0,0 +1,181 @@
+/** @file *//********************************************************************************************************
+
+                                                      AuditLog.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/AuditLog.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "Sha256.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace Crypto
+{
+
+class MappedFile;
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! An append-only, tamper-evident log of records
+//
+//! Each record is protected two ways. First, the records form a hash chain: the chain hash of a record is
+//! SHA-256( previous chain hash || leaf hash ), where the leaf hash is that of a MerkleTree (RFC 6962) and the chain
+//! hash before the first record is all 0's. Second, the leaf hashes form a Merkle tree whose root is the tree head for
+//! a given size of the log, with inclusion proofs for records and consistency proofs between sizes (RFC 6962).
+//!
+//! Records are appended to segment files in a directory. Each segment file ("segment-NNNNNN.log") starts with "CLOG"
+//! and a version number, followed by records:
+//!
+//!		Size		Contents
+//!		4			Size of the record (n)
+//!		n			Record
+//!		32			Chain hash
+//!
+//! Every complete subtree of the Merkle tree is stored in "tree.hashes", which starts with "CTRE" and a version number.
+//! The hashes are in the order they are completed, so the position of any node can be computed from its level and
+//! index, and proofs are served from the stored nodes without hashing the records. Appending keeps only the roots of
+//! the complete subtrees along the right edge of the tree (the frontier), so each record costs its leaf hash plus,
+//! on average, one interior node. The interior nodes completed by a batch are hashed a level at a time with
+//! MerkleTree::HashNodes().
+//!
+//! The files are read through memory mappings. A record is written before its tree nodes, so when the log is opened,
+//! tree nodes past the last complete record are discarded and missing ones are recomputed from the records. The header
+//! of a new file is flushed as soon as the file is created, and a last segment or a tree file that holds only part of
+//! a header is created again. All values are little-endian.
+//!
+//! @note	An AuditLog is not thread-safe, and only one AuditLog may have a directory open at a time.
+
+class AuditLog
+{
+public:
+
+	//! Default maximum size of a segment file
+	static uint64_t const	DEFAULT_SEGMENT_SIZE	= uint64_t( 1 ) << 30;
+
+	//! Constructor
+	AuditLog();
+
+	//! Destructor. Flushes and closes the log.
+	~AuditLog();
+
+	//! Opens the log in an existing directory. Returns false if the files cannot be opened or are invalid.
+	bool Open( char const * directory, uint64_t maxSegmentSize = DEFAULT_SEGMENT_SIZE );
+
+	//! Flushes and closes the log. Returns false if any buffered data cannot be written.
+	bool Close();
+
+	//! Writes any buffered data to the files. Returns false if it fails.
+	bool Flush();
+
+	//! Returns the number of records
+	uint64_t Size() const									{ return m_records.size(); }
+
+	//! Appends a record. Returns false if it could not be written, in which case the log should be closed and opened
+	//! again.
+	bool Append( uint8_t const * data, size_t size );
+
+	//! Appends many records. Returns false if any could not be written, in which case the log should be closed and
+	//! opened again.
+	bool Append( uint8_t const * const * data, size_t const * sizes, size_t count );
+
+	//! Reads a record and checks its chain hash. Returns false if the index is out of range or the record is corrupt.
+	bool Get( uint64_t index, std::vector< uint8_t > & data );
+
+	//! Returns the chain hash of the last record
+	Sha256 const & Chain() const							{ return m_chain; }
+
+	//! Returns the tree head for the current size
+	Sha256 Root() const;
+
+	//! Returns the tree head for an earlier size. Returns false if the size is larger than the log.
+	bool Root( uint64_t size, Sha256 & root );
+
+	//! Returns the proof that a record is in the log at a given size. Returns false if the index or size is out of
+	//! range. The proof is verified with MerkleTree::Verify().
+	bool ProveInclusion( uint64_t index, uint64_t size, std::vector< Sha256 > & proof );
+
+	//! Returns the proof that the log at one size is a prefix of the log at a larger size. Returns false if the sizes
+	//! are out of range.
+	bool ProveConsistency( uint64_t first, uint64_t second, std::vector< Sha256 > & proof );
+
+	//! Returns true if a consistency proof shows that the first tree is a prefix of the second (RFC 9162)
+	static bool VerifyConsistency( uint64_t first, Sha256 const & firstRoot, uint64_t second,
+								   Sha256 const & secondRoot, Sha256 const * proof, size_t proofSize );
+
+private:
+
+	// Non-copyable
+	AuditLog( AuditLog const & ) = delete;
+	AuditLog & operator =( AuditLog const & ) = delete;
+
+	// Loads the records of a segment up to the first incomplete one
+	bool LoadSegment( uint32_t segment );
+
+	// Loads the tree, discards nodes past the last record, and recomputes any that are missing
+	bool LoadTree();
+
+	// Starts a new segment
+	bool StartSegment( uint32_t segment );
+
+	// Appends a record to the current segment and extends the chain
+	bool WriteRecord( uint8_t const * data, size_t size, Sha256 const & leaf );
+
+	// Adds leaves to the end of the tree, writing them and the nodes they complete, and updates the frontier
+	bool AddLeaves( Sha256 const * leaves, size_t count );
+
+	// Returns the record at an index, or nullptr if it cannot be mapped. size is set to the size of the record.
+	uint8_t const * Record( uint64_t index, uint32_t & size );
+
+	// Reads a complete node of the tree
+	bool ReadNode( int level, uint64_t index, Sha256 & hash );
+
+	// Computes the root of the subtree of leaves [first, last)
+	bool SubtreeRoot( uint64_t first, uint64_t last, Sha256 & root );
+
+	// Appends the inclusion proof of leaf index in the subtree [first, last)
+	bool Path( uint64_t index, uint64_t first, uint64_t last, std::vector< Sha256 > & proof );
+
+	// Appends the consistency proof of the first size leaves of the subtree [first, last)
+	bool Subproof( uint64_t size, uint64_t first, uint64_t last, bool complete, std::vector< Sha256 > & proof );
+
+	// Returns the name of a file in the directory
+	std::string FileName( char const * name ) const;
+
+	// Returns the name of a segment file
+	std::string SegmentName( uint32_t segment ) const;
+
+	// Returns true if a segment file exists
+	bool SegmentExists( uint32_t segment ) const;
+
+	std::string									m_directory;		// Directory holding the files
+	uint64_t									m_maxSegmentSize;	// Maximum size of a segment file
+	FILE *										m_segmentFile;		// Segment being written
+	FILE *										m_treeFile;			// Tree nodes being written
+	uint32_t									m_segment;			// Number of the segment being written
+	uint64_t									m_segmentSize;		// Size of the segment being written
+	uint64_t									m_leaves;			// Number of leaves in the tree
+	bool										m_dirty;			// True if data may be buffered
+	std::vector< std::unique_ptr< MappedFile > >	m_segments;		// Mapped segments
+	std::unique_ptr< MappedFile >				m_tree;				// Mapped tree nodes
+	std::vector< uint64_t >						m_records;			// Segment (high 16 bits) and offset of each record
+	Sha256										m_frontier[ 64 ];	// Root of the complete subtree at each level of the right edge
+	Sha256										m_chain;			// Chain hash of the last record
+};
+
+
+} // namespace Crypto
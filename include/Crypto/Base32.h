@@ -0,0 +1,81 @@
+/** @file *//********************************************************************************************************
+
+                                                       Base32.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Base32.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Base32 encoding and decoding (RFC 4648)
+//
+//! Base32 is typically used for content identifiers that must be case-insensitive, such as file names and DNS
+//! labels. The functions work on values of a known size, such as digests, so they do not need to allocate memory.
+//! Decoding is case-insensitive.
+//!
+//! Example:
+//! @code
+//!		char	text[ Base32::EncodedSize( Md5::SIZE ) ];
+//!		Base32::ToChars( md5.m_digest, Md5::SIZE, text, text + sizeof( text ) );
+//! @endcode
+
+class Base32
+{
+public:
+
+	//! Alphabets
+	enum Alphabet
+	{
+		STANDARD,	//!< A-Z and 2-7
+		LOWER		//!< a-z and 2-7 (as used by multibase content identifiers)
+	};
+
+	//! Returns the number of characters in the encoding of a value of the given size
+	static constexpr size_t EncodedSize( size_t size, bool padding = true )
+	{
+		return padding ? ( size + 4 ) / 5 * 8 : ( size * 8 + 4 ) / 5;
+	}
+
+	//! Encodes a value. Like std::to_chars, the result's ec is std::errc::value_too_large if the buffer is too small.
+	static std::to_chars_result ToChars( uint8_t const * data, size_t size, char * first, char * last,
+										 Alphabet alphabet = STANDARD, bool padding = true );
+
+	//! Decodes a value of the given size. The padding is optional. If the text is not valid, then the result's ec is
+	//! std::errc::invalid_argument and the value is undefined.
+	static std::from_chars_result FromChars( char const * first, char const * last, uint8_t * data, size_t size );
+
+	//! Returns the encoding of a value
+	static std::string Encode( uint8_t const * data, size_t size, Alphabet alphabet = STANDARD, bool padding = true );
+
+	//! Encodes @a count values of @a size bytes each. The encodings are stored consecutively in @a text, which must
+	//! hold count * EncodedSize( size, padding ) characters.
+	static void Encode( uint8_t const * data, size_t size, size_t count, char * text,
+						Alphabet alphabet = STANDARD, bool padding = true );
+
+	//! Decodes @a count values of @a size bytes each from consecutive encodings of EncodedSize( size, padding )
+	//! characters. Returns false if any of the encodings is not valid.
+	static bool Decode( char const * text, size_t size, size_t count, uint8_t * data, bool padding = true );
+};
+
+
+} // namespace Crypto
@@ -0,0 +1,84 @@
+/** @file *//********************************************************************************************************
+
+                                                       Base64.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Base64.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Base64 encoding and decoding (RFC 4648)
+//
+//! Base64 is typically used for digests in HTTP headers (Content-MD5, Digest) and subresource integrity. The
+//! functions work on values of a known size, such as digests, so they do not need to allocate memory. Bulk
+//! conversions use SSSE3 or AVX2 if the processor supports them.
+//!
+//! Example:
+//! @code
+//!		char	text[ Base64::EncodedSize( Md5::SIZE ) ];
+//!		Base64::ToChars( md5.m_digest, Md5::SIZE, text, text + sizeof( text ) );
+//! @endcode
+
+class Base64
+{
+public:
+
+	//! Alphabets
+	enum Alphabet
+	{
+		STANDARD,	//!< A-Z, a-z, 0-9, '+' and '/'
+		URL			//!< A-Z, a-z, 0-9, '-' and '_' (safe for URLs and file names)
+	};
+
+	//! Returns the number of characters in the encoding of a value of the given size
+	static constexpr size_t EncodedSize( size_t size, bool padding = true )
+	{
+		return padding ? ( size + 2 ) / 3 * 4 : ( size * 4 + 2 ) / 3;
+	}
+
+	//! Encodes a value. Like std::to_chars, the result's ec is std::errc::value_too_large if the buffer is too small.
+	static std::to_chars_result ToChars( uint8_t const * data, size_t size, char * first, char * last,
+										 Alphabet alphabet = STANDARD, bool padding = true );
+
+	//! Decodes a value of the given size. The padding is optional. If the text is not valid, then the result's ec is
+	//! std::errc::invalid_argument and the value is undefined.
+	static std::from_chars_result FromChars( char const * first, char const * last, uint8_t * data, size_t size,
+											 Alphabet alphabet = STANDARD );
+
+	//! Returns the encoding of a value
+	static std::string Encode( uint8_t const * data, size_t size, Alphabet alphabet = STANDARD, bool padding = true );
+
+	//! Encodes @a count values of @a size bytes each. The encodings are stored consecutively in @a text, which must
+	//! hold count * EncodedSize( size, padding ) characters. Small values are converted in batches, so the SIMD
+	//! kernels are used even for 16-byte values.
+	static void Encode( uint8_t const * data, size_t size, size_t count, char * text,
+						Alphabet alphabet = STANDARD, bool padding = true );
+
+	//! Decodes @a count values of @a size bytes each from consecutive encodings of EncodedSize( size, padding )
+	//! characters. Returns false if any of the encodings is not valid.
+	static bool Decode( char const * text, size_t size, size_t count, uint8_t * data,
+						Alphabet alphabet = STANDARD, bool padding = true );
+};
+
+
+} // namespace Crypto
@@ -0,0 +1,160 @@
+/** @file *//********************************************************************************************************
+
+                                                     ChunkStore.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/ChunkStore.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "ContentChunker.h"
+#include "DigestMap.h"
+#include "Sha256.h"
+
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace Crypto
+{
+
+class MappedFile;
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! A content-addressable store of chunks named by their SHA-256 digests
+//
+//! Chunks are appended to pack files in a directory. Each pack file ("pack-NNNNNN.pack") starts with "CPAK" and a
+//! version number, followed by records:
+//!
+//!		Size		Contents
+//!		4			Size of the chunk (n)
+//!		32			SHA-256 digest of the chunk
+//!		n			Chunk
+//!		4			CRC-32 of the preceding fields
+//!
+//! Each pack file has an index file ("pack-NNNNNN.idx") holding an entry for each record: the digest, the offset of
+//! the record, the size of the chunk, and a CRC-32 of the entry. All values are little-endian. The index files are
+//! loaded into a DigestMap when the store is opened, so the pack files are not read. A record is written before its
+//! index entry, so if the process is interrupted, the index can only be behind the pack. Any records past the last
+//! index entry are recovered when the store is opened. A partially-written record at the end of the last pack is left
+//! in place and ignored, and new records go into a new pack. A pack's header is flushed as soon as the pack is
+//! started, and if the last pack's header is incomplete, the pack is empty and is started again.
+//!
+//! Chunks are read through memory-mapped pack files, and the CRC-32 of each record is checked when it is read. A chunk
+//! that is already in the store is not written again. Objects are split at content-defined boundaries, so data that
+//! objects have in common is stored once, even if it is at different offsets.
+//!
+//! @note	A ChunkStore is not thread-safe, and only one ChunkStore may have a directory open at a time.
+
+class ChunkStore
+{
+public:
+
+	//! Default maximum size of a pack file
+	static uint64_t const	DEFAULT_PACK_SIZE	= uint64_t( 1 ) << 30;
+
+	//! Called by the batch Get() with the position of the digest in the request and the chunk. The data is only valid
+	//! during the call.
+	typedef std::function< void ( size_t i, uint8_t const * data, size_t size ) >	Receiver;
+
+	//! Constructor
+	ChunkStore();
+
+	//! Destructor. Flushes and closes the store.
+	~ChunkStore();
+
+	//! Opens the store in an existing directory. Returns false if the pack files or index files cannot be opened.
+	bool Open( char const * directory, uint64_t maxPackSize = DEFAULT_PACK_SIZE );
+
+	//! Flushes and closes the store. Returns false if any buffered data cannot be written.
+	bool Close();
+
+	//! Writes any buffered data to the files. Returns false if it fails.
+	bool Flush();
+
+	//! Returns the number of chunks in the store
+	size_t Size() const									{ return m_index.Size(); }
+
+	//! Returns true if the chunk is in the store
+	bool Contains( Sha256 const & digest ) const		{ return m_index.Contains( digest ); }
+
+	//! Stores a chunk and returns its digest. Returns false if it could not be written.
+	bool Put( uint8_t const * data, size_t size, Sha256 & digest );
+
+	//! Stores many chunks and returns their digests. Returns false if any could not be written.
+	bool Put( uint8_t const * const * data, size_t const * sizes, size_t count, Sha256 * digests );
+
+	//! Reads a chunk. Returns false if the chunk is not in the store or its record is corrupt.
+	bool Get( Sha256 const & digest, std::vector< uint8_t > & data );
+
+	//! Reads many chunks, in the order they are stored, and passes each one to the receiver. Returns the number read.
+	size_t Get( Sha256 const * digests, size_t count, Receiver const & receiver );
+
+	//! Splits an object into chunks with a ContentChunker and stores them. Returns the digests of the chunks, which are
+	//! needed to read the object. Returns false if a chunk could not be written.
+	bool PutObject( uint8_t const * data, size_t size, std::vector< Sha256 > & chunks );
+
+	//! Splits an object into chunks with the given chunker and stores them. See above.
+	bool PutObject( uint8_t const * data, size_t size, std::vector< Sha256 > & chunks, ContentChunker const & chunker );
+
+	//! Reads an object from the digests of its chunks. Returns false if a chunk is missing or corrupt.
+	bool GetObject( std::vector< Sha256 > const & chunks, std::vector< uint8_t > & data );
+
+private:
+
+	// Location of a record
+	struct Location
+	{
+		uint32_t	pack;		// Pack number
+		uint32_t	size;		// Size of the chunk
+		uint64_t	offset;		// Offset of the record in the pack
+	};
+
+	// Non-copyable
+	ChunkStore( ChunkStore const & ) = delete;
+	ChunkStore & operator =( ChunkStore const & ) = delete;
+
+	// Loads the index of a pack and recovers any records past its end
+	bool LoadPack( uint32_t pack );
+
+	// Starts a new pack
+	bool StartPack( uint32_t pack );
+
+	// Appends a chunk with a known digest to the current pack
+	bool Append( uint8_t const * data, size_t size, Sha256 const & digest );
+
+	// Returns the record at a location after checking its digest and CRC, or nullptr
+	uint8_t const * Record( Location const & location, Sha256 const & digest );
+
+	// Returns the name of a pack or index file
+	std::string FileName( uint32_t pack, char const * extension ) const;
+
+	// Returns true if a pack file exists
+	bool PackExists( uint32_t pack ) const;
+
+	std::string										m_directory;	// Directory holding the files
+	uint64_t										m_maxPackSize;	// Maximum size of a pack file
+	DigestMap< Sha256, Location >					m_index;		// Location of each chunk
+	std::vector< std::unique_ptr< MappedFile > >	m_packs;		// Mapped pack files (mapped when needed)
+	uint32_t										m_pack;			// Number of the pack being written
+	uint64_t										m_packSize;		// Size of the pack being written
+	FILE *											m_packFile;		// Pack being written
+	FILE *											m_indexFile;	// Index of the pack being written
+	bool											m_dirty;		// True if data has been written since the last flush
+};
+
+
+} // namespace Crypto
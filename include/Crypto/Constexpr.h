@@ -0,0 +1,377 @@
+/** @file *//********************************************************************************************************
+
+                                                      Constexpr.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Constexpr.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Crypto
+{
+
+//! Compile-time implementations of the digest algorithms
+//
+//! These functions are straightforward implementations that can be evaluated by the compiler. They are used by
+//! Crc32::Of(), Md5::Of(), Sha1::Of(), and Sha256::Of() to compute digests of literals and other constant data at
+//! compile time. They are much slower than the calculators at run time, so they should not be used on run-time data.
+
+namespace Constexpr
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+namespace Details
+{
+
+size_t const	BYTES_PER_CHUNK	= 64;
+
+// Table for the byte-at-a-time CRC-32 (see Crc32Calculator.h)
+
+struct Crc32Table
+{
+	constexpr Crc32Table()
+		: m_table()
+	{
+		for ( uint32_t i = 0; i < 256; ++i )
+		{
+			uint32_t	x	= i;
+
+			for ( int j = 0; j < 8; ++j )
+			{
+				x = ( x >> 1 ) ^ ( ( x & 1 ) ? 0xEDB88320 : 0 );
+			}
+
+			m_table[i] = x;
+		}
+	}
+
+	uint32_t	m_table[ 256 ];
+};
+
+inline constexpr Crc32Table	CRC32_TABLE;
+
+inline constexpr uint32_t	MD5_K[ 64 ] =
+{
+	0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+	0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+	0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+	0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+	0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+	0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+	0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+	0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+inline constexpr int		MD5_S[ 16 ]	= { 7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21 };
+
+inline constexpr uint32_t	SHA256_K[ 64 ] =
+{
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+constexpr uint32_t Rotl( uint32_t x, int n )
+{
+	return ( x << n ) | ( x >> ( 32 - n ) );
+}
+
+constexpr uint32_t Rotr( uint32_t x, int n )
+{
+	return ( x >> n ) | ( x << ( 32 - n ) );
+}
+
+// Returns the size of the message after padding with the 1 bit, the 0 bits and the 64-bit length
+
+constexpr size_t PaddedSize( size_t size )
+{
+	return ( size + 1 + 8 + BYTES_PER_CHUNK - 1 ) / BYTES_PER_CHUNK * BYTES_PER_CHUNK;
+}
+
+// Returns byte i of the padded message
+
+constexpr uint8_t PaddedByte( char const * data, size_t size, size_t i, bool bigEndian )
+{
+	size_t const	lengthOffset	= PaddedSize( size ) - 8;
+
+	if ( i < size )
+		return uint8_t( data[i] );
+	if ( i == size )
+		return 0x80;
+	if ( i < lengthOffset )
+		return 0;
+
+	uint64_t const	bits	= uint64_t( size ) * 8;
+	int const		j		= int( i - lengthOffset );
+
+	return uint8_t( bits >> ( bigEndian ? ( 7 - j ) * 8 : j * 8 ) );
+}
+
+// Returns 32-bit word i of the padded message
+
+constexpr uint32_t PaddedWord( char const * data, size_t size, size_t i, bool bigEndian )
+{
+	uint32_t	x	= 0;
+
+	for ( int j = 0; j < 4; ++j )
+	{
+		uint32_t const	b	= PaddedByte( data, size, i * 4 + j, bigEndian );
+		x |= bigEndian ? b << ( ( 3 - j ) * 8 ) : b << ( j * 8 );
+	}
+
+	return x;
+}
+
+} // namespace Details
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Returns the CRC-32 of the data. The result is the same as Crc32Calculator::Calculate().
+
+constexpr uint32_t Crc32( char const * data, size_t size )
+{
+	uint32_t	crc	= 0xFFFFFFFF;
+
+	for ( size_t i = 0; i < size; ++i )
+	{
+		crc = ( crc >> 8 ) ^ Details::CRC32_TABLE.m_table[ ( crc ^ uint8_t( data[i] ) ) & 0xFF ];
+	}
+
+	return ~crc;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Computes the MD5 digest of the data. @a digest must hold 16 bytes.
+
+constexpr void Md5( char const * data, size_t size, uint8_t * digest )
+{
+	uint32_t	h[ 4 ]	= { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+
+	for ( size_t chunk = 0; chunk < Details::PaddedSize( size ) / Details::BYTES_PER_CHUNK; ++chunk )
+	{
+		uint32_t	x[ 16 ]	= {};
+
+		for ( int i = 0; i < 16; ++i )
+		{
+			x[i] = Details::PaddedWord( data, size, chunk * 16 + i, false );
+		}
+
+		uint32_t	a	= h[0];
+		uint32_t	b	= h[1];
+		uint32_t	c	= h[2];
+		uint32_t	d	= h[3];
+
+		for ( int i = 0; i < 64; ++i )
+		{
+			uint32_t	f	= 0;
+			int			g	= 0;
+
+			switch ( i / 16 )
+			{
+			case 0:	f = ( b & c ) | ( ~b & d );	g = i;					break;
+			case 1:	f = ( b & d ) | ( c & ~d );	g = ( 5 * i + 1 ) % 16;	break;
+			case 2:	f = b ^ c ^ d;				g = ( 3 * i + 5 ) % 16;	break;
+			case 3:	f = c ^ ( b | ~d );			g = ( 7 * i ) % 16;		break;
+			}
+
+			uint32_t const	temp	= d;
+			d = c;
+			c = b;
+			b = b + Details::Rotl( a + f + Details::MD5_K[i] + x[g], Details::MD5_S[ ( i / 16 ) * 4 + i % 4 ] );
+			a = temp;
+		}
+
+		h[0] += a;
+		h[1] += b;
+		h[2] += c;
+		h[3] += d;
+	}
+
+	for ( int i = 0; i < 16; ++i )
+	{
+		digest[i] = uint8_t( h[ i / 4 ] >> ( ( i % 4 ) * 8 ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Computes the SHA-1 digest of the data. @a digest must hold 20 bytes.
+
+constexpr void Sha1( char const * data, size_t size, uint8_t * digest )
+{
+	uint32_t	h[ 5 ]	= { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+
+	for ( size_t chunk = 0; chunk < Details::PaddedSize( size ) / Details::BYTES_PER_CHUNK; ++chunk )
+	{
+		uint32_t	w[ 80 ]	= {};
+
+		for ( int i = 0; i < 16; ++i )
+		{
+			w[i] = Details::PaddedWord( data, size, chunk * 16 + i, true );
+		}
+
+		for ( int i = 16; i < 80; ++i )
+		{
+			w[i] = Details::Rotl( w[i-3] ^ w[i-8] ^ w[i-14] ^ w[i-16], 1 );
+		}
+
+		uint32_t	a	= h[0];
+		uint32_t	b	= h[1];
+		uint32_t	c	= h[2];
+		uint32_t	d	= h[3];
+		uint32_t	e	= h[4];
+
+		for ( int i = 0; i < 80; ++i )
+		{
+			uint32_t	f	= 0;
+			uint32_t	k	= 0;
+
+			if ( i < 20 )
+			{
+				f = d ^ ( b & ( c ^ d ) );
+				k = 0x5A827999;
+			}
+			else if ( i < 40 )
+			{
+				f = b ^ c ^ d;
+				k = 0x6ED9EBA1;
+			}
+			else if ( i < 60 )
+			{
+				f = ( b & c ) | ( d & ( b | c ) );
+				k = 0x8F1BBCDC;
+			}
+			else
+			{
+				f = b ^ c ^ d;
+				k = 0xCA62C1D6;
+			}
+
+			uint32_t const	temp	= Details::Rotl( a, 5 ) + f + e + k + w[i];
+			e = d;
+			d = c;
+			c = Details::Rotl( b, 30 );
+			b = a;
+			a = temp;
+		}
+
+		h[0] += a;
+		h[1] += b;
+		h[2] += c;
+		h[3] += d;
+		h[4] += e;
+	}
+
+	for ( int i = 0; i < 20; ++i )
+	{
+		digest[i] = uint8_t( h[ i / 4 ] >> ( ( 3 - i % 4 ) * 8 ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Computes the SHA-256 digest of the data. @a digest must hold 32 bytes.
+
+constexpr void Sha256( char const * data, size_t size, uint8_t * digest )
+{
+	uint32_t	h[ 8 ]	=
+	{
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+	};
+
+	for ( size_t chunk = 0; chunk < Details::PaddedSize( size ) / Details::BYTES_PER_CHUNK; ++chunk )
+	{
+		uint32_t	w[ 64 ]	= {};
+
+		for ( int i = 0; i < 16; ++i )
+		{
+			w[i] = Details::PaddedWord( data, size, chunk * 16 + i, true );
+		}
+
+		for ( int i = 16; i < 64; ++i )
+		{
+			uint32_t const	s0	= Details::Rotr( w[i-15],  7 ) ^ Details::Rotr( w[i-15], 18 ) ^ ( w[i-15] >>  3 );
+			uint32_t const	s1	= Details::Rotr( w[i- 2], 17 ) ^ Details::Rotr( w[i- 2], 19 ) ^ ( w[i- 2] >> 10 );
+
+			w[i] = w[i-16] + s0 + w[i-7] + s1;
+		}
+
+		uint32_t	a	= h[0];
+		uint32_t	b	= h[1];
+		uint32_t	c	= h[2];
+		uint32_t	d	= h[3];
+		uint32_t	e	= h[4];
+		uint32_t	f	= h[5];
+		uint32_t	g	= h[6];
+		uint32_t	hh	= h[7];
+
+		for ( int i = 0; i < 64; ++i )
+		{
+			uint32_t const	s0	= Details::Rotr( a, 2 ) ^ Details::Rotr( a, 13 ) ^ Details::Rotr( a, 22 );
+			uint32_t const	maj	= ( a & b ) | ( b & c ) | ( c & a );
+			uint32_t const	t0	= s0 + maj;
+			uint32_t const	s1	= Details::Rotr( e, 6 ) ^ Details::Rotr( e, 11 ) ^ Details::Rotr( e, 25 );
+			uint32_t const	ch	= ( e & f ) | ( ~e & g );
+			uint32_t const	t1	= hh + s1 + ch + Details::SHA256_K[i] + w[i];
+
+			hh	= g;
+			g	= f;
+			f	= e;
+			e	= d + t1;
+			d	= c;
+			c	= b;
+			b	= a;
+			a	= t0 + t1;
+		}
+
+		h[0] += a;
+		h[1] += b;
+		h[2] += c;
+		h[3] += d;
+		h[4] += e;
+		h[5] += f;
+		h[6] += g;
+		h[7] += hh;
+	}
+
+	for ( int i = 0; i < 32; ++i )
+	{
+		digest[i] = uint8_t( h[ i / 4 ] >> ( ( 3 - i % 4 ) * 8 ) );
+	}
+}
+
+
+} // namespace Constexpr
+} // namespace Crypto
@@ -0,0 +1,132 @@
+/** @file *//********************************************************************************************************
+
+                                                   ContentChunker.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/ContentChunker.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "Sha256.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+
+namespace Crypto
+{
+
+class Sha256Calculator;
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Splits data into chunks at boundaries determined by the content (FastCDC)
+//
+//! A boundary is placed after a byte when a gear hash of the 64 bytes ending with that byte has no bits set under a
+//! mask. Since a boundary depends only on the bytes around it, inserting or deleting data only changes the chunks
+//! near the change, and identical data in different places is split into identical chunks.
+//!
+//! Chunks are at least the minimum size and at most the maximum size. Chunking is normalized: the mask has two more
+//! bits before the average size and two fewer bits after it, which concentrates the sizes around the average.
+//!
+//! The hash at each position depends only on the window ending there, so the search for a boundary is split into
+//! four independent streams that are hashed together. This hides the latency of the hash and chunks at several
+//! GB/s. If digests are requested, each chunk's SHA-256 digest is computed as the chunk is scanned, while the data is
+//! still in the cache.
+//!
+//! @code
+//!		ContentChunker	chunker( 16 * 1024, 64 * 1024, 256 * 1024, true );
+//!		chunker.Process( data, size, []( uint8_t const * chunk, size_t size, Sha256 const * digest ) { ... } );
+//!		...
+//!		chunker.Finish( receiver );
+//! @endcode
+
+class ContentChunker
+{
+public:
+
+	//! Default minimum chunk size
+	static size_t const		DEFAULT_MIN_SIZE		= 16 * 1024;
+
+	//! Default average chunk size
+	static size_t const		DEFAULT_AVERAGE_SIZE	= 64 * 1024;
+
+	//! Default maximum chunk size
+	static size_t const		DEFAULT_MAX_SIZE		= 256 * 1024;
+
+	//! Number of bytes that determine whether there is a boundary at a position. It is the smallest minimum size.
+	static constexpr size_t	WINDOW_SIZE				= 64;
+
+	//! Called with each chunk and its digest, or nullptr if digests are not computed. The data is only valid during
+	//! the call.
+	typedef std::function< void ( uint8_t const * data, size_t size, Sha256 const * digest ) >	Receiver;
+
+	//! Constructor
+	ContentChunker( size_t minSize		= DEFAULT_MIN_SIZE,
+					size_t averageSize	= DEFAULT_AVERAGE_SIZE,
+					size_t maxSize		= DEFAULT_MAX_SIZE,
+					bool digests		= false );
+
+	//! Returns the size of the first chunk of data, which is all the data there is
+	size_t Cut( uint8_t const * data, size_t size ) const;
+
+	//! Splits data, which is all the data there is, into chunks
+	void Split( uint8_t const * data, size_t size, Receiver const & receiver ) const;
+
+	//! Splits the contents of a file into chunks. Returns false if the file cannot be read.
+	bool Split( char const * path, Receiver const & receiver ) const;
+
+	//! @name Chunking In Steps
+	//@{
+
+	//! Processes the next part of a stream. Any data after the last boundary that can be determined is held until the
+	//! next call.
+	void Process( uint8_t const * data, size_t size, Receiver const & receiver );
+
+	//! Passes the remaining data to the receiver as the final chunks of the stream, and resets the chunker
+	void Finish( Receiver const & receiver );
+
+	//! Discards any data held by the chunker
+	void Reset()									{ m_buffer.clear(); }
+
+	//@}
+
+	//! Returns the minimum chunk size
+	size_t MinSize() const							{ return m_minSize; }
+
+	//! Returns the average chunk size, which is rounded to a power of 2
+	size_t AverageSize() const						{ return m_averageSize; }
+
+	//! Returns the maximum chunk size
+	size_t MaxSize() const							{ return m_maxSize; }
+
+private:
+
+	// Finds the first boundary in data and passes the data before it to the hasher if there is one
+	size_t Next( uint8_t const * data, size_t size, Sha256Calculator * hasher ) const;
+
+	// Cuts the first chunk from data and passes it to the receiver. Returns its size.
+	size_t Emit( uint8_t const * data, size_t size, Receiver const & receiver ) const;
+
+	size_t					m_minSize;		// Minimum chunk size
+	size_t					m_averageSize;	// Average chunk size
+	size_t					m_maxSize;		// Maximum chunk size
+	uint64_t				m_smallMask;	// Mask for boundaries before the average size
+	uint64_t				m_largeMask;	// Mask for boundaries after the average size
+	bool					m_digests;		// True if digests are computed
+	std::vector< uint8_t >	m_buffer;		// Data held from the previous call to Process()
+};
+
+
+} // namespace Crypto
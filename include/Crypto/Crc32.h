@@ -13,7 +13,13 @@
 
 #pragma once
 
+#include "Constexpr.h"
+
+#include <charconv>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <iostream>
 
 
@@ -34,11 +40,14 @@ public:
 	//! Size of a CRC-32 value in bytes
 	static size_t const	SIZE = 4;
 
+	//! Number of characters in the text representation
+	static size_t const	TEXT_SIZE = SIZE * 2;
+
 	//! Default constructor
-	Crc32()	{}
+	constexpr Crc32() : m_value( 0 )	{}
 
 	//! Constructs a CRC-32 from a memory image
-	Crc32( unsigned __int8 const * pData, size_t size );
+	Crc32( uint8_t const * pData, size_t size );
 
 	//! Constructs an CRC-32 from a stream
 	Crc32( std::istream & stream );
@@ -49,18 +58,50 @@ public:
 	//! Constructs a CRC-32 from its 0-terminated text representation (up to 8 hex characters)
 	Crc32( char const * pText );
 
-	// Destructor
-	virtual ~Crc32() {}
+	//! Returns the CRC-32 of the data, computed at compile time if the data is constant
+	static constexpr Crc32 Of( std::string_view data );
 
 	//! Returns the value as a text representation (with leading 0's)
 	std::string ToString() const;
 
-	//! Equality operator
-	bool operator == ( Crc32 const & y ) const	{ return m_value == y.m_value; }
+	//! Writes the text representation to a buffer without allocating memory
+	std::to_chars_result ToChars( char * first, char * last ) const;
+
+	//! Parses a text representation of exactly TEXT_SIZE hex digits without allocating memory
+	static std::from_chars_result FromChars( char const * first, char const * last, Crc32 & value );
+
+	//! Comparison operators. Values are compared in the same order as their text.
+	constexpr bool operator == ( Crc32 const & y ) const	{ return m_value == y.m_value; }
+	constexpr bool operator != ( Crc32 const & y ) const	{ return m_value != y.m_value; }
+	constexpr bool operator <  ( Crc32 const & y ) const	{ return m_value <  y.m_value; }
+	constexpr bool operator >  ( Crc32 const & y ) const	{ return m_value >  y.m_value; }
+	constexpr bool operator <= ( Crc32 const & y ) const	{ return m_value <= y.m_value; }
+	constexpr bool operator >= ( Crc32 const & y ) const	{ return m_value >= y.m_value; }
 
-	unsigned __int32 m_value;	//!< Value
+	uint32_t m_value;			//!< Value
 };
 
+static_assert( std::is_trivially_copyable< Crc32 >::value, "Crc32 must be trivially copyable." );
+static_assert( sizeof( Crc32 ) == Crc32::SIZE, "Crc32 must be no larger than its value." );
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Data to hash. Any string literal or std::string_view with constant contents can be hashed at
+//!					compile time, so the value can be used as a case label, e.g.
+//!					@code case Crc32::Of( "key" ).m_value: @endcode
+
+inline constexpr Crc32 Crc32::Of( std::string_view data )
+{
+	Crc32	result;
+
+	result.m_value = Constexpr::Crc32( data.data(), data.size() );
+
+	return result;
+}
+
 
 /********************************************************************************************************************/
 /*																													*/
@@ -73,7 +114,10 @@ public:
 
 inline std::ostream & operator<<( std::ostream & stream, Crc32 const & crc32 )
 {
-	stream << crc32.ToString();
+	char	text[ Crc32::TEXT_SIZE ];
+
+	crc32.ToChars( text, text + sizeof( text ) );
+	stream << std::string_view( text, sizeof( text ) );
 
 	return stream;
 }
@@ -100,4 +144,27 @@ inline std::istream & operator>>( std::istream & stream, Crc32 & crc32 )
 }
 
 
-} // namespace Crypto
\ No newline at end of file
+} // namespace Crypto
+
+
+namespace std
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Hashes a CRC-32 by using its value
+
+template<>
+struct hash< Crypto::Crc32 >
+{
+	size_t operator()( Crypto::Crc32 const & crc32 ) const noexcept
+	{
+		return crc32.m_value;
+	}
+};
+
+
+} // namespace std
\ No newline at end of file
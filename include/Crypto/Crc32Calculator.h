@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <istream>
 
@@ -47,11 +48,11 @@ namespace Crypto
 //! as 0x04C11DB7.
 //!
 //! @code
-//!		unsigned __int32 const	POLYNOMIAL	= 0xEDB88320;
+//!		uint32_t const			POLYNOMIAL	= 0xEDB88320;
 //!
 //!		for	( int i	= 0; i < 256; i++ )
 //!		{
-//!			unsigned __int32		x;
+//!			uint32_t				x;
 //!
 //!			x = i;
 //!
@@ -74,6 +75,15 @@ class Crc32Calculator
 {
 public:
 
+	//! A change to a range of bytes, for Update()
+	struct Edit
+	{
+		uint64_t		offset;		//!< Offset of the first byte in the range
+		uint8_t const *	before;		//!< Old values of the bytes
+		uint8_t const *	after;		//!< New values of the bytes
+		size_t			size;		//!< Number of bytes in the range
+	};
+
 	//! Constructor
 	Crc32Calculator();
 
@@ -81,16 +91,48 @@ public:
 	virtual ~Crc32Calculator();
 
 	//! Returns a CRC-32 value from a buffer of a given size.
-	unsigned __int32 Calculate( unsigned __int8 const * paData, size_t size );
+	uint32_t Calculate( uint8_t const * paData, size_t size );
 
 	//! Returns a CRC-32 value from an input stream.
-	unsigned __int32 Calculate( std::istream & stream );
+	uint32_t Calculate( std::istream & stream );
 
 	//! Returns a CRC-32 value from a C string.
-	unsigned __int32 Calculate( char const * string );
+	uint32_t Calculate( char const * string );
 
 	//! Returns a CRC-32 value from a string.
-	unsigned __int32 Calculate( std::string const & string );
+	uint32_t Calculate( std::string const & string );
+
+	//! Computes the CRC-32 of a file, skipping the holes in a sparse file. Returns false if the file cannot be read.
+	bool CalculateFile( char const * path, uint32_t * pCrc );
+
+	//! Returns the CRC-32 of a buffer after bytes in it are changed, given its CRC-32 before the changes.
+	static uint32_t Update( uint32_t crc, uint64_t size, Edit const * edits, size_t count );
+
+	//! Returns the CRC-32 of a buffer after a range of bytes in it is changed, given its CRC-32 before the change.
+	static uint32_t Update( uint32_t crc, uint64_t size, uint64_t offset, uint8_t const * before,
+							uint8_t const * after, size_t n );
+
+	//! Returns the CRC-32 of two buffers one after the other, given the CRC-32 of each.
+	static uint32_t Combine( uint32_t first, uint32_t second, uint64_t secondSize );
+
+	//! @name Batches
+	//@{
+
+	//! Computes the CRC-32 values of buffers of the same size
+	static void CalculateBatch( uint8_t const * const * buffers, size_t size, size_t count, uint32_t * crcs );
+
+	//! Computes the CRC-32 values of buffers of different sizes
+	static void CalculateBatch( uint8_t const * const * buffers, size_t const * sizes, size_t count, uint32_t * crcs );
+
+	//! Checks the CRC-32 values of buffers of the same size. Returns the number of buffers that fail.
+	static size_t VerifyBatch( uint8_t const * const * buffers, size_t size, size_t count, uint32_t const * expected,
+							   uint64_t * failures );
+
+	//! Checks the CRC-32 values of buffers of different sizes. Returns the number of buffers that fail.
+	static size_t VerifyBatch( uint8_t const * const * buffers, size_t const * sizes, size_t count,
+							   uint32_t const * expected, uint64_t * failures );
+
+	//@}
 
 	//! @name Computation In Steps
 	//@{
@@ -99,29 +141,54 @@ public:
 	void Reset();
 
 	//! Updates the CRC with the given character.
-	void Process( unsigned __int8 c );
+	void Process( uint8_t c );
 
 	//! Updates the CRC with a buffer.
-	void Process( unsigned __int8 const * paData, size_t size );
+	void Process( uint8_t const * paData, size_t size );
 
 	//! Updates the CRC with a stream.
 	void Process( std::istream & stream );
 
+	//! Updates the CRC with a run of 0's, in time proportional to the log of the size.
+	void ProcessZeros( uint64_t size );
+
+	//! Updates the CRC with the contents of a file, skipping the holes in a sparse file. Returns false if the file
+	//! cannot be read.
+	bool ProcessFile( char const * path );
+
 	//! Finalizes a CRC.
-	void Finalize( unsigned __int32 * pCrc );
+	void Finalize( uint32_t * pCrc );
 
 	//@}
 
 private:
-	
-	unsigned __int32	m_crc;
+
+	// Size of the buffer used to read streams
+	static int const	STREAM_BUFFER_SIZE	= 4096;
+
+	// Size of the buffer used to read files
+	static size_t const	FILE_BUFFER_SIZE	= 1024 * 1024;
+
+	uint32_t			m_crc;
+	void				( *m_kernel )( uint32_t *, uint8_t const *, size_t );	// Kernel (see Kernels.h)
 
 	static int const	LOOKUP_TABLE_SIZE	= 256;
 
+	// Returns the CRC register after size 0's are processed
+	static uint32_t Shift( uint32_t crc, uint64_t size );
+
+	// Computes the CRC-32 values of a batch. The size of buffer i is sizes[i * step].
+	static void Batch( uint8_t const * const * buffers, size_t const * sizes, size_t step, size_t count,
+					   uint32_t * crcs );
+
+	// Checks the CRC-32 values of a batch. The size of buffer i is sizes[i * step].
+	static size_t Verify( uint8_t const * const * buffers, size_t const * sizes, size_t step, size_t count,
+						  uint32_t const * expected, uint64_t * failures );
+
 	// Generates the CRC32 lookup table.
-	static void GenerateLookupTable( unsigned __int32 aTable[ LOOKUP_TABLE_SIZE ] );
+	static void GenerateLookupTable( uint32_t aTable[ LOOKUP_TABLE_SIZE ] );
 
-	static unsigned __int32	m_lookupTable[ LOOKUP_TABLE_SIZE ];	// The lookup table
+	static uint32_t			m_lookupTable[ LOOKUP_TABLE_SIZE ];	// The lookup table
 
 };
 
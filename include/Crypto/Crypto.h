@@ -23,11 +23,33 @@ namespace Crypto
 {
 }
 
+#include "AuditLog.h"
+#include "Base32.h"
+#include "Base64.h"
+#include "ChunkStore.h"
+#include "Constexpr.h"
+#include "ContentChunker.h"
 #include "Crc32.h"
 #include "Crc32Calculator.h"
+#include "Delta.h"
+#include "Digest.h"
+#include "DigestIndex.h"
+#include "DigestMap.h"
+#include "DigestSort.h"
+#include "Drbg.h"
+#include "GitObject.h"
+#include "Hkdf.h"
+#include "Hmac.h"
+#include "KernelRegistry.h"
 #include "Md5.h"
 #include "Md5Calculator.h"
+#include "MerkleTree.h"
+#include "MultipartETag.h"
+#include "Pbkdf2.h"
+#include "Scrypt.h"
 #include "Sha1.h"
 #include "Sha1Calculator.h"
 #include "Sha256.h"
 #include "Sha256Calculator.h"
+#include "TorrentPieces.h"
+#include "VerifiedStream.h"
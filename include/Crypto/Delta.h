@@ -0,0 +1,145 @@
+/** @file *//********************************************************************************************************
+
+                                                        Delta.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Delta.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! The signature of a file, used to compute a delta against it (rsync)
+//
+//! The file is divided into blocks of a fixed size (the last one may be shorter). Each block has a weak checksum that
+//! can be rolled along a buffer one byte at a time, and a strong digest that confirms a match. The strong digest is
+//! an MD5 digest or the first 16 bytes of a SHA-256 digest. The weak checksums are computed with AVX2 if the processor
+//! supports it.
+//!
+//! The replica that has the old file sends its signature to the replica that has the new file, which computes a
+//! delta and sends it back:
+//!
+//! @code
+//!		BlockSignature	signature;
+//!		signature.Generate( oldData, oldSize );
+//!		signature.Serialize( message );
+//!		...
+//!		signature.Deserialize( message.data(), message.size() );
+//!		Delta::Compute( signature, newData, newSize, delta );
+//!		...
+//!		Delta::Apply( oldData, oldSize, delta.data(), delta.size(), newFile );
+//! @endcode
+
+class BlockSignature
+{
+public:
+
+	//! Strong digests
+	enum StrongDigest
+	{
+		MD5,		//!< MD5
+		SHA256		//!< SHA-256, truncated to 16 bytes
+	};
+
+	//! Default block size
+	static size_t const		DEFAULT_BLOCK_SIZE	= 4096;
+
+	//! Size of a strong digest
+	static size_t const		STRONG_SIZE			= 16;
+
+	//! Checksums of a block
+	struct Block
+	{
+		uint32_t	weak;						//!< Weak checksum
+		uint8_t		strong[ STRONG_SIZE ];		//!< Strong digest
+	};
+
+	//! Constructor
+	BlockSignature();
+
+	//! Generates the signature of a file
+	void Generate( uint8_t const * data, size_t size, size_t blockSize = DEFAULT_BLOCK_SIZE,
+				   StrongDigest strong = SHA256 );
+
+	//! Appends the signature to a buffer in a portable format
+	void Serialize( std::vector< uint8_t > & buffer ) const;
+
+	//! Loads a signature created by Serialize(). Returns false if it is invalid.
+	bool Deserialize( uint8_t const * data, size_t size );
+
+	//! Returns the block size
+	size_t BlockSize() const							{ return m_blockSize; }
+
+	//! Returns the size of the file
+	uint64_t FileSize() const							{ return m_fileSize; }
+
+	//! Returns the kind of strong digest
+	StrongDigest Strong() const							{ return m_strong; }
+
+	//! Returns the checksums of the blocks
+	std::vector< Block > const & Blocks() const			{ return m_blocks; }
+
+	//! Returns the weak checksum of a buffer. The low 16 bits are the sum of the bytes, and the high 16 bits are the sum
+	//! of the running sums.
+	static uint32_t ComputeWeak( uint8_t const * data, size_t size );
+
+	//! Computes the strong digest of a buffer
+	void ComputeStrong( uint8_t const * data, size_t size, uint8_t * digest ) const;
+
+private:
+
+	size_t					m_blockSize;	// Size of a block
+	uint64_t				m_fileSize;		// Size of the file
+	StrongDigest			m_strong;		// Kind of strong digest
+	std::vector< Block >	m_blocks;		// Checksums of each block
+};
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Computes and applies deltas between versions of a file (rsync)
+//
+//! A delta is computed from the signature of the old file and the contents of the new file. A rolling weak checksum
+//! is slid over the new file one byte at a time. When it matches the weak checksum of a block, the strong digest
+//! confirms the match and the block is copied from the old file instead of being sent. Everything else is sent as
+//! literal data.
+//!
+//! A delta starts with "CDLT", a version number, the block size, the sizes of the old and new files and the SHA-256
+//! digest of the new file, and Apply() checks the files against them. The rest is a sequence of operations, each of
+//! which is either a run of blocks to copy from the old file or literal data.
+
+class Delta
+{
+public:
+
+	//! Computes the delta that turns the file with the signature into the given data
+	static void Compute( BlockSignature const & signature, uint8_t const * data, size_t size,
+						 std::vector< uint8_t > & delta );
+
+	//! Applies a delta to a file. Returns false if the delta is invalid, was not computed against this file, or does
+	//! not produce the expected result.
+	static bool Apply( uint8_t const * base, size_t baseSize, uint8_t const * delta, size_t deltaSize,
+					   std::vector< uint8_t > & result );
+};
+
+
+} // namespace Crypto
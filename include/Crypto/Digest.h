@@ -0,0 +1,117 @@
+/** @file *//********************************************************************************************************
+
+                                                       Digest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Digest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+namespace Crypto
+{
+
+//! Helpers shared by the digest value types
+//
+//! A digest is already uniformly distributed, so it can be hashed by taking one of its words, and digests can be
+//! ordered by comparing them a word at a time. The order is the same as the order of their text representations.
+
+namespace Digest
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Loads 8 bytes as a big-endian value, so that comparing two values gives the same result as memcmp
+
+inline uint64_t LoadWord( uint8_t const * p )
+{
+	uint64_t	x;
+
+	memcpy( &x, p, sizeof( x ) );
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return x;
+#elif defined( _MSC_VER )
+	return _byteswap_uint64( x );
+#else
+	return __builtin_bswap64( x );
+#endif
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Returns true if two digests are equal
+
+template< size_t SIZE >
+inline bool Equal( uint8_t const ( & x )[ SIZE ], uint8_t const ( & y )[ SIZE ] )
+{
+	return memcmp( x, y, SIZE ) == 0;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Compares two digests a word at a time. Returns <0, 0 or >0, like memcmp.
+
+template< size_t SIZE >
+inline int Compare( uint8_t const ( & x )[ SIZE ], uint8_t const ( & y )[ SIZE ] )
+{
+	size_t	i	= 0;
+
+	for ( ; i + 8 <= SIZE; i += 8 )
+	{
+		uint64_t const	a	= LoadWord( x + i );
+		uint64_t const	b	= LoadWord( y + i );
+
+		if ( a != b )
+			return ( a < b ) ? -1 : 1;
+	}
+
+	for ( ; i < SIZE; ++i )
+	{
+		if ( x[i] != y[i] )
+			return ( x[i] < y[i] ) ? -1 : 1;
+	}
+
+	return 0;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Returns a hash of a digest, which is simply its first word
+
+template< size_t SIZE >
+inline size_t Hash( uint8_t const ( & x )[ SIZE ] )
+{
+	static_assert( SIZE >= sizeof( size_t ), "The digest is smaller than a hash value." );
+
+	size_t	hash;
+
+	memcpy( &hash, x, sizeof( hash ) );
+
+	return hash;
+}
+
+
+} // namespace Digest
+} // namespace Crypto
@@ -0,0 +1,181 @@
+/** @file *//********************************************************************************************************
+
+                                                     DigestIndex.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/DigestIndex.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Crypto
+{
+
+class MappedFile;
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! A read-only, memory-mapped file of sorted digests
+//
+//! The file is a header followed by the digests, sorted and without duplicates, each taking exactly DigestSize()
+//! bytes. The header holds a fan-out table (like the one in a git pack index) giving, for each value of the first
+//! byte, the number of digests whose first byte is less than or equal to it. All values are little-endian.
+//!
+//!		Offset	Size		Contents
+//!		0		4			"CDIX"
+//!		4		4			Version (1)
+//!		8		4			Size of a digest in bytes
+//!		12		4			Reserved (0)
+//!		16		8			Number of digests
+//!		24		8 * 256		Fan-out table
+//!		2072	n * size	Digests
+//!
+//! Opening the file only maps it and checks the header, so it costs nothing regardless of the size of the file, and
+//! the only memory used is the page cache. Digests are uniformly distributed, so a lookup narrows the range given by
+//! the fan-out table with interpolation search and usually touches only a few pages.
+//!
+//! Digests are compared as byte strings. For Crc32 this is the order of the bytes in memory, not of the value.
+
+class DigestIndex
+{
+public:
+
+	//! Position returned by Find() when the digest is not in the index
+	static constexpr size_t	NOT_FOUND = ~size_t( 0 );
+
+	//! Constructor
+	DigestIndex();
+
+	//! Destructor
+	~DigestIndex();
+
+	//! Maps an index file. Returns false if the file cannot be mapped or is not a valid index.
+	bool Open( char const * path );
+
+	//! Unmaps the file
+	void Close();
+
+	//! Returns true if a file is mapped
+	bool IsOpen() const					{ return m_digests != nullptr; }
+
+	//! Returns the number of digests
+	size_t Size() const					{ return m_count; }
+
+	//! Returns the size of a digest in bytes
+	size_t DigestSize() const			{ return m_digestSize; }
+
+	//! Returns the digest at a position
+	uint8_t const * Digest( size_t i ) const	{ return m_digests + i * m_digestSize; }
+
+	//! Returns the position of a digest of DigestSize() bytes, or NOT_FOUND
+	size_t Find( uint8_t const * digest ) const;
+
+	//! Returns the position of a digest, or NOT_FOUND
+	template< typename Key >
+	size_t Find( Key const & key ) const;
+
+	//! Finds many digests of DigestSize() bytes. The queries are sorted and merged with the index, so each search
+	//! starts where the previous one ended. Sets positions[i] to the position of the i'th digest, or NOT_FOUND.
+	//! Returns the number found.
+	size_t Find( uint8_t const * digests, size_t count, size_t * positions ) const;
+
+	//! Finds many digests. See above.
+	template< typename Key >
+	size_t Find( Key const * keys, size_t count, size_t * positions ) const;
+
+	//! Writes an index of digests of size bytes. The digests can be in any order and may contain duplicates.
+	//! Returns false if the file cannot be written.
+	static bool Write( char const * path, uint8_t const * digests, size_t size, size_t count );
+
+	//! Writes an index of digests. See above.
+	template< typename Key >
+	static bool Write( char const * path, Key const * keys, size_t count );
+
+private:
+
+	// Non-copyable
+	DigestIndex( DigestIndex const & ) = delete;
+	DigestIndex & operator =( DigestIndex const & ) = delete;
+
+	// Returns the position of the first digest in [first, last) that is not less than the digest. The prefixes of the
+	// digests in the range must be in [low, high].
+	size_t LowerBound( uint8_t const * digest, size_t first, size_t last, uint64_t low, uint64_t high ) const;
+
+	// Returns the first 8 bytes of a digest as a big-endian value, for interpolation
+	uint64_t Prefix( uint8_t const * digest ) const;
+
+	MappedFile *	m_file;				// The mapped file
+	uint8_t const *	m_digests;			// Sorted digests
+	size_t			m_count;			// Number of digests
+	size_t			m_digestSize;		// Size of a digest in bytes
+	uint64_t		m_fanOut[ 256 ];	// Number of digests whose first byte is less than or equal to the index
+};
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	key		Digest (Crc32, Md5, Sha1 or Sha256). Its size must match DigestSize().
+
+template< typename Key >
+inline size_t DigestIndex::Find( Key const & key ) const
+{
+	if ( sizeof( Key ) != m_digestSize )
+		return NOT_FOUND;
+
+	return Find( reinterpret_cast< uint8_t const * >( &key ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	keys		Digests (Crc32, Md5, Sha1 or Sha256). Their size must match DigestSize().
+//! @param	count		Number of digests
+//! @param	positions	Positions of the digests (output)
+
+template< typename Key >
+inline size_t DigestIndex::Find( Key const * keys, size_t count, size_t * positions ) const
+{
+	if ( sizeof( Key ) != m_digestSize )
+	{
+		for ( size_t i = 0; i < count; ++i )
+		{
+			positions[i] = NOT_FOUND;
+		}
+		return 0;
+	}
+
+	return Find( reinterpret_cast< uint8_t const * >( keys ), count, positions );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	path	Name of the file
+//! @param	keys	Digests (Crc32, Md5, Sha1 or Sha256)
+//! @param	count	Number of digests
+
+template< typename Key >
+inline bool DigestIndex::Write( char const * path, Key const * keys, size_t count )
+{
+	return Write( path, reinterpret_cast< uint8_t const * >( keys ), sizeof( Key ), count );
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,818 @@
+/** @file *//********************************************************************************************************
+
+                                                      DigestMap.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/DigestMap.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define CRYPTO_DIGEST_TABLE_SSE2 1
+#include <emmintrin.h>
+#else
+#define CRYPTO_DIGEST_TABLE_SSE2 0
+#endif
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+
+namespace Crypto
+{
+namespace Details
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! An open-addressing hash table of slots keyed by a digest
+//
+//! The slots are kept in a single array, divided into groups of 16. Each slot has a control byte holding a 7-bit
+//! fingerprint of its key, or a marker for an empty or deleted slot. A lookup compares the fingerprint with the 16
+//! control bytes of a group at once, and only compares keys where the fingerprints match. Digests are uniformly
+//! distributed, so the group is taken straight from the bits of the digest (see std::hash for the digest types).
+//!
+//! @param	Key		Digest type (Crc32, Md5, Sha1 or Sha256)
+//! @param	Slot	Type of a slot. It must be default-constructible and have a member named @p key.
+
+template< typename Key, typename Slot >
+class DigestTable
+{
+public:
+
+	//! Number of slots in a group
+	static size_t const	GROUP_SIZE = 16;
+
+	//! Number of keys ahead that the bulk operations prefetch. The control bytes are prefetched twice as far ahead.
+	static size_t const	PREFETCH_DISTANCE = 16;
+
+	//! Constructor
+	DigestTable() : m_size( 0 ), m_available( 0 ), m_groupMask( 0 )	{}
+
+	//! Returns the number of entries
+	size_t Size() const					{ return m_size; }
+
+	//! Returns the number of slots
+	size_t Capacity() const				{ return m_slots.size(); }
+
+	//! Makes room for at least the given number of entries without growing
+	void Reserve( size_t count );
+
+	//! Removes all entries and frees the memory
+	void Clear();
+
+	//! Returns the slot with the given key, or nullptr if there is none
+	Slot * Find( Key const & key );
+
+	//! Returns the slot with the given key, or nullptr if there is none
+	Slot const * Find( Key const & key ) const;
+
+	//! Returns the slot with the given key, adding it if it is not there. The bool is true if the slot was added.
+	std::pair< Slot *, bool > Insert( Key const & key );
+
+	//! Removes the slot with the given key. Returns false if there is none.
+	bool Erase( Key const & key );
+
+	//! Prefetches the control bytes that a lookup of the key will touch first
+	void PrefetchControl( Key const & key ) const;
+
+	//! Prefetches the first slot whose fingerprint matches the key. The control bytes should already be in the cache.
+	void PrefetchSlot( Key const & key ) const;
+
+	//! Runs f( i ) for i = 0 .. count-1, prefetching the control bytes and then the slots for keys[i] ahead of time
+	template< typename Function >
+	void Pipeline( Key const * keys, size_t count, Function f ) const;
+
+	//! Calls f( slot ) for each slot in use
+	template< typename Function >
+	void ForEach( Function f ) const;
+
+private:
+
+	typedef uint32_t	Mask;
+
+	static constexpr int8_t	EMPTY	= -128;
+	static constexpr int8_t	DELETED	= -2;
+
+	// Returns a bit for each control byte in the group equal to value
+	static Mask Match( int8_t const * control, int8_t value );
+
+	// Returns a bit for each control byte in the group that is empty or deleted
+	static Mask MatchAvailable( int8_t const * control );
+
+	// Hints that the memory at p will be read soon
+	static void PrefetchAddress( void const * p );
+
+	// Returns the index of the lowest bit set in mask
+	static size_t LowestBit( Mask mask );
+
+	// Returns the fingerprint stored in the control bytes. The multiply mixes all the bits of the hash into the top 7.
+	static int8_t Fingerprint( size_t hash )	{ return int8_t( ( uint64_t( hash ) * 0x9e3779b97f4a7c15ull ) >> 57 ); }
+
+	// Returns the index of the slot with the given key, or SIZE_MAX if there is none
+	size_t Locate( Key const & key, size_t hash ) const;
+
+	// Returns the index of the first empty or deleted slot in the probe sequence
+	size_t FindAvailable( size_t hash ) const;
+
+	// Rebuilds the table with the given number of slots, dropping the deleted markers
+	void Rehash( size_t capacity );
+
+	std::vector< int8_t >	m_control;		// Control byte of each slot
+	std::vector< Slot >		m_slots;		// Slots
+	size_t					m_size;			// Number of entries
+	size_t					m_available;	// Number of empty slots that can be filled before the table must grow
+	size_t					m_groupMask;	// Number of groups - 1
+};
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+void DigestTable< Key, Slot >::Reserve( size_t count )
+{
+	// The load factor is kept at or below 7/8
+
+	size_t	capacity	= GROUP_SIZE;
+
+	while ( capacity / 8 * 7 < count )
+	{
+		capacity *= 2;
+	}
+
+	if ( capacity > m_slots.size() )
+		Rehash( capacity );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+void DigestTable< Key, Slot >::Clear()
+{
+	m_control	= std::vector< int8_t >();
+	m_slots		= std::vector< Slot >();
+	m_size		= 0;
+	m_available	= 0;
+	m_groupMask	= 0;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+inline Slot * DigestTable< Key, Slot >::Find( Key const & key )
+{
+	size_t const	i	= Locate( key, std::hash< Key >()( key ) );
+
+	return ( i != SIZE_MAX ) ? &m_slots[i] : nullptr;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+inline Slot const * DigestTable< Key, Slot >::Find( Key const & key ) const
+{
+	size_t const	i	= Locate( key, std::hash< Key >()( key ) );
+
+	return ( i != SIZE_MAX ) ? &m_slots[i] : nullptr;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+std::pair< Slot *, bool > DigestTable< Key, Slot >::Insert( Key const & key )
+{
+	size_t const	hash	= std::hash< Key >()( key );
+	size_t const	found	= Locate( key, hash );
+
+	if ( found != SIZE_MAX )
+		return { &m_slots[ found ], false };
+
+	size_t	i	= m_slots.empty() ? 0 : FindAvailable( hash );
+
+	// Filling a deleted slot does not use up an empty one, so the table only grows if the slot is empty
+
+	if ( m_slots.empty() || ( m_available == 0 && m_control[i] == EMPTY ) )
+	{
+		// If much of the table is deleted slots, it is rebuilt at the same size instead of growing
+
+		if ( m_slots.empty() )
+			Rehash( GROUP_SIZE );
+		else if ( m_size * 16 / 7 <= m_slots.size() )
+			Rehash( m_slots.size() );
+		else
+			Rehash( m_slots.size() * 2 );
+
+		i = FindAvailable( hash );
+	}
+
+	if ( m_control[i] == EMPTY )
+		--m_available;
+
+	m_control[i]		= Fingerprint( hash );
+	m_slots[i].key	= key;
+	++m_size;
+
+	return { &m_slots[i], true };
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+bool DigestTable< Key, Slot >::Erase( Key const & key )
+{
+	size_t const	i	= Locate( key, std::hash< Key >()( key ) );
+
+	if ( i == SIZE_MAX )
+		return false;
+
+	// If the group still has an empty slot, it has never been full, so no probe sequence has ever continued past it
+	// and the slot can be made empty again. Otherwise it must be marked as deleted so that later probes continue.
+
+	if ( Match( &m_control[ i & ~( GROUP_SIZE - 1 ) ], EMPTY ) != 0 )
+	{
+		m_control[i] = EMPTY;
+		++m_available;
+	}
+	else
+	{
+		m_control[i] = DELETED;
+	}
+
+	m_slots[i] = Slot();
+	--m_size;
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+inline void DigestTable< Key, Slot >::PrefetchControl( Key const & key ) const
+{
+	if ( m_slots.empty() )
+		return;
+
+	size_t const	first	= ( std::hash< Key >()( key ) & m_groupMask ) * GROUP_SIZE;
+
+	PrefetchAddress( &m_control[ first ] );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+inline void DigestTable< Key, Slot >::PrefetchSlot( Key const & key ) const
+{
+	if ( m_slots.empty() )
+		return;
+
+	size_t const	hash	= std::hash< Key >()( key );
+	size_t const	first	= ( hash & m_groupMask ) * GROUP_SIZE;
+	Mask const		mask	= Match( &m_control[ first ], Fingerprint( hash ) );
+
+	if ( mask != 0 )
+		PrefetchAddress( &m_slots[ first + LowestBit( mask ) ] );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! A lookup usually misses the cache twice, once for the control bytes and once for the slot. The control bytes for
+//! keys[i + 2 * PREFETCH_DISTANCE] are prefetched first, and then the slot for keys[i + PREFETCH_DISTANCE] is
+//! prefetched using the control bytes that are now in the cache, so both misses overlap with the work on keys[i].
+
+template< typename Key, typename Slot >
+template< typename Function >
+void DigestTable< Key, Slot >::Pipeline( Key const * keys, size_t count, Function f ) const
+{
+	size_t const	distance	= PREFETCH_DISTANCE;
+
+	for ( size_t i = 0; i < count && i < 2 * distance; ++i )
+	{
+		PrefetchControl( keys[i] );
+	}
+
+	for ( size_t i = 0; i < count && i < distance; ++i )
+	{
+		PrefetchSlot( keys[i] );
+	}
+
+	for ( size_t i = 0; i < count; ++i )
+	{
+		if ( i + 2 * distance < count )
+			PrefetchControl( keys[ i + 2 * distance ] );
+		if ( i + distance < count )
+			PrefetchSlot( keys[ i + distance ] );
+
+		f( i );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+inline void DigestTable< Key, Slot >::PrefetchAddress( void const * p )
+{
+#if CRYPTO_DIGEST_TABLE_SSE2
+	_mm_prefetch( static_cast< char const * >( p ), _MM_HINT_T0 );
+#elif defined( __GNUC__ )
+	__builtin_prefetch( p );
+#else
+	(void)p;
+#endif
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+template< typename Function >
+void DigestTable< Key, Slot >::ForEach( Function f ) const
+{
+	for ( size_t i = 0; i < m_slots.size(); ++i )
+	{
+		if ( m_control[i] >= 0 )
+			f( m_slots[i] );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+inline typename DigestTable< Key, Slot >::Mask DigestTable< Key, Slot >::Match( int8_t const * control, int8_t value )
+{
+#if CRYPTO_DIGEST_TABLE_SSE2
+	__m128i const	group	= _mm_loadu_si128( reinterpret_cast< __m128i const * >( control ) );
+
+	return Mask( _mm_movemask_epi8( _mm_cmpeq_epi8( group, _mm_set1_epi8( value ) ) ) );
+#else
+	Mask	mask	= 0;
+
+	for ( size_t i = 0; i < GROUP_SIZE; ++i )
+	{
+		mask |= Mask( control[i] == value ) << i;
+	}
+
+	return mask;
+#endif
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+inline typename DigestTable< Key, Slot >::Mask DigestTable< Key, Slot >::MatchAvailable( int8_t const * control )
+{
+	// Empty and deleted slots are the only ones with the sign bit set
+
+#if CRYPTO_DIGEST_TABLE_SSE2
+	return Mask( _mm_movemask_epi8( _mm_loadu_si128( reinterpret_cast< __m128i const * >( control ) ) ) );
+#else
+	Mask	mask	= 0;
+
+	for ( size_t i = 0; i < GROUP_SIZE; ++i )
+	{
+		mask |= Mask( control[i] < 0 ) << i;
+	}
+
+	return mask;
+#endif
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+inline size_t DigestTable< Key, Slot >::LowestBit( Mask mask )
+{
+#if defined( _MSC_VER )
+	unsigned long	index;
+
+	_BitScanForward( &index, mask );
+
+	return index;
+#else
+	return size_t( __builtin_ctz( mask ) );
+#endif
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+inline size_t DigestTable< Key, Slot >::Locate( Key const & key, size_t hash ) const
+{
+	if ( m_slots.empty() )
+		return SIZE_MAX;
+
+	int8_t const	fingerprint	= Fingerprint( hash );
+	size_t			group		= hash & m_groupMask;
+
+	// The groups are probed in triangular order, which visits every group when the number of groups is a power of 2
+
+	for ( size_t step = 1; ; ++step )
+	{
+		size_t const			first	= group * GROUP_SIZE;
+		int8_t const * const	control	= &m_control[ first ];
+
+		for ( Mask mask = Match( control, fingerprint ); mask != 0; mask &= mask - 1 )
+		{
+			size_t const	i	= first + LowestBit( mask );
+
+			if ( m_slots[i].key == key )
+				return i;
+		}
+
+		// A probe sequence never continues past a group with an empty slot
+
+		if ( Match( control, EMPTY ) != 0 )
+			return SIZE_MAX;
+
+		group = ( group + step ) & m_groupMask;
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+inline size_t DigestTable< Key, Slot >::FindAvailable( size_t hash ) const
+{
+	size_t	group	= hash & m_groupMask;
+
+	for ( size_t step = 1; ; ++step )
+	{
+		Mask const	mask	= MatchAvailable( &m_control[ group * GROUP_SIZE ] );
+
+		if ( mask != 0 )
+			return group * GROUP_SIZE + LowestBit( mask );
+
+		group = ( group + step ) & m_groupMask;
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Slot >
+void DigestTable< Key, Slot >::Rehash( size_t capacity )
+{
+	std::vector< int8_t >	control( capacity, EMPTY );
+	std::vector< Slot >		slots( capacity );
+
+	m_control.swap( control );
+	m_slots.swap( slots );
+	m_groupMask = capacity / GROUP_SIZE - 1;
+	m_available = capacity / 8 * 7 - m_size;
+
+	// The keys are known to be unique, so they are simply put in the first available slot
+
+	for ( size_t j = 0; j < slots.size(); ++j )
+	{
+		if ( control[j] >= 0 )
+		{
+			size_t const	hash	= std::hash< Key >()( slots[j].key );
+			size_t const	i		= FindAvailable( hash );
+
+			m_control[i]	= Fingerprint( hash );
+			m_slots[i]		= std::move( slots[j] );
+		}
+	}
+}
+
+
+} // namespace Details
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! A hash map keyed by a digest
+//
+//! The entries are stored in place, at about 1 byte of overhead per slot, and a lookup usually touches only one group
+//! of control bytes and one slot. References to entries are invalidated when the map grows.
+//!
+//! @param	Key		Digest type (Crc32, Md5, Sha1 or Sha256)
+//! @param	Value	Type of the value. It must be default-constructible.
+
+template< typename Key, typename Value >
+class DigestMap
+{
+public:
+
+	//! Constructor
+	DigestMap()																{}
+
+	//! Constructs a map with room for the given number of entries
+	explicit DigestMap( size_t count )										{ m_table.Reserve( count ); }
+
+	//! Returns the number of entries
+	size_t Size() const														{ return m_table.Size(); }
+
+	//! Returns true if the map has no entries
+	bool Empty() const														{ return m_table.Size() == 0; }
+
+	//! Makes room for at least the given number of entries without growing
+	void Reserve( size_t count )											{ m_table.Reserve( count ); }
+
+	//! Removes all entries and frees the memory
+	void Clear()															{ m_table.Clear(); }
+
+	//! Adds an entry if the key is not already in the map. Returns the value for the key and true if it was added.
+	std::pair< Value *, bool > Insert( Key const & key, Value const & value );
+
+	//! Returns the value for a key, or nullptr if the key is not in the map
+	Value * Find( Key const & key );
+
+	//! Returns the value for a key, or nullptr if the key is not in the map
+	Value const * Find( Key const & key ) const;
+
+	//! Returns true if the key is in the map
+	bool Contains( Key const & key ) const									{ return m_table.Find( key ) != nullptr; }
+
+	//! Removes the entry for a key. Returns false if the key is not in the map.
+	bool Erase( Key const & key )											{ return m_table.Erase( key ); }
+
+	//! Adds entries for the keys that are not already in the map. Returns the number of entries added.
+	size_t Insert( Key const * keys, Value const * values, size_t count );
+
+	//! Looks up many keys. Sets values[i] to the value for keys[i], or nullptr. Returns the number of keys found.
+	size_t Find( Key const * keys, size_t count, Value const ** values ) const;
+
+	//! Calls f( key, value ) for each entry, in no particular order
+	template< typename Function >
+	void ForEach( Function f ) const;
+
+private:
+
+	struct Slot
+	{
+		Key		key;
+		Value	value;
+	};
+
+	Details::DigestTable< Key, Slot >	m_table;
+};
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Value >
+inline std::pair< Value *, bool > DigestMap< Key, Value >::Insert( Key const & key, Value const & value )
+{
+	std::pair< Slot *, bool > const	result	= m_table.Insert( key );
+
+	if ( result.second )
+		result.first->value = value;
+
+	return { &result.first->value, result.second };
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Value >
+inline Value * DigestMap< Key, Value >::Find( Key const & key )
+{
+	Slot * const	slot	= m_table.Find( key );
+
+	return ( slot != nullptr ) ? &slot->value : nullptr;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Value >
+inline Value const * DigestMap< Key, Value >::Find( Key const & key ) const
+{
+	Slot const * const	slot	= m_table.Find( key );
+
+	return ( slot != nullptr ) ? &slot->value : nullptr;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Room is made for all the keys first, so the table does not grow while the lookups ahead are being prefetched.
+
+template< typename Key, typename Value >
+size_t DigestMap< Key, Value >::Insert( Key const * keys, Value const * values, size_t count )
+{
+	size_t	added	= 0;
+
+	m_table.Reserve( m_table.Size() + count );
+	m_table.Pipeline( keys, count, [ & ]( size_t i ) { added += Insert( keys[i], values[i] ).second ? 1 : 0; } );
+
+	return added;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Value >
+size_t DigestMap< Key, Value >::Find( Key const * keys, size_t count, Value const ** values ) const
+{
+	size_t	found	= 0;
+
+	m_table.Pipeline( keys, count, [ & ]( size_t i )
+	{
+		values[i] = Find( keys[i] );
+		found += ( values[i] != nullptr ) ? 1 : 0;
+	} );
+
+	return found;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key, typename Value >
+template< typename Function >
+inline void DigestMap< Key, Value >::ForEach( Function f ) const
+{
+	m_table.ForEach( [ &f ]( Slot const & slot ) { f( slot.key, slot.value ); } );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! A hash set of digests
+//
+//! The digests are stored in place, at about 1 byte of overhead per slot. See DigestMap.
+//!
+//! @param	Key		Digest type (Crc32, Md5, Sha1 or Sha256)
+
+template< typename Key >
+class DigestSet
+{
+public:
+
+	//! Constructor
+	DigestSet()																{}
+
+	//! Constructs a set with room for the given number of digests
+	explicit DigestSet( size_t count )										{ m_table.Reserve( count ); }
+
+	//! Returns the number of digests
+	size_t Size() const														{ return m_table.Size(); }
+
+	//! Returns true if the set has no digests
+	bool Empty() const														{ return m_table.Size() == 0; }
+
+	//! Makes room for at least the given number of digests without growing
+	void Reserve( size_t count )											{ m_table.Reserve( count ); }
+
+	//! Removes all digests and frees the memory
+	void Clear()															{ m_table.Clear(); }
+
+	//! Adds a digest. Returns false if it is already in the set.
+	bool Insert( Key const & key )											{ return m_table.Insert( key ).second; }
+
+	//! Returns true if the digest is in the set
+	bool Contains( Key const & key ) const									{ return m_table.Find( key ) != nullptr; }
+
+	//! Removes a digest. Returns false if it is not in the set.
+	bool Erase( Key const & key )											{ return m_table.Erase( key ); }
+
+	//! Adds many digests. Returns the number that were not already in the set.
+	size_t Insert( Key const * keys, size_t count );
+
+	//! Looks up many digests. Sets found[i] to true if keys[i] is in the set. Returns the number found.
+	size_t Contains( Key const * keys, size_t count, bool * found ) const;
+
+	//! Calls f( key ) for each digest, in no particular order
+	template< typename Function >
+	void ForEach( Function f ) const;
+
+private:
+
+	struct Slot
+	{
+		Key	key;
+	};
+
+	Details::DigestTable< Key, Slot >	m_table;
+};
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key >
+size_t DigestSet< Key >::Insert( Key const * keys, size_t count )
+{
+	size_t	added	= 0;
+
+	m_table.Reserve( m_table.Size() + count );
+	m_table.Pipeline( keys, count, [ & ]( size_t i ) { added += Insert( keys[i] ) ? 1 : 0; } );
+
+	return added;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key >
+size_t DigestSet< Key >::Contains( Key const * keys, size_t count, bool * found ) const
+{
+	size_t	n	= 0;
+
+	m_table.Pipeline( keys, count, [ & ]( size_t i )
+	{
+		found[i] = Contains( keys[i] );
+		n += found[i] ? 1 : 0;
+	} );
+
+	return n;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Key >
+template< typename Function >
+inline void DigestSet< Key >::ForEach( Function f ) const
+{
+	m_table.ForEach( [ &f ]( Slot const & slot ) { f( slot.key ); } );
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,136 @@
+/** @file *//********************************************************************************************************
+
+                                                     DigestSort.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/DigestSort.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Sorts digests of size bytes as byte strings
+//
+//! Digests are uniformly distributed, so a single radix pass on the first 16 bits divides them into buckets of nearly
+//! equal size, small enough to be sorted in the cache. This is much faster than sorting the whole array with
+//! comparisons. The order is the same as the order of operator< for Md5, Sha1 and Sha256 and the order used by
+//! DigestIndex. For Crc32 it is the order of the bytes in memory, not of the value.
+//!
+//! @param	digests		Digests of size bytes each
+//! @param	size		Size of a digest in bytes
+//! @param	count		Number of digests
+
+void RadixSort( uint8_t * digests, size_t size, size_t count );
+
+//! Sorts digests (Crc32, Md5, Sha1 or Sha256). See above.
+template< typename Key >
+inline void RadixSort( Key * keys, size_t count )
+{
+	RadixSort( reinterpret_cast< uint8_t * >( keys ), sizeof( Key ), count );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Sorts more digests than fit in memory and reports each distinct digest with the number of times it occurs
+//
+//! Digests are collected in a buffer of a fixed size. When the buffer is full, it is radix-sorted and written to a
+//! temporary file as a sorted run. Merge() maps the runs and merges them, so memory use is bounded by the buffer
+//! size no matter how many digests are added. The temporary files are deleted by Merge() and by the destructor.
+//!
+//! @code
+//!		ExternalDigestSort	sort( Sha256::SIZE, "/var/tmp", 1 << 30 );
+//!		sort.Add( digests, count );
+//!		...
+//!		sort.Merge( []( uint8_t const * digest, uint64_t count ) { if ( count > 1 ) ReportDuplicate( digest ); } );
+//! @endcode
+
+class ExternalDigestSort
+{
+public:
+
+	//! Called by Merge() with each distinct digest, in sorted order, and the number of times it was added
+	typedef std::function< void ( uint8_t const * digest, uint64_t count ) >	Visitor;
+
+	//! Constructor
+	ExternalDigestSort( size_t size, char const * directory, size_t memory );
+
+	//! Destructor. Deletes the temporary files.
+	~ExternalDigestSort();
+
+	//! Adds digests of DigestSize() bytes. Returns false if a run could not be written.
+	bool Add( uint8_t const * digests, size_t count );
+
+	//! Adds digests (Crc32, Md5, Sha1 or Sha256). Their size must be DigestSize().
+	template< typename Key >
+	bool Add( Key const * keys, size_t count );
+
+	//! Merges the runs and calls the visitor with each distinct digest. Returns false if a run could not be read or
+	//! written. Afterwards, the sort is empty and can be reused.
+	bool Merge( Visitor const & visitor );
+
+	//! Returns the size of a digest in bytes
+	size_t DigestSize() const	{ return m_size; }
+
+	//! Returns the number of runs written so far
+	size_t Runs() const			{ return m_runs.size(); }
+
+private:
+
+	// Non-copyable
+	ExternalDigestSort( ExternalDigestSort const & ) = delete;
+	ExternalDigestSort & operator =( ExternalDigestSort const & ) = delete;
+
+	// Sorts the buffer and writes it to a new temporary file
+	bool Spill();
+
+	// Deletes the temporary files
+	void RemoveRuns();
+
+	size_t						m_size;			// Size of a digest in bytes
+	std::string					m_directory;	// Directory for the temporary files
+	size_t						m_capacity;		// Number of digests that fit in the buffer
+	std::vector< uint8_t >		m_buffer;		// Digests that have not been written yet
+	std::vector< std::string >	m_runs;			// Names of the temporary files
+};
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	keys	Digests
+//! @param	count	Number of digests
+
+template< typename Key >
+inline bool ExternalDigestSort::Add( Key const * keys, size_t count )
+{
+	if ( sizeof( Key ) != m_size )
+		return false;
+
+	return Add( reinterpret_cast< uint8_t const * >( keys ), count );
+}
+
+
+} // namespace Crypto
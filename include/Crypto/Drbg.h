@@ -0,0 +1,149 @@
+/** @file *//********************************************************************************************************
+
+                                                        Drbg.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Drbg.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "Hmac.h"
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Deterministic random bit generator based on SHA-256 (Hash_DRBG, NIST SP 800-90A)
+//
+//! The output of a request is the digest of V, V + 1, V + 2, ... where V is the 55-byte internal state, and V is
+//! updated at the end of each request. Each of those messages fits in a single padded block, and the blocks are
+//! independent, so they are compressed eight at a time in the lanes of the SHA256X8 kernel. A SHA-NI kernel compresses
+//! one block about as fast as AVX2 compresses eight, so on a processor with the SHA extensions (or with the portable
+//! x8 kernel) the blocks are compressed one after another with the SHA256 kernel instead.
+//!
+//! Generate() is a single request as defined by the standard. Fill() and Skip() treat the output as a stream made of
+//! requests of MAX_REQUEST_SIZE bytes with no additional input, so a stream can be generated in pieces of any size,
+//! and skipping ahead only costs the update of V for each request skipped instead of the output itself.
+//!
+//! @code
+//!		HashDrbg	drbg( seed, seedSize, nonce, nonceSize );
+//!		drbg.Skip( shard * shardSize );
+//!		drbg.Fill( buffer, shardSize );
+//! @endcode
+
+class HashDrbg
+{
+public:
+
+	//! Size of the internal state in bytes (seedlen)
+	static size_t const		SEED_SIZE			= 55;
+
+	//! Maximum size of a request in bytes
+	static size_t const		MAX_REQUEST_SIZE	= 1 << 16;
+
+	//! Maximum number of requests between reseeds
+	static uint64_t const	RESEED_INTERVAL		= uint64_t( 1 ) << 48;
+
+	//! Constructor
+	HashDrbg( uint8_t const * entropy, size_t entropySize, uint8_t const * nonce, size_t nonceSize,
+			  uint8_t const * personalization = nullptr, size_t personalizationSize = 0 );
+
+	//! Instantiates the generator again
+	void Instantiate( uint8_t const * entropy, size_t entropySize, uint8_t const * nonce, size_t nonceSize,
+					  uint8_t const * personalization = nullptr, size_t personalizationSize = 0 );
+
+	//! Reseeds the generator
+	void Reseed( uint8_t const * entropy, size_t entropySize, uint8_t const * additional = nullptr,
+				 size_t additionalSize = 0 );
+
+	//! Generates the output of one request. Returns false if the request is longer than MAX_REQUEST_SIZE or the
+	//! generator must be reseeded.
+	bool Generate( uint8_t * output, size_t size, uint8_t const * additional = nullptr, size_t additionalSize = 0 );
+
+	//! Generates the next part of the stream. Returns false if the generator must be reseeded.
+	bool Fill( uint8_t * output, size_t size );
+
+	//! Skips part of the stream. Returns false if the generator must be reseeded.
+	bool Skip( uint64_t size );
+
+private:
+
+	// Finishes the current request and updates V
+	void Advance();
+
+	// Generates part of the output of the current request
+	void Output( size_t offset, uint8_t * output, size_t size ) const;
+
+	uint8_t		m_v[ SEED_SIZE ];		// Internal state
+	uint8_t		m_c[ SEED_SIZE ];		// Constant added to V after each request
+	uint64_t	m_reseedCounter;		// Number of requests since the last reseed, plus 1
+	size_t		m_position;				// Amount of the current request already generated by Fill() and Skip()
+};
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Deterministic random bit generator based on HMAC-SHA-256 (HMAC_DRBG, NIST SP 800-90A)
+//
+//! Each block of output is the HMAC of the previous one, so unlike Hash_DRBG the blocks cannot be computed in
+//! parallel. The key's HMAC pads are computed when the key changes, so each 32 bytes of output costs two blocks of
+//! the compression function.
+
+class HmacDrbg
+{
+public:
+
+	//! Size of the internal state in bytes
+	static constexpr size_t	SEED_SIZE			= HmacSha256::DIGEST_SIZE;
+
+	//! Maximum size of a request in bytes
+	static size_t const		MAX_REQUEST_SIZE	= 1 << 16;
+
+	//! Maximum number of requests between reseeds
+	static uint64_t const	RESEED_INTERVAL		= uint64_t( 1 ) << 48;
+
+	//! Constructor
+	HmacDrbg( uint8_t const * entropy, size_t entropySize, uint8_t const * nonce, size_t nonceSize,
+			  uint8_t const * personalization = nullptr, size_t personalizationSize = 0 );
+
+	//! Instantiates the generator again
+	void Instantiate( uint8_t const * entropy, size_t entropySize, uint8_t const * nonce, size_t nonceSize,
+					  uint8_t const * personalization = nullptr, size_t personalizationSize = 0 );
+
+	//! Reseeds the generator
+	void Reseed( uint8_t const * entropy, size_t entropySize, uint8_t const * additional = nullptr,
+				 size_t additionalSize = 0 );
+
+	//! Generates the output of one request. Returns false if the request is longer than MAX_REQUEST_SIZE or the
+	//! generator must be reseeded.
+	bool Generate( uint8_t * output, size_t size, uint8_t const * additional = nullptr, size_t additionalSize = 0 );
+
+private:
+
+	// Updates the key and V with up to three pieces of provided data
+	void Update( uint8_t const * a, size_t aSize, uint8_t const * b = nullptr, size_t bSize = 0,
+				 uint8_t const * c = nullptr, size_t cSize = 0 );
+
+	HmacSha256	m_hmac;					// HMAC keyed with the key
+	uint8_t		m_v[ SEED_SIZE ];		// Internal state
+	uint64_t	m_reseedCounter;		// Number of requests since the last reseed, plus 1
+};
+
+
+} // namespace Crypto
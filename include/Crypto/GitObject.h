@@ -0,0 +1,116 @@
+/** @file *//********************************************************************************************************
+
+                                                     GitObject.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/GitObject.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "Sha1Calculator.h"
+#include "Sha256Calculator.h"
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Computes the IDs of git objects
+//
+//! The ID of an object is the digest of a header, "<type> <size>\0", followed by the object's contents. Repositories in
+//! the SHA-1 object format use SHA-1 and those in the SHA-256 object format use SHA-256, with the same header.
+//!
+//! A GitObject hashes one object in steps: the header is hashed when it is constructed and the contents are passed
+//! straight to the calculator, so they are never copied. Hash() does the same for an object in memory.
+//!
+//! HashBatch() hashes many objects at once in the lanes of the x8 kernels selected by the KernelRegistry, with each
+//! lane hashing one object and starting the next when it finishes. The blocks are read straight from the contents,
+//! except for the ones containing the header or the padding. On a processor with the SHA extensions, SHA-256 objects
+//! are hashed one after another with the SHA-NI kernel instead, and SHA-1 objects only use the lanes while at least
+//! four of them are left.
+//!
+//! @code
+//!		uint8_t	id[ GitObject::MAX_DIGEST_SIZE ];
+//!		GitObject::Hash( GitObject::SHA1, GitObject::BLOB, contents, size, id );
+//! @endcode
+
+class GitObject
+{
+public:
+
+	//! Type of an object
+	enum Type
+	{
+		BLOB,
+		TREE,
+		COMMIT,
+		TAG
+	};
+
+	//! Object format of a repository
+	enum Format
+	{
+		SHA1,
+		SHA256
+	};
+
+	//! Size of the largest header, "commit 18446744073709551615\0"
+	static size_t const		MAX_HEADER_SIZE	= 28;
+
+	//! Size of the largest ID
+	static size_t const		MAX_DIGEST_SIZE	= Sha256Calculator::DIGEST_SIZE;
+
+	//! An object to hash in a batch
+	struct Object
+	{
+		Type				type;		//!< Type
+		uint8_t const *		data;		//!< Contents
+		size_t				size;		//!< Size of the contents
+		uint8_t *			digest;		//!< Where to put the ID
+	};
+
+	//! Constructor. Hashes the header of an object whose contents will be passed to Process().
+	GitObject( Format format, Type type, uint64_t size );
+
+	//! Hashes the next part of the contents
+	void Process( uint8_t const * data, size_t size );
+
+	//! Returns the ID of the object. Returns false if the amount of contents processed does not match the size.
+	bool Finalize( uint8_t * digest );
+
+	//! Returns the size of an ID
+	static size_t DigestSize( Format format );
+
+	//! Writes the header of an object and returns its size
+	static size_t Header( Type type, uint64_t size, char * header );
+
+	//! Computes the ID of an object
+	static void Hash( Format format, Type type, uint8_t const * data, size_t size, uint8_t * digest );
+
+	//! Computes the IDs of many objects
+	static void HashBatch( Format format, Object const * objects, size_t count );
+
+private:
+
+	Format				m_format;		// Object format
+	uint64_t			m_size;			// Size of the contents given in the header
+	uint64_t			m_processed;	// Size of the contents processed
+	Sha1Calculator		m_sha1;			// Calculator for the SHA-1 format
+	Sha256Calculator	m_sha256;		// Calculator for the SHA-256 format
+};
+
+
+} // namespace Crypto
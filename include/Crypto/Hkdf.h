@@ -0,0 +1,216 @@
+/** @file *//********************************************************************************************************
+
+                                                        Hkdf.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Hkdf.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "Hmac.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Derives keys with the HMAC-based extract-and-expand key derivation function (HKDF, RFC 5869)
+//
+//! Extracting turns the input keying material into a pseudorandom key, and expanding turns the pseudorandom key and
+//! some context information into as many keys as needed. An Hkdf keeps the HMAC of the pseudorandom key, so deriving
+//! a key for each of many objects from one secret only costs the blocks of the expansion itself. A const Hkdf can be
+//! used by several threads at once.
+//!
+//! @code
+//!		HkdfSha256	hkdf( salt, saltSize, secret, secretSize );
+//!		for ( ... )
+//!			hkdf.Expand( objectId, idSize, key, sizeof( key ) );
+//! @endcode
+//!
+//! @param	Calculator	Sha1Calculator or Sha256Calculator
+
+template< typename Calculator >
+class Hkdf
+{
+public:
+
+	//! Size of the pseudorandom key in bytes
+	static int const		DIGEST_SIZE	= Calculator::DIGEST_SIZE;
+
+	//! Maximum size of an expanded key in bytes
+	static size_t const		MAX_SIZE	= 255 * DIGEST_SIZE;
+
+	//! Constructor. The pseudorandom key is extracted from empty keying material.
+	Hkdf();
+
+	//! Constructor
+	Hkdf( uint8_t const * salt, size_t saltSize, uint8_t const * ikm, size_t ikmSize );
+
+	//! Extracts the pseudorandom key from keying material. An empty salt is the same as DIGEST_SIZE 0's.
+	void Extract( uint8_t const * salt, size_t saltSize, uint8_t const * ikm, size_t ikmSize );
+
+	//! Sets the pseudorandom key directly, skipping the extraction
+	void SetPrk( uint8_t const * prk, size_t size );
+
+	//! Returns the pseudorandom key. It is DIGEST_SIZE bytes.
+	uint8_t const * Prk() const									{ return m_prk; }
+
+	//! Expands the pseudorandom key into a key. Returns false if the key is longer than MAX_SIZE.
+	bool Expand( uint8_t const * info, size_t infoSize, uint8_t * okm, size_t size ) const;
+
+	//! Extracts and expands in one step. Returns false if the key is longer than MAX_SIZE.
+	static bool Derive( uint8_t const * salt, size_t saltSize, uint8_t const * ikm, size_t ikmSize,
+						uint8_t const * info, size_t infoSize, uint8_t * okm, size_t size );
+
+private:
+
+	uint8_t					m_prk[ DIGEST_SIZE ];	// Pseudorandom key
+	Hmac< Calculator >		m_hmac;					// HMAC keyed with the pseudorandom key
+};
+
+//! HKDF with HMAC-SHA-1
+typedef Hkdf< Sha1Calculator >		HkdfSha1;
+
+//! HKDF with HMAC-SHA-256
+typedef Hkdf< Sha256Calculator >	HkdfSha256;
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Calculator >
+Hkdf< Calculator >::Hkdf()
+{
+	Extract( nullptr, 0, nullptr, 0 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	salt		Salt (optional)
+//! @param	saltSize	Size of the salt
+//! @param	ikm			Input keying material
+//! @param	ikmSize		Size of the input keying material
+
+template< typename Calculator >
+Hkdf< Calculator >::Hkdf( uint8_t const * salt, size_t saltSize, uint8_t const * ikm, size_t ikmSize )
+{
+	Extract( salt, saltSize, ikm, ikmSize );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	salt		Salt (optional)
+//! @param	saltSize	Size of the salt
+//! @param	ikm			Input keying material
+//! @param	ikmSize		Size of the input keying material
+
+template< typename Calculator >
+void Hkdf< Calculator >::Extract( uint8_t const * salt, size_t saltSize, uint8_t const * ikm, size_t ikmSize )
+{
+	uint8_t	prk[ DIGEST_SIZE ];
+
+	// An HMAC key shorter than a block is padded with 0's, so an empty salt is already the same as DIGEST_SIZE 0's
+
+	Hmac< Calculator >( salt, saltSize ).Calculate( ikm, ikmSize, prk );
+	SetPrk( prk, DIGEST_SIZE );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	prk		Pseudorandom key
+//! @param	size	Size of the pseudorandom key. It should be at least DIGEST_SIZE, and only the first DIGEST_SIZE
+//!					bytes are returned by Prk().
+
+template< typename Calculator >
+void Hkdf< Calculator >::SetPrk( uint8_t const * prk, size_t size )
+{
+	memset( m_prk, 0, DIGEST_SIZE );
+	memcpy( m_prk, prk, ( size < size_t( DIGEST_SIZE ) ) ? size : DIGEST_SIZE );
+	m_hmac.SetKey( prk, size );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	info		Context information (optional)
+//! @param	infoSize	Size of the context information
+//! @param	okm			Where to put the key
+//! @param	size		Size of the key. It is at most MAX_SIZE.
+//!
+//! Each block of the key is the HMAC of the previous block, the context information and a counter.
+
+template< typename Calculator >
+bool Hkdf< Calculator >::Expand( uint8_t const * info, size_t infoSize, uint8_t * okm, size_t size ) const
+{
+	if ( size > MAX_SIZE )
+		return false;
+
+	Hmac< Calculator >	hmac	= m_hmac;
+	uint8_t				t[ DIGEST_SIZE ];
+
+	for ( size_t offset = 0, i = 1; offset < size; offset += DIGEST_SIZE, ++i )
+	{
+		uint8_t const	counter	= uint8_t( i );
+
+		if ( offset > 0 )
+			hmac.Process( t, DIGEST_SIZE );
+		if ( infoSize > 0 )
+			hmac.Process( info, infoSize );
+		hmac.Process( &counter, 1 );
+		hmac.Finalize( t );
+
+		memcpy( okm + offset, t, ( size - offset < size_t( DIGEST_SIZE ) ) ? size - offset : DIGEST_SIZE );
+	}
+
+	return true;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	salt		Salt (optional)
+//! @param	saltSize	Size of the salt
+//! @param	ikm			Input keying material
+//! @param	ikmSize		Size of the input keying material
+//! @param	info		Context information (optional)
+//! @param	infoSize	Size of the context information
+//! @param	okm			Where to put the key
+//! @param	size		Size of the key. It is at most MAX_SIZE.
+
+template< typename Calculator >
+bool Hkdf< Calculator >::Derive( uint8_t const * salt, size_t saltSize, uint8_t const * ikm, size_t ikmSize,
+								 uint8_t const * info, size_t infoSize, uint8_t * okm, size_t size )
+{
+	return Hkdf( salt, saltSize, ikm, ikmSize ).Expand( info, infoSize, okm, size );
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,461 @@
+/** @file *//********************************************************************************************************
+
+                                                        Hmac.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Hmac.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "KernelRegistry.h"
+#include "Md5Calculator.h"
+#include "Sha1Calculator.h"
+#include "Sha256Calculator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+
+namespace Crypto
+{
+namespace Details
+{
+
+//! Largest number of messages passed to HmacBatch(), which is one word of the failures of Hmac::VerifyBatch()
+size_t const	HMAC_BATCH_SIZE	= 64;
+
+//! Computes the HMAC-SHA-1 or HMAC-SHA-256 of several messages in the lanes of the multi-buffer kernels (Hmac.cpp).
+//! Returns false and computes nothing if the lanes are not used on this processor.
+bool HmacBatch( KernelRegistry::Algorithm algorithm, uint8_t const * key, uint8_t const * const * data,
+				size_t const * sizes, size_t count, uint8_t * macs );
+
+} // namespace Details
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Computes and verifies keyed-hash message authentication codes (HMAC, RFC 2104)
+//
+//! The key only affects the first block of the inner hash and the first block of the outer hash, so the states of the
+//! calculator after those two blocks are computed once when the key is set. After that, each message only costs its
+//! own blocks plus one block for the outer hash. A const Hmac can be used by several threads at once.
+//!
+//! @code
+//!		HmacSha256	hmac( key, keySize );
+//!		if ( !hmac.Verify( message, size, signature ) )
+//!			...
+//! @endcode
+//!
+//! @param	Calculator	Md5Calculator, Sha1Calculator or Sha256Calculator
+
+template< typename Calculator >
+class Hmac
+{
+public:
+
+	//! Size of a MAC in bytes
+	static int const	DIGEST_SIZE	= Calculator::DIGEST_SIZE;
+
+	//! Size of a block of the hash function. A longer key is hashed first.
+	static int const	BLOCK_SIZE	= Calculator::OPTIMAL_BLOCK_SIZE;
+
+	//! Constructor. The key is empty.
+	Hmac();
+
+	//! Constructor
+	Hmac( uint8_t const * key, size_t size );
+
+	//! Sets the key
+	void SetKey( uint8_t const * key, size_t size );
+
+	//! Computes the MAC of a message
+	void Calculate( uint8_t const * data, size_t size, uint8_t * mac ) const;
+
+	//! Returns true if the MAC of a message matches. A MAC can be truncated to its first macSize bytes.
+	bool Verify( uint8_t const * data, size_t size, uint8_t const * mac, size_t macSize = DIGEST_SIZE ) const;
+
+	//! Verifies the MACs of several messages. Returns the number of messages that fail. The MACs can be truncated to
+	//! their first macSize bytes.
+	size_t VerifyBatch( uint8_t const * const * data, size_t const * sizes, size_t count, uint8_t const * const * macs,
+						uint64_t * failures, size_t macSize = DIGEST_SIZE ) const;
+
+	//! @name Computation In Steps
+	//@{
+
+	//! Restarts the computation of a MAC
+	void Reset()											{ m_calculator = m_inner; }
+
+	//! Processes the next part of a message
+	void Process( uint8_t const * data, size_t size )		{ m_calculator.Process( data, size ); }
+
+	//! Returns the MAC of the message and restarts the computation
+	void Finalize( uint8_t * mac );
+
+	//@}
+
+private:
+
+	// Finishes the inner hash of a message and computes its MAC
+	void Finish( Calculator & inner, uint8_t * mac ) const;
+
+	// Compares two MACs in a time that does not depend on where they differ
+	static bool Equal( uint8_t const * a, uint8_t const * b, size_t size );
+
+	uint8_t		m_key[ BLOCK_SIZE ];	// Key padded with 0's to a block, for the multi-buffer kernels
+	Calculator	m_inner;				// State after the key XORed with the inner pad
+	Calculator	m_outer;				// State after the key XORed with the outer pad
+	Calculator	m_calculator;			// Inner hash of the message being computed in steps
+};
+
+//! HMAC-MD5
+typedef Hmac< Md5Calculator >		HmacMd5;
+
+//! HMAC-SHA-1
+typedef Hmac< Sha1Calculator >		HmacSha1;
+
+//! HMAC-SHA-256
+typedef Hmac< Sha256Calculator >	HmacSha256;
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Keeps the Hmac objects for the most recently used keys
+//
+//! Setting a key costs two blocks of the hash function, which is as much as a short message. When a few keys are used
+//! over and over (one for each tenant, for example), a cache avoids setting them up again for each message. When the
+//! cache is full, the least recently used key is dropped. A cache is not thread-safe, so each thread should have its
+//! own.
+//!
+//! @code
+//!		HmacCache< Sha256Calculator >	cache;
+//!		...
+//!		bool const	valid	= cache.Get( key, keySize ).Verify( message, size, signature );
+//! @endcode
+
+template< typename Calculator >
+class HmacCache
+{
+public:
+
+	//! Default number of keys kept
+	static size_t const		DEFAULT_CAPACITY	= 256;
+
+	//! Constructor
+	explicit HmacCache( size_t capacity = DEFAULT_CAPACITY );
+
+	//! Returns the Hmac for a key, setting one up if the key is not in the cache. The reference is valid until the
+	//! next call to Get() or Clear().
+	Hmac< Calculator > const & Get( uint8_t const * key, size_t size );
+
+	//! Removes all the keys
+	void Clear();
+
+	//! Returns the number of keys in the cache
+	size_t Size() const										{ return m_entries.size(); }
+
+	//! Returns the maximum number of keys in the cache
+	size_t Capacity() const									{ return m_capacity; }
+
+private:
+
+	typedef std::list< std::pair< std::string, Hmac< Calculator > > >	List;
+
+	size_t													m_capacity;		// Maximum number of keys
+	List													m_entries;		// Most recently used first
+	std::unordered_map< std::string_view, typename List::iterator >	m_index;	// Entries by key
+};
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Calculator >
+Hmac< Calculator >::Hmac()
+{
+	SetKey( nullptr, 0 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	key		The key
+//! @param	size	The size of the key
+
+template< typename Calculator >
+Hmac< Calculator >::Hmac( uint8_t const * key, size_t size )
+{
+	SetKey( key, size );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	key		The key
+//! @param	size	The size of the key
+
+template< typename Calculator >
+void Hmac< Calculator >::SetKey( uint8_t const * key, size_t size )
+{
+	uint8_t	block[ BLOCK_SIZE ]	= { 0 };
+
+	if ( size > size_t( BLOCK_SIZE ) )
+		Calculator().Calculate( key, size, block );
+	else if ( size > 0 )
+		memcpy( block, key, size );
+
+	memcpy( m_key, block, BLOCK_SIZE );
+
+	for ( int i = 0; i < BLOCK_SIZE; ++i )
+	{
+		block[i] ^= 0x36;
+	}
+
+	m_inner.Reset();
+	m_inner.Process( block, BLOCK_SIZE );
+
+	for ( int i = 0; i < BLOCK_SIZE; ++i )
+	{
+		block[i] ^= 0x36 ^ 0x5c;
+	}
+
+	m_outer.Reset();
+	m_outer.Process( block, BLOCK_SIZE );
+
+	m_calculator = m_inner;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	The message
+//! @param	size	The size of the message
+//! @param	mac		Where to put the MAC. It is DIGEST_SIZE bytes.
+
+template< typename Calculator >
+void Hmac< Calculator >::Calculate( uint8_t const * data, size_t size, uint8_t * mac ) const
+{
+	Calculator	inner	= m_inner;
+
+	inner.Process( data, size );
+	Finish( inner, mac );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	The message
+//! @param	size	The size of the message
+//! @param	mac		The MAC to check
+//! @param	macSize	The size of the MAC. It must be between 1 and DIGEST_SIZE.
+
+template< typename Calculator >
+bool Hmac< Calculator >::Verify( uint8_t const * data, size_t size, uint8_t const * mac, size_t macSize ) const
+{
+	if ( macSize == 0 || macSize > size_t( DIGEST_SIZE ) )
+		return false;
+
+	uint8_t	expected[ DIGEST_SIZE ];
+
+	Calculate( data, size, expected );
+
+	return Equal( expected, mac, macSize );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data		The messages
+//! @param	sizes		The size of each message
+//! @param	count		The number of messages
+//! @param	macs		The MAC of each message. Each one is macSize bytes.
+//! @param	failures	Bit i % 64 of failures[i / 64] is set if message i fails. There must be ( count + 63 ) / 64
+//!						words.
+//! @param	macSize		The size of each MAC. It must be between 1 and DIGEST_SIZE, or every message fails.
+//!
+//! The key is only set up once for all the messages. For HMAC-SHA-1 and HMAC-SHA-256, the messages are hashed 64 at a
+//! time in the lanes of the multi-buffer kernels if they are used on this processor (see MultiBufferHash.h).
+
+template< typename Calculator >
+size_t Hmac< Calculator >::VerifyBatch( uint8_t const * const * data, size_t const * sizes, size_t count,
+										uint8_t const * const * macs, uint64_t * failures, size_t macSize ) const
+{
+	size_t	failed	= 0;
+
+	for ( size_t i = 0; i < count; i += Details::HMAC_BATCH_SIZE )
+	{
+		size_t const	n		= ( count - i < Details::HMAC_BATCH_SIZE ) ? count - i : Details::HMAC_BATCH_SIZE;
+		uint64_t		bits	= 0;
+		uint8_t			expected[ Details::HMAC_BATCH_SIZE ][ DIGEST_SIZE ];
+		bool			lanes	= false;
+
+		if constexpr ( !std::is_same_v< Calculator, Md5Calculator > )
+		{
+			KernelRegistry::Algorithm const	algorithm	= std::is_same_v< Calculator, Sha1Calculator > ?
+														  KernelRegistry::SHA1 : KernelRegistry::SHA256;
+
+			if ( macSize > 0 && macSize <= size_t( DIGEST_SIZE ) )
+				lanes = Details::HmacBatch( algorithm, m_key, data + i, sizes + i, n, expected[0] );
+		}
+
+		for ( size_t j = 0; j < n; ++j )
+		{
+			bool const	valid	= lanes ? Equal( expected[j], macs[ i + j ], macSize )
+										: Verify( data[ i + j ], sizes[ i + j ], macs[ i + j ], macSize );
+
+			if ( !valid )
+			{
+				bits |= uint64_t( 1 ) << j;
+				++failed;
+			}
+		}
+
+		failures[ i / 64 ] = bits;
+	}
+
+	return failed;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	mac		Where to put the MAC. It is DIGEST_SIZE bytes.
+
+template< typename Calculator >
+void Hmac< Calculator >::Finalize( uint8_t * mac )
+{
+	Finish( m_calculator, mac );
+	m_calculator = m_inner;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Calculator >
+void Hmac< Calculator >::Finish( Calculator & inner, uint8_t * mac ) const
+{
+	uint8_t		digest[ DIGEST_SIZE ];
+	Calculator	outer	= m_outer;
+
+	inner.Finalize( digest );
+	outer.Process( digest, DIGEST_SIZE );
+	outer.Finalize( mac );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Calculator >
+inline bool Hmac< Calculator >::Equal( uint8_t const * a, uint8_t const * b, size_t size )
+{
+	uint8_t	difference	= 0;
+
+	for ( size_t i = 0; i < size; ++i )
+	{
+		difference |= a[i] ^ b[i];
+	}
+
+	return difference == 0;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	capacity	The maximum number of keys kept. It is at least 1.
+
+template< typename Calculator >
+HmacCache< Calculator >::HmacCache( size_t capacity )
+	: m_capacity( ( capacity > 0 ) ? capacity : 1 )
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	key		The key
+//! @param	size	The size of the key
+
+template< typename Calculator >
+Hmac< Calculator > const & HmacCache< Calculator >::Get( uint8_t const * key, size_t size )
+{
+	std::string_view const	name( reinterpret_cast< char const * >( key ), size );
+	auto const				found	= m_index.find( name );
+
+	if ( found != m_index.end() )
+	{
+		m_entries.splice( m_entries.begin(), m_entries, found->second );
+		return found->second->second;
+	}
+
+	// Reuse the least recently used entry if the cache is full. Its key is only overwritten after it is removed from
+	// the index, since the index refers to it.
+
+	if ( m_entries.size() >= m_capacity )
+	{
+		m_index.erase( std::string_view( m_entries.back().first ) );
+		m_entries.splice( m_entries.begin(), m_entries, std::prev( m_entries.end() ) );
+		m_entries.front().first.assign( name );
+		m_entries.front().second.SetKey( key, size );
+	}
+	else
+	{
+		m_entries.emplace_front( std::string( name ), Hmac< Calculator >( key, size ) );
+	}
+
+	m_index.emplace( std::string_view( m_entries.front().first ), m_entries.begin() );
+
+	return m_entries.front().second;
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+template< typename Calculator >
+void HmacCache< Calculator >::Clear()
+{
+	m_index.clear();
+	m_entries.clear();
+}
+
+
+} // namespace Crypto
@@ -0,0 +1,89 @@
+/** @file *//********************************************************************************************************
+
+                                                   KernelRegistry.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/KernelRegistry.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Selects the kernels used by the calculators
+//
+//! Crc32Calculator, Md5Calculator, Sha1Calculator and Sha256Calculator do their bulk processing with a "kernel" that
+//! is chosen from a set of candidates -- portable C++ versions and versions that use processor extensions such as
+//! SHA-NI and PCLMULQDQ. The other algorithms listed in Algorithm, such as the hex and Base64 conversions, are
+//! selected the same way. The first time a kernel is needed for an algorithm, the registry probes the processor (the
+//! probe is only done once), runs known-answer tests against each candidate that the processor supports, and selects
+//! the fastest candidate that passes.
+//!
+//! The automatic selection can be overridden by calling Force() or by setting the environment variable
+//! CRYPTO_KERNEL_<name> (for example, CRYPTO_KERNEL_SHA256=generic) before the first use, or before calling
+//! Reselect(). A kernel can only be forced if the processor supports it and it has passed the known-answer tests. A
+//! variable that names anything else is ignored with a warning, and RejectedOverride() returns it.
+//!
+//! @note	A calculator picks up the active kernel when it is constructed and when it is Reset().
+
+class KernelRegistry
+{
+public:
+
+	//! Algorithms with selectable kernels
+	enum Algorithm
+	{
+		CRC32,
+		MD5,
+		SHA1,
+		SHA256,
+		HEX,			//!< Hex encoding and decoding
+		BASE64,			//!< Base64 encoding and decoding
+		SHA1X8,			//!< SHA-1 of eight messages at once, for the batch hashes
+		SHA256X8,		//!< SHA-256 of eight messages at once, for the batch hashes
+		SCRYPT,			//!< ROMix of scrypt
+
+		NUMBER_OF_ALGORITHMS
+	};
+
+	//! Returns the name of the algorithm as used in the environment variable (e.g. "SHA256")
+	static char const * Name( Algorithm algorithm );
+
+	//! Returns the name of the kernel currently in use for an algorithm
+	static char const * Active( Algorithm algorithm );
+
+	//! Returns the names of the kernels that are supported by the processor and passed the known-answer tests
+	static std::vector< std::string > Available( Algorithm algorithm );
+
+	//! Returns the kernel named by the environment variable if it was ignored because it is not available, or nullptr.
+	//! The automatically-selected kernel is used instead, and a warning is written to stderr.
+	static char const * RejectedOverride( Algorithm algorithm );
+
+	//! Forces the use of a kernel. Returns false (and changes nothing) if the kernel is not available.
+	static bool Force( Algorithm algorithm, char const * kernel );
+
+	//! Reverts to the automatically-selected kernel
+	static void Automatic( Algorithm algorithm );
+
+	//! Selects the kernel again as on first use, from the automatic selection and the current value of the environment
+	//! variable. It must not be called while other threads are using the algorithm.
+	static void Reselect( Algorithm algorithm );
+};
+
+
+} // namespace Crypto
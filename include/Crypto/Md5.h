@@ -14,7 +14,14 @@
 #pragma once
 
 
+#include "Constexpr.h"
+#include "Digest.h"
+
+#include <charconv>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <iostream>
 
 
@@ -35,11 +42,14 @@ public:
 	//! Size of an MD5 digest in bytes
 	static int const	SIZE = 16;
 
+	//! Number of characters in the text representation
+	static int const	TEXT_SIZE = SIZE * 2;
+
 	//! Default constructor
-	Md5();
+	constexpr Md5() : m_digest()	{}
 
 	//! Constructs an MD5 from a memory image
-	Md5( unsigned __int8 const * pData, size_t size );
+	Md5( uint8_t const * pData, size_t size );
 
 	//! Constructs an MD5 from a stream
 	Md5( std::istream & stream );
@@ -50,19 +60,51 @@ public:
 	//! Constructs an MD5 from its 0-terminated text representation (up to 32 hex characters)
 	Md5( char const * pText );
 
-	// Destructor
-	virtual ~Md5();
+
+	//! Returns the MD5 digest of the data, computed at compile time if the data is constant
+	static constexpr Md5 Of( std::string_view data );
 
 	//! Returns the value as a text representation (with leading 0's)
 	std::string ToString() const;
 
-	//! Equality operator
-	bool operator == ( Md5 const & y ) const;
+	//! Writes the text representation to a buffer without allocating memory
+	std::to_chars_result ToChars( char * first, char * last ) const;
+
+	//! Parses a text representation of exactly TEXT_SIZE hex digits without allocating memory
+	static std::from_chars_result FromChars( char const * first, char const * last, Md5 & value );
+
+	//! Comparison operators. Digests are compared a word at a time, in the same order as their text.
+	bool operator == ( Md5 const & y ) const	{ return Digest::Equal( m_digest, y.m_digest ); }
+	bool operator != ( Md5 const & y ) const	{ return !Digest::Equal( m_digest, y.m_digest ); }
+	bool operator <  ( Md5 const & y ) const	{ return Digest::Compare( m_digest, y.m_digest ) < 0; }
+	bool operator >  ( Md5 const & y ) const	{ return Digest::Compare( m_digest, y.m_digest ) > 0; }
+	bool operator <= ( Md5 const & y ) const	{ return Digest::Compare( m_digest, y.m_digest ) <= 0; }
+	bool operator >= ( Md5 const & y ) const	{ return Digest::Compare( m_digest, y.m_digest ) >= 0; }
 
 	//! MD5 digest value
-	unsigned __int8 m_digest[ SIZE ];
+	uint8_t m_digest[ SIZE ];
 };
 
+static_assert( std::is_trivially_copyable< Md5 >::value, "Md5 must be trivially copyable." );
+static_assert( sizeof( Md5 ) == Md5::SIZE, "Md5 must be no larger than its value." );
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Data to hash. Any string literal or std::string_view with constant contents can be hashed at
+//!					compile time, e.g. @code static constexpr Md5 TAG = Md5::Of( "tag" ); @endcode
+
+inline constexpr Md5 Md5::Of( std::string_view data )
+{
+	Md5	result;
+
+	Constexpr::Md5( data.data(), data.size(), result.m_digest );
+
+	return result;
+}
+
 
 /********************************************************************************************************************/
 /*																													*/
@@ -75,7 +117,10 @@ public:
 
 inline std::ostream & operator<<( std::ostream & stream, Md5 const & md5 )
 {
-	stream << md5.ToString();
+	char	text[ Md5::TEXT_SIZE ];
+
+	md5.ToChars( text, text + sizeof( text ) );
+	stream << std::string_view( text, sizeof( text ) );
 
 	return stream;
 }
@@ -102,4 +147,27 @@ inline std::istream & operator>>( std::istream & stream, Md5 & md5 )
 }
 
 
-} // namespace Crypto
\ No newline at end of file
+} // namespace Crypto
+
+
+namespace std
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Hashes an MD5 digest by taking its first word. The digest is already uniformly distributed.
+
+template<>
+struct hash< Crypto::Md5 >
+{
+	size_t operator()( Crypto::Md5 const & md5 ) const noexcept
+	{
+		return Crypto::Digest::Hash( md5.m_digest );
+	}
+};
+
+
+} // namespace std
\ No newline at end of file
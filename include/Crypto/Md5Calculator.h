@@ -55,6 +55,7 @@ documentation and/or software.
 
 */
 
+#include <cstdint>
 #include <istream>
 
 
@@ -94,10 +95,10 @@ public:
 	virtual ~Md5Calculator() {};
 
 	//! Calculates the MD5 digest for a buffer
-	void Calculate( unsigned __int8 const * data, size_t size, unsigned __int8 * digest );
+	void Calculate( uint8_t const * data, size_t size, uint8_t * digest );
 
 	//! Calculates the MD5 digest for a stream
-	void Calculate( std::istream & stream, unsigned __int8 * digest );
+	void Calculate( std::istream & stream, uint8_t * digest );
 
 	//! @name Computation In Steps
 	//@{
@@ -109,25 +110,26 @@ public:
 	void Reset();
 
 	//! Processes a buffer
-	void Process( unsigned __int8 const * data, size_t size );
+	void Process( uint8_t const * data, size_t size );
 
 	//! Processes a file
 	void Process( std::istream & stream );
 
 	//! Does the final computation and returns the digest
-	void Finalize( unsigned __int8 * digest );
+	void Finalize( uint8_t * digest );
 
 	//@}
 
 private:
 
-	// Processes a 512 bit chunk of data
-	void ProcessChunk( unsigned __int8 const * data );
+	// Processes 512 bit chunks of data with the kernel selected by the KernelRegistry
+	void ProcessChunks( uint8_t const * data, size_t n )	{ m_kernel( m_digest, data, n * BYTES_PER_CHUNK ); }
 
-	unsigned __int32	m_digest[ DIGEST_SIZE_IN_WORDS ];	// Intermediate digest value
-	unsigned __int8		m_buffer[ BYTES_PER_CHUNK ];		// Buffer for storing partial chunks
+	uint32_t			m_digest[ DIGEST_SIZE_IN_WORDS ];	// Intermediate digest value
+	uint8_t				m_buffer[ BYTES_PER_CHUNK ];		// Buffer for storing partial chunks
 	int					m_tail;								// End of the data in the m_buffer
 	size_t				m_nProcessed;						// Number of bytes processed so far
+	void				( *m_kernel )( uint32_t *, uint8_t const *, size_t );	// Kernel (see Kernels.h)
 };
 
 
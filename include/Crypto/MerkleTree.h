@@ -0,0 +1,119 @@
+/** @file *//********************************************************************************************************
+
+                                                     MerkleTree.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/MerkleTree.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "Sha256.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! A binary hash tree over a list of records, with inclusion proofs (RFC 6962)
+//
+//! The hash of a leaf is SHA-256( 0x00 || record ) and the hash of an interior node is SHA-256( 0x01 || left ||
+//! right ). The levels are built bottom-up, and a node without a sibling at the end of a level is moved up unchanged,
+//! which gives the same root as the recursive definition in RFC 6962 for any number of leaves.
+//!
+//! All the levels are stored one after the other in a single array. The nodes of a level are hashed in groups of
+//! eight, which are computed in the lanes of the SHA256X8 kernel unless the SHA256 kernel uses the SHA extensions. In
+//! that case the nodes of a group are hashed one at a time with SHA-NI, which is as fast, and HashLeaves() does the
+//! same with the leaves. Changing a leaf only marks it, and Update() then recomputes only the nodes above the changed
+//! leaves, one level at a time.
+//!
+//! @code
+//!		MerkleTree	tree;
+//!		tree.Build( leaves.data(), leaves.size() );
+//!		tree.SetLeaf( 1234, record, recordSize );
+//!		tree.Update();
+//!		tree.Prove( 1234, proof );
+//!		...
+//!		bool const	valid	= MerkleTree::Verify( root, size, 1234, MerkleTree::HashLeaf( record, recordSize ),
+//!											  proof.data(), proof.size() );
+//! @endcode
+
+class MerkleTree
+{
+public:
+
+	//! Constructor. The tree is empty.
+	MerkleTree();
+
+	//! Builds a tree from the hashes of its leaves
+	void Build( Sha256 const * leaves, size_t count );
+
+	//! Returns the number of leaves
+	size_t Size() const										{ return m_size; }
+
+	//! Returns the hash of a leaf
+	Sha256 const & Leaf( size_t index ) const				{ return m_nodes[ index ]; }
+
+	//! Changes the record of a leaf. The tree is not updated until Update() is called.
+	void SetLeaf( size_t index, uint8_t const * data, size_t size );
+
+	//! Changes the hash of a leaf. The tree is not updated until Update() is called.
+	void SetLeaf( size_t index, Sha256 const & hash );
+
+	//! Recomputes the nodes above the leaves that have changed
+	void Update();
+
+	//! Returns the root. The root of an empty tree is the SHA-256 digest of nothing.
+	Sha256 Root() const;
+
+	//! Returns the hashes of the siblings on the path from a leaf to the root, bottom-up. Returns false if the index
+	//! is out of range or the tree has changes that are not updated yet.
+	bool Prove( size_t index, std::vector< Sha256 > & proof ) const;
+
+	//! Returns true if a proof shows that a leaf is in a tree
+	static bool Verify( Sha256 const & root, size_t size, size_t index, Sha256 const & leaf, Sha256 const * proof,
+						size_t proofSize );
+
+	//! Returns the hash of a leaf with a record
+	static Sha256 HashLeaf( uint8_t const * data, size_t size );
+
+	//! Computes the hashes of many leaves at once
+	static void HashLeaves( uint8_t const * const * data, size_t const * sizes, size_t count, Sha256 * leaves );
+
+	//! Returns the hash of an interior node
+	static Sha256 HashNode( Sha256 const & left, Sha256 const & right );
+
+	//! Computes the hashes of many interior nodes at once
+	static void HashNodes( Sha256 const * const * lefts, Sha256 const * const * rights, Sha256 * const * parents,
+						   size_t count );
+
+private:
+
+	// Sets up the levels for a number of leaves
+	void Allocate( size_t size );
+
+	// Recomputes the given nodes of a level from the level below. If parents is nullptr, the first count nodes are
+	// recomputed.
+	void Recompute( size_t level, size_t const * parents, size_t count );
+
+	size_t					m_size;			// Number of leaves
+	std::vector< Sha256 >	m_nodes;		// All the levels, from the leaves to the root
+	std::vector< size_t >	m_offsets;		// Position of each level in m_nodes, plus the end
+	std::vector< size_t >	m_dirty;		// Leaves changed since the last update
+};
+
+
+} // namespace Crypto
@@ -0,0 +1,131 @@
+/** @file *//********************************************************************************************************
+
+                                                   MultipartETag.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/MultipartETag.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "Md5.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Computes the ETag and CRC-32 of an object uploaded in parts (S3 multipart uploads)
+//
+//! The ETag of an object uploaded in parts is the MD5 digest of the MD5 digests of the parts, in order of part number,
+//! followed by "-" and the number of parts. The CRC-32 of the whole object is computed at the same time from the
+//! CRC-32 of each part with Crc32Calculator::Combine(), so the object is never read again once its parts are hashed.
+//!
+//! Parts are added in any order, from any thread, as they arrive, and are hashed by a pool of threads. Each part's MD5
+//! digest and CRC-32 are computed together a slice at a time, so the data is read once while it is in the cache. A
+//! single part cannot be split among threads, since MD5 is sequential, so the parts are hashed in parallel instead.
+//!
+//! @code
+//!		MultipartETag	etag( 4 );
+//!		etag.AddPart( 2, part2, part2Size );	// The data must remain valid until the part has been hashed
+//!		etag.AddPart( 1, part1, part1Size );
+//!		...
+//!		std::string const	value	= etag.ETag();	// Waits for the parts to be hashed
+//! @endcode
+
+class MultipartETag
+{
+public:
+
+	//! Largest part number
+	static uint32_t const	MAX_PART_NUMBER	= 10000;
+
+	//! Constructor. At least one thread is started.
+	explicit MultipartETag( unsigned threads = std::thread::hardware_concurrency() );
+
+	//! Destructor. Waits for the parts that have been added to be hashed.
+	~MultipartETag();
+
+	//! Adds a part to be hashed. The data must remain valid until Wait() returns. Returns false if the part number is
+	//! out of range or the part has already been added.
+	bool AddPart( uint32_t number, uint8_t const * data, size_t size );
+
+	//! Waits until every part that has been added is hashed
+	void Wait();
+
+	//! Returns the MD5 digest of a part. Waits until it is hashed. Returns false if the part has not been added.
+	bool PartMd5( uint32_t number, Md5 & digest );
+
+	//! Returns the ETag of the object, without quotes, or an empty string if no parts have been added. Waits until the
+	//! parts are hashed.
+	std::string ETag();
+
+	//! Returns the CRC-32 of the object. Waits until the parts are hashed.
+	uint32_t Crc32();
+
+	//! Returns the size of the object
+	uint64_t Size();
+
+	//! Returns the number of parts
+	uint32_t PartCount();
+
+	//! Waits until the parts are hashed and forgets them, so the next object can be started. Parts must not be added
+	//! while it is called.
+	void Reset();
+
+private:
+
+	// Non-copyable
+	MultipartETag( MultipartETag const & ) = delete;
+	MultipartETag & operator =( MultipartETag const & ) = delete;
+
+	// Part of the object
+	struct Part
+	{
+		Md5			md5;		// MD5 digest
+		uint32_t	crc;		// CRC-32
+		uint64_t	size;		// Size
+		bool		added;		// True if the part has been added
+	};
+
+	// A part waiting to be hashed
+	struct Job
+	{
+		uint32_t		number;		// Part number
+		uint8_t const *	data;		// Contents
+		size_t			size;		// Size of the contents
+	};
+
+	// Hashes parts until the pool is stopped and there are no more
+	void Work();
+
+	std::mutex					m_mutex;		// Protects everything below
+	std::condition_variable		m_queued;		// Signaled when a job is queued or the pool is stopped
+	std::condition_variable		m_finished;		// Signaled when the last pending job is finished
+	std::deque< Job >			m_jobs;			// Parts waiting to be hashed
+	size_t						m_pending;		// Number of parts added but not hashed yet
+	std::vector< Part >			m_parts;		// Parts by number, starting with 1
+	bool						m_stop;			// True if the threads should exit once the jobs are done
+	std::vector< std::thread >	m_threads;		// The pool
+};
+
+
+} // namespace Crypto
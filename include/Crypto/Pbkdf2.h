@@ -0,0 +1,79 @@
+/** @file *//********************************************************************************************************
+
+                                                       Pbkdf2.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Pbkdf2.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Derives keys from passwords (PBKDF2 with HMAC-SHA-1 or HMAC-SHA-256, RFC 8018)
+//
+//! Nearly all the time goes to the iterations, each of which hashes the 20 or 32-byte output of the previous one with
+//! two blocks of the compression function. The states after the padded password blocks are computed once, and the
+//! iterations call the compression function directly on a block whose padding never changes.
+//!
+//! Eight iterations are done at once, one in each lane of the x8 kernels selected by the KernelRegistry, so deriving
+//! several keys (or a key longer than one digest) at once costs little more than deriving one. DeriveBatch() is meant
+//! for servers that verify many logins. The lanes are skipped where the regular kernel is as fast: with the SHA
+//! extensions, HMAC-SHA-256 jobs are iterated one at a time with the SHA-NI kernel and HMAC-SHA-1 jobs only use the
+//! lanes in groups of at least four, and the portable x8 kernel is never used.
+//!
+//! @code
+//!		uint8_t	key[ 32 ];
+//!		Pbkdf2::Derive( Pbkdf2::SHA256, password, passwordSize, salt, saltSize, 600000, key, sizeof( key ) );
+//! @endcode
+
+class Pbkdf2
+{
+public:
+
+	//! Hash functions
+	enum Hash
+	{
+		SHA1,		//!< HMAC-SHA-1
+		SHA256		//!< HMAC-SHA-256
+	};
+
+	//! A key to derive, for DeriveBatch()
+	struct Request
+	{
+		uint8_t const *	password;		//!< Password
+		size_t			passwordSize;	//!< Size of the password
+		uint8_t const *	salt;			//!< Salt
+		size_t			saltSize;		//!< Size of the salt
+		uint8_t *		key;			//!< Where to put the derived key
+		size_t			keySize;		//!< Size of the derived key
+	};
+
+	//! Derives a key from a password. The number of iterations is at least 1.
+	static void Derive( Hash hash, uint8_t const * password, size_t passwordSize, uint8_t const * salt,
+						size_t saltSize, uint32_t iterations, uint8_t * key, size_t keySize );
+
+	//! Derives several keys with the same number of iterations at once
+	static void DeriveBatch( Hash hash, Request const * requests, size_t count, uint32_t iterations );
+
+	//! Returns the memory Derive() allocates to derive a key, besides the key itself
+	static size_t ScratchSize( Hash hash, size_t saltSize, size_t keySize );
+};
+
+
+} // namespace Crypto
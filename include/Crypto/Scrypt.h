@@ -0,0 +1,88 @@
+/** @file *//********************************************************************************************************
+
+                                                       Scrypt.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Scrypt.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Derives keys from passwords with a memory-hard function (scrypt, RFC 7914)
+//
+//! The password and salt are expanded with PBKDF2-HMAC-SHA256 into p blocks of 128 * r bytes. Each block is mixed by
+//! ROMix, which fills a table of n BlockMix results and then reads it back in a data-dependent order, and the mixed
+//! blocks are the salt of a final PBKDF2. The ROMix kernel is selected by the KernelRegistry (SCRYPT).
+//!
+//! Each block being mixed at once needs 128 * r * ( n + 2 ) bytes, and that memory comes from an arena that is kept
+//! between calls, so a Scrypt object that derives keys over and over only allocates once. The p blocks themselves
+//! take another 256 * r * p bytes during a call, and PBKDF2 needs about 144 bytes for each 32 bytes it derives. The
+//! blocks are mixed by up to the given number of threads, and the memory limit caps the arena, the blocks and the
+//! PBKDF2 scratch space together: if there is not enough memory for all the threads, fewer threads are used, and an
+//! arena kept from an earlier call is made smaller if it no longer fits, so the memory allocated by an object never
+//! exceeds its limit. A Scrypt object is not thread-safe, so each thread should have its own.
+//!
+//! @code
+//!		Scrypt	scrypt;
+//!		uint8_t	key[ 32 ];
+//!		if ( !scrypt.Derive( password, passwordSize, salt, saltSize, 1 << 15, 8, 1, key, sizeof( key ) ) )
+//!			...
+//! @endcode
+
+class Scrypt
+{
+public:
+
+	//! Default memory limit
+	static size_t const		DEFAULT_MAX_MEMORY	= size_t( 256 ) << 20;
+
+	//! Constructor
+	explicit Scrypt( size_t maxMemory = DEFAULT_MAX_MEMORY, unsigned threads = 1 );
+
+	//! Destructor
+	~Scrypt();
+
+	//! Derives a key from a password. Returns false if the parameters are invalid or need more memory than the limit.
+	bool Derive( uint8_t const * password, size_t passwordSize, uint8_t const * salt, size_t saltSize, uint64_t n,
+				 uint32_t r, uint32_t p, uint8_t * key, size_t keySize );
+
+	//! Returns the amount of memory needed to mix one block, or 0 if the parameters are invalid
+	static size_t MemoryPerBlock( uint64_t n, uint32_t r );
+
+	//! Returns the size of the arena
+	size_t ArenaSize() const						{ return m_arenaSize; }
+
+	//! Frees the arena
+	void Release();
+
+private:
+
+	// Non-copyable
+	Scrypt( Scrypt const & ) = delete;
+	Scrypt & operator =( Scrypt const & ) = delete;
+
+	size_t		m_maxMemory;	// Maximum memory allocated during a call, including the arena
+	unsigned	m_threads;		// Maximum number of threads
+	void *		m_arena;		// Scratch space for ROMix, aligned to 64 bytes
+	size_t		m_arenaSize;	// Size of the arena
+};
+
+
+} // namespace Crypto
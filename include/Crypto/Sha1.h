@@ -14,7 +14,14 @@
 #pragma once
 
 
+#include "Constexpr.h"
+#include "Digest.h"
+
+#include <charconv>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <iostream>
 
 
@@ -35,11 +42,14 @@ public:
 	//! Size of an SHA-1 digest in bytes
 	static size_t const	SIZE = 20;
 
+	//! Number of characters in the text representation
+	static size_t const	TEXT_SIZE = SIZE * 2;
+
 	//! Default constructor
-	Sha1();
+	constexpr Sha1() : m_value()	{}
 
 	//! Constructs an SHA-1 from a memory image
-	Sha1( unsigned __int8 const * pData, size_t size );
+	Sha1( uint8_t const * pData, size_t size );
 
 	//! Constructs an SHA-1 from a stream
 	Sha1( std::istream & stream );
@@ -50,19 +60,51 @@ public:
 	//! Constructs an SHA-1 from its 0-terminated text representation (up to 40 hex characters)
 	Sha1( char const * pText );
 
-	// Destructor
-	virtual ~Sha1();
+
+	//! Returns the SHA-1 digest of the data, computed at compile time if the data is constant
+	static constexpr Sha1 Of( std::string_view data );
 
 	//! Returns the value as a text representation (with leading 0's)
 	std::string ToString() const;
 
-	//! Equality operator
-	bool operator == ( Sha1 const & y ) const;
+	//! Writes the text representation to a buffer without allocating memory
+	std::to_chars_result ToChars( char * first, char * last ) const;
+
+	//! Parses a text representation of exactly TEXT_SIZE hex digits without allocating memory
+	static std::from_chars_result FromChars( char const * first, char const * last, Sha1 & value );
+
+	//! Comparison operators. Digests are compared a word at a time, in the same order as their text.
+	bool operator == ( Sha1 const & y ) const	{ return Digest::Equal( m_value, y.m_value ); }
+	bool operator != ( Sha1 const & y ) const	{ return !Digest::Equal( m_value, y.m_value ); }
+	bool operator <  ( Sha1 const & y ) const	{ return Digest::Compare( m_value, y.m_value ) < 0; }
+	bool operator >  ( Sha1 const & y ) const	{ return Digest::Compare( m_value, y.m_value ) > 0; }
+	bool operator <= ( Sha1 const & y ) const	{ return Digest::Compare( m_value, y.m_value ) <= 0; }
+	bool operator >= ( Sha1 const & y ) const	{ return Digest::Compare( m_value, y.m_value ) >= 0; }
 
 	//! SHA-1 digest value
-	unsigned __int8 m_value[ SIZE ];
+	uint8_t m_value[ SIZE ];
 };
 
+static_assert( std::is_trivially_copyable< Sha1 >::value, "Sha1 must be trivially copyable." );
+static_assert( sizeof( Sha1 ) == Sha1::SIZE, "Sha1 must be no larger than its value." );
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Data to hash. Any string literal or std::string_view with constant contents can be hashed at
+//!					compile time, e.g. @code static constexpr Sha1 TAG = Sha1::Of( "tag" ); @endcode
+
+inline constexpr Sha1 Sha1::Of( std::string_view data )
+{
+	Sha1	result;
+
+	Constexpr::Sha1( data.data(), data.size(), result.m_value );
+
+	return result;
+}
+
 
 /********************************************************************************************************************/
 /*																													*/
@@ -75,7 +117,10 @@ public:
 
 inline std::ostream & operator<<( std::ostream & stream, Sha1 const & sha1 )
 {
-	stream << sha1.ToString();
+	char	text[ Sha1::TEXT_SIZE ];
+
+	sha1.ToChars( text, text + sizeof( text ) );
+	stream << std::string_view( text, sizeof( text ) );
 
 	return stream;
 }
@@ -102,4 +147,27 @@ inline std::istream & operator>>( std::istream & stream, Sha1 & sha1 )
 }
 
 
-} // namespace Crypto
\ No newline at end of file
+} // namespace Crypto
+
+
+namespace std
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Hashes an SHA-1 digest by taking its first word. The digest is already uniformly distributed.
+
+template<>
+struct hash< Crypto::Sha1 >
+{
+	size_t operator()( Crypto::Sha1 const & sha1 ) const noexcept
+	{
+		return Crypto::Digest::Hash( sha1.m_value );
+	}
+};
+
+
+} // namespace std
\ No newline at end of file
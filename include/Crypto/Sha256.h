@@ -13,7 +13,14 @@
 
 #pragma once
 
+#include "Constexpr.h"
+#include "Digest.h"
+
+#include <charconv>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <iostream>
 
 
@@ -34,11 +41,14 @@ public:
 	//! Size of an SHA-256 digest in bytes
 	static size_t const	SIZE = 32;
 
+	//! Number of characters in the text representation
+	static size_t const	TEXT_SIZE = SIZE * 2;
+
 	//! Default constructor
-	Sha256();
+	constexpr Sha256() : m_value()	{}
 
 	//! Constructs an SHA-256 from a memory image
-	Sha256( unsigned __int8 const * pData, size_t size );
+	Sha256( uint8_t const * pData, size_t size );
 
 	//! Constructs an SHA-256 from a stream
 	Sha256( std::istream & stream );
@@ -49,18 +59,50 @@ public:
 	//! Constructs an SHA-256 from its 0-terminated text representation (up to 64 hex characters)
 	Sha256( char const * pText );
 
-	// Destructor
-	virtual ~Sha256();
+
+	//! Returns the SHA-256 digest of the data, computed at compile time if the data is constant
+	static constexpr Sha256 Of( std::string_view data );
 
 	//! Returns the value as a text representation (with leading 0's)
 	std::string ToString() const;
 
-	//! Equality operator
-	bool operator == ( Sha256 const & y ) const;
+	//! Writes the text representation to a buffer without allocating memory
+	std::to_chars_result ToChars( char * first, char * last ) const;
+
+	//! Parses a text representation of exactly TEXT_SIZE hex digits without allocating memory
+	static std::from_chars_result FromChars( char const * first, char const * last, Sha256 & value );
 
-	unsigned __int8 m_value[ SIZE ];	//!< Value
+	//! Comparison operators. Digests are compared a word at a time, in the same order as their text.
+	bool operator == ( Sha256 const & y ) const	{ return Digest::Equal( m_value, y.m_value ); }
+	bool operator != ( Sha256 const & y ) const	{ return !Digest::Equal( m_value, y.m_value ); }
+	bool operator <  ( Sha256 const & y ) const	{ return Digest::Compare( m_value, y.m_value ) < 0; }
+	bool operator >  ( Sha256 const & y ) const	{ return Digest::Compare( m_value, y.m_value ) > 0; }
+	bool operator <= ( Sha256 const & y ) const	{ return Digest::Compare( m_value, y.m_value ) <= 0; }
+	bool operator >= ( Sha256 const & y ) const	{ return Digest::Compare( m_value, y.m_value ) >= 0; }
+
+	uint8_t m_value[ SIZE ];			//!< Value
 };
 
+static_assert( std::is_trivially_copyable< Sha256 >::value, "Sha256 must be trivially copyable." );
+static_assert( sizeof( Sha256 ) == Sha256::SIZE, "Sha256 must be no larger than its value." );
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! @param	data	Data to hash. Any string literal or std::string_view with constant contents can be hashed at
+//!					compile time, e.g. @code static constexpr Sha256 TAG = Sha256::Of( "tag" ); @endcode
+
+inline constexpr Sha256 Sha256::Of( std::string_view data )
+{
+	Sha256	result;
+
+	Constexpr::Sha256( data.data(), data.size(), result.m_value );
+
+	return result;
+}
+
 
 /********************************************************************************************************************/
 /*																													*/
@@ -73,7 +115,10 @@ public:
 
 inline std::ostream & operator<<( std::ostream & stream, Sha256 const & sha256 )
 {
-	stream << sha256.ToString();
+	char	text[ Sha256::TEXT_SIZE ];
+
+	sha256.ToChars( text, text + sizeof( text ) );
+	stream << std::string_view( text, sizeof( text ) );
 
 	return stream;
 }
@@ -100,4 +145,27 @@ inline std::istream & operator>>( std::istream & stream, Sha256 & sha256 )
 }
 
 
-} // namespace Crypto
\ No newline at end of file
+} // namespace Crypto
+
+
+namespace std
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Hashes an SHA-256 digest by taking its first word. The digest is already uniformly distributed.
+
+template<>
+struct hash< Crypto::Sha256 >
+{
+	size_t operator()( Crypto::Sha256 const & sha256 ) const noexcept
+	{
+		return Crypto::Digest::Hash( sha256.m_value );
+	}
+};
+
+
+} // namespace std
\ No newline at end of file
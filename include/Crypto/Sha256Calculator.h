@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 
 
@@ -52,10 +53,10 @@ public:
 	virtual ~Sha256Calculator() {}
 
 	//! Calculates the SHA-256 digest for a buffer
-	void Calculate( unsigned __int8 const * data, size_t size, unsigned __int8 * digest );
+	void Calculate( uint8_t const * data, size_t size, uint8_t * digest );
 
 	//! Calculates the SHA-256 digest for a stream
-	void Calculate( std::istream & stream, unsigned __int8 * digest );
+	void Calculate( std::istream & stream, uint8_t * digest );
 
 	//! @name Computation In Steps
 	//@{
@@ -67,25 +68,26 @@ public:
 	void Reset();
 
 	//! Processes a buffer
-	void Process( unsigned __int8 const * data, size_t size );
+	void Process( uint8_t const * data, size_t size );
 
 	//! Processes a stream
 	void Process( std::istream & stream );
 
 	//! Does the final computation and returns the digest
-	void Finalize( unsigned __int8 * digest );
+	void Finalize( uint8_t * digest );
 
 	//@}
 
 private:
 
-	// Processes a 512 bit chunk of data
-	void ProcessChunk( unsigned __int8 const * data );
+	// Processes 512 bit chunks of data with the kernel selected by the KernelRegistry
+	void ProcessChunks( uint8_t const * data, size_t n )	{ m_kernel( m_digest, data, n * BYTES_PER_CHUNK ); }
 
-	unsigned __int32	m_digest[ DIGEST_SIZE_IN_WORDS ];
-	unsigned __int8		m_buffer[ BYTES_PER_CHUNK ];
+	uint32_t			m_digest[ DIGEST_SIZE_IN_WORDS ];
+	uint8_t				m_buffer[ BYTES_PER_CHUNK ];
 	int					m_tail;
 	size_t				m_nProcessed;
+	void				( *m_kernel )( uint32_t * state, uint8_t const * data, size_t size );
 };
 
 
@@ -0,0 +1,167 @@
+/** @file *//********************************************************************************************************
+
+                                                   TorrentPieces.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/TorrentPieces.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "Sha1.h"
+#include "Sha256.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace Crypto
+{
+
+class MappedFile;
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Hashes the pieces of a BitTorrent file set and checks existing data against them
+//
+//! In a v1 torrent (BEP 3), the files are concatenated in order and split into pieces of a fixed size, so a piece may
+//! span several files and the last one may be shorter. Each piece is identified by its SHA-1 digest.
+//!
+//! In a v2 torrent (BEP 52), each file has its own SHA-256 Merkle tree whose leaves are the digests of 16 KB blocks.
+//! The last block may be shorter, and the leaves past the end of the file are 0's up to a power of two. The root of
+//! the tree is the file's "pieces root". Pieces start at the beginning of each file, and the nodes of the tree that
+//! cover a piece each form the file's "piece layer", which is only given for files larger than a piece. An empty file
+//! has no root and no pieces.
+//!
+//! The files are read through memory mappings, a few at a time, and are never copied except for the blocks that span
+//! two files. The pieces (v1), blocks and nodes (v2) are hashed in batches in the lanes of the x8 kernels selected by
+//! the KernelRegistry, and a lane that finishes starts the next. With the SHA extensions, the v2 blocks and nodes are
+//! hashed one at a time by the SHA-NI kernel, which keeps up with eight AVX2 lanes, and the v1 pieces go back to the
+//! SHA-1 kernel once fewer than four lanes are busy.
+//!
+//! To check downloaded data, the files are added with the sizes given by the torrent. A piece is valid only if all of
+//! its data is present and its hash matches. Checking hashes each piece once and nothing else, so it reads the data
+//! once, sequentially.
+//!
+//! @code
+//!		TorrentPieces		torrent( 256 * 1024 );
+//!		torrent.AddFile( "data/a.bin" );
+//!		torrent.AddFile( "data/b.bin" );
+//!		std::vector< Sha1 >	pieces;
+//!		torrent.HashV1( pieces );
+//! @endcode
+
+class TorrentPieces
+{
+public:
+
+	//! Version of the torrent format
+	enum Version
+	{
+		V1,
+		V2
+	};
+
+	//! Size of a block hashed by a leaf of a v2 Merkle tree. A v2 piece size is a power of two at least this large.
+	static constexpr size_t	BLOCK_SIZE	= 16 * 1024;
+
+	//! The v2 hashes of a file
+	struct FileHashes
+	{
+		Sha256					root;		//!< Root of the file's Merkle tree, or 0's if the file is empty
+		std::vector< Sha256 >	layer;		//!< Piece layer, which is empty if the file is no larger than a piece
+	};
+
+	//! Constructor
+	explicit TorrentPieces( size_t pieceSize );
+
+	//! Destructor
+	~TorrentPieces();
+
+	//! Adds a file that exists, with its current size. Returns false if its size cannot be determined.
+	bool AddFile( std::string const & path );
+
+	//! Adds a file with the size given by a torrent. The file may be missing or incomplete.
+	void AddFile( std::string const & path, uint64_t size );
+
+	//! Returns the size of a piece
+	size_t PieceSize() const						{ return m_pieceSize; }
+
+	//! Returns the total size of the files
+	uint64_t Size() const							{ return m_size; }
+
+	//! Returns the number of pieces
+	size_t PieceCount( Version version ) const;
+
+	//! Computes the v1 piece hashes. Returns false if the piece size is 0 or any of the data is missing.
+	bool HashV1( std::vector< Sha1 > & pieces );
+
+	//! Computes the v2 hashes of each file. Returns false if the piece size is invalid or any of the data is missing.
+	bool HashV2( std::vector< FileHashes > & files );
+
+	//! Checks the data against v1 piece hashes and sets the flag of each piece that is valid. Returns true if every
+	//! piece is valid.
+	bool VerifyV1( std::vector< Sha1 > const & pieces, std::vector< bool > & valid );
+
+	//! Checks the data against the v2 hashes of each file and sets the flag of each piece that is valid, with the
+	//! pieces numbered in the order of the files. A file's pieces are invalid if its piece layer does not match its
+	//! root. Returns true if every piece is valid.
+	bool VerifyV2( std::vector< FileHashes > const & files, std::vector< bool > & valid );
+
+private:
+
+	// Non-copyable
+	TorrentPieces( TorrentPieces const & ) = delete;
+	TorrentPieces & operator =( TorrentPieces const & ) = delete;
+
+	// A file of the set
+	struct File
+	{
+		std::string						path;		// Path
+		uint64_t						size;		// Size
+		uint64_t						offset;		// Offset of the file in the set
+		std::unique_ptr< MappedFile >	mapping;	// Contents, mapped when they are needed
+		bool							opened;		// True if mapping the file has been attempted
+	};
+
+	// Appends the data and size of each part of a range of the set that is in a different file. Returns false if any
+	// of the data is missing.
+	bool Segments( uint64_t begin, uint64_t end, std::vector< std::pair< uint8_t const *, size_t > > & segments );
+
+	// Returns the contents of a file, or nullptr if the file is missing or too small
+	uint8_t const * Map( size_t file );
+
+	// Unmaps the files that end at or before an offset in the set
+	void Unmap( uint64_t offset );
+
+	// Hashes the v1 pieces [first, last) and sets the flag of each one whose data is all present. A piece whose data
+	// is missing is not hashed.
+	void HashPieces( size_t first, size_t last, std::vector< Sha1 > & hashes, std::vector< bool > & available );
+
+	// Hashes the v2 pieces [first, last) of a file, or the whole file if it is no larger than a piece. Returns false if
+	// any of the data is missing.
+	bool HashPieces( size_t file, uint64_t first, uint64_t last, Sha256 * hashes );
+
+	// Returns true if the piece size is valid for v2
+	bool ValidV2() const;
+
+	size_t					m_pieceSize;	// Size of a piece
+	uint64_t				m_size;			// Total size of the files
+	std::vector< File >		m_files;		// Files of the set, in order
+	size_t					m_mapped;		// Files before this one have been unmapped
+};
+
+
+} // namespace Crypto
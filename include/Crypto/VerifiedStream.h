@@ -0,0 +1,160 @@
+/** @file *//********************************************************************************************************
+
+                                                   VerifiedStream.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/VerifiedStream.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "Sha256.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+
+namespace Crypto
+{
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+//! Verifies an object chunk by chunk against its hash as the object arrives (Bao-style verified streaming)
+//
+//! An object is split into chunks of CHUNK_SIZE bytes, the last of which may be shorter. An empty object has one empty
+//! chunk. The chunks are the leaves of a binary hash tree whose leaf and node hashes are those of a MerkleTree (RFC
+//! 6962), and the left subtree of each node has the largest power of 2 number of chunks less than the node's. The
+//! hash of the object binds the size to the root of the tree:
+//!
+//!		SHA-256( 0x02 || root || size as a 64-bit little-endian value )
+//!
+//! The tree is kept with the object in one of two encodings. Both start with the size of the object (8 bytes,
+//! little-endian), followed by the tree in pre-order:
+//!	- Combined: each interior node is the hashes of its two children (64 bytes), and each leaf is its chunk.
+//!	- Outboard: only the interior nodes. The object is kept separately, and the outboard tree is 1/256 of its size.
+//!
+//! A VerifiedStream is given the hash of an object and then the combined encoding (or, with an outboard tree, the
+//! object itself) in pieces of any size. Each interior node is checked against the hash its parent gave it, and each
+//! chunk is checked as soon as it is complete and only then passed to the receiver. Corrupt data is detected at the
+//! first chunk that is wrong rather than after the whole object has arrived, and nothing unverified is passed on.
+//!
+//! Read() and ReadOutboard() verify a range of an encoded object that is in memory or mapped. Only the chunks that
+//! overlap the range and the interior nodes above them are hashed.
+//!
+//! @code
+//!		VerifiedStream	stream( hash, []( uint64_t offset, uint8_t const * data, size_t size ) { ... } );
+//!		while ( ... )
+//!		{
+//!			if ( !stream.Write( received, receivedSize ) )
+//!				... the object is corrupt
+//!		}
+//!		bool const	complete	= stream.Finish();
+//! @endcode
+
+class VerifiedStream
+{
+public:
+
+	//! Size of a chunk
+	static size_t const		CHUNK_SIZE	= 16 * 1024;
+
+	//! Size of the header of an encoding
+	static size_t const		HEADER_SIZE	= 8;
+
+	//! Size of an interior node in an encoding
+	static size_t const		NODE_SIZE	= 2 * Sha256::SIZE;
+
+	//! Called with each verified chunk and its offset in the object. The data is only valid during the call.
+	typedef std::function< void ( uint64_t offset, uint8_t const * data, size_t size ) >	Receiver;
+
+	//! Constructor for a combined encoding
+	VerifiedStream( Sha256 const & hash, Receiver const & receiver );
+
+	//! Constructor for an outboard tree. The tree is not copied, so it must remain valid while the stream is used.
+	VerifiedStream( Sha256 const & hash, uint8_t const * outboard, size_t outboardSize, Receiver const & receiver );
+
+	//! Processes the next part of the stream. Returns false if any data so far is corrupt or there is too much.
+	bool Write( uint8_t const * data, size_t size );
+
+	//! Returns true if the whole object has arrived and been verified
+	bool Finish() const;
+
+	//! Returns true if the stream has been found to be corrupt
+	bool Failed() const										{ return m_failed; }
+
+	//! Returns the number of bytes of the object verified so far
+	uint64_t Verified() const								{ return m_verified; }
+
+	//! Returns the size of the combined encoding of an object
+	static uint64_t EncodedSize( uint64_t size );
+
+	//! Returns the size of the outboard tree of an object
+	static uint64_t OutboardSize( uint64_t size );
+
+	//! Returns the hash of an object
+	static Sha256 Hash( uint8_t const * data, size_t size );
+
+	//! Writes the combined encoding of an object, which is EncodedSize() bytes, and returns its hash
+	static Sha256 Encode( uint8_t const * data, size_t size, uint8_t * encoded );
+
+	//! Writes the outboard tree of an object, which is OutboardSize() bytes, and returns its hash
+	static Sha256 EncodeOutboard( uint8_t const * data, size_t size, uint8_t * outboard );
+
+	//! Verifies and copies a range of an object from its combined encoding. Returns false if the range is out of
+	//! bounds or any part of the object or tree needed is corrupt.
+	static bool Read( Sha256 const & hash, uint8_t const * encoded, size_t encodedSize, uint64_t offset, size_t size,
+					  uint8_t * output );
+
+	//! Verifies and copies a range of an object using its outboard tree. Returns false if the range is out of bounds or
+	//! any part of the object or tree needed is corrupt.
+	static bool ReadOutboard( Sha256 const & hash, uint8_t const * outboard, size_t outboardSize, uint8_t const * data,
+							  uint64_t offset, size_t size, uint8_t * output );
+
+private:
+
+	// A subtree whose encoding has not arrived yet
+	struct Subtree
+	{
+		Sha256		hash;		// Expected hash
+		uint64_t	first;		// First chunk
+		uint64_t	count;		// Number of chunks
+	};
+
+	// Returns the number of bytes needed for the next part of the encoding, or 0 if the encoding is complete
+	size_t Needed() const;
+
+	// Verifies the next part of the encoding
+	bool Consume( uint8_t const * data );
+
+	// Verifies an interior node and replaces it with its children
+	bool Split( uint8_t const * node );
+
+	// Verifies the interior nodes in the outboard tree until the next subtree is a chunk
+	bool Expand();
+
+	Sha256					m_hash;				// Hash of the object
+	Receiver				m_receiver;			// Called with each verified chunk
+	uint8_t const *			m_outboard;			// Outboard tree, or nullptr for a combined encoding
+	size_t					m_outboardSize;		// Size of the outboard tree
+	size_t					m_outboardPosition;	// Position of the next interior node in the outboard tree
+	uint64_t				m_size;				// Size of the object
+	uint64_t				m_chunks;			// Number of chunks in the object
+	uint64_t				m_verified;			// Number of bytes verified
+	bool					m_started;			// True if the size is known
+	bool					m_failed;			// True if corrupt data was found
+	std::vector< Subtree >	m_pending;			// Subtrees still to arrive, with the next one last
+	std::vector< uint8_t >	m_buffer;			// Partial part of the encoding held from the previous call
+};
+
+
+} // namespace Crypto
@@ -0,0 +1,460 @@
+/********************************************************************************************************************
+
+                                                  AuditLogTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/AuditLogTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "AuditLogTest.h"
+
+#include "../AuditLog.h"
+#include "../MerkleTree.h"
+
+#include "Misc/Etc.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+using namespace TestFiles;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( AuditLogTest );
+
+namespace
+{
+	uint64_t const	SEGMENT_SIZE	= 4096;
+	long const		HEADER_SIZE		= 8;
+	size_t const	MAX_RECORD_SIZE	= 300;
+
+	// Appends records one at a time
+	void Append( AuditLog & log, std::vector< std::vector< uint8_t > > const & records )
+	{
+		for ( size_t i = 0; i < records.size(); ++i )
+		{
+			CPPUNIT_ASSERT( log.Append( records[i].data(), records[i].size() ) );
+		}
+	}
+
+	// Appends records in one batch
+	void AppendBatch( AuditLog & log, std::vector< std::vector< uint8_t > > const & records )
+	{
+		std::vector< uint8_t const * >	data;
+		std::vector< size_t >			sizes;
+
+		for ( size_t i = 0; i < records.size(); ++i )
+		{
+			data.push_back( records[i].data() );
+			sizes.push_back( records[i].size() );
+		}
+
+		CPPUNIT_ASSERT( log.Append( data.data(), sizes.data(), records.size() ) );
+	}
+
+	// Checks that every record reads back, and that the log has no others
+	void Check( AuditLog & log, std::vector< std::vector< uint8_t > > const & records )
+	{
+		std::vector< uint8_t >	data;
+
+		CPPUNIT_ASSERT_EQUAL( uint64_t( records.size() ), log.Size() );
+		for ( size_t i = 0; i < records.size(); ++i )
+		{
+			CPPUNIT_ASSERT( log.Get( i, data ) );
+			CPPUNIT_ASSERT( data == records[i] );
+		}
+		CPPUNIT_ASSERT( !log.Get( records.size(), data ) );
+	}
+
+	// Returns the chain hash of the last of the records, computed here from the definition
+	Sha256 Chain( std::vector< std::vector< uint8_t > > const & records )
+	{
+		Sha256	chain;
+
+		for ( size_t i = 0; i < records.size(); ++i )
+		{
+			Sha256 const	leaf	= MerkleTree::HashLeaf( records[i].data(), records[i].size() );
+			uint8_t			message[ 2 * Sha256::SIZE ];
+
+			memcpy( message, chain.m_value, Sha256::SIZE );
+			memcpy( message + Sha256::SIZE, leaf.m_value, Sha256::SIZE );
+			chain = Sha256( message, sizeof( message ) );
+		}
+
+		return chain;
+	}
+
+	// Returns the root of a MerkleTree of the first size records
+	Sha256 Root( std::vector< std::vector< uint8_t > > const & records, size_t size )
+	{
+		std::vector< Sha256 >	leaves;
+		MerkleTree				tree;
+
+		for ( size_t i = 0; i < size; ++i )
+		{
+			leaves.push_back( MerkleTree::HashLeaf( records[i].data(), records[i].size() ) );
+		}
+		tree.Build( leaves.data(), leaves.size() );
+
+		return tree.Root();
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void AuditLogTest::setUp()
+{
+	m_directory.Create();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void AuditLogTest::tearDown()
+{
+	m_directory.Remove();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The chain hash follows each record, whether the records are appended one at a time or in a batch, and the tree head
+// matches a MerkleTree of the same records
+
+void AuditLogTest::TestChaining()
+{
+	std::vector< std::vector< uint8_t > >		records	= RandomBuffers( 40, MAX_RECORD_SIZE, 1 );
+	std::vector< std::vector< uint8_t > > const	batch	= RandomBuffers( 60, MAX_RECORD_SIZE, 2 );
+	AuditLog									log;
+
+	CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+	CPPUNIT_ASSERT( log.Chain() == Sha256() );
+	CPPUNIT_ASSERT( log.Root() == Sha256::Of( "" ) );
+
+	Append( log, records );
+	CPPUNIT_ASSERT( log.Chain() == Chain( records ) );
+	CPPUNIT_ASSERT( log.Root() == Root( records, records.size() ) );
+
+	AppendBatch( log, batch );
+	records.insert( records.end(), batch.begin(), batch.end() );
+	CPPUNIT_ASSERT( log.Chain() == Chain( records ) );
+	CPPUNIT_ASSERT( log.Root() == Root( records, records.size() ) );
+	Check( log, records );
+
+	for ( size_t size = 0; size <= records.size(); size += 7 )
+	{
+		Sha256	root;
+
+		CPPUNIT_ASSERT( log.Root( size, root ) );
+		CPPUNIT_ASSERT( root == Root( records, size ) );
+	}
+
+	Sha256	root;
+
+	CPPUNIT_ASSERT( !log.Root( records.size() + 1, root ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The records in several segments are there after the log is reopened, and appending resumes the chain. Tree nodes
+// that are lost are recomputed.
+
+void AuditLogTest::TestReopen()
+{
+	std::vector< std::vector< uint8_t > >		records	= RandomBuffers( 100, MAX_RECORD_SIZE, 3 );
+	std::vector< std::vector< uint8_t > > const	more	= RandomBuffers( 10, MAX_RECORD_SIZE, 4 );
+
+	{
+		AuditLog	log;
+
+		CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+		Append( log, records );
+	}
+
+	CPPUNIT_ASSERT( FileSize( SegmentName( 2 ) ) > HEADER_SIZE );
+
+	{
+		AuditLog	log;
+
+		CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+		Check( log, records );
+		CPPUNIT_ASSERT( log.Chain() == Chain( records ) );
+		AppendBatch( log, more );
+		records.insert( records.end(), more.begin(), more.end() );
+	}
+
+	WriteFile( TreeName(), nullptr, 0 );
+
+	AuditLog	log;
+
+	CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+	Check( log, records );
+	CPPUNIT_ASSERT( log.Chain() == Chain( records ) );
+	CPPUNIT_ASSERT( log.Root() == Root( records, records.size() ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A changed byte in a record or in its chain hash is detected by Get(). A changed chain hash also breaks the record
+// after it, which is chained to it.
+
+void AuditLogTest::TestTamper()
+{
+	std::vector< std::vector< uint8_t > > const	records	= RandomBuffers( 5, MAX_RECORD_SIZE, 5 );
+	long const									second	= HEADER_SIZE + 4 + long( records[0].size() ) + 32;
+	long const									third	= second + 4 + long( records[1].size() ) + 32;
+	std::vector< uint8_t >						data;
+
+	{
+		AuditLog	log;
+
+		CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+		Append( log, records );
+	}
+
+	Corrupt( SegmentName( 0 ), second + 4 );
+
+	{
+		AuditLog	log;
+
+		CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+		CPPUNIT_ASSERT( log.Get( 0, data ) );
+		CPPUNIT_ASSERT( !log.Get( 1, data ) );
+		CPPUNIT_ASSERT( log.Get( 2, data ) );
+	}
+
+	Corrupt( SegmentName( 0 ), second + 4 );
+	Corrupt( SegmentName( 0 ), third - 1 );
+
+	AuditLog	log;
+
+	CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+	CPPUNIT_ASSERT( log.Get( 0, data ) );
+	CPPUNIT_ASSERT( !log.Get( 1, data ) );
+	CPPUNIT_ASSERT( !log.Get( 2, data ) );
+	CPPUNIT_ASSERT( log.Get( 3, data ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The inclusion proof of each record at several sizes is verified against the tree head for that size, and fails for
+// a different record
+
+void AuditLogTest::TestInclusion()
+{
+	std::vector< std::vector< uint8_t > > const	records	= RandomBuffers( 37, MAX_RECORD_SIZE, 6 );
+	AuditLog									log;
+	std::vector< Sha256 >						proof;
+
+	CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+	Append( log, records );
+
+	for ( size_t size = 1; size <= records.size(); size += 4 )
+	{
+		Sha256 const	root	= Root( records, size );
+
+		for ( size_t i = 0; i < size; ++i )
+		{
+			Sha256 const	leaf	= MerkleTree::HashLeaf( records[i].data(), records[i].size() );
+			Sha256 const	other	= MerkleTree::HashNode( leaf, leaf );
+
+			CPPUNIT_ASSERT( log.ProveInclusion( i, size, proof ) );
+			CPPUNIT_ASSERT( MerkleTree::Verify( root, size, i, leaf, proof.data(), proof.size() ) );
+			CPPUNIT_ASSERT( !MerkleTree::Verify( root, size, i, other, proof.data(), proof.size() ) );
+		}
+
+		CPPUNIT_ASSERT( !log.ProveInclusion( size, size, proof ) );
+	}
+
+	CPPUNIT_ASSERT( !log.ProveInclusion( 0, records.size() + 1, proof ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The consistency proof between every pair of sizes is verified, and it fails if the proof or either root is changed,
+// or if a hash is missing
+
+void AuditLogTest::TestConsistency()
+{
+	std::vector< std::vector< uint8_t > > const	records	= RandomBuffers( 33, MAX_RECORD_SIZE, 7 );
+	AuditLog									log;
+	std::vector< Sha256 >						proof;
+
+	CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+	Append( log, records );
+
+	for ( uint64_t first = 1; first <= records.size(); ++first )
+	{
+		Sha256 const	firstRoot	= Root( records, size_t( first ) );
+		Sha256			bad			= firstRoot;
+
+		bad.m_value[0] ^= 1;
+
+		for ( uint64_t second = first; second <= records.size(); ++second )
+		{
+			Sha256 const	secondRoot	= Root( records, size_t( second ) );
+
+			CPPUNIT_ASSERT( log.ProveConsistency( first, second, proof ) );
+			CPPUNIT_ASSERT( AuditLog::VerifyConsistency( first, firstRoot, second, secondRoot, proof.data(), proof.size() ) );
+			CPPUNIT_ASSERT( !AuditLog::VerifyConsistency( first, bad, second, secondRoot, proof.data(), proof.size() ) );
+			CPPUNIT_ASSERT( !AuditLog::VerifyConsistency( first, firstRoot, second, bad, proof.data(), proof.size() ) );
+
+			if ( first == second )
+			{
+				CPPUNIT_ASSERT( proof.empty() );
+				continue;
+			}
+
+			CPPUNIT_ASSERT( !AuditLog::VerifyConsistency( first, firstRoot, second, secondRoot, proof.data(),
+														  proof.size() - 1 ) );
+
+			for ( size_t i = 0; i < proof.size(); ++i )
+			{
+				std::vector< Sha256 >	changed	= proof;
+
+				changed[i].m_value[ 31 ] ^= 0x80;
+				CPPUNIT_ASSERT( !AuditLog::VerifyConsistency( first, firstRoot, second, secondRoot, changed.data(),
+															  changed.size() ) );
+			}
+		}
+	}
+
+	CPPUNIT_ASSERT( !log.ProveConsistency( 0, 1, proof ) );
+	CPPUNIT_ASSERT( !log.ProveConsistency( 2, 1, proof ) );
+	CPPUNIT_ASSERT( !log.ProveConsistency( 1, records.size() + 1, proof ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The headers of a new segment and a new tree file are on disk as soon as the log is opened, before anything is
+// flushed
+
+void AuditLogTest::TestHeaderIsFlushed()
+{
+	AuditLog	log;
+
+	CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+	CPPUNIT_ASSERT_EQUAL( HEADER_SIZE, FileSize( SegmentName( 0 ) ) );
+	CPPUNIT_ASSERT_EQUAL( HEADER_SIZE, FileSize( TreeName() ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// If the process stopped while a segment was being started, the last segment is empty or has part of its header. The
+// log still opens with the earlier records and its chain, and the segment is started again. The same goes for a tree
+// file with part of its header.
+
+void AuditLogTest::TestInterruptedStart()
+{
+	std::vector< std::vector< uint8_t > > const	records	= RandomBuffers( 50, MAX_RECORD_SIZE, 8 );
+	std::vector< std::vector< uint8_t > > const	more	= RandomBuffers( 5, MAX_RECORD_SIZE, 9 );
+
+	{
+		AuditLog	log;
+
+		CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+		Append( log, records );
+	}
+
+	char const		partial[]	= "CLOG";
+	size_t const	sizes[]		= { 0, 4 };
+	int				next		= 0;
+
+	while ( FileSize( SegmentName( next ) ) > 0 )
+	{
+		++next;
+	}
+
+	for ( int i = 0; i < (int)elementsof( sizes ); ++i )
+	{
+		WriteFile( SegmentName( next ), partial, sizes[i] );
+		WriteFile( TreeName(), "CTRE", sizes[i] );
+
+		AuditLog	log;
+
+		CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+		Check( log, records );
+		CPPUNIT_ASSERT( log.Chain() == Chain( records ) );
+		CPPUNIT_ASSERT( log.Root() == Root( records, records.size() ) );
+
+		Append( log, more );
+		log.Close();
+
+		std::vector< std::vector< uint8_t > >	all	= records;
+
+		all.insert( all.end(), more.begin(), more.end() );
+		CPPUNIT_ASSERT( log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+		Check( log, all );
+		CPPUNIT_ASSERT( log.Chain() == Chain( all ) );
+
+		// Remove the segment and the tree so that the next case starts from the same state
+
+		log.Close();
+		remove( SegmentName( next ).c_str() );
+		remove( TreeName().c_str() );
+	}
+
+	// A headerless segment that is not the last one is an error
+
+	WriteFile( SegmentName( next ), nullptr, 0 );
+	WriteFile( SegmentName( next + 1 ), partial, 4 );
+
+	AuditLog	log;
+
+	CPPUNIT_ASSERT( !log.Open( m_directory.Path(), SEGMENT_SIZE ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::string AuditLogTest::SegmentName( int segment ) const
+{
+	char	name[ 32 ];
+
+	snprintf( name, sizeof( name ), "segment-%06u.log", unsigned( segment ) );
+	return m_directory.Path( name );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::string AuditLogTest::TreeName() const
+{
+	return m_directory.Path( "tree.hashes" );
+}
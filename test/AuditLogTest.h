@@ -0,0 +1,57 @@
+/********************************************************************************************************************
+
+                                                   AuditLogTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/AuditLogTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+#include "Misc/TestFiles.h"
+
+#include <string>
+
+class AuditLogTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( AuditLogTest );
+	CPPUNIT_TEST( TestChaining );
+	CPPUNIT_TEST( TestReopen );
+	CPPUNIT_TEST( TestTamper );
+	CPPUNIT_TEST( TestInclusion );
+	CPPUNIT_TEST( TestConsistency );
+	CPPUNIT_TEST( TestHeaderIsFlushed );
+	CPPUNIT_TEST( TestInterruptedStart );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestChaining();
+	void TestReopen();
+	void TestTamper();
+	void TestInclusion();
+	void TestConsistency();
+	void TestHeaderIsFlushed();
+	void TestInterruptedStart();
+
+private:
+
+	// Returns the name of a segment file
+	std::string SegmentName( int segment ) const;
+
+	// Returns the name of the tree file
+	std::string TreeName() const;
+
+	TestFiles::TemporaryDirectory	m_directory;	// Holds the files of the log
+};
@@ -0,0 +1,316 @@
+/********************************************************************************************************************
+
+                                                    Base64Test.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/Base64Test.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Base64Test.h"
+
+#include "../Base64.h"
+#include "../KernelRegistry.h"
+
+#include "Misc/Random.h"
+#include "Misc/Etc.h"
+
+#include <cstring>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Base64Test );
+
+namespace
+{
+	// RFC 4648, section 10
+	struct Vector
+	{
+		char const *	data;
+		char const *	text;
+	};
+
+	Vector const	RFC4648[]	=
+	{
+		{ "",		""			},
+		{ "f",		"Zg=="		},
+		{ "fo",		"Zm8="		},
+		{ "foo",	"Zm9v"		},
+		{ "foob",	"Zm9vYg=="	},
+		{ "fooba",	"Zm9vYmE="	},
+		{ "foobar",	"Zm9vYmFy"	},
+	};
+
+	// Decodes a value of the given size from all of the text. Returns false if the text is not valid or not all of it
+	// is used.
+	bool Decode( std::string const & text, size_t size, uint8_t * data, Base64::Alphabet alphabet = Base64::STANDARD )
+	{
+		std::from_chars_result const	result	= Base64::FromChars( text.data(), text.data() + text.size(), data, size, alphabet );
+
+		return result.ec == std::errc() && result.ptr == text.data() + text.size();
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Base64Test::setUp()
+{
+	m_kernels = KernelRegistry::Available( KernelRegistry::BASE64 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Base64Test::tearDown()
+{
+	KernelRegistry::Automatic( KernelRegistry::BASE64 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Base64Test::TestRfc4648()
+{
+	for ( size_t k = 0; k < m_kernels.size(); ++k )
+	{
+		CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::BASE64, m_kernels[k].c_str() ) );
+
+		for ( int i = 0; i < (int)elementsof( RFC4648 ); ++i )
+		{
+			uint8_t const *		data		= reinterpret_cast< uint8_t const * >( RFC4648[i].data );
+			size_t const		size		= strlen( RFC4648[i].data );
+			std::string const	text		= RFC4648[i].text;
+			std::string const	unpadded	= text.substr( 0, text.find( '=' ) );
+			uint8_t				decoded[ 6 ];
+
+			CPPUNIT_ASSERT_EQUAL( text, Base64::Encode( data, size ) );
+			CPPUNIT_ASSERT_EQUAL( unpadded, Base64::Encode( data, size, Base64::STANDARD, false ) );
+
+			CPPUNIT_ASSERT( Decode( text, size, decoded ) && memcmp( decoded, data, size ) == 0 );
+			CPPUNIT_ASSERT( Decode( unpadded, size, decoded ) && memcmp( decoded, data, size ) == 0 );
+		}
+
+		// A buffer that is too small is not written
+
+		char					text[ 8 ]	= { '*', '*', '*', '*', '*', '*', '*', '*' };
+		std::to_chars_result	result		= Base64::ToChars( reinterpret_cast< uint8_t const * >( "fooba" ), 5, text, text + 7 );
+
+		CPPUNIT_ASSERT( result.ec == std::errc::value_too_large && result.ptr == text + 7 );
+		CPPUNIT_ASSERT_EQUAL( std::string( 8, '*' ), std::string( text, 8 ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The URL alphabet differs only in characters 62 and 63
+
+void Base64Test::TestUrl()
+{
+	uint8_t const	DATA[]	= { 0xfb, 0xef, 0xff, 0xfb, 0xff };
+
+	for ( size_t k = 0; k < m_kernels.size(); ++k )
+	{
+		CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::BASE64, m_kernels[k].c_str() ) );
+
+		uint8_t	decoded[ sizeof( DATA ) ];
+
+		CPPUNIT_ASSERT_EQUAL( std::string( "++//+/8=" ), Base64::Encode( DATA, sizeof( DATA ) ) );
+		CPPUNIT_ASSERT_EQUAL( std::string( "--__-_8=" ), Base64::Encode( DATA, sizeof( DATA ), Base64::URL ) );
+		CPPUNIT_ASSERT( Decode( "--__-_8", sizeof( DATA ), decoded, Base64::URL ) );
+		CPPUNIT_ASSERT( memcmp( decoded, DATA, sizeof( DATA ) ) == 0 );
+		CPPUNIT_ASSERT( !Decode( "++//+/8=", sizeof( DATA ), decoded, Base64::URL ) );
+		CPPUNIT_ASSERT( !Decode( "--__-_8=", sizeof( DATA ), decoded ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A character that is not in the alphabet is rejected at every position of an encoding that is long enough to use
+// the widest kernel
+
+void Base64Test::TestInvalid()
+{
+	char const	INVALID[]	= "=.-_* \n\x80\xff";
+	uint8_t		data[ 100 ];
+	Random		rng( 2 );
+
+	for ( int i = 0; i < (int)elementsof( data ); ++i )
+	{
+		data[i] = uint8_t( rng.Get() );
+	}
+
+	for ( size_t k = 0; k < m_kernels.size(); ++k )
+	{
+		CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::BASE64, m_kernels[k].c_str() ) );
+
+		std::string const	text	= Base64::Encode( data, sizeof( data ) );
+		uint8_t				decoded[ sizeof( data ) ];
+
+		CPPUNIT_ASSERT( Decode( text, sizeof( data ), decoded ) && memcmp( decoded, data, sizeof( data ) ) == 0 );
+
+		for ( size_t i = 0; i < Base64::EncodedSize( sizeof( data ), false ); ++i )
+		{
+			for ( char const * c = INVALID; *c != 0; ++c )
+			{
+				std::string	bad	= text;
+
+				bad[i] = *c;
+				CPPUNIT_ASSERT_MESSAGE( m_kernels[k], !Decode( bad, sizeof( data ), decoded ) );
+			}
+		}
+
+		// Text that is too short, and incomplete padding
+
+		CPPUNIT_ASSERT( !Decode( text.substr( 0, Base64::EncodedSize( sizeof( data ), false ) - 1 ), sizeof( data ), decoded ) );
+		CPPUNIT_ASSERT( !Decode( "Zg=", 1, decoded ) );
+		CPPUNIT_ASSERT( !Decode( "Zg=A", 1, decoded ) );
+		CPPUNIT_ASSERT( !Decode( "Zm8A", 2, decoded ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// An encoding whose unused bits are not 0 is rejected, so each value has only one encoding (RFC 4648, section 3.5)
+
+void Base64Test::TestNonCanonical()
+{
+	for ( size_t k = 0; k < m_kernels.size(); ++k )
+	{
+		CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::BASE64, m_kernels[k].c_str() ) );
+
+		uint8_t	decoded[ 2 ];
+
+		CPPUNIT_ASSERT( Decode( "Zg==", 1, decoded ) );
+		CPPUNIT_ASSERT( !Decode( "Zh==", 1, decoded ) );
+		CPPUNIT_ASSERT( !Decode( "Zv", 1, decoded ) );
+		CPPUNIT_ASSERT( Decode( "Zm8=", 2, decoded ) );
+		CPPUNIT_ASSERT( !Decode( "Zm9=", 2, decoded ) );
+		CPPUNIT_ASSERT( !Decode( "Zm_", 2, decoded, Base64::URL ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Bulk conversions of digest-sized values match the conversions of each value
+
+void Base64Test::TestBulk()
+{
+	size_t const	SIZES[]	= { 1, 2, 3, 16, 20, 32, 255, 300 };
+	size_t const	COUNT	= 100;
+	uint8_t			data[ 300 * COUNT ];
+	Random			rng( 3 );
+
+	for ( int i = 0; i < (int)elementsof( data ); ++i )
+	{
+		data[i] = uint8_t( rng.Get() );
+	}
+
+	for ( size_t k = 0; k < m_kernels.size(); ++k )
+	{
+		CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::BASE64, m_kernels[k].c_str() ) );
+
+		for ( int s = 0; s < (int)elementsof( SIZES ); ++s )
+		{
+			for ( int padding = 0; padding < 2; ++padding )
+			{
+				size_t const	size		= SIZES[s];
+				size_t const	length		= Base64::EncodedSize( size, padding != 0 );
+				std::string		expected;
+
+				for ( size_t i = 0; i < COUNT; ++i )
+				{
+					expected += Base64::Encode( data + i * size, size, Base64::URL, padding != 0 );
+				}
+
+				std::string				text( length * COUNT, '*' );
+				std::vector< uint8_t >	decoded( size * COUNT );
+
+				Base64::Encode( data, size, COUNT, &text[0], Base64::URL, padding != 0 );
+				CPPUNIT_ASSERT_EQUAL_MESSAGE( m_kernels[k], expected, text );
+				CPPUNIT_ASSERT( Base64::Decode( text.data(), size, COUNT, decoded.data(), Base64::URL, padding != 0 ) );
+				CPPUNIT_ASSERT( memcmp( decoded.data(), data, size * COUNT ) == 0 );
+			}
+		}
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A bulk decoding fails if any one of the encodings is invalid, non-canonical or has the wrong padding
+
+void Base64Test::TestBulkInvalid()
+{
+	size_t const	SIZES[]	= { 16, 20, 32 };
+	size_t const	COUNT	= 50;
+	uint8_t			data[ 32 * COUNT ];
+	uint8_t			decoded[ 32 * COUNT ];
+	Random			rng( 4 );
+
+	for ( int i = 0; i < (int)elementsof( data ); ++i )
+	{
+		data[i] = uint8_t( rng.Get() );
+	}
+
+	for ( size_t k = 0; k < m_kernels.size(); ++k )
+	{
+		CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::BASE64, m_kernels[k].c_str() ) );
+
+		for ( int s = 0; s < (int)elementsof( SIZES ); ++s )
+		{
+			size_t const	size	= SIZES[s];
+			size_t const	length	= Base64::EncodedSize( size );
+			size_t const	used	= Base64::EncodedSize( size, false );
+			std::string		text( length * COUNT, '*' );
+
+			Base64::Encode( data, size, COUNT, &text[0] );
+
+			for ( size_t i = 0; i < COUNT; i += 7 )
+			{
+				std::string	bad	= text;
+
+				bad[ i * length + i % used ] = '.';
+				CPPUNIT_ASSERT_MESSAGE( m_kernels[k], !Base64::Decode( bad.data(), size, COUNT, decoded ) );
+
+				// Set the lowest of the unused bits of the last character ('A' + 1 is 'B', 'w' + 1 is 'x', and so on)
+
+				if ( size % 3 != 0 )
+				{
+					bad = text;
+					bad[ i * length + used - 1 ] += 1;
+					CPPUNIT_ASSERT_MESSAGE( m_kernels[k], !Base64::Decode( bad.data(), size, COUNT, decoded ) );
+
+					bad = text;
+					bad[ i * length + length - 1 ] = 'A';
+					CPPUNIT_ASSERT_MESSAGE( m_kernels[k], !Base64::Decode( bad.data(), size, COUNT, decoded ) );
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,48 @@
+/********************************************************************************************************************
+
+                                                     Base64Test.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/Base64Test.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+#include <string>
+#include <vector>
+
+class Base64Test : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( Base64Test );
+	CPPUNIT_TEST( TestRfc4648 );
+	CPPUNIT_TEST( TestUrl );
+	CPPUNIT_TEST( TestInvalid );
+	CPPUNIT_TEST( TestNonCanonical );
+	CPPUNIT_TEST( TestBulk );
+	CPPUNIT_TEST( TestBulkInvalid );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestRfc4648();
+	void TestUrl();
+	void TestInvalid();
+	void TestNonCanonical();
+	void TestBulk();
+	void TestBulkInvalid();
+
+private:
+
+	std::vector< std::string >	m_kernels;	// Names of the available Base64 kernels
+};
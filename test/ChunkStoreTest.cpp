@@ -0,0 +1,281 @@
+/********************************************************************************************************************
+
+                                                 ChunkStoreTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/ChunkStoreTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "ChunkStoreTest.h"
+
+#include "../ChunkStore.h"
+
+#include "Misc/Random.h"
+#include "Misc/Etc.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+using namespace TestFiles;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ChunkStoreTest );
+
+namespace
+{
+	uint64_t const	PACK_SIZE		= 64 * 1024;
+	size_t const	MAX_CHUNK_SIZE	= 5000;
+
+	// Stores chunks and returns their digests
+	std::vector< Sha256 > Put( ChunkStore & store, std::vector< std::vector< uint8_t > > const & chunks )
+	{
+		std::vector< Sha256 >	digests( chunks.size() );
+
+		for ( size_t i = 0; i < chunks.size(); ++i )
+		{
+			CPPUNIT_ASSERT( store.Put( chunks[i].data(), chunks[i].size(), digests[i] ) );
+		}
+
+		return digests;
+	}
+
+	// Checks that every chunk can be read back
+	void Check( ChunkStore & store, std::vector< std::vector< uint8_t > > const & chunks, std::vector< Sha256 > const & digests )
+	{
+		for ( size_t i = 0; i < chunks.size(); ++i )
+		{
+			std::vector< uint8_t >	data;
+
+			CPPUNIT_ASSERT( store.Get( digests[i], data ) );
+			CPPUNIT_ASSERT( data == chunks[i] );
+		}
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ChunkStoreTest::setUp()
+{
+	m_directory.Create();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ChunkStoreTest::tearDown()
+{
+	m_directory.Remove();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Chunks and objects read back the same, and a chunk that is already stored is not written again
+
+void ChunkStoreTest::TestRoundTrip()
+{
+	ChunkStore									store;
+	std::vector< std::vector< uint8_t > > const	chunks	= RandomBuffers( 50, MAX_CHUNK_SIZE, 1 );
+
+	CPPUNIT_ASSERT( store.Open( m_directory.Path(), PACK_SIZE ) );
+
+	std::vector< Sha256 > const	digests	= Put( store, chunks );
+
+	Check( store, chunks, digests );
+	CPPUNIT_ASSERT_EQUAL( size_t( 50 ), store.Size() );
+
+	Sha256	digest;
+
+	CPPUNIT_ASSERT( store.Put( chunks[0].data(), chunks[0].size(), digest ) );
+	CPPUNIT_ASSERT( digest == digests[0] );
+	CPPUNIT_ASSERT_EQUAL( size_t( 50 ), store.Size() );
+
+	std::vector< uint8_t >	object( 200000 );
+	std::vector< Sha256 >	objectChunks;
+	std::vector< uint8_t >	read;
+	Random					rng( 2 );
+
+	for ( size_t i = 0; i < object.size(); ++i )
+	{
+		object[i] = uint8_t( rng.Get() );
+	}
+
+	CPPUNIT_ASSERT( store.PutObject( object.data(), object.size(), objectChunks ) );
+	CPPUNIT_ASSERT( store.GetObject( objectChunks, read ) );
+	CPPUNIT_ASSERT( read == object );
+	CPPUNIT_ASSERT( !store.Get( Sha256(), read ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The chunks in several packs are found after the store is reopened, and writing resumes
+
+void ChunkStoreTest::TestReopen()
+{
+	std::vector< std::vector< uint8_t > > const	chunks	= RandomBuffers( 100, MAX_CHUNK_SIZE, 3 );
+	std::vector< std::vector< uint8_t > > const	more	= RandomBuffers( 10, MAX_CHUNK_SIZE, 4 );
+	std::vector< Sha256 >						digests;
+	std::vector< Sha256 >						moreDigests;
+
+	{
+		ChunkStore	store;
+
+		CPPUNIT_ASSERT( store.Open( m_directory.Path(), PACK_SIZE ) );
+		digests = Put( store, chunks );
+	}
+
+	CPPUNIT_ASSERT( FileSize( FileName( 2, "pack" ) ) > 0 );
+
+	{
+		ChunkStore	store;
+
+		CPPUNIT_ASSERT( store.Open( m_directory.Path(), PACK_SIZE ) );
+		CPPUNIT_ASSERT_EQUAL( size_t( 100 ), store.Size() );
+		Check( store, chunks, digests );
+		moreDigests = Put( store, more );
+	}
+
+	ChunkStore	store;
+
+	CPPUNIT_ASSERT( store.Open( m_directory.Path(), PACK_SIZE ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 110 ), store.Size() );
+	Check( store, chunks, digests );
+	Check( store, more, moreDigests );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A new pack's header is on disk as soon as the pack is started, before anything is flushed
+
+void ChunkStoreTest::TestHeaderIsFlushed()
+{
+	ChunkStore	store;
+
+	CPPUNIT_ASSERT( store.Open( m_directory.Path(), PACK_SIZE ) );
+	CPPUNIT_ASSERT_EQUAL( 8L, FileSize( FileName( 0, "pack" ) ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// If the process stopped while a pack was being started, the last pack is empty or has part of its header. The store
+// still opens, the earlier chunks are there, and the pack is started again.
+
+void ChunkStoreTest::TestInterruptedStart()
+{
+	std::vector< std::vector< uint8_t > > const	chunks	= RandomBuffers( 50, MAX_CHUNK_SIZE, 5 );
+	std::vector< std::vector< uint8_t > > const	more	= RandomBuffers( 5, MAX_CHUNK_SIZE, 6 );
+	std::vector< Sha256 >						digests;
+
+	{
+		ChunkStore	store;
+
+		CPPUNIT_ASSERT( store.Open( m_directory.Path(), PACK_SIZE ) );
+		digests = Put( store, chunks );
+	}
+
+	char const		partial[]	= "CPAK";
+	size_t const	sizes[]		= { 0, 4 };
+	int				next		= 0;
+
+	while ( FileSize( FileName( next, "pack" ) ) > 0 )
+	{
+		++next;
+	}
+
+	for ( int i = 0; i < (int)elementsof( sizes ); ++i )
+	{
+		WriteFile( FileName( next, "pack" ), partial, sizes[i] );
+		WriteFile( FileName( next, "idx" ), nullptr, 0 );
+
+		ChunkStore	store;
+
+		CPPUNIT_ASSERT( store.Open( m_directory.Path(), PACK_SIZE ) );
+		Check( store, chunks, digests );
+		CPPUNIT_ASSERT_EQUAL( 8L, FileSize( FileName( next, "pack" ) ) );
+
+		std::vector< Sha256 > const	moreDigests	= Put( store, more );
+
+		store.Close();
+		CPPUNIT_ASSERT( store.Open( m_directory.Path(), PACK_SIZE ) );
+		Check( store, more, moreDigests );
+
+		// Remove the pack so that the next case starts from the same state
+
+		store.Close();
+		remove( FileName( next, "pack" ).c_str() );
+		remove( FileName( next, "idx" ).c_str() );
+	}
+
+	// A headerless pack that is not the last one is an error
+
+	WriteFile( FileName( next, "pack" ), nullptr, 0 );
+	WriteFile( FileName( next + 1, "pack" ), partial, 4 );
+
+	ChunkStore	store;
+
+	CPPUNIT_ASSERT( !store.Open( m_directory.Path(), PACK_SIZE ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Records that are in a pack but missing from its index are recovered
+
+void ChunkStoreTest::TestRecoverRecords()
+{
+	std::vector< std::vector< uint8_t > > const	chunks	= RandomBuffers( 5, MAX_CHUNK_SIZE, 7 );
+	std::vector< Sha256 >						digests;
+
+	{
+		ChunkStore	store;
+
+		CPPUNIT_ASSERT( store.Open( m_directory.Path(), PACK_SIZE ) );
+		digests = Put( store, chunks );
+	}
+
+	WriteFile( FileName( 0, "idx" ), nullptr, 0 );
+
+	ChunkStore	store;
+
+	CPPUNIT_ASSERT( store.Open( m_directory.Path(), PACK_SIZE ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 5 ), store.Size() );
+	Check( store, chunks, digests );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::string ChunkStoreTest::FileName( int pack, char const * extension ) const
+{
+	char	name[ 32 ];
+
+	snprintf( name, sizeof( name ), "pack-%06u.%s", unsigned( pack ), extension );
+	return m_directory.Path( name );
+}
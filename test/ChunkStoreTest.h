@@ -0,0 +1,50 @@
+/********************************************************************************************************************
+
+                                                  ChunkStoreTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/ChunkStoreTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+#include "Misc/TestFiles.h"
+
+#include <string>
+
+class ChunkStoreTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( ChunkStoreTest );
+	CPPUNIT_TEST( TestRoundTrip );
+	CPPUNIT_TEST( TestReopen );
+	CPPUNIT_TEST( TestHeaderIsFlushed );
+	CPPUNIT_TEST( TestInterruptedStart );
+	CPPUNIT_TEST( TestRecoverRecords );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestRoundTrip();
+	void TestReopen();
+	void TestHeaderIsFlushed();
+	void TestInterruptedStart();
+	void TestRecoverRecords();
+
+private:
+
+	// Returns the name of a pack or index file
+	std::string FileName( int pack, char const * extension ) const;
+
+	TestFiles::TemporaryDirectory	m_directory;	// Holds the files of the store
+};
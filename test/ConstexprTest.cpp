@@ -0,0 +1,149 @@
+/********************************************************************************************************************
+
+                                                  ConstexprTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/ConstexprTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "ConstexprTest.h"
+
+#include "../Crc32.h"
+#include "../Md5.h"
+#include "../Sha1.h"
+#include "../Sha256.h"
+
+#include <string>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ConstexprTest );
+
+namespace
+{
+	// The vectors are from RFC 1321 (test-suite.txt) and FIPS 180-2. NIST spans two blocks once it is padded, and
+	// DIGITS spans two blocks by itself.
+
+	char const	DIGITS[]	= "12345678901234567890123456789012345678901234567890123456789012345678901234567890";
+	char const	NIST[]		= "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+	// The values are used as constants, so they must be computed at compile time
+
+	constexpr Crc32		CRC32_CHECK		= Crc32::Of( "123456789" );
+	constexpr Md5		MD5_ABC			= Md5::Of( "abc" );
+	constexpr Sha1		SHA1_ABC		= Sha1::Of( "abc" );
+	constexpr Sha256	SHA256_ABC		= Sha256::Of( "abc" );
+
+	static_assert( CRC32_CHECK.m_value == 0xcbf43926, "Crc32::Of() is wrong." );
+	static_assert( MD5_ABC.m_digest[0] == 0x90 && MD5_ABC.m_digest[15] == 0x72, "Md5::Of() is wrong." );
+	static_assert( SHA1_ABC.m_value[0] == 0xa9 && SHA1_ABC.m_value[19] == 0x9d, "Sha1::Of() is wrong." );
+	static_assert( SHA256_ABC.m_value[0] == 0xba && SHA256_ABC.m_value[31] == 0xad, "Sha256::Of() is wrong." );
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ConstexprTest::setUp()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ConstexprTest::tearDown()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ConstexprTest::TestCrc32()
+{
+	CPPUNIT_ASSERT_EQUAL( std::string( "00000000" ), Crc32::Of( "" ).ToString() );
+	CPPUNIT_ASSERT_EQUAL( std::string( "cbf43926" ), CRC32_CHECK.ToString() );
+	CPPUNIT_ASSERT_EQUAL( std::string( "414fa339" ), Crc32::Of( "The quick brown fox jumps over the lazy dog" ).ToString() );
+	CPPUNIT_ASSERT_EQUAL( std::string( "7ca94a72" ), Crc32::Of( DIGITS ).ToString() );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ConstexprTest::TestMd5()
+{
+	CPPUNIT_ASSERT_EQUAL( std::string( "d41d8cd98f00b204e9800998ecf8427e" ), Md5::Of( "" ).ToString() );
+	CPPUNIT_ASSERT_EQUAL( std::string( "900150983cd24fb0d6963f7d28e17f72" ), MD5_ABC.ToString() );
+	CPPUNIT_ASSERT_EQUAL( std::string( "f96b697d7cb7938d525a2f31aaf161d0" ), Md5::Of( "message digest" ).ToString() );
+	CPPUNIT_ASSERT_EQUAL( std::string( "57edf4a22be3c955ac49da2e2107b67a" ), Md5::Of( DIGITS ).ToString() );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ConstexprTest::TestSha1()
+{
+	CPPUNIT_ASSERT_EQUAL( std::string( "da39a3ee5e6b4b0d3255bfef95601890afd80709" ), Sha1::Of( "" ).ToString() );
+	CPPUNIT_ASSERT_EQUAL( std::string( "a9993e364706816aba3e25717850c26c9cd0d89d" ), SHA1_ABC.ToString() );
+	CPPUNIT_ASSERT_EQUAL( std::string( "84983e441c3bd26ebaae4aa1f95129e5e54670f1" ), Sha1::Of( NIST ).ToString() );
+	CPPUNIT_ASSERT_EQUAL( std::string( "50abf5706a150990a08b2c5ea40fa0e585554732" ), Sha1::Of( DIGITS ).ToString() );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ConstexprTest::TestSha256()
+{
+	CPPUNIT_ASSERT_EQUAL( std::string( "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" ),
+						  Sha256::Of( "" ).ToString() );
+	CPPUNIT_ASSERT_EQUAL( std::string( "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" ),
+						  SHA256_ABC.ToString() );
+	CPPUNIT_ASSERT_EQUAL( std::string( "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" ),
+						  Sha256::Of( NIST ).ToString() );
+	CPPUNIT_ASSERT_EQUAL( std::string( "f371bc4a311f2b009eef952dd83ca80e2b60026c8e935592d0f9c308453c813e" ),
+						  Sha256::Of( DIGITS ).ToString() );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Every size from 0 to 200 crosses each padding boundary, and the results must match the calculators
+
+void ConstexprTest::TestMatchesCalculators()
+{
+	std::string	data;
+
+	for ( int i = 0; i < 200; ++i )
+	{
+		data.push_back( char( i * 7 + 3 ) );
+	}
+
+	for ( size_t size = 0; size <= data.size(); ++size )
+	{
+		std::string_view const	view( data.data(), size );
+		uint8_t const * const	bytes	= reinterpret_cast< uint8_t const * >( data.data() );
+
+		CPPUNIT_ASSERT( Crc32::Of( view ) == Crc32( bytes, size ) );
+		CPPUNIT_ASSERT( Md5::Of( view ) == Md5( bytes, size ) );
+		CPPUNIT_ASSERT( Sha1::Of( view ) == Sha1( bytes, size ) );
+		CPPUNIT_ASSERT( Sha256::Of( view ) == Sha256( bytes, size ) );
+	}
+}
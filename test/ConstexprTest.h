@@ -0,0 +1,39 @@
+/********************************************************************************************************************
+
+                                                   ConstexprTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/ConstexprTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class ConstexprTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( ConstexprTest );
+	CPPUNIT_TEST( TestCrc32 );
+	CPPUNIT_TEST( TestMd5 );
+	CPPUNIT_TEST( TestSha1 );
+	CPPUNIT_TEST( TestSha256 );
+	CPPUNIT_TEST( TestMatchesCalculators );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestCrc32();
+	void TestMd5();
+	void TestSha1();
+	void TestSha256();
+	void TestMatchesCalculators();
+};
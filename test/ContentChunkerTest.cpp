@@ -0,0 +1,197 @@
+/********************************************************************************************************************
+
+                                               ContentChunkerTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/ContentChunkerTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "ContentChunkerTest.h"
+
+#include "../ContentChunker.h"
+#include "../Sha256Calculator.h"
+
+#include <set>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ContentChunkerTest );
+
+namespace
+{
+	size_t const	DATA_SIZE		= 1 << 20;
+	size_t const	MIN_SIZE		= 1024;
+	size_t const	AVERAGE_SIZE	= 4096;
+	size_t const	MAX_SIZE		= 16384;
+
+	// Returns the sizes of the chunks of a buffer
+
+	std::vector< size_t > Sizes( ContentChunker const & chunker, uint8_t const * data, size_t size )
+	{
+		std::vector< size_t >	sizes;
+
+		chunker.Split( data, size, [ &sizes ]( uint8_t const *, size_t n, Sha256 const * ) { sizes.push_back( n ); } );
+
+		return sizes;
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ContentChunkerTest::setUp()
+{
+	// Pseudo-random data from a linear congruential generator
+
+	uint32_t	x	= 1;
+
+	m_data.resize( DATA_SIZE );
+	for ( size_t i = 0; i < DATA_SIZE; ++i )
+	{
+		x = x * 1664525 + 1013904223;
+		m_data[i] = uint8_t( x >> 24 );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ContentChunkerTest::tearDown()
+{
+	m_data.clear();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ContentChunkerTest::TestSizes()
+{
+	ContentChunker const		chunker( MIN_SIZE, AVERAGE_SIZE, MAX_SIZE );
+	std::vector< size_t > const	sizes	= Sizes( chunker, m_data.data(), m_data.size() );
+	size_t						total	= 0;
+
+	for ( size_t i = 0; i < sizes.size(); ++i )
+	{
+		// Only the last chunk may be smaller than the minimum
+
+		CPPUNIT_ASSERT( sizes[i] >= MIN_SIZE || i == sizes.size() - 1 );
+		CPPUNIT_ASSERT( sizes[i] <= MAX_SIZE );
+		total += sizes[i];
+	}
+
+	CPPUNIT_ASSERT_EQUAL( m_data.size(), total );
+
+	// The average is close to the requested size
+
+	size_t const	average	= total / sizes.size();
+
+	CPPUNIT_ASSERT( average > AVERAGE_SIZE / 2 && average < AVERAGE_SIZE * 2 );
+
+	// Data smaller than the minimum is a single chunk, and no data has no chunks
+
+	CPPUNIT_ASSERT_EQUAL( size_t( 1 ), Sizes( chunker, m_data.data(), MIN_SIZE - 1 ).size() );
+	CPPUNIT_ASSERT( Sizes( chunker, m_data.data(), 0 ).empty() );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ContentChunkerTest::TestStreaming()
+{
+	ContentChunker				chunker( MIN_SIZE, AVERAGE_SIZE, MAX_SIZE );
+	std::vector< size_t > const	expected	= Sizes( chunker, m_data.data(), m_data.size() );
+
+	// The chunks are the same no matter how the stream is divided
+
+	size_t const	parts[]	= { 1, 100, MIN_SIZE, MAX_SIZE - 1, MAX_SIZE, MAX_SIZE + 1, 100000 };
+
+	for ( size_t part : parts )
+	{
+		std::vector< size_t >				sizes;
+		ContentChunker::Receiver const		receiver	= [ &sizes ]( uint8_t const *, size_t n, Sha256 const * )
+														  {
+															  sizes.push_back( n );
+														  };
+
+		for ( size_t i = 0; i < m_data.size(); i += part )
+		{
+			chunker.Process( &m_data[i], std::min( part, m_data.size() - i ), receiver );
+		}
+
+		chunker.Finish( receiver );
+
+		CPPUNIT_ASSERT( sizes == expected );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ContentChunkerTest::TestShift()
+{
+	ContentChunker const	chunker( MIN_SIZE, AVERAGE_SIZE, MAX_SIZE, true );
+	std::set< Sha256 >		original;
+
+	chunker.Split( m_data.data(), m_data.size(),
+				   [ &original ]( uint8_t const *, size_t, Sha256 const * digest ) { original.insert( *digest ); } );
+
+	// Inserting bytes near the start only changes the chunks around the insertion
+
+	std::vector< uint8_t >	shifted( m_data );
+
+	shifted.insert( shifted.begin() + 10000, 37, 0x55 );
+
+	size_t	count	= 0;
+	size_t	shared	= 0;
+
+	chunker.Split( shifted.data(), shifted.size(),
+				   [ &original, &count, &shared ]( uint8_t const *, size_t, Sha256 const * digest )
+				   {
+					   ++count;
+					   shared += original.count( *digest );
+				   } );
+
+	CPPUNIT_ASSERT( count - shared <= 3 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ContentChunkerTest::TestDigests()
+{
+	ContentChunker const	chunker( MIN_SIZE, AVERAGE_SIZE, MAX_SIZE, true );
+	size_t					offset	= 0;
+
+	chunker.Split( m_data.data(), m_data.size(),
+				   [ this, &offset ]( uint8_t const * data, size_t size, Sha256 const * digest )
+				   {
+					   Sha256	expected;
+
+					   Sha256Calculator().Calculate( data, size, expected.m_value );
+
+					   CPPUNIT_ASSERT( data == &m_data[ offset ] );
+					   CPPUNIT_ASSERT( digest != nullptr );
+					   CPPUNIT_ASSERT( *digest == expected );
+					   offset += size;
+				   } );
+
+	CPPUNIT_ASSERT_EQUAL( m_data.size(), offset );
+}
@@ -0,0 +1,44 @@
+/********************************************************************************************************************
+
+                                                ContentChunkerTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/ContentChunkerTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+#include <cstdint>
+#include <vector>
+
+class ContentChunkerTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( ContentChunkerTest );
+	CPPUNIT_TEST( TestSizes );
+	CPPUNIT_TEST( TestStreaming );
+	CPPUNIT_TEST( TestShift );
+	CPPUNIT_TEST( TestDigests );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestSizes();
+	void TestStreaming();
+	void TestShift();
+	void TestDigests();
+
+private:
+
+	std::vector< uint8_t >	m_data;
+};
@@ -13,11 +13,17 @@
 
 #include "Crc32CalculatorTest.h"
 
+#include "../KernelRegistry.h"
+
 #include "Misc/Random.h"
 #include "Misc/Etc.h"
 
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <sstream>
-#include <fstream>
+#include <string>
+#include <vector>
 
 using namespace Crypto;
 
@@ -25,9 +31,55 @@ CPPUNIT_TEST_SUITE_REGISTRATION( Crc32CalculatorTest );
 
 namespace
 {
-	unsigned __int32	s_ReferenceCrcTable[256];
+	uint32_t			s_ReferenceCrcTable[256];
 	unsigned char		testbuffer[ 256 ];
 
+	// Returns the CRC-32 of a buffer computed one buffer at a time with the first kernel, which has no batch version
+	uint32_t SingleCrc( uint8_t const * buffer, size_t size )
+	{
+		std::string const	active	= KernelRegistry::Active( KernelRegistry::CRC32 );
+
+		KernelRegistry::Force( KernelRegistry::CRC32, KernelRegistry::Available( KernelRegistry::CRC32 )[0].c_str() );
+
+		uint32_t const	crc	= Crc32Calculator().Calculate( buffer, size );
+
+		KernelRegistry::Force( KernelRegistry::CRC32, active.c_str() );
+		return crc;
+	}
+
+	// A part of a sparse file that has data in it
+	struct Extent
+	{
+		size_t	offset;
+		size_t	size;
+	};
+
+	// Writes a file of the given size with random data in the extents and holes everywhere else. Returns the contents
+	// of the file.
+	std::vector< uint8_t > WriteSparseFile( std::string const & path, size_t size, Extent const * extents, int count )
+	{
+		std::vector< uint8_t >	contents( size, 0 );
+		Random					rng( 0 );
+		FILE *					file	= fopen( path.c_str(), "wb" );
+
+		CPPUNIT_ASSERT( file != nullptr );
+		for ( int i = 0; i < count; ++i )
+		{
+			for ( size_t j = 0; j < extents[i].size; ++j )
+			{
+				contents[ extents[i].offset + j ] = uint8_t( rng.Get() );
+			}
+			CPPUNIT_ASSERT( fseek( file, long( extents[i].offset ), SEEK_SET ) == 0 );
+			CPPUNIT_ASSERT( fwrite( &contents[ extents[i].offset ], 1, extents[i].size, file ) == extents[i].size );
+		}
+		fclose( file );
+
+		// A hole at the end is made by extending the file
+
+		std::filesystem::resize_file( path, size );
+		return contents;
+	}
+
 } // anonymous namespace
 
 
@@ -57,6 +109,7 @@ void Crc32CalculatorTest::setUp()
 
 void Crc32CalculatorTest::tearDown()
 {
+	m_directory.Remove();
 }
 
 
@@ -66,7 +119,7 @@ void Crc32CalculatorTest::tearDown()
 
 void Crc32CalculatorTest::TestSizeOfCrc32()
 {
-	CPPUNIT_ASSERT_EQUAL_MESSAGE( "The size of Crc32 is not 32 bits.", sizeof( __int32 ), sizeof( Crc32 ) );
+	CPPUNIT_ASSERT_EQUAL_MESSAGE( "The size of Crc32 is not 32 bits.", sizeof( int32_t ), sizeof( Crc32 ) );
 }
 
 
@@ -84,13 +137,16 @@ void Crc32CalculatorTest::TestConstructor()
 /*																													*/
 /********************************************************************************************************************/
 
-void Crc32CalculatorTest::TestOpen()
+void Crc32CalculatorTest::TestReset()
 {
-	Crc32	crc(0xDEADBEEF);
+	Crc32Calculator	calculator;
+	uint32_t		crc;
 
-	Crc32Calculator::Open( &crc );
+	calculator.Process( testbuffer, sizeof( testbuffer ) );
+	calculator.Reset();
+	calculator.Finalize( &crc );
 
-	CPPUNIT_ASSERT_EQUAL( 0xffffffff, crc );
+	CPPUNIT_ASSERT_EQUAL( CalculateReferenceCrc( testbuffer, 0 ), crc );
 }
 
 
@@ -98,14 +154,17 @@ void Crc32CalculatorTest::TestOpen()
 /*																													*/
 /********************************************************************************************************************/
 
-void Crc32CalculatorTest::TestUpdateByte()
+void Crc32CalculatorTest::TestProcessByte()
 {
 	for ( int i = 0; i < 256; ++i )
 	{
-		Crc32 const	expected	= CalculateReferenceUpdateValue( 0, i );
-		Crc32		actual		= 0;
-		
-		Crc32Calculator::Update( i, &actual );
+		uint8_t const	x			= uint8_t( i );
+		uint32_t const	expected	= CalculateReferenceCrc( &x, 1 );
+		Crc32Calculator	calculator;
+		uint32_t		actual;
+
+		calculator.Process( x );
+		calculator.Finalize( &actual );
 
 		std::ostringstream	message;
 		message << "Crc table mismatch at element " << i << ".";
@@ -119,14 +178,17 @@ void Crc32CalculatorTest::TestUpdateByte()
 /*																													*/
 /********************************************************************************************************************/
 
-void Crc32CalculatorTest::TestUpdateBuffer()
+void Crc32CalculatorTest::TestProcessBuffer()
 {
 	for ( int i = 0; i <= 256; ++i )
 	{
-		Crc32 const	expected	= CalculateReferenceUpdate( 0xBADC0DE, testbuffer, i );
-		Crc32		actual		= 0xBADC0DE;
-		
-		Crc32Calculator::Update( testbuffer, i, &actual );
+		uint32_t const	expected	= CalculateReferenceCrc( testbuffer, i );
+		Crc32Calculator	calculator;
+		uint32_t		actual;
+
+		calculator.Process( testbuffer, i / 3 );
+		calculator.Process( testbuffer + i / 3, i - i / 3 );
+		calculator.Finalize( &actual );
 
 		std::ostringstream	message;
 		message << "Failed updating the CRC for a buffer of size " << i << " bytes.";
@@ -140,14 +202,15 @@ void Crc32CalculatorTest::TestUpdateBuffer()
 /*																													*/
 /********************************************************************************************************************/
 
-void Crc32CalculatorTest::TestClose()
+void Crc32CalculatorTest::TestFinalize()
 {
-	Crc32 const	openCrc		= 0xDEADBEEF;
-	Crc32		closedCrc	= openCrc;
+	Crc32Calculator	calculator;
+	uint32_t		crc;
 
-	Crc32Calculator::Close( &closedCrc );
+	calculator.Process( testbuffer, 100 );
+	calculator.Finalize( &crc );
 
-	CPPUNIT_ASSERT_EQUAL( (Crc32)( openCrc ^ 0xffffffff ), closedCrc );
+	CPPUNIT_ASSERT_EQUAL( CalculateReferenceUpdate( 0xffffffff, testbuffer, 100 ) ^ 0xffffffff, crc );
 }
 
 
@@ -157,10 +220,12 @@ void Crc32CalculatorTest::TestClose()
 
 void Crc32CalculatorTest::TestBufferCalculate()
 {
+	Crc32Calculator	calculator;
+
 	for ( int i = 0; i <= 256; ++i )
 	{
-		Crc32 const	expected	= CalculateReferenceCrc( testbuffer, i );
-		Crc32 const	actual		= Crc32Calculator::Calculate( testbuffer, i );
+		uint32_t const	expected	= CalculateReferenceCrc( testbuffer, i );
+		uint32_t const	actual		= calculator.Calculate( testbuffer, i );
 
 		std::ostringstream	message;
 		message << "Failed generating a CRC for a buffer of size " << i << " bytes.";
@@ -185,11 +250,12 @@ void Crc32CalculatorTest::TestCStringCalculate()
 		"ghij",
 		"The quick brown fox jumped over the lazy dog."
 	};
+	Crc32Calculator	calculator;
 
-	for ( int i = 0; i < elementsof( strings ); ++i )
+	for ( int i = 0; i < (int)elementsof( strings ); ++i )
 	{
-		Crc32 const	expected	= CalculateReferenceCrc( (unsigned char const *)strings[i], (size_t)strlen( strings[i] ) );
-		Crc32 const	actual		= Crc32Calculator::Calculate( strings[i] );
+		uint32_t const	expected	= CalculateReferenceCrc( (unsigned char const *)strings[i], (int)strlen( strings[i] ) );
+		uint32_t const	actual		= calculator.Calculate( strings[i] );
 
 		std::ostringstream	message;
 		message << "Failed generating a CRC for the string " << '"' << strings[i] << '"';
@@ -214,11 +280,12 @@ void Crc32CalculatorTest::TestStringCalculate()
 		"ghij",
 		"The quick brown fox jumped over the lazy dog."
 	};
+	Crc32Calculator	calculator;
 
-	for ( int i = 0; i < elementsof( strings ); ++i )
+	for ( int i = 0; i < (int)elementsof( strings ); ++i )
 	{
-		Crc32 const	expected	= CalculateReferenceCrc( (unsigned char const *)strings[i].c_str(), strings[i].size() );
-		Crc32 const	actual		= Crc32Calculator::Calculate( strings[i] );
+		uint32_t const	expected	= CalculateReferenceCrc( (unsigned char const *)strings[i].c_str(), (int)strings[i].size() );
+		uint32_t const	actual		= calculator.Calculate( strings[i] );
 
 		std::ostringstream	message;
 		message << "Failed generating a CRC for the string " << '"' << strings[i] << '"';
@@ -232,36 +299,344 @@ void Crc32CalculatorTest::TestStringCalculate()
 /*																													*/
 /********************************************************************************************************************/
 
-#define FILENAME	"\\WINDOWS\\notepad.exe"
+// The stream is longer than the buffer used to read it
 
 void Crc32CalculatorTest::TestInputStreamCalculate()
 {
-	Crc32	expected;
-	Crc32	actual;
+	std::string	contents;
+
+	for ( int i = 0; i < 40; ++i )
+	{
+		contents.append( (char const *)testbuffer, sizeof( testbuffer ) );
+	}
+
+	std::istringstream	stream( contents );
+	uint32_t const		expected	= CalculateReferenceCrc( (unsigned char const *)contents.data(), (int)contents.size() );
+	uint32_t const		actual		= Crc32Calculator().Calculate( stream );
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE( "Failed generating a CRC for a stream.", expected, actual );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Crc32CalculatorTest::TestUpdateEdits()
+{
+	for ( int offset = 0; offset < 256; offset += 17 )
+	{
+		for ( int size = 0; offset + size <= 256; size += 23 )
+		{
+			unsigned char	changed[ 256 ];
+
+			memcpy( changed, testbuffer, sizeof( changed ) );
+			for ( int i = offset; i < offset + size; ++i )
+			{
+				changed[i] ^= (unsigned char)( i * 37 + 1 );
+			}
+
+			uint32_t const	expected	= CalculateReferenceCrc( changed, 256 );
+			uint32_t const	actual		= Crc32Calculator::Update( CalculateReferenceCrc( testbuffer, 256 ), 256, offset,
+																   testbuffer + offset, changed + offset, size );
+
+			std::ostringstream	message;
+			message << "Failed updating a CRC for " << size << " bytes changed at offset " << offset << ".";
+
+			CPPUNIT_ASSERT_EQUAL_MESSAGE( message.str(), expected, actual );
+		}
+	}
+
+	// Several edits, the second overlapping the first
+
+	unsigned char	first[ 256 ];
+	unsigned char	second[ 256 ];
+
+	memcpy( first, testbuffer, sizeof( first ) );
+	memset( first + 10, 0x5a, 100 );
+	memcpy( second, first, sizeof( second ) );
+	memset( second + 50, 0xa5, 150 );
+
+	Crc32Calculator::Edit const	edits[] =
+	{
+		{ 10, testbuffer + 10, first + 10, 100 },
+		{ 50, first + 50, second + 50, 150 },
+	};
+
+	uint32_t const	expected	= CalculateReferenceCrc( second, 256 );
+	uint32_t const	actual		= Crc32Calculator::Update( CalculateReferenceCrc( testbuffer, 256 ), 256, edits, 2 );
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE( "Failed updating a CRC for several edits.", expected, actual );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Crc32CalculatorTest::TestProcessZeros()
+{
+	unsigned char	zeros[ 4096 ]	= { 0 };
+
+	for ( int size = 0; size <= 4096; size += ( size < 64 ) ? 1 : 61 )
+	{
+		Crc32Calculator	expected;
+		Crc32Calculator	actual;
+		uint32_t		expectedCrc;
+		uint32_t		actualCrc;
+
+		expected.Process( testbuffer, 100 );
+		expected.Process( zeros, size );
+		expected.Process( testbuffer + 100, 100 );
+		expected.Finalize( &expectedCrc );
+
+		actual.Process( testbuffer, 100 );
+		actual.ProcessZeros( size );
+		actual.Process( testbuffer + 100, 100 );
+		actual.Finalize( &actualCrc );
+
+		std::ostringstream	message;
+		message << "Failed processing a run of " << size << " 0's.";
+
+		CPPUNIT_ASSERT_EQUAL_MESSAGE( message.str(), expectedCrc, actualCrc );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The CRC-32 of a file with holes is the CRC-32 of its contents with the holes filled with 0's, whether the holes are
+// at the start, in the middle or at the end, and whether an extent of data is larger than the amount read at a time
+
+void Crc32CalculatorTest::TestSparseFiles()
+{
+	size_t const	HOLE	= 3 * 1024 * 1024 + 1000;
+	size_t const	LARGE	= 1024 * 1024 + 3;
+
+	struct Case
+	{
+		char const *	name;
+		size_t			size;
+		Extent			extents[ 2 ];
+		int				count;
+	};
+
+	Case const	cases[]	=
+	{
+		{ "empty",				0,							{ { 0, 0 }, { 0, 0 } },					0 },
+		{ "one byte",			1,							{ { 0, 1 }, { 0, 0 } },					1 },
+		{ "all hole",			HOLE,						{ { 0, 0 }, { 0, 0 } },					0 },
+		{ "hole at start",		HOLE + 100,					{ { HOLE, 100 }, { 0, 0 } },			1 },
+		{ "hole at end",		100 + HOLE,					{ { 0, 100 }, { 0, 0 } },				1 },
+		{ "data after a hole",	100 + HOLE + LARGE + HOLE,	{ { 0, 100 }, { 100 + HOLE, LARGE } },	2 },
+	};
+
+	m_directory.Create();
+
+	for ( size_t i = 0; i < elementsof( cases ); ++i )
+	{
+		Case const &					c			= cases[i];
+		std::string const				path		= m_directory.Path( "sparse" );
+		std::vector< uint8_t > const	contents	= WriteSparseFile( path, c.size, c.extents, c.count );
+		std::string const				message		= std::string( "Failed with a file that is " ) + c.name + ".";
+		Crc32Calculator					calculator;
+		uint32_t						expected;
+		uint32_t						actual		= 0;
+
+		CPPUNIT_ASSERT_EQUAL_MESSAGE( message, long( c.size ), TestFiles::FileSize( path ) );
+
+		expected = calculator.Calculate( contents.data(), contents.size() );
+		CPPUNIT_ASSERT_MESSAGE( message, calculator.CalculateFile( path.c_str(), &actual ) );
+		CPPUNIT_ASSERT_EQUAL_MESSAGE( message, expected, actual );
+
+		// ProcessFile continues the CRC of the data before it
+
+		calculator.Reset();
+		calculator.Process( testbuffer, 100 );
+		calculator.Process( contents.data(), contents.size() );
+		calculator.Finalize( &expected );
+
+		calculator.Reset();
+		calculator.Process( testbuffer, 100 );
+		CPPUNIT_ASSERT_MESSAGE( message, calculator.ProcessFile( path.c_str() ) );
+		calculator.Finalize( &actual );
+		CPPUNIT_ASSERT_EQUAL_MESSAGE( message, expected, actual );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A file that does not exist cannot be read
+
+void Crc32CalculatorTest::TestMissingFile()
+{
+	Crc32Calculator	calculator;
+	uint32_t		crc	= 0;
+
+	m_directory.Create();
+
+	std::string const	path	= m_directory.Path( "missing" );
+
+	CPPUNIT_ASSERT( !calculator.CalculateFile( path.c_str(), &crc ) );
+
+	calculator.Reset();
+	CPPUNIT_ASSERT( !calculator.ProcessFile( path.c_str() ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Crc32CalculatorTest::TestCombine()
+{
+	for ( int split = 0; split <= 200; split += ( split < 16 ) ? 1 : 23 )
+	{
+		Crc32Calculator	calculator;
+		uint32_t const	expected	= calculator.Calculate( testbuffer, 200 );
+		uint32_t const	first		= calculator.Calculate( testbuffer, split );
+		uint32_t const	second		= calculator.Calculate( testbuffer + split, 200 - split );
+
+		std::ostringstream	message;
+		message << "Failed combining the CRCs of a buffer split at " << split << ".";
+
+		CPPUNIT_ASSERT_EQUAL_MESSAGE( message.str(), expected, Crc32Calculator::Combine( first, second, 200 - split ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Each buffer of a batch gets the same CRC as it does alone, with every available kernel. The counts cover the groups
+// of four buffers and the buffers left over, and the sizes cover the buffers too short to be folded.
+
+void Crc32CalculatorTest::TestCalculateBatch()
+{
+	size_t const						sizes[]		= { 0, 1, 15, 16, 17, 31, 64, 100, 200 };
+	std::vector< std::string > const	kernels		= KernelRegistry::Available( KernelRegistry::CRC32 );
+
+	for ( size_t k = 0; k < kernels.size(); ++k )
+	{
+		KernelRegistry::Force( KernelRegistry::CRC32, kernels[k].c_str() );
+
+		for ( int s = 0; s < (int)elementsof( sizes ); ++s )
+		{
+			for ( size_t count = 1; count <= 9; ++count )
+			{
+				uint8_t const *	buffers[ 9 ];
+				uint32_t		crcs[ 9 ];
+
+				for ( size_t i = 0; i < count; ++i )
+				{
+					buffers[i] = testbuffer + i * 5;	// Not aligned
+				}
+
+				Crc32Calculator::CalculateBatch( buffers, sizes[s], count, crcs );
+
+				for ( size_t i = 0; i < count; ++i )
+				{
+					std::ostringstream	message;
+					message << "The \"" << kernels[k] << "\" batch CRC of buffer " << i << " of " << count << " ("
+							<< sizes[s] << " bytes) is wrong.";
+
+					CPPUNIT_ASSERT_EQUAL_MESSAGE( message.str(), SingleCrc( buffers[i], sizes[s] ), crcs[i] );
+				}
+			}
+		}
+	}
+
+	KernelRegistry::Automatic( KernelRegistry::CRC32 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Crc32CalculatorTest::TestCalculateBatchSizes()
+{
+	std::vector< std::string > const	kernels	= KernelRegistry::Available( KernelRegistry::CRC32 );
+	size_t const						COUNT	= 23;
 
+	for ( size_t k = 0; k < kernels.size(); ++k )
 	{
-		std::ifstream	file( FILENAME, std::ios_base::in|std::ios_base::binary|std::ios_base::ate );
-		CPPUNIT_ASSERT_MESSAGE( "Crc32Calculator::Calculate( std::istream & stream ) cannot be tested because the file \"" FILENAME "\" cannot be opened.", file.is_open() );
+		KernelRegistry::Force( KernelRegistry::CRC32, kernels[k].c_str() );
 
-		int const	size	= file.tellg();
-		char *		buffer	= new char [ size ];
+		uint8_t const *	buffers[ COUNT ];
+		size_t			sizes[ COUNT ];
+		uint32_t		crcs[ COUNT ];
 
-		file.seekg ( 0, std::ios::beg );
-		file.read( buffer, size );
+		for ( size_t i = 0; i < COUNT; ++i )
+		{
+			buffers[i]	= testbuffer + i;
+			sizes[i]	= ( i * 37 ) % ( sizeof( testbuffer ) - i );
+		}
 
-		expected = CalculateReferenceCrc( (unsigned char *)buffer, size );
+		Crc32Calculator::CalculateBatch( buffers, sizes, COUNT, crcs );
 
-		delete[] buffer;
+		for ( size_t i = 0; i < COUNT; ++i )
+		{
+			std::ostringstream	message;
+			message << "The \"" << kernels[k] << "\" batch CRC of a buffer of " << sizes[i] << " bytes is wrong.";
+
+			CPPUNIT_ASSERT_EQUAL_MESSAGE( message.str(), SingleCrc( buffers[i], sizes[i] ), crcs[i] );
+		}
 	}
 
+	KernelRegistry::Automatic( KernelRegistry::CRC32 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Exactly the buffers whose expected values are wrong are reported, in a batch that spans three words of the bitmap
+
+void Crc32CalculatorTest::TestVerifyBatch()
+{
+	size_t const	COUNT	= 150;
+	size_t const	SIZE	= 64;
+	uint8_t const *	buffers[ COUNT ];
+	size_t			sizes[ COUNT ];
+	uint32_t		expected[ COUNT ];
+	uint64_t		failures[ ( COUNT + 63 ) / 64 ];
+	size_t			nWrong	= 0;
+
+	for ( size_t i = 0; i < COUNT; ++i )
 	{
-		std::ifstream	file( FILENAME, std::ios_base::in|std::ios_base::binary );
-		CPPUNIT_ASSERT_MESSAGE( "Crc32Calculator::Calculate( std::istream & stream ) cannot be tested because the file \"" FILENAME "\" cannot be opened.", file.is_open() );
+		buffers[i]	= testbuffer + i;
+		sizes[i]	= SIZE;
+		expected[i]	= SingleCrc( buffers[i], SIZE );
+		if ( i % 7 == 3 )
+		{
+			expected[i] ^= 0x100;
+			++nWrong;
+		}
+	}
 
-		actual = Crc32Calculator::Calculate( file );
+	CPPUNIT_ASSERT_EQUAL( nWrong, Crc32Calculator::VerifyBatch( buffers, SIZE, COUNT, expected, failures ) );
+
+	for ( size_t i = 0; i < COUNT; ++i )
+	{
+		CPPUNIT_ASSERT_EQUAL( i % 7 == 3, ( ( failures[ i / 64 ] >> ( i % 64 ) ) & 1 ) != 0 );
 	}
 
-	CPPUNIT_ASSERT_EQUAL_MESSAGE( "Failed generating a CRC for the file \"" FILENAME "\".", expected, actual );
+	// Bits past the last buffer are 0
+
+	CPPUNIT_ASSERT_EQUAL( uint64_t( 0 ), failures[ COUNT / 64 ] >> ( COUNT % 64 ) );
+
+	memset( failures, 0xff, sizeof( failures ) );
+	CPPUNIT_ASSERT_EQUAL( nWrong, Crc32Calculator::VerifyBatch( buffers, sizes, COUNT, expected, failures ) );
+	CPPUNIT_ASSERT_EQUAL( uint64_t( 1 ) << 3, failures[0] & 0xff );
+	CPPUNIT_ASSERT_EQUAL( uint64_t( 0 ), failures[ COUNT / 64 ] >> ( COUNT % 64 ) );
 }
 
 
@@ -275,12 +650,12 @@ void Crc32CalculatorTest::InitializeReferenceAlgorithm()
 {
 	/* Make the table for a fast CRC. */
 
-	Crc32 c;
+	uint32_t c;
 	int n, k;
 
 	for (n = 0; n < 256; n++)
 	{
-		c = (Crc32) n;
+		c = (uint32_t) n;
 		for (k = 0; k < 8; k++)
 		{
 			if (c & 1)
@@ -292,12 +667,12 @@ void Crc32CalculatorTest::InitializeReferenceAlgorithm()
 	}
 }
 
-Crc32 Crc32CalculatorTest::CalculateReferenceCrc( unsigned char const * buf, int len )
+uint32_t Crc32CalculatorTest::CalculateReferenceCrc( unsigned char const * buf, int len )
 {
 	return CalculateReferenceUpdate( 0xffffffff, buf, len ) ^ 0xffffffff;
 }
 
-Crc32 Crc32CalculatorTest::CalculateReferenceUpdate( Crc32 crc, unsigned char const * buf, int len )
+uint32_t Crc32CalculatorTest::CalculateReferenceUpdate( uint32_t crc, unsigned char const * buf, int len )
 {
 	for ( int n = 0; n < len; n++ )
 	{
@@ -307,7 +682,7 @@ Crc32 Crc32CalculatorTest::CalculateReferenceUpdate( Crc32 crc, unsigned char co
 	return crc;
 }
 
-Crc32 Crc32CalculatorTest::CalculateReferenceUpdateValue( Crc32 crc, unsigned char x )
+uint32_t Crc32CalculatorTest::CalculateReferenceUpdateValue( uint32_t crc, unsigned char x )
 {
     return s_ReferenceCrcTable[ ( crc ^ x ) & 0xff ] ^ ( crc >> 8 );
 }
@@ -19,19 +19,29 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <cppunit/TestFixture.h>
 
+#include "Misc/TestFiles.h"
+
 class Crc32CalculatorTest : public CPPUNIT_NS::TestFixture
 {
 	CPPUNIT_TEST_SUITE( Crc32CalculatorTest );
 	CPPUNIT_TEST( TestSizeOfCrc32 );
 	CPPUNIT_TEST( TestConstructor );
-	CPPUNIT_TEST( TestOpen );
-	CPPUNIT_TEST( TestUpdateByte );
-	CPPUNIT_TEST( TestUpdateBuffer );
-	CPPUNIT_TEST( TestClose );
+	CPPUNIT_TEST( TestReset );
+	CPPUNIT_TEST( TestProcessByte );
+	CPPUNIT_TEST( TestProcessBuffer );
+	CPPUNIT_TEST( TestFinalize );
 	CPPUNIT_TEST( TestBufferCalculate );
 	CPPUNIT_TEST( TestCStringCalculate );
 	CPPUNIT_TEST( TestStringCalculate );
 	CPPUNIT_TEST( TestInputStreamCalculate );
+	CPPUNIT_TEST( TestUpdateEdits );
+	CPPUNIT_TEST( TestProcessZeros );
+	CPPUNIT_TEST( TestSparseFiles );
+	CPPUNIT_TEST( TestMissingFile );
+	CPPUNIT_TEST( TestCombine );
+	CPPUNIT_TEST( TestCalculateBatch );
+	CPPUNIT_TEST( TestCalculateBatchSizes );
+	CPPUNIT_TEST( TestVerifyBatch );
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -41,19 +51,29 @@ public:
 
 	void TestSizeOfCrc32();
 	void TestConstructor();
-	void TestOpen();
-	void TestUpdateByte();
-	void TestUpdateBuffer();
-	void TestClose();
+	void TestReset();
+	void TestProcessByte();
+	void TestProcessBuffer();
+	void TestFinalize();
 	void TestBufferCalculate();
 	void TestCStringCalculate();
 	void TestStringCalculate();
 	void TestInputStreamCalculate();
+	void TestUpdateEdits();
+	void TestProcessZeros();
+	void TestSparseFiles();
+	void TestMissingFile();
+	void TestCombine();
+	void TestCalculateBatch();
+	void TestCalculateBatchSizes();
+	void TestVerifyBatch();
 
 private:
 
 	void InitializeReferenceAlgorithm();
-	Crypto::Crc32 CalculateReferenceUpdateValue( Crypto::Crc32 crc, unsigned char x );
-	Crypto::Crc32 CalculateReferenceUpdate( Crypto::Crc32 crc, unsigned char const * buf, int len );
-	Crypto::Crc32 CalculateReferenceCrc( unsigned char const * buf, int len );
+	uint32_t CalculateReferenceUpdateValue( uint32_t crc, unsigned char x );
+	uint32_t CalculateReferenceUpdate( uint32_t crc, unsigned char const * buf, int len );
+	uint32_t CalculateReferenceCrc( unsigned char const * buf, int len );
+
+	TestFiles::TemporaryDirectory	m_directory;
 };
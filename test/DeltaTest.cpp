@@ -0,0 +1,204 @@
+/********************************************************************************************************************
+
+                                                    DeltaTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/DeltaTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "DeltaTest.h"
+
+#include "../Delta.h"
+
+#include "Misc/Random.h"
+#include "Misc/Etc.h"
+
+#include <algorithm>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( DeltaTest );
+
+namespace
+{
+	size_t const	OLD_SIZE	= 100000;
+
+	// Computes a delta from the old file to the new one and checks that applying it gives the new file. Returns the
+	// size of the delta.
+	size_t RoundTrip( std::vector< uint8_t > const & oldFile, std::vector< uint8_t > const & newFile, size_t blockSize,
+					  BlockSignature::StrongDigest strong = BlockSignature::SHA256 )
+	{
+		BlockSignature			signature;
+		std::vector< uint8_t >	message;
+		std::vector< uint8_t >	delta;
+		std::vector< uint8_t >	result;
+
+		signature.Generate( oldFile.data(), oldFile.size(), blockSize, strong );
+		signature.Serialize( message );
+		CPPUNIT_ASSERT( signature.Deserialize( message.data(), message.size() ) );
+
+		Delta::Compute( signature, newFile.data(), newFile.size(), delta );
+		CPPUNIT_ASSERT( Delta::Apply( oldFile.data(), oldFile.size(), delta.data(), delta.size(), result ) );
+		CPPUNIT_ASSERT( result == newFile );
+
+		return delta.size();
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DeltaTest::setUp()
+{
+	Random	rng( 8 );
+
+	m_old.resize( OLD_SIZE );
+	for ( size_t i = 0; i < m_old.size(); ++i )
+	{
+		m_old[i] = uint8_t( rng.Get() );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DeltaTest::tearDown()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The delta of a file against itself is little more than the header, with either strong digest
+
+void DeltaTest::TestIdentical()
+{
+	CPPUNIT_ASSERT( RoundTrip( m_old, m_old, 4096 ) < 200 );
+	CPPUNIT_ASSERT( RoundTrip( m_old, m_old, 1000, BlockSignature::MD5 ) < 200 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Insertions, deletions and changes are sent as literals and the rest is copied
+
+void DeltaTest::TestEdits()
+{
+	std::vector< uint8_t >	edited	= m_old;
+
+	edited.insert( edited.begin() + 1000, 37, 'x' );
+	edited.erase( edited.begin() + 50000, edited.begin() + 50100 );
+	edited[ 80000 ] ^= 1;
+
+	CPPUNIT_ASSERT( RoundTrip( m_old, edited, 1024 ) < 5000 );
+
+	std::vector< uint8_t > const	empty;
+
+	RoundTrip( m_old, empty, 1024 );
+	RoundTrip( empty, m_old, 1024 );
+	RoundTrip( m_old, std::vector< uint8_t >( m_old.begin(), m_old.begin() + 100 ), 1024 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The positions are scanned 256 at a time. After a match, the next batch starts after the matched block, and if fewer
+// than 256 positions are left, the batch is partial. Only the candidates of that batch may be checked, not ones left
+// over from the previous batch, which would be past the end of the file.
+//
+// The old file repeats a 16-byte pattern, so every 16th position of a copy of the pattern matches. The new file has
+// 100 random bytes, 112 bytes of the pattern (so the first batch has candidates at 100, 116, 132 and 148) and random
+// bytes up to a length that leaves 92 to 127 positions for the second batch, which starts at 164.
+
+void DeltaTest::TestPartialScan()
+{
+	size_t const			BLOCK_SIZE	= 64;
+	std::vector< uint8_t >	pattern( 4096 );
+
+	for ( size_t i = 0; i < pattern.size(); ++i )
+	{
+		pattern[i] = m_old[ i % 16 ];
+	}
+
+	for ( size_t count = 92; count < 128; ++count )
+	{
+		std::vector< uint8_t >	newFile( m_old.begin() + 1000, m_old.begin() + 1000 + 164 + count + BLOCK_SIZE - 1 );
+
+		std::copy( pattern.begin(), pattern.begin() + 112, newFile.begin() + 100 );
+
+		RoundTrip( pattern, newFile, BLOCK_SIZE );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DeltaTest::TestSignature()
+{
+	BlockSignature	signature;
+
+	signature.Generate( m_old.data(), 10000, 4096, BlockSignature::MD5 );
+	CPPUNIT_ASSERT_EQUAL( size_t( 4096 ), signature.BlockSize() );
+	CPPUNIT_ASSERT_EQUAL( uint64_t( 10000 ), signature.FileSize() );
+	CPPUNIT_ASSERT_EQUAL( size_t( 3 ), signature.Blocks().size() );
+	CPPUNIT_ASSERT_EQUAL( BlockSignature::ComputeWeak( m_old.data() + 8192, 10000 - 8192 ), signature.Blocks()[2].weak );
+
+	// The weak checksum of "abc": the sum of the bytes and the sum of the running sums
+
+	uint32_t const	a	= 'a';
+	uint32_t const	b	= 'b';
+	uint32_t const	c	= 'c';
+
+	CPPUNIT_ASSERT_EQUAL( ( ( a * 3 + b * 2 + c ) << 16 ) | ( a + b + c ),
+						  BlockSignature::ComputeWeak( reinterpret_cast< uint8_t const * >( "abc" ), 3 ) );
+
+	std::vector< uint8_t >	message;
+
+	signature.Serialize( message );
+	message.pop_back();
+	CPPUNIT_ASSERT( !signature.Deserialize( message.data(), message.size() ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A delta is rejected if it is applied to a different file or is corrupt
+
+void DeltaTest::TestWrongBase()
+{
+	BlockSignature			signature;
+	std::vector< uint8_t >	delta;
+	std::vector< uint8_t >	result;
+	std::vector< uint8_t >	edited	= m_old;
+
+	edited[ 500 ] ^= 0xff;
+	signature.Generate( m_old.data(), m_old.size(), 1024 );
+	Delta::Compute( signature, edited.data(), edited.size(), delta );
+
+	std::vector< uint8_t >	other	= m_old;
+
+	other[ 20000 ] ^= 1;
+	CPPUNIT_ASSERT( !Delta::Apply( other.data(), other.size(), delta.data(), delta.size(), result ) );
+	CPPUNIT_ASSERT( !Delta::Apply( m_old.data(), m_old.size() - 1, delta.data(), delta.size(), result ) );
+	CPPUNIT_ASSERT( !Delta::Apply( m_old.data(), m_old.size(), delta.data(), delta.size() - 1, result ) );
+}
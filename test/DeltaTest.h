@@ -0,0 +1,46 @@
+/********************************************************************************************************************
+
+                                                     DeltaTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/DeltaTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+#include <cstdint>
+#include <vector>
+
+class DeltaTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( DeltaTest );
+	CPPUNIT_TEST( TestIdentical );
+	CPPUNIT_TEST( TestEdits );
+	CPPUNIT_TEST( TestPartialScan );
+	CPPUNIT_TEST( TestSignature );
+	CPPUNIT_TEST( TestWrongBase );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestIdentical();
+	void TestEdits();
+	void TestPartialScan();
+	void TestSignature();
+	void TestWrongBase();
+
+private:
+
+	std::vector< uint8_t >	m_old;	// The old version of the file
+};
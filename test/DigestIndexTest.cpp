@@ -0,0 +1,256 @@
+/********************************************************************************************************************
+
+                                                 DigestIndexTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/DigestIndexTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "DigestIndexTest.h"
+
+#include "../DigestIndex.h"
+#include "../Md5.h"
+#include "../Sha256.h"
+
+#include "Misc/Random.h"
+#include "Misc/Etc.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( DigestIndexTest );
+
+namespace
+{
+	char const	PATH[]	= "DigestIndexTest.idx";
+	int const	COUNT	= 10000;
+
+	// Returns the SHA-256 digests of the numbers [first, first + count)
+	std::vector< Sha256 > Digests( int first, int count )
+	{
+		std::vector< Sha256 >	digests;
+
+		for ( int i = first; i < first + count; ++i )
+		{
+			digests.push_back( Sha256( reinterpret_cast< uint8_t const * >( &i ), sizeof( i ) ) );
+		}
+
+		return digests;
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestIndexTest::setUp()
+{
+	std::vector< Sha256 > const	digests	= Digests( 0, COUNT );
+
+	CPPUNIT_ASSERT( DigestIndex::Write( PATH, digests.data(), digests.size() ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestIndexTest::tearDown()
+{
+	remove( PATH );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Every digest that was written is found at a position that holds it, the digests are sorted, and digests that were
+// not written are not found
+
+void DigestIndexTest::TestFind()
+{
+	DigestIndex	index;
+
+	CPPUNIT_ASSERT( index.Open( PATH ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( COUNT ), index.Size() );
+	CPPUNIT_ASSERT_EQUAL( size_t( Sha256::SIZE ), index.DigestSize() );
+
+	for ( size_t i = 1; i < index.Size(); ++i )
+	{
+		CPPUNIT_ASSERT( memcmp( index.Digest( i - 1 ), index.Digest( i ), Sha256::SIZE ) < 0 );
+	}
+
+	std::vector< Sha256 > const	present	= Digests( 0, COUNT );
+	std::vector< Sha256 > const	absent	= Digests( COUNT, COUNT );
+
+	for ( int i = 0; i < COUNT; ++i )
+	{
+		size_t const	position	= index.Find( present[i] );
+
+		CPPUNIT_ASSERT( position != DigestIndex::NOT_FOUND );
+		CPPUNIT_ASSERT( memcmp( index.Digest( position ), present[i].m_value, Sha256::SIZE ) == 0 );
+		CPPUNIT_ASSERT_EQUAL( DigestIndex::NOT_FOUND, index.Find( absent[i] ) );
+	}
+
+	// The smallest and largest possible digests
+
+	Sha256	zero;
+	Sha256	ones;
+
+	memset( ones.m_value, 0xff, sizeof( ones.m_value ) );
+	CPPUNIT_ASSERT_EQUAL( DigestIndex::NOT_FOUND, index.Find( zero ) );
+	CPPUNIT_ASSERT_EQUAL( DigestIndex::NOT_FOUND, index.Find( ones ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A batch of queries in random order, half of them present, gives the same positions as single queries
+
+void DigestIndexTest::TestFindMany()
+{
+	DigestIndex	index;
+
+	CPPUNIT_ASSERT( index.Open( PATH ) );
+
+	std::vector< Sha256 >	queries	= Digests( COUNT / 2, COUNT );
+	Random					rng( 6 );
+
+	for ( size_t i = queries.size() - 1; i > 0; --i )
+	{
+		std::swap( queries[i], queries[ rng.Get() % ( i + 1 ) ] );
+	}
+
+	std::vector< size_t >	positions( queries.size() );
+
+	CPPUNIT_ASSERT_EQUAL( size_t( COUNT / 2 ), index.Find( queries.data(), queries.size(), positions.data() ) );
+
+	for ( size_t i = 0; i < queries.size(); ++i )
+	{
+		CPPUNIT_ASSERT_EQUAL( index.Find( queries[i] ), positions[i] );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Duplicates are written once
+
+void DigestIndexTest::TestDuplicates()
+{
+	std::vector< Sha256 >	digests	= Digests( 0, 100 );
+	std::vector< Sha256 >	more	= Digests( 50, 100 );
+
+	digests.insert( digests.end(), more.begin(), more.end() );
+	CPPUNIT_ASSERT( DigestIndex::Write( PATH, digests.data(), digests.size() ) );
+
+	DigestIndex	index;
+
+	CPPUNIT_ASSERT( index.Open( PATH ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 150 ), index.Size() );
+
+	size_t	positions[ 3 ];
+	Sha256	queries[ 3 ]	= { digests[0], digests[0], digests[ 120 ] };
+
+	CPPUNIT_ASSERT_EQUAL( size_t( 3 ), index.Find( queries, 3, positions ) );
+	CPPUNIT_ASSERT_EQUAL( positions[0], positions[1] );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestIndexTest::TestEmpty()
+{
+	CPPUNIT_ASSERT( DigestIndex::Write( PATH, static_cast< Sha256 const * >( nullptr ), 0 ) );
+
+	DigestIndex	index;
+	size_t		position	= 0;
+	Sha256		digest;
+
+	CPPUNIT_ASSERT( index.Open( PATH ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), index.Size() );
+	CPPUNIT_ASSERT_EQUAL( DigestIndex::NOT_FOUND, index.Find( digest ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), index.Find( &digest, 1, &position ) );
+	CPPUNIT_ASSERT_EQUAL( DigestIndex::NOT_FOUND, position );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Digests of a different size are never found
+
+void DigestIndexTest::TestWrongSize()
+{
+	DigestIndex	index;
+	Md5			md5[ 4 ];
+	size_t		positions[ 4 ]	= { 0, 1, 2, 3 };
+
+	CPPUNIT_ASSERT( index.Open( PATH ) );
+	CPPUNIT_ASSERT_EQUAL( DigestIndex::NOT_FOUND, index.Find( md5[0] ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), index.Find( md5, 4, positions ) );
+
+	for ( int i = 0; i < 4; ++i )
+	{
+		CPPUNIT_ASSERT_EQUAL( DigestIndex::NOT_FOUND, positions[i] );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A missing file, a file that is not an index and a truncated index cannot be opened
+
+void DigestIndexTest::TestInvalidFile()
+{
+	DigestIndex	index;
+
+	CPPUNIT_ASSERT( !index.Open( "DigestIndexTest.missing" ) );
+	CPPUNIT_ASSERT( !index.IsOpen() );
+
+	FILE *	file	= fopen( PATH, "r+b" );
+
+	CPPUNIT_ASSERT( file != nullptr );
+	fputc( 'X', file );
+	fclose( file );
+	CPPUNIT_ASSERT( !index.Open( PATH ) );
+
+	std::vector< Sha256 > const	digests	= Digests( 0, 10 );
+	std::vector< uint8_t >		contents;
+
+	CPPUNIT_ASSERT( DigestIndex::Write( PATH, digests.data(), digests.size() ) );
+	file = fopen( PATH, "rb" );
+	CPPUNIT_ASSERT( file != nullptr );
+	for ( int c; ( c = fgetc( file ) ) != EOF; )
+	{
+		contents.push_back( uint8_t( c ) );
+	}
+	fclose( file );
+
+	file = fopen( PATH, "wb" );
+	CPPUNIT_ASSERT( file != nullptr );
+	fwrite( contents.data(), 1, contents.size() - 1, file );
+	fclose( file );
+	CPPUNIT_ASSERT( !index.Open( PATH ) );
+}
@@ -0,0 +1,41 @@
+/********************************************************************************************************************
+
+                                                  DigestIndexTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/DigestIndexTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class DigestIndexTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( DigestIndexTest );
+	CPPUNIT_TEST( TestFind );
+	CPPUNIT_TEST( TestFindMany );
+	CPPUNIT_TEST( TestDuplicates );
+	CPPUNIT_TEST( TestEmpty );
+	CPPUNIT_TEST( TestWrongSize );
+	CPPUNIT_TEST( TestInvalidFile );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestFind();
+	void TestFindMany();
+	void TestDuplicates();
+	void TestEmpty();
+	void TestWrongSize();
+	void TestInvalidFile();
+};
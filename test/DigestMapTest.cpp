@@ -0,0 +1,188 @@
+/********************************************************************************************************************
+
+                                                  DigestMapTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/DigestMapTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "DigestMapTest.h"
+
+#include "../DigestMap.h"
+
+#include <memory>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( DigestMapTest );
+
+namespace
+{
+	int const	NUMBER_OF_KEYS	= 10000;
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestMapTest::setUp()
+{
+	m_keys.resize( NUMBER_OF_KEYS );
+
+	for ( int i = 0; i < NUMBER_OF_KEYS; ++i )
+	{
+		m_keys[i] = Sha256( reinterpret_cast< uint8_t const * >( &i ), sizeof( i ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestMapTest::tearDown()
+{
+	m_keys.clear();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestMapTest::TestInsertFind()
+{
+	DigestMap< Sha256, int >	map;
+
+	// The map grows many times along the way
+
+	for ( int i = 0; i < NUMBER_OF_KEYS; ++i )
+	{
+		std::pair< int *, bool > const	result	= map.Insert( m_keys[i], i );
+
+		CPPUNIT_ASSERT( result.second );
+		CPPUNIT_ASSERT_EQUAL( i, *result.first );
+	}
+
+	CPPUNIT_ASSERT_EQUAL( size_t( NUMBER_OF_KEYS ), map.Size() );
+
+	// Inserting an existing key keeps the original value
+
+	std::pair< int *, bool > const	again	= map.Insert( m_keys[0], -1 );
+
+	CPPUNIT_ASSERT( !again.second );
+	CPPUNIT_ASSERT_EQUAL( 0, *again.first );
+
+	for ( int i = 0; i < NUMBER_OF_KEYS; ++i )
+	{
+		int const * const	value	= map.Find( m_keys[i] );
+
+		CPPUNIT_ASSERT( value != nullptr );
+		CPPUNIT_ASSERT_EQUAL( i, *value );
+	}
+
+	CPPUNIT_ASSERT( map.Find( Sha256::Of( "not in the map" ) ) == nullptr );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestMapTest::TestErase()
+{
+	DigestMap< Sha256, int >	map;
+
+	for ( int i = 0; i < NUMBER_OF_KEYS; ++i )
+	{
+		map.Insert( m_keys[i], i );
+	}
+
+	for ( int i = 0; i < NUMBER_OF_KEYS; i += 2 )
+	{
+		CPPUNIT_ASSERT( map.Erase( m_keys[i] ) );
+		CPPUNIT_ASSERT( !map.Erase( m_keys[i] ) );
+	}
+
+	CPPUNIT_ASSERT_EQUAL( size_t( NUMBER_OF_KEYS / 2 ), map.Size() );
+
+	for ( int i = 0; i < NUMBER_OF_KEYS; ++i )
+	{
+		CPPUNIT_ASSERT_EQUAL( i % 2 != 0, map.Contains( m_keys[i] ) );
+	}
+
+	// Refilling the erased slots must not disturb the other keys
+
+	for ( int i = 0; i < NUMBER_OF_KEYS; i += 2 )
+	{
+		CPPUNIT_ASSERT( map.Insert( m_keys[i], -i ).second );
+	}
+
+	for ( int i = 0; i < NUMBER_OF_KEYS; ++i )
+	{
+		CPPUNIT_ASSERT_EQUAL( ( i % 2 != 0 ) ? i : -i, *map.Find( m_keys[i] ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestMapTest::TestBulk()
+{
+	DigestMap< Sha256, int >	map;
+	std::vector< int >			values( NUMBER_OF_KEYS );
+
+	for ( int i = 0; i < NUMBER_OF_KEYS; ++i )
+	{
+		values[i] = i;
+	}
+
+	CPPUNIT_ASSERT_EQUAL( size_t( NUMBER_OF_KEYS / 2 ), map.Insert( &m_keys[0], &values[0], NUMBER_OF_KEYS / 2 ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( NUMBER_OF_KEYS / 2 ), map.Insert( &m_keys[0], &values[0], NUMBER_OF_KEYS ) );
+
+	std::unique_ptr< int const *[] > const	found( new int const *[ NUMBER_OF_KEYS ] );
+
+	CPPUNIT_ASSERT_EQUAL( size_t( NUMBER_OF_KEYS ), map.Find( &m_keys[0], NUMBER_OF_KEYS, found.get() ) );
+
+	for ( int i = 0; i < NUMBER_OF_KEYS; ++i )
+	{
+		CPPUNIT_ASSERT( found[i] != nullptr );
+		CPPUNIT_ASSERT_EQUAL( i, *found[i] );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestMapTest::TestSet()
+{
+	DigestSet< Sha256 >	set;
+
+	CPPUNIT_ASSERT_EQUAL( size_t( NUMBER_OF_KEYS / 2 ), set.Insert( &m_keys[0], NUMBER_OF_KEYS / 2 ) );
+	CPPUNIT_ASSERT( !set.Insert( m_keys[0] ) );
+
+	std::unique_ptr< bool[] > const	found( new bool[ NUMBER_OF_KEYS ] );
+
+	CPPUNIT_ASSERT_EQUAL( size_t( NUMBER_OF_KEYS / 2 ), set.Contains( &m_keys[0], NUMBER_OF_KEYS, found.get() ) );
+
+	for ( int i = 0; i < NUMBER_OF_KEYS; ++i )
+	{
+		CPPUNIT_ASSERT_EQUAL( i < NUMBER_OF_KEYS / 2, found[i] );
+	}
+
+	size_t	count	= 0;
+
+	set.ForEach( [ & ]( Sha256 const & key ) { CPPUNIT_ASSERT( set.Contains( key ) ); ++count; } );
+	CPPUNIT_ASSERT_EQUAL( set.Size(), count );
+}
@@ -0,0 +1,45 @@
+/********************************************************************************************************************
+
+                                                   DigestMapTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/DigestMapTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../Sha256.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+#include <vector>
+
+class DigestMapTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( DigestMapTest );
+	CPPUNIT_TEST( TestInsertFind );
+	CPPUNIT_TEST( TestErase );
+	CPPUNIT_TEST( TestBulk );
+	CPPUNIT_TEST( TestSet );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestInsertFind();
+	void TestErase();
+	void TestBulk();
+	void TestSet();
+
+private:
+
+	std::vector< Crypto::Sha256 >	m_keys;
+};
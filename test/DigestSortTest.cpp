@@ -0,0 +1,171 @@
+/********************************************************************************************************************
+
+                                                 DigestSortTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/DigestSortTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "DigestSortTest.h"
+
+#include "../DigestSort.h"
+#include "../Sha1.h"
+
+#include "Misc/Random.h"
+#include "Misc/Etc.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( DigestSortTest );
+
+namespace
+{
+	int const	DISTINCT	= 500;
+	int const	COUNT		= 2000;
+
+	// Returns COUNT digests drawn from DISTINCT values, so most of them occur several times
+	std::vector< Sha1 > Digests()
+	{
+		std::vector< Sha1 >	digests;
+		Random				rng( 7 );
+
+		for ( int i = 0; i < COUNT; ++i )
+		{
+			int const	value	= int( rng.Get() % DISTINCT );
+
+			digests.push_back( Sha1( reinterpret_cast< uint8_t const * >( &value ), sizeof( value ) ) );
+		}
+
+		return digests;
+	}
+
+	// Adds the digests in batches of varying sizes, merges them and checks the result against a std::map
+	void Check( ExternalDigestSort & sort, std::vector< Sha1 > const & digests, size_t minimumRuns )
+	{
+		std::map< Sha1, uint64_t >	expected;
+
+		for ( size_t i = 0; i < digests.size(); ++i )
+		{
+			++expected[ digests[i] ];
+		}
+
+		for ( size_t i = 0, n = 1; i < digests.size(); i += n, n = n * 3 % 97 + 1 )
+		{
+			CPPUNIT_ASSERT( sort.Add( &digests[i], std::min( n, digests.size() - i ) ) );
+		}
+
+		CPPUNIT_ASSERT( sort.Runs() >= minimumRuns );
+
+		std::vector< std::pair< Sha1, uint64_t > >	merged;
+
+		CPPUNIT_ASSERT( sort.Merge( [ &merged ]( uint8_t const * digest, uint64_t count )
+		{
+			Sha1	sha1;
+
+			memcpy( sha1.m_value, digest, Sha1::SIZE );
+			merged.push_back( std::make_pair( sha1, count ) );
+		} ) );
+
+		CPPUNIT_ASSERT_EQUAL( size_t( 0 ), sort.Runs() );
+		CPPUNIT_ASSERT_EQUAL( expected.size(), merged.size() );
+
+		std::map< Sha1, uint64_t >::const_iterator	e	= expected.begin();
+
+		for ( size_t i = 0; i < merged.size(); ++i, ++e )
+		{
+			CPPUNIT_ASSERT( merged[i].first == e->first );
+			CPPUNIT_ASSERT_EQUAL( e->second, merged[i].second );
+		}
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestSortTest::setUp()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestSortTest::tearDown()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestSortTest::TestRadixSort()
+{
+	std::vector< Sha1 >	digests		= Digests();
+	std::vector< Sha1 >	expected	= digests;
+
+	std::sort( expected.begin(), expected.end() );
+	RadixSort( digests.data(), digests.size() );
+
+	CPPUNIT_ASSERT( digests == expected );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Digests that fit in memory are sorted without writing any runs
+
+void DigestSortTest::TestInMemory()
+{
+	ExternalDigestSort	sort( Sha1::SIZE, ".", 2 * COUNT * Sha1::SIZE );
+
+	Check( sort, Digests(), 0 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A limit of 64 digests forces many runs, and digests that are added in the same batch as a spill end up in different
+// runs
+
+void DigestSortTest::TestSpilledRuns()
+{
+	ExternalDigestSort	sort( Sha1::SIZE, ".", 2 * 64 * Sha1::SIZE );
+
+	Check( sort, Digests(), COUNT / 64 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// After a merge, the sort is empty and can be used again
+
+void DigestSortTest::TestReuse()
+{
+	ExternalDigestSort	sort( Sha1::SIZE, ".", 2 * 100 * Sha1::SIZE );
+	std::vector< Sha1 >	digests	= Digests();
+
+	Check( sort, digests, COUNT / 100 - 1 );
+	digests.resize( 100 );
+	Check( sort, digests, 0 );
+}
@@ -0,0 +1,37 @@
+/********************************************************************************************************************
+
+                                                  DigestSortTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/DigestSortTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class DigestSortTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( DigestSortTest );
+	CPPUNIT_TEST( TestRadixSort );
+	CPPUNIT_TEST( TestInMemory );
+	CPPUNIT_TEST( TestSpilledRuns );
+	CPPUNIT_TEST( TestReuse );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestRadixSort();
+	void TestInMemory();
+	void TestSpilledRuns();
+	void TestReuse();
+};
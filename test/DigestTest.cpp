@@ -0,0 +1,264 @@
+/********************************************************************************************************************
+
+                                                    DigestTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/DigestTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "DigestTest.h"
+
+#include "../Crc32.h"
+#include "../Md5.h"
+#include "../Sha1.h"
+#include "../Sha256.h"
+
+#include "Misc/Random.h"
+#include "Misc/Etc.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( DigestTest );
+
+namespace
+{
+	static_assert( std::is_trivially_copyable< Crc32 >::value, "Crc32 is not trivially copyable." );
+	static_assert( std::is_trivially_copyable< Md5 >::value, "Md5 is not trivially copyable." );
+	static_assert( std::is_trivially_copyable< Sha1 >::value, "Sha1 is not trivially copyable." );
+	static_assert( std::is_trivially_copyable< Sha256 >::value, "Sha256 is not trivially copyable." );
+
+	// Returns a CRC-32 with the given value
+	constexpr Crc32 MakeCrc32( uint32_t value )
+	{
+		Crc32	crc32;
+
+		crc32.m_value = value;
+		return crc32;
+	}
+
+	static_assert( MakeCrc32( 1 ) < MakeCrc32( 2 ) && MakeCrc32( 2 ) != MakeCrc32( 1 ), "The Crc32 operators are not constexpr." );
+
+	int const	COUNT	= 1000;
+
+	// Returns the digests of COUNT random buffers
+	template< typename Digest >
+	std::vector< Digest > Digests()
+	{
+		std::vector< Digest >	digests;
+		Random					rng( 5 );
+
+		for ( int i = 0; i < COUNT; ++i )
+		{
+			uint8_t	buffer[ 16 ];
+
+			for ( int j = 0; j < (int)elementsof( buffer ); ++j )
+			{
+				buffer[j] = uint8_t( rng.Get() );
+			}
+			digests.push_back( Digest( buffer, sizeof( buffer ) ) );
+		}
+
+		return digests;
+	}
+
+	// Checks that sorting digests puts their text in order, and that equal digests are adjacent
+	template< typename Digest >
+	void CheckOrder()
+	{
+		std::vector< Digest >	digests	= Digests< Digest >();
+
+		digests.push_back( digests[ COUNT / 2 ] );
+		std::sort( digests.begin(), digests.end() );
+
+		for ( size_t i = 1; i < digests.size(); ++i )
+		{
+			CPPUNIT_ASSERT( digests[ i - 1 ].ToString() <= digests[i].ToString() );
+			CPPUNIT_ASSERT( ( digests[ i - 1 ] == digests[i] ) == ( digests[ i - 1 ].ToString() == digests[i].ToString() ) );
+		}
+	}
+
+	// Checks the six operators on a pair of digests whose order is known
+	template< typename Digest >
+	void CheckOperators( Digest const & x, Digest const & y )
+	{
+		CPPUNIT_ASSERT( x < y && !( y < x ) && !( x < x ) );
+		CPPUNIT_ASSERT( y > x && !( x > y ) && !( x > x ) );
+		CPPUNIT_ASSERT( x <= y && x <= x && !( y <= x ) );
+		CPPUNIT_ASSERT( y >= x && x >= x && !( x >= y ) );
+		CPPUNIT_ASSERT( x == x && !( x == y ) );
+		CPPUNIT_ASSERT( x != y && !( x != x ) );
+	}
+
+	// Checks that every digest can be found in hashed and ordered containers
+	template< typename Digest >
+	void CheckContainers()
+	{
+		std::vector< Digest > const		digests	= Digests< Digest >();
+		std::unordered_map< Digest, int >	hashed;
+		std::map< Digest, int >				ordered;
+		std::unordered_set< Digest >		set( digests.begin(), digests.end() );
+
+		for ( int i = 0; i < COUNT; ++i )
+		{
+			hashed[ digests[i] ] = i;
+			ordered[ digests[i] ] = i;
+		}
+
+		CPPUNIT_ASSERT_EQUAL( size_t( COUNT ), hashed.size() );
+		CPPUNIT_ASSERT_EQUAL( size_t( COUNT ), ordered.size() );
+		CPPUNIT_ASSERT_EQUAL( size_t( COUNT ), set.size() );
+
+		for ( int i = 0; i < COUNT; ++i )
+		{
+			CPPUNIT_ASSERT_EQUAL( i, hashed[ digests[i] ] );
+			CPPUNIT_ASSERT_EQUAL( i, ordered[ digests[i] ] );
+			CPPUNIT_ASSERT( set.count( digests[i] ) == 1 );
+		}
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestTest::setUp()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestTest::tearDown()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestTest::TestOrderMatchesText()
+{
+	CheckOrder< Crc32 >();
+	CheckOrder< Md5 >();
+	CheckOrder< Sha1 >();
+	CheckOrder< Sha256 >();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Digests that differ only in one byte are ordered by that byte, whether it is in a whole word or in the tail of a
+// SHA-1 digest
+
+void DigestTest::TestLastByte()
+{
+	for ( size_t i = 0; i < Sha1::SIZE; ++i )
+	{
+		Sha1	x;
+		Sha1	y;
+
+		y.m_value[i] = 1;
+		CheckOperators( x, y );
+
+		// A difference in a later byte does not outweigh one in an earlier byte
+
+		x.m_value[ Sha1::SIZE - 1 - i ] |= 2;
+		if ( Sha1::SIZE - 1 - i > i )
+			CheckOperators( x, y );
+		else if ( Sha1::SIZE - 1 - i < i )
+			CheckOperators( y, x );
+	}
+
+	for ( size_t i = 0; i < Sha256::SIZE; ++i )
+	{
+		Sha256	x;
+		Sha256	y;
+
+		x.m_value[i] = 0x7f;
+		y.m_value[i] = 0x80;
+		CheckOperators( x, y );
+	}
+
+	for ( int i = 0; i < Md5::SIZE; ++i )
+	{
+		Md5	x;
+		Md5	y;
+
+		y.m_digest[i] = 0xff;
+		CheckOperators( x, y );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestTest::TestOperators()
+{
+	CheckOperators( MakeCrc32( 0x0000ffff ), MakeCrc32( 0x00010000 ) );
+	CheckOperators( Md5( "00000000000000000000000000000001" ), Md5( "10000000000000000000000000000000" ) );
+	CheckOperators( Sha1( "ffffffffffffffffffffffffffffffffffffff00" ), Sha1( "ffffffffffffffffffffffffffffffffffffff01" ) );
+	CheckOperators( Sha256( "00000000000000000000000000000000000000000000000000000000000000ff" ),
+					Sha256( "0000000000000000000000000000000000000000000000000000000000000100" ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Equal digests have equal hashes, and the hashes of different digests are almost all different
+
+void DigestTest::TestHash()
+{
+	std::vector< Sha256 > const	digests	= Digests< Sha256 >();
+	std::set< size_t >			hashes;
+
+	for ( int i = 0; i < COUNT; ++i )
+	{
+		Sha256 const	copy	= digests[i];
+
+		CPPUNIT_ASSERT_EQUAL( std::hash< Sha256 >()( digests[i] ), std::hash< Sha256 >()( copy ) );
+		hashes.insert( std::hash< Sha256 >()( digests[i] ) );
+	}
+
+	CPPUNIT_ASSERT_EQUAL( size_t( COUNT ), hashes.size() );
+	CPPUNIT_ASSERT_EQUAL( std::hash< Crc32 >()( MakeCrc32( 0x12345678 ) ), std::hash< Crc32 >()( Crc32( "12345678" ) ) );
+	CPPUNIT_ASSERT( std::hash< Md5 >()( Md5( "00000000000000000000000000000000" ) ) !=
+					std::hash< Md5 >()( Md5( "01000000000000000000000000000000" ) ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DigestTest::TestContainers()
+{
+	CheckContainers< Crc32 >();
+	CheckContainers< Md5 >();
+	CheckContainers< Sha1 >();
+	CheckContainers< Sha256 >();
+}
@@ -0,0 +1,39 @@
+/********************************************************************************************************************
+
+                                                     DigestTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/DigestTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class DigestTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( DigestTest );
+	CPPUNIT_TEST( TestOrderMatchesText );
+	CPPUNIT_TEST( TestLastByte );
+	CPPUNIT_TEST( TestOperators );
+	CPPUNIT_TEST( TestHash );
+	CPPUNIT_TEST( TestContainers );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestOrderMatchesText();
+	void TestLastByte();
+	void TestOperators();
+	void TestHash();
+	void TestContainers();
+};
@@ -0,0 +1,240 @@
+/********************************************************************************************************************
+
+                                                    DrbgTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/DrbgTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "DrbgTest.h"
+
+#include "../Common.h"
+#include "../Drbg.h"
+#include "../KernelRegistry.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( DrbgTest );
+
+namespace
+{
+	// Returns the bytes of a hex string
+
+	std::vector< uint8_t > Bytes( std::string const & hex )
+	{
+		std::vector< uint8_t >	bytes( hex.size() / 2 );
+
+		HexToBinary( hex, bytes.data(), bytes.size() );
+
+		return bytes;
+	}
+
+	// Returns the bytes first, first + 1, ... last - 1
+
+	std::vector< uint8_t > Range( int first, int last )
+	{
+		std::vector< uint8_t >	bytes;
+
+		for ( int i = first; i < last; ++i )
+		{
+			bytes.push_back( uint8_t( i ) );
+		}
+
+		return bytes;
+	}
+
+	// The first SHA-256 test with no reseed, prediction resistance or additional input from each of the NIST CAVP
+	// response files Hash_DRBG.rsp and HMAC_DRBG.rsp (COUNT = 0). The generator is instantiated and then generates
+	// 1024 bits twice, and the second output is returned.
+
+	char const	CAVP_ENTROPY[][ 65 ]	=
+	{
+		"a65ad0f345db4e0effe875c3a2e71f42c7129d620ff5c119a9ef55f05185e0fb",
+		"ca851911349384bffe89de1cbdc46e6831e44d34a4fb935ee285dd14b71a7488",
+	};
+
+	char const	CAVP_NONCE[][ 33 ]		=
+	{
+		"8581f9317517276e06e9607ddbcbcc2e",
+		"659ba96c601dc69fc902940805ec0ca8",
+	};
+
+	char const	CAVP_RETURNED[][ 257 ]	=
+	{
+		"d3e160c35b99f340b2628264d1751060e0045da383ff57a57d73a673d2b8d80daaf6a6c35a91bb4579d73fd0c8fed111b0391306828adf"
+		"ed528f018121b3febdc343e797b87dbb63db1333ded9d1ece177cfa6b71fe8ab1da46624ed6415e51ccde2c7ca86e283990eeaeb911204"
+		"15528b2295910281b02dd431f4c9f70427df",
+		"e528e9abf2dece54d47c7e75e5fe302149f817ea9fb4bee6f4199697d04d5b89d54fbb978a15b5c443c9ec21036d2460b6f73ebad0dc2a"
+		"ba6e624abf07745bc107694bb7547bb0995f70de25d6b29e2d3011bb19d27676c07162c8b5ccde0668961df86803482cb37ed6d5c0bb8d"
+		"50cf1f50d476aa0458bdaba806f48be9dcb8",
+	};
+
+	// The outputs with a personalization string, a reseed with additional input and additional input for each request
+
+	char const	RESEED_RETURNED[][ 257 ]	=
+	{
+		"790b4568527bbe22fb8e5534d28ad9977d41945537bf3b75a87e098e375298475c15eff8eb89b0cb09c7b260f0b2e8add5d8714d659e33"
+		"3249dc5426d1be4631a1fba3a2f7262e80d43b1c1ff9d2cf5169d9d376089f65e1269015463d934758a28b529e86143817da0f06444a6d"
+		"d49d4f67f040048bf5681415633414713cf6",
+		"e7ac7f5503440e15dcfd4e564225f17100181b5ca84d2da16dbe958985e9a3f070999e45deadcdd01f126db2e04d7c327ec736137f7446"
+		"a1ef0cdfd04608ad845038a2e75ec63622702c8ee6018f3da8fd356ab4f7d01c337e6397f73eb0ee62fb44ac462efa6339be0496c8a7ce"
+		"4b1e2235e75445f2216cbb9116a5a82ba03e",
+	};
+
+	// Runs a test with each combination of the SHA-256 kernels, since Hash_DRBG hashes its blocks in the lanes of the
+	// x8 kernel only when the SHA extensions are not used
+
+	template< typename Test >
+	void WithEachKernel( Test const & test )
+	{
+		std::vector< std::string > const	singles	= KernelRegistry::Available( KernelRegistry::SHA256 );
+		std::vector< std::string > const	x8s		= KernelRegistry::Available( KernelRegistry::SHA256X8 );
+
+		for ( size_t s = 0; s < singles.size(); ++s )
+		{
+			for ( size_t x = 0; x < x8s.size(); ++x )
+			{
+				CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::SHA256, singles[s].c_str() ) );
+				CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::SHA256X8, x8s[x].c_str() ) );
+				test();
+			}
+		}
+	}
+
+	// Instantiates a generator, generates 1024 bits twice and returns the second output in hex
+
+	template< typename Drbg >
+	std::string Cavp( int i )
+	{
+		std::vector< uint8_t > const	entropy	= Bytes( CAVP_ENTROPY[i] );
+		std::vector< uint8_t > const	nonce	= Bytes( CAVP_NONCE[i] );
+		Drbg							drbg( entropy.data(), entropy.size(), nonce.data(), nonce.size() );
+		uint8_t							output[ 128 ];
+
+		CPPUNIT_ASSERT( drbg.Generate( output, sizeof( output ) ) );
+		CPPUNIT_ASSERT( drbg.Generate( output, sizeof( output ) ) );
+
+		return BinaryToHex( output, sizeof( output ) );
+	}
+
+	// Instantiates a generator with a personalization string, reseeds it with additional input and generates 1024
+	// bits twice with additional input. Returns the second output in hex.
+
+	template< typename Drbg >
+	std::string Reseed()
+	{
+		std::vector< uint8_t > const	entropy			= Range( 0, 32 );
+		std::vector< uint8_t > const	nonce			= Range( 32, 48 );
+		std::vector< uint8_t > const	personalization	= Range( 48, 80 );
+		std::vector< uint8_t > const	reseed			= Range( 80, 112 );
+		std::vector< uint8_t > const	additional		= Range( 112, 208 );
+		Drbg							drbg( entropy.data(), entropy.size(), nonce.data(), nonce.size(),
+											  personalization.data(), personalization.size() );
+		uint8_t							output[ 128 ];
+
+		drbg.Reseed( reseed.data(), reseed.size(), additional.data(), 32 );
+		CPPUNIT_ASSERT( drbg.Generate( output, sizeof( output ), additional.data() + 32, 32 ) );
+		CPPUNIT_ASSERT( drbg.Generate( output, sizeof( output ), additional.data() + 64, 32 ) );
+
+		return BinaryToHex( output, sizeof( output ) );
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DrbgTest::setUp()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DrbgTest::tearDown()
+{
+	KernelRegistry::Automatic( KernelRegistry::SHA256 );
+	KernelRegistry::Automatic( KernelRegistry::SHA256X8 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DrbgTest::TestHashDrbg()
+{
+	WithEachKernel( [] () { CPPUNIT_ASSERT_EQUAL( std::string( CAVP_RETURNED[0] ), Cavp< HashDrbg >( 0 ) ); } );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void DrbgTest::TestHmacDrbg()
+{
+	CPPUNIT_ASSERT_EQUAL( std::string( CAVP_RETURNED[1] ), Cavp< HmacDrbg >( 1 ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The expected outputs were computed with an independent implementation of SP 800-90A
+
+void DrbgTest::TestReseed()
+{
+	WithEachKernel( [] () { CPPUNIT_ASSERT_EQUAL( std::string( RESEED_RETURNED[0] ), Reseed< HashDrbg >() ); } );
+	CPPUNIT_ASSERT_EQUAL( std::string( RESEED_RETURNED[1] ), Reseed< HmacDrbg >() );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Filling the stream in pieces of any size gives the outputs of whole requests, and skipping part of it gives the rest
+
+void DrbgTest::TestStream()
+{
+	std::vector< uint8_t > const	entropy	= Range( 0, 32 );
+	size_t const					SIZE	= 2 * HashDrbg::MAX_REQUEST_SIZE + 100;
+	std::vector< uint8_t >			expected( SIZE );
+	std::vector< uint8_t >			actual( SIZE );
+
+	HashDrbg	requests( entropy.data(), entropy.size(), nullptr, 0 );
+
+	CPPUNIT_ASSERT( requests.Generate( expected.data(), HashDrbg::MAX_REQUEST_SIZE ) );
+	CPPUNIT_ASSERT( requests.Generate( expected.data() + HashDrbg::MAX_REQUEST_SIZE, HashDrbg::MAX_REQUEST_SIZE ) );
+	CPPUNIT_ASSERT( requests.Generate( expected.data() + 2 * HashDrbg::MAX_REQUEST_SIZE, 100 ) );
+
+	HashDrbg	stream( entropy.data(), entropy.size(), nullptr, 0 );
+
+	for ( size_t offset = 0, n = 1; offset < SIZE; offset += n, n = n * 3 + 7 )
+	{
+		n = std::min( n, SIZE - offset );
+		CPPUNIT_ASSERT( stream.Fill( actual.data() + offset, n ) );
+	}
+	CPPUNIT_ASSERT( actual == expected );
+
+	HashDrbg	skipped( entropy.data(), entropy.size(), nullptr, 0 );
+
+	CPPUNIT_ASSERT( skipped.Skip( HashDrbg::MAX_REQUEST_SIZE + 77 ) );
+	CPPUNIT_ASSERT( skipped.Fill( actual.data(), 200 ) );
+	CPPUNIT_ASSERT( std::equal( actual.begin(), actual.begin() + 200, expected.begin() + HashDrbg::MAX_REQUEST_SIZE + 77 ) );
+}
@@ -0,0 +1,37 @@
+/********************************************************************************************************************
+
+                                                     DrbgTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/DrbgTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class DrbgTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( DrbgTest );
+	CPPUNIT_TEST( TestHashDrbg );
+	CPPUNIT_TEST( TestHmacDrbg );
+	CPPUNIT_TEST( TestReseed );
+	CPPUNIT_TEST( TestStream );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestHashDrbg();
+	void TestHmacDrbg();
+	void TestReseed();
+	void TestStream();
+};
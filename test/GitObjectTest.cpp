@@ -0,0 +1,222 @@
+/********************************************************************************************************************
+
+                                                  GitObjectTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/GitObjectTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "GitObjectTest.h"
+
+#include "../Common.h"
+#include "../GitObject.h"
+#include "../KernelRegistry.h"
+
+#include "Misc/Random.h"
+#include "Misc/Etc.h"
+
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GitObjectTest );
+
+namespace
+{
+	// An object with its IDs in both formats, as computed by git hash-object
+
+	struct Vector
+	{
+		GitObject::Type		type;
+		std::string			contents;
+		char const *		sha1;
+		char const *		sha256;
+	};
+
+	// The contents of a tree with one entry, "100644 hello.txt", for the blob "hello\n" in a format
+	std::string HelloTree( GitObject::Format format )
+	{
+		uint8_t			id[ GitObject::MAX_DIGEST_SIZE ];
+		std::string		hello( "hello\n" );
+
+		GitObject::Hash( format, GitObject::BLOB, reinterpret_cast< uint8_t const * >( hello.data() ), hello.size(), id );
+
+		return std::string( "100644 hello.txt", 17 ) + std::string( reinterpret_cast< char * >( id ),
+																	 GitObject::DigestSize( format ) );
+	}
+
+	// Returns the ID of an object in hex
+	std::string Id( GitObject::Format format, GitObject::Type type, std::string const & contents )
+	{
+		uint8_t	id[ GitObject::MAX_DIGEST_SIZE ];
+
+		GitObject::Hash( format, type, reinterpret_cast< uint8_t const * >( contents.data() ), contents.size(), id );
+
+		return BinaryToHex( id, GitObject::DigestSize( format ) );
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void GitObjectTest::setUp()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void GitObjectTest::tearDown()
+{
+	KernelRegistry::Automatic( KernelRegistry::SHA1 );
+	KernelRegistry::Automatic( KernelRegistry::SHA256 );
+	KernelRegistry::Automatic( KernelRegistry::SHA1X8 );
+	KernelRegistry::Automatic( KernelRegistry::SHA256X8 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The IDs of the empty blob and tree, of a small blob, and of a tree holding that blob, in both object formats
+
+void GitObjectTest::TestKnownIds()
+{
+	Vector const	vectors[]	=
+	{
+		{ GitObject::BLOB, "",
+		  "e69de29bb2d1d6434b8b29ae775ad8c2e48c5391",
+		  "473a0f4c3be8a93681a267e3b1e9a7dcda1185436fe141f7749120a303721813" },
+		{ GitObject::BLOB, "hello\n",
+		  "ce013625030ba8dba906f756967f9e9ca394464a",
+		  "2cf8d83d9ee29543b34a87727421fdecb7e3f3a183d337639025de576db9ebb4" },
+		{ GitObject::TREE, "",
+		  "4b825dc642cb6eb9a060e54bf8d69288fbee4904",
+		  "6ef19b41225c5369f1c104d45d8d85efa9b057b53b14b4b9b939dd74decc5321" },
+	};
+
+	for ( size_t i = 0; i < elementsof( vectors ); ++i )
+	{
+		CPPUNIT_ASSERT_EQUAL( std::string( vectors[i].sha1 ), Id( GitObject::SHA1, vectors[i].type, vectors[i].contents ) );
+		CPPUNIT_ASSERT_EQUAL( std::string( vectors[i].sha256 ),
+							  Id( GitObject::SHA256, vectors[i].type, vectors[i].contents ) );
+	}
+
+	CPPUNIT_ASSERT_EQUAL( std::string( "aaa96ced2d9a1c8e72c56b253a0e2fe78393feb7" ),
+						  Id( GitObject::SHA1, GitObject::TREE, HelloTree( GitObject::SHA1 ) ) );
+	CPPUNIT_ASSERT_EQUAL( std::string( "c7187e8fdb691b3a692e5f3f0bbcb6359e5046285225f18f9773d4fe54268c55" ),
+						  Id( GitObject::SHA256, GitObject::TREE, HelloTree( GitObject::SHA256 ) ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// An object hashed in pieces has the same ID as one hashed at once, and Finalize() reports a size that does not match
+// the header
+
+void GitObjectTest::TestStreaming()
+{
+	std::string const	contents( 1000, 'x' );
+	uint8_t const *		data	= reinterpret_cast< uint8_t const * >( contents.data() );
+
+	for ( int f = 0; f < 2; ++f )
+	{
+		GitObject::Format const	format	= GitObject::Format( f );
+		GitObject				object( format, GitObject::COMMIT, contents.size() );
+		uint8_t					id[ GitObject::MAX_DIGEST_SIZE ];
+
+		object.Process( data, 3 );
+		object.Process( data + 3, 500 );
+		object.Process( data + 503, contents.size() - 503 );
+		CPPUNIT_ASSERT( object.Finalize( id ) );
+		CPPUNIT_ASSERT_EQUAL( Id( format, GitObject::COMMIT, contents ), BinaryToHex( id, GitObject::DigestSize( format ) ) );
+
+		GitObject	shorter( format, GitObject::COMMIT, contents.size() );
+
+		shorter.Process( data, contents.size() - 1 );
+		CPPUNIT_ASSERT( !shorter.Finalize( id ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Batches of objects of sizes around the block boundaries give the same IDs as hashing them one at a time, with each
+// combination of the single-message and x8 kernels and batches of each size up to 20, so the lanes are filled, refilled
+// and drained
+
+void GitObjectTest::TestBatch()
+{
+	size_t const					COUNT		= 20;
+	KernelRegistry::Algorithm const	SINGLES[]	= { KernelRegistry::SHA1, KernelRegistry::SHA256 };
+	KernelRegistry::Algorithm const	LANES[]		= { KernelRegistry::SHA1X8, KernelRegistry::SHA256X8 };
+	std::vector< std::string >		contents( COUNT );
+	Random							rng( 3 );
+
+	for ( size_t i = 0; i < COUNT; ++i )
+	{
+		size_t const	size	= ( i < 8 ) ? 47 + i * 2 : rng.Get() % 1000;
+
+		for ( size_t j = 0; j < size; ++j )
+		{
+			contents[i].push_back( char( rng.Get() ) );
+		}
+	}
+
+	for ( int f = 0; f < 2; ++f )
+	{
+		GitObject::Format const				format	= GitObject::Format( f );
+		std::vector< std::string > const	singles	= KernelRegistry::Available( SINGLES[f] );
+		std::vector< std::string > const	x8s		= KernelRegistry::Available( LANES[f] );
+		std::vector< std::string >			expected;
+
+		for ( size_t i = 0; i < COUNT; ++i )
+		{
+			expected.push_back( Id( format, GitObject::Type( i % 4 ), contents[i] ) );
+		}
+
+		for ( size_t s = 0; s < singles.size(); ++s )
+		{
+			for ( size_t x = 0; x < x8s.size(); ++x )
+			{
+				CPPUNIT_ASSERT( KernelRegistry::Force( SINGLES[f], singles[s].c_str() ) );
+				CPPUNIT_ASSERT( KernelRegistry::Force( LANES[f], x8s[x].c_str() ) );
+
+				for ( size_t count = 0; count <= COUNT; ++count )
+				{
+					std::vector< GitObject::Object >	objects( count );
+					std::vector< uint8_t >				ids( count * GitObject::MAX_DIGEST_SIZE );
+
+					for ( size_t i = 0; i < count; ++i )
+					{
+						objects[i] = { GitObject::Type( i % 4 ), reinterpret_cast< uint8_t const * >( contents[i].data() ),
+									   contents[i].size(), &ids[ i * GitObject::MAX_DIGEST_SIZE ] };
+					}
+
+					GitObject::HashBatch( format, objects.data(), count );
+
+					for ( size_t i = 0; i < count; ++i )
+					{
+						CPPUNIT_ASSERT_EQUAL( expected[i], BinaryToHex( objects[i].digest, GitObject::DigestSize( format ) ) );
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,35 @@
+/********************************************************************************************************************
+
+                                                   GitObjectTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/GitObjectTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class GitObjectTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( GitObjectTest );
+	CPPUNIT_TEST( TestKnownIds );
+	CPPUNIT_TEST( TestStreaming );
+	CPPUNIT_TEST( TestBatch );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestKnownIds();
+	void TestStreaming();
+	void TestBatch();
+};
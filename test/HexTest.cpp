@@ -0,0 +1,245 @@
+/********************************************************************************************************************
+
+                                                     HexTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/HexTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "HexTest.h"
+
+#include "../Common.h"
+#include "../Crc32.h"
+#include "../KernelRegistry.h"
+#include "../Md5.h"
+#include "../Sha1.h"
+#include "../Sha256.h"
+
+#include "Misc/Random.h"
+#include "Misc/Etc.h"
+
+#include <cstring>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( HexTest );
+
+namespace
+{
+	char const	ABC[]				= "abc";
+
+	char const	CRC32_ABC[]			= "352441c2";
+	char const	MD5_ABC[]			= "900150983cd24fb0d6963f7d28e17f72";
+	char const	SHA1_ABC[]			= "a9993e364706816aba3e25717850c26c9cd0d89d";
+	char const	SHA256_ABC[]		= "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+	char const	SHA256_ABC_UPPER[]	= "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD";
+
+	// Characters that are next to the ranges of hex digits, and others that are not digits
+	char const	INVALID[]			= "/:@G`g \n\x80\xff";
+
+	// Formats a value with ToChars() into a buffer of exactly the right size
+	template< typename Digest >
+	std::string Format( Digest const & digest )
+	{
+		char	text[ Digest::TEXT_SIZE ];
+
+		std::to_chars_result const	result	= digest.ToChars( text, text + sizeof( text ) );
+
+		CPPUNIT_ASSERT( result.ec == std::errc() && result.ptr == text + sizeof( text ) );
+		return std::string( text, sizeof( text ) );
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HexTest::setUp()
+{
+	m_kernels = KernelRegistry::Available( KernelRegistry::HEX );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HexTest::tearDown()
+{
+	KernelRegistry::Automatic( KernelRegistry::HEX );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HexTest::TestToChars()
+{
+	uint8_t const * const	data	= reinterpret_cast< uint8_t const * >( ABC );
+
+	for ( size_t k = 0; k < m_kernels.size(); ++k )
+	{
+		CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::HEX, m_kernels[k].c_str() ) );
+
+		CPPUNIT_ASSERT_EQUAL( std::string( CRC32_ABC ), Format( Crc32( data, 3 ) ) );
+		CPPUNIT_ASSERT_EQUAL( std::string( MD5_ABC ), Format( Md5( data, 3 ) ) );
+		CPPUNIT_ASSERT_EQUAL( std::string( SHA1_ABC ), Format( Sha1( data, 3 ) ) );
+		CPPUNIT_ASSERT_EQUAL( std::string( SHA256_ABC ), Format( Sha256( data, 3 ) ) );
+		CPPUNIT_ASSERT_EQUAL( std::string( SHA256_ABC ), Sha256( data, 3 ).ToString() );
+
+		// A buffer that is one character too small is not written
+
+		char					text[ Sha256::TEXT_SIZE ];
+		std::to_chars_result	result;
+
+		memset( text, '*', sizeof( text ) );
+		result = Sha256( data, 3 ).ToChars( text, text + sizeof( text ) - 1 );
+		CPPUNIT_ASSERT( result.ec == std::errc::value_too_large );
+		CPPUNIT_ASSERT( result.ptr == text + sizeof( text ) - 1 );
+		CPPUNIT_ASSERT_EQUAL( std::string( sizeof( text ), '*' ), std::string( text, sizeof( text ) ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HexTest::TestFromChars()
+{
+	Sha256 const	expected	= Sha256( reinterpret_cast< uint8_t const * >( ABC ), 3 );
+
+	for ( size_t k = 0; k < m_kernels.size(); ++k )
+	{
+		CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::HEX, m_kernels[k].c_str() ) );
+
+		char const * const	texts[]	= { SHA256_ABC, SHA256_ABC_UPPER };
+
+		for ( int i = 0; i < (int)elementsof( texts ); ++i )
+		{
+			Sha256							value;
+			char const * const				last	= texts[i] + strlen( texts[i] );
+			std::from_chars_result const	result	= Sha256::FromChars( texts[i], last, value );
+
+			CPPUNIT_ASSERT( result.ec == std::errc() && result.ptr == last );
+			CPPUNIT_ASSERT( value == expected );
+		}
+
+		// Only TEXT_SIZE digits are parsed
+
+		std::string const		longer	= std::string( SHA256_ABC ) + "00";
+		Sha256					value;
+		std::from_chars_result	result	= Sha256::FromChars( longer.data(), longer.data() + longer.size(), value );
+
+		CPPUNIT_ASSERT( result.ec == std::errc() && result.ptr == longer.data() + Sha256::TEXT_SIZE );
+		CPPUNIT_ASSERT( value == expected );
+
+		Crc32	crc32;
+		Md5		md5;
+		Sha1	sha1;
+
+		CPPUNIT_ASSERT( Crc32::FromChars( CRC32_ABC, CRC32_ABC + strlen( CRC32_ABC ), crc32 ).ec == std::errc() );
+		CPPUNIT_ASSERT( Md5::FromChars( MD5_ABC, MD5_ABC + strlen( MD5_ABC ), md5 ).ec == std::errc() );
+		CPPUNIT_ASSERT( Sha1::FromChars( SHA1_ABC, SHA1_ABC + strlen( SHA1_ABC ), sha1 ).ec == std::errc() );
+		CPPUNIT_ASSERT_EQUAL( std::string( CRC32_ABC ), crc32.ToString() );
+		CPPUNIT_ASSERT_EQUAL( std::string( MD5_ABC ), md5.ToString() );
+		CPPUNIT_ASSERT_EQUAL( std::string( SHA1_ABC ), sha1.ToString() );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Text that is too short or has a character that is not a hex digit is rejected, and the value is not changed
+
+void HexTest::TestInvalid()
+{
+	Sha256 const	original	= Sha256( reinterpret_cast< uint8_t const * >( "x" ), 1 );
+
+	for ( size_t k = 0; k < m_kernels.size(); ++k )
+	{
+		CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::HEX, m_kernels[k].c_str() ) );
+
+		for ( size_t i = 0; i < Sha256::TEXT_SIZE; ++i )
+		{
+			for ( char const * c = INVALID; *c != 0; ++c )
+			{
+				char	text[ Sha256::TEXT_SIZE ];
+
+				memcpy( text, SHA256_ABC, sizeof( text ) );
+				text[i] = *c;
+
+				Sha256							value	= original;
+				std::from_chars_result const	result	= Sha256::FromChars( text, text + sizeof( text ), value );
+
+				CPPUNIT_ASSERT( result.ec == std::errc::invalid_argument );
+				CPPUNIT_ASSERT( result.ptr == text );
+				CPPUNIT_ASSERT( value == original );
+			}
+		}
+
+		Sha256					value	= original;
+		std::from_chars_result	result	= Sha256::FromChars( SHA256_ABC, SHA256_ABC + Sha256::TEXT_SIZE - 1, value );
+
+		CPPUNIT_ASSERT( result.ec == std::errc::invalid_argument && result.ptr == SHA256_ABC );
+		CPPUNIT_ASSERT( value == original );
+
+		uint8_t	buffer[ 4 ];
+
+		CPPUNIT_ASSERT( !HexToBinary( "123456789", buffer, sizeof( buffer ) ) );
+		CPPUNIT_ASSERT( !HexToBinary( "1234567g", buffer, sizeof( buffer ) ) );
+		CPPUNIT_ASSERT( !HexToBinary( "g", buffer, sizeof( buffer ) ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Each kernel converts buffers of every length up to a few of its widest blocks, so its tails are tested too
+
+void HexTest::TestLengths()
+{
+	char const	DIGITS[]	= "0123456789abcdef";
+	uint8_t		data[ 200 ];
+	Random		rng( 1 );
+
+	for ( int i = 0; i < (int)elementsof( data ); ++i )
+	{
+		data[i] = uint8_t( rng.Get() );
+	}
+
+	for ( size_t k = 0; k < m_kernels.size(); ++k )
+	{
+		CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::HEX, m_kernels[k].c_str() ) );
+
+		for ( size_t size = 0; size <= sizeof( data ); ++size )
+		{
+			std::string	expected;
+
+			for ( size_t i = 0; i < size; ++i )
+			{
+				expected += DIGITS[ data[i] >> 4 ];
+				expected += DIGITS[ data[i] & 0xf ];
+			}
+
+			std::string const	text	= BinaryToHex( data, size );
+			uint8_t				decoded[ sizeof( data ) ];
+
+			CPPUNIT_ASSERT_EQUAL_MESSAGE( m_kernels[k], expected, text );
+			CPPUNIT_ASSERT_MESSAGE( m_kernels[k], HexToBinary( text, decoded, size ) );
+			CPPUNIT_ASSERT_MESSAGE( m_kernels[k], memcmp( decoded, data, size ) == 0 );
+		}
+	}
+}
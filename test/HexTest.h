@@ -0,0 +1,44 @@
+/********************************************************************************************************************
+
+                                                      HexTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/HexTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+#include <string>
+#include <vector>
+
+class HexTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( HexTest );
+	CPPUNIT_TEST( TestToChars );
+	CPPUNIT_TEST( TestFromChars );
+	CPPUNIT_TEST( TestInvalid );
+	CPPUNIT_TEST( TestLengths );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestToChars();
+	void TestFromChars();
+	void TestInvalid();
+	void TestLengths();
+
+private:
+
+	std::vector< std::string >	m_kernels;	// Names of the available hex kernels
+};
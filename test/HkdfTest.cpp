@@ -0,0 +1,145 @@
+/********************************************************************************************************************
+
+                                                    HkdfTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/HkdfTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "HkdfTest.h"
+
+#include "../Common.h"
+#include "../Hkdf.h"
+#include "Misc/Etc.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( HkdfTest );
+
+namespace
+{
+	// Returns the bytes first, first + 1, ... last - 1
+
+	std::vector< uint8_t > Range( int first, int last )
+	{
+		std::vector< uint8_t >	bytes;
+
+		for ( int i = first; i < last; ++i )
+		{
+			bytes.push_back( uint8_t( i ) );
+		}
+
+		return bytes;
+	}
+
+	// A test case of RFC 5869
+
+	struct Case
+	{
+		std::vector< uint8_t >	ikm;
+		std::vector< uint8_t >	salt;
+		std::vector< uint8_t >	info;
+		char const *			prk;
+		char const *			okm;
+	};
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HkdfTest::setUp()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HkdfTest::tearDown()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Test cases 1 to 3 of RFC 5869 (SHA-256): a basic one, one with long inputs and one with an empty salt and info
+
+void HkdfTest::TestRfc5869()
+{
+	Case const	CASES[]	=
+	{
+		{
+			std::vector< uint8_t >( 22, 0x0b ), Range( 0x00, 0x0d ), Range( 0xf0, 0xfa ),
+			"077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5",
+			"3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf34007208d5b887185865"
+		},
+		{
+			Range( 0x00, 0x50 ), Range( 0x60, 0xb0 ), Range( 0xb0, 0x100 ),
+			"06a6b88c5853361a06104c9ceb35b45cef760014904671014a193f40c15fc244",
+			"b11e398dc80327a1c8e7f78c596a49344f012eda2d4efad8a050cc4c19afa97c59045a99cac7827271cb41c65e590e09da3275600c2f"
+			"09b8367793a9aca3db71cc30c58179ec3e87c14c01d5c1f3434f1d87"
+		},
+		{
+			std::vector< uint8_t >( 22, 0x0b ), std::vector< uint8_t >(), std::vector< uint8_t >(),
+			"19ef24a32c717b167f33a91d6f648bdf96596776afdb6377ac434c1c293ccb04",
+			"8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d9d201395faa4b61a96c8"
+		},
+	};
+
+	for ( size_t i = 0; i < elementsof( CASES ); ++i )
+	{
+		Case const &			c	= CASES[i];
+		HkdfSha256 const		hkdf( c.salt.data(), c.salt.size(), c.ikm.data(), c.ikm.size() );
+		std::vector< uint8_t >	okm( strlen( c.okm ) / 2 );
+
+		CPPUNIT_ASSERT_EQUAL( std::string( c.prk ), BinaryToHex( hkdf.Prk(), HkdfSha256::DIGEST_SIZE ) );
+		CPPUNIT_ASSERT( hkdf.Expand( c.info.data(), c.info.size(), okm.data(), okm.size() ) );
+		CPPUNIT_ASSERT_EQUAL( std::string( c.okm ), BinaryToHex( okm.data(), okm.size() ) );
+
+		std::fill( okm.begin(), okm.end(), 0 );
+		CPPUNIT_ASSERT( HkdfSha256::Derive( c.salt.data(), c.salt.size(), c.ikm.data(), c.ikm.size(), c.info.data(),
+											c.info.size(), okm.data(), okm.size() ) );
+		CPPUNIT_ASSERT_EQUAL( std::string( c.okm ), BinaryToHex( okm.data(), okm.size() ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A shorter key is a prefix of a longer one, and a key longer than MAX_SIZE is refused
+
+void HkdfTest::TestExpand()
+{
+	std::vector< uint8_t > const	ikm		= Range( 0, 40 );
+	HkdfSha256 const				hkdf( nullptr, 0, ikm.data(), ikm.size() );
+	std::vector< uint8_t >			longest( HkdfSha256::MAX_SIZE );
+	std::vector< uint8_t >			key( HkdfSha256::MAX_SIZE + 1 );
+
+	CPPUNIT_ASSERT( hkdf.Expand( nullptr, 0, longest.data(), longest.size() ) );
+
+	for ( size_t size = 1; size < 100; size += 7 )
+	{
+		CPPUNIT_ASSERT( hkdf.Expand( nullptr, 0, key.data(), size ) );
+		CPPUNIT_ASSERT( std::equal( key.begin(), key.begin() + size, longest.begin() ) );
+	}
+
+	CPPUNIT_ASSERT( !hkdf.Expand( nullptr, 0, key.data(), key.size() ) );
+}
@@ -0,0 +1,33 @@
+/********************************************************************************************************************
+
+                                                     HkdfTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/HkdfTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class HkdfTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( HkdfTest );
+	CPPUNIT_TEST( TestRfc5869 );
+	CPPUNIT_TEST( TestExpand );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestRfc5869();
+	void TestExpand();
+};
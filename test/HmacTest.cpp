@@ -0,0 +1,297 @@
+/********************************************************************************************************************
+
+                                                     HmacTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/HmacTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "HmacTest.h"
+
+#include "../Hmac.h"
+#include "../KernelRegistry.h"
+#include "Misc/Etc.h"
+#include "Misc/Random.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( HmacTest );
+
+namespace
+{
+	// Returns the MAC of a message as text
+
+	template< typename Calculator >
+	std::string Mac( std::string const & key, std::string const & message )
+	{
+		Hmac< Calculator > const	hmac( reinterpret_cast< uint8_t const * >( key.data() ), key.size() );
+		uint8_t						mac[ Hmac< Calculator >::DIGEST_SIZE ];
+		char						text[ 2 * Hmac< Calculator >::DIGEST_SIZE + 1 ];
+
+		hmac.Calculate( reinterpret_cast< uint8_t const * >( message.data() ), message.size(), mac );
+
+		for ( int i = 0; i < Hmac< Calculator >::DIGEST_SIZE; ++i )
+		{
+			snprintf( text + 2 * i, 3, "%02x", mac[i] );
+		}
+
+		return text;
+	}
+
+	// Verifies a batch of messages of many sizes, some of which have bad MACs, with every available kernel. The batch
+	// is long enough to fill the lanes several times over and to span more than one word of failures.
+
+	template< typename Calculator >
+	void CheckBatch( KernelRegistry::Algorithm algorithm, size_t keySize, size_t macSize )
+	{
+		typedef Hmac< Calculator >	Mac;
+
+		size_t const					COUNT	= 150;
+		Random							rng( uint32_t( keySize + macSize ) );
+		std::vector< uint8_t >			key( keySize );
+		std::vector< uint8_t >			data( 300 );
+		std::vector< uint8_t const * >	messages( COUNT );
+		std::vector< size_t >			sizes( COUNT );
+		std::vector< uint8_t >			macs( COUNT * Mac::DIGEST_SIZE );
+		std::vector< uint8_t const * >	pointers( COUNT );
+		std::vector< uint64_t >			failures( ( COUNT + 63 ) / 64 );
+		std::vector< uint64_t >			expected( ( COUNT + 63 ) / 64 );
+		std::vector< std::string > const	kernels	= KernelRegistry::Available( algorithm );
+
+		for ( size_t i = 0; i < key.size(); ++i )
+		{
+			key[i] = uint8_t( rng.Get() );
+		}
+
+		for ( size_t i = 0; i < data.size(); ++i )
+		{
+			data[i] = uint8_t( rng.Get() );
+		}
+
+		Mac const	reference( key.data(), key.size() );
+
+		for ( size_t i = 0; i < COUNT; ++i )
+		{
+			messages[i]	= data.data() + rng.Get() % 16;
+			sizes[i]	= ( i * 37 ) % ( data.size() - 16 );
+			pointers[i]	= macs.data() + i * Mac::DIGEST_SIZE;
+			reference.Calculate( messages[i], sizes[i], macs.data() + i * Mac::DIGEST_SIZE );
+
+			// Every fifth MAC is bad in a byte that is checked, and every seventh in a byte that is not
+
+			if ( i % 5 == 0 )
+			{
+				macs[ i * Mac::DIGEST_SIZE + i % macSize ] ^= 0x10;
+				expected[ i / 64 ] |= uint64_t( 1 ) << ( i % 64 );
+			}
+			else if ( i % 7 == 0 && macSize < size_t( Mac::DIGEST_SIZE ) )
+			{
+				macs[ i * Mac::DIGEST_SIZE + macSize ] ^= 0x10;
+			}
+		}
+
+		for ( size_t k = 0; k < kernels.size(); ++k )
+		{
+			CPPUNIT_ASSERT( KernelRegistry::Force( algorithm, kernels[k].c_str() ) );
+
+			Mac const	hmac( key.data(), key.size() );
+
+			CPPUNIT_ASSERT_EQUAL( size_t( ( COUNT + 4 ) / 5 ),
+								  hmac.VerifyBatch( messages.data(), sizes.data(), COUNT, pointers.data(), failures.data(),
+													macSize ) );
+			CPPUNIT_ASSERT( failures == expected );
+
+			// Fewer messages than there are lanes
+
+			CPPUNIT_ASSERT_EQUAL( size_t( 1 ),
+								  hmac.VerifyBatch( messages.data() + 1, sizes.data() + 1, 5, pointers.data() + 1,
+													failures.data(), macSize ) );
+			CPPUNIT_ASSERT_EQUAL( uint64_t( 1 ) << 4, failures[0] );
+		}
+
+		KernelRegistry::Automatic( algorithm );
+	}
+
+	std::string const	JEFE	= "Jefe";
+	std::string const	NOTHING	= "what do ya want for nothing?";
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HmacTest::setUp()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HmacTest::tearDown()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Test cases 1, 2 and 6 from RFC 4231. The key in case 6 is longer than a block, so it is hashed.
+
+void HmacTest::TestSha256()
+{
+	CPPUNIT_ASSERT_EQUAL( std::string( "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7" ),
+						  Mac< Sha256Calculator >( std::string( 20, '\x0b' ), "Hi There" ) );
+	CPPUNIT_ASSERT_EQUAL( std::string( "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843" ),
+						  Mac< Sha256Calculator >( JEFE, NOTHING ) );
+	CPPUNIT_ASSERT_EQUAL( std::string( "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54" ),
+						  Mac< Sha256Calculator >( std::string( 131, '\xaa' ),
+												   "Test Using Larger Than Block-Size Key - Hash Key First" ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Test case 2 from RFC 2202
+
+void HmacTest::TestSha1AndMd5()
+{
+	CPPUNIT_ASSERT_EQUAL( std::string( "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79" ), Mac< Sha1Calculator >( JEFE, NOTHING ) );
+	CPPUNIT_ASSERT_EQUAL( std::string( "750c783e6ab0b503eaa86e310a5db738" ), Mac< Md5Calculator >( JEFE, NOTHING ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HmacTest::TestSteps()
+{
+	HmacSha256	hmac( reinterpret_cast< uint8_t const * >( JEFE.data() ), JEFE.size() );
+	uint8_t		expected[ HmacSha256::DIGEST_SIZE ];
+	uint8_t		actual[ HmacSha256::DIGEST_SIZE ];
+
+	hmac.Calculate( reinterpret_cast< uint8_t const * >( NOTHING.data() ), NOTHING.size(), expected );
+
+	// Finalize() restarts the computation, so the same MAC is computed twice
+
+	for ( int pass = 0; pass < 2; ++pass )
+	{
+		for ( size_t i = 0; i < NOTHING.size(); i += 5 )
+		{
+			hmac.Process( reinterpret_cast< uint8_t const * >( NOTHING.data() ) + i, std::min( size_t( 5 ), NOTHING.size() - i ) );
+		}
+
+		hmac.Finalize( actual );
+		CPPUNIT_ASSERT( memcmp( expected, actual, sizeof( actual ) ) == 0 );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HmacTest::TestVerify()
+{
+	HmacSha256 const	hmac( reinterpret_cast< uint8_t const * >( JEFE.data() ), JEFE.size() );
+	uint8_t const *		messages[ 100 ];
+	size_t				sizes[ 100 ];
+	uint8_t				macs[ 100 ][ HmacSha256::DIGEST_SIZE ];
+	uint8_t const *		pointers[ 100 ];
+	uint64_t			failures[ 2 ];
+
+	for ( int i = 0; i < 100; ++i )
+	{
+		messages[i]	= reinterpret_cast< uint8_t const * >( NOTHING.data() );
+		sizes[i]	= i % NOTHING.size();
+		pointers[i]	= macs[i];
+		hmac.Calculate( messages[i], sizes[i], macs[i] );
+	}
+
+	CPPUNIT_ASSERT( hmac.Verify( messages[10], sizes[10], macs[10] ) );
+	CPPUNIT_ASSERT( hmac.Verify( messages[10], sizes[10], macs[10], 16 ) );
+	CPPUNIT_ASSERT( !hmac.Verify( messages[10], sizes[10], macs[11] ) );
+	CPPUNIT_ASSERT( !hmac.Verify( messages[10], sizes[10], macs[10], 0 ) );
+
+	macs[3][0] ^= 1;
+	macs[70][31] ^= 1;
+
+	CPPUNIT_ASSERT_EQUAL( size_t( 2 ), hmac.VerifyBatch( messages, sizes, 100, pointers, failures ) );
+	CPPUNIT_ASSERT_EQUAL( uint64_t( 1 ) << 3, failures[0] );
+	CPPUNIT_ASSERT_EQUAL( uint64_t( 1 ) << 6, failures[1] );
+
+	// A MAC of an invalid size fails
+
+	CPPUNIT_ASSERT_EQUAL( size_t( 100 ), hmac.VerifyBatch( messages, sizes, 100, pointers, failures, 0 ) );
+	CPPUNIT_ASSERT_EQUAL( ~uint64_t( 0 ), failures[0] );
+	CPPUNIT_ASSERT_EQUAL( size_t( 100 ),
+						  hmac.VerifyBatch( messages, sizes, 100, pointers, failures, HmacSha256::DIGEST_SIZE + 1 ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The batch is checked with each kernel, which exercises the lanes of the multi-buffer kernels where the processor
+// has them, and with full and truncated MACs and keys shorter and longer than a block
+
+void HmacTest::TestVerifyBatch()
+{
+	size_t const	KEY_SIZES[]	= { 4, 100 };
+
+	for ( size_t i = 0; i < elementsof( KEY_SIZES ); ++i )
+	{
+		CheckBatch< Sha256Calculator >( KernelRegistry::SHA256, KEY_SIZES[i], HmacSha256::DIGEST_SIZE );
+		CheckBatch< Sha256Calculator >( KernelRegistry::SHA256, KEY_SIZES[i], 16 );
+		CheckBatch< Sha1Calculator >( KernelRegistry::SHA1, KEY_SIZES[i], HmacSha1::DIGEST_SIZE );
+		CheckBatch< Sha1Calculator >( KernelRegistry::SHA1, KEY_SIZES[i], 10 );
+		CheckBatch< Md5Calculator >( KernelRegistry::MD5, KEY_SIZES[i], HmacMd5::DIGEST_SIZE );
+		CheckBatch< Md5Calculator >( KernelRegistry::MD5, KEY_SIZES[i], 12 );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void HmacTest::TestCache()
+{
+	HmacCache< Sha256Calculator >	cache( 2 );
+	std::string const				keys[]	= { "one", "two", "three" };
+
+	for ( int i = 0; i < 30; ++i )
+	{
+		std::string const &	key	= keys[ ( i * 7 ) % 3 ];
+		uint8_t				expected[ HmacSha256::DIGEST_SIZE ];
+		uint8_t				actual[ HmacSha256::DIGEST_SIZE ];
+
+		HmacSha256( reinterpret_cast< uint8_t const * >( key.data() ), key.size() ).Calculate( nullptr, 0, expected );
+		cache.Get( reinterpret_cast< uint8_t const * >( key.data() ), key.size() ).Calculate( nullptr, 0, actual );
+
+		CPPUNIT_ASSERT( memcmp( expected, actual, sizeof( actual ) ) == 0 );
+		CPPUNIT_ASSERT( cache.Size() <= 2 );
+	}
+
+	cache.Clear();
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), cache.Size() );
+}
@@ -0,0 +1,41 @@
+/********************************************************************************************************************
+
+                                                      HmacTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/HmacTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class HmacTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( HmacTest );
+	CPPUNIT_TEST( TestSha256 );
+	CPPUNIT_TEST( TestSha1AndMd5 );
+	CPPUNIT_TEST( TestSteps );
+	CPPUNIT_TEST( TestVerify );
+	CPPUNIT_TEST( TestVerifyBatch );
+	CPPUNIT_TEST( TestCache );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestSha256();
+	void TestSha1AndMd5();
+	void TestSteps();
+	void TestVerify();
+	void TestVerifyBatch();
+	void TestCache();
+};
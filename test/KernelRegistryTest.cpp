@@ -0,0 +1,273 @@
+/********************************************************************************************************************
+
+                                                KernelRegistryTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/KernelRegistryTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "KernelRegistryTest.h"
+
+#include "../Base64.h"
+#include "../Common.h"
+#include "../Crc32.h"
+#include "../Md5.h"
+#include "../Pbkdf2.h"
+#include "../Scrypt.h"
+#include "../Sha1.h"
+#include "../Sha256.h"
+
+#include "Misc/Random.h"
+#include "Misc/Etc.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( KernelRegistryTest );
+
+namespace
+{
+	unsigned char	testbuffer[ 10000 ];
+
+	// Sets an environment variable, or removes it if the value is nullptr
+
+	void SetEnvironment( char const * name, char const * value )
+	{
+#if defined( _WIN32 )
+		CPPUNIT_ASSERT( _putenv_s( name, ( value != nullptr ) ? value : "" ) == 0 );
+#else
+		CPPUNIT_ASSERT( ( ( value != nullptr ) ? setenv( name, value, 1 ) : unsetenv( name ) ) == 0 );
+#endif
+	}
+
+	// Derives eight keys from parts of a buffer in one batch, which runs them in the lanes of the x8 kernels if they
+	// are used
+
+	std::string DeriveBatch( Pbkdf2::Hash hash, unsigned char const * buffer, size_t size )
+	{
+		Pbkdf2::Request	requests[ 8 ];
+		uint8_t			keys[ 8 ][ 32 ];
+
+		for ( size_t i = 0; i < 8; ++i )
+		{
+			requests[i] = { buffer + size * i / 8, size / 8, buffer, size % 17, keys[i], sizeof( keys[i] ) };
+		}
+
+		Pbkdf2::DeriveBatch( hash, requests, 8, 2 );
+
+		return BinaryToHex( keys[0], sizeof( keys ) );
+	}
+
+	// Derives a scrypt key from a buffer, with the first bytes as the salt
+
+	std::string DeriveScrypt( unsigned char const * buffer, size_t size )
+	{
+		Scrypt	scrypt;
+		uint8_t	key[ 32 ];
+
+		scrypt.Derive( buffer, size, buffer, size % 17, 16, 2, 2, key, sizeof( key ) );
+
+		return BinaryToHex( key, sizeof( key ) );
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void KernelRegistryTest::setUp()
+{
+	Random	rng( 0 );
+
+	for ( int i = 0; i < (int)elementsof( testbuffer ); ++i )
+	{
+		testbuffer[i] = rng.Get();
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void KernelRegistryTest::tearDown()
+{
+	for ( int a = 0; a < KernelRegistry::NUMBER_OF_ALGORITHMS; ++a )
+	{
+		KernelRegistry::Automatic( KernelRegistry::Algorithm( a ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void KernelRegistryTest::TestActiveIsAvailable()
+{
+	for ( int a = 0; a < KernelRegistry::NUMBER_OF_ALGORITHMS; ++a )
+	{
+		KernelRegistry::Algorithm const	algorithm	= KernelRegistry::Algorithm( a );
+		std::vector< std::string > const	available	= KernelRegistry::Available( algorithm );
+
+		std::ostringstream	message;
+		message << "The active " << KernelRegistry::Name( algorithm ) << " kernel is not in the list of available kernels.";
+
+		CPPUNIT_ASSERT_MESSAGE( message.str(), std::find( available.begin(), available.end(), KernelRegistry::Active( algorithm ) ) != available.end() );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void KernelRegistryTest::TestForce()
+{
+	for ( int a = 0; a < KernelRegistry::NUMBER_OF_ALGORITHMS; ++a )
+	{
+		KernelRegistry::Algorithm const	algorithm	= KernelRegistry::Algorithm( a );
+		std::vector< std::string > const	available	= KernelRegistry::Available( algorithm );
+
+		for ( size_t i = 0; i < available.size(); ++i )
+		{
+			CPPUNIT_ASSERT( KernelRegistry::Force( algorithm, available[i].c_str() ) );
+			CPPUNIT_ASSERT_EQUAL( available[i], std::string( KernelRegistry::Active( algorithm ) ) );
+		}
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void KernelRegistryTest::TestForceUnknown()
+{
+	std::string const	before	= KernelRegistry::Active( KernelRegistry::SHA256 );
+
+	CPPUNIT_ASSERT( !KernelRegistry::Force( KernelRegistry::SHA256, "no such kernel" ) );
+	CPPUNIT_ASSERT_EQUAL( before, std::string( KernelRegistry::Active( KernelRegistry::SHA256 ) ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Only an override in the environment that does not name an available kernel is reported, and the automatically-
+// selected kernel is used instead. An override that names an available kernel is used.
+
+void KernelRegistryTest::TestRejectedOverride()
+{
+	for ( int a = 0; a < KernelRegistry::NUMBER_OF_ALGORITHMS; ++a )
+	{
+		KernelRegistry::Algorithm const		algorithm	= KernelRegistry::Algorithm( a );
+		std::string const					variable	= std::string( "CRYPTO_KERNEL_" ) + KernelRegistry::Name( algorithm );
+		char const * const					forced		= getenv( variable.c_str() );
+		bool const							wasSet		= forced != nullptr;
+		std::string const					original	= wasSet ? forced : "";
+		std::vector< std::string > const	available	= KernelRegistry::Available( algorithm );
+
+		// The override in the environment the test was started with
+
+		char const *	rejected	= KernelRegistry::RejectedOverride( algorithm );
+		bool const		wasRejected	= rejected != nullptr;
+
+		if ( rejected != nullptr )
+		{
+			CPPUNIT_ASSERT( wasSet && original == rejected );
+			CPPUNIT_ASSERT( std::find( available.begin(), available.end(), rejected ) == available.end() );
+		}
+
+		// The name of a kernel that does not exist
+
+		KernelRegistry::Automatic( algorithm );
+
+		std::string const	automatic	= KernelRegistry::Active( algorithm );
+
+		SetEnvironment( variable.c_str(), "no such kernel" );
+		KernelRegistry::Reselect( algorithm );
+		rejected = KernelRegistry::RejectedOverride( algorithm );
+		CPPUNIT_ASSERT( rejected != nullptr && std::string( rejected ) == "no such kernel" );
+		CPPUNIT_ASSERT_EQUAL( automatic, std::string( KernelRegistry::Active( algorithm ) ) );
+
+		// The name of an available kernel
+
+		SetEnvironment( variable.c_str(), available[0].c_str() );
+		KernelRegistry::Reselect( algorithm );
+		CPPUNIT_ASSERT( KernelRegistry::RejectedOverride( algorithm ) == nullptr );
+		CPPUNIT_ASSERT_EQUAL( available[0], std::string( KernelRegistry::Active( algorithm ) ) );
+
+		// Restore the environment and the selection
+
+		SetEnvironment( variable.c_str(), wasSet ? original.c_str() : nullptr );
+		KernelRegistry::Reselect( algorithm );
+		CPPUNIT_ASSERT_EQUAL( wasRejected, KernelRegistry::RejectedOverride( algorithm ) != nullptr );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void KernelRegistryTest::TestKernelsAgree()
+{
+	size_t const	sizes[]	= { 0, 1, 55, 56, 63, 64, 65, 127, 128, 129, 1000, 4095, 4096, 4097, elementsof( testbuffer ) };
+
+	for ( int a = 0; a < KernelRegistry::NUMBER_OF_ALGORITHMS; ++a )
+	{
+		KernelRegistry::Algorithm const	algorithm	= KernelRegistry::Algorithm( a );
+		std::vector< std::string > const	available	= KernelRegistry::Available( algorithm );
+
+		for ( int i = 0; i < (int)elementsof( sizes ); ++i )
+		{
+			KernelRegistry::Force( algorithm, available[0].c_str() );
+			std::string const	expected	= Calculate( algorithm, testbuffer, sizes[i] );
+
+			for ( size_t k = 1; k < available.size(); ++k )
+			{
+				KernelRegistry::Force( algorithm, available[k].c_str() );
+
+				std::ostringstream	message;
+				message << "The " << KernelRegistry::Name( algorithm ) << " kernel \"" << available[k] << "\" does not match \""
+						<< available[0] << "\" for a buffer of size " << sizes[i] << " bytes.";
+
+				CPPUNIT_ASSERT_EQUAL_MESSAGE( message.str(), expected, Calculate( algorithm, testbuffer, sizes[i] ) );
+			}
+		}
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::string KernelRegistryTest::Calculate( KernelRegistry::Algorithm algorithm, unsigned char const * buffer, size_t size )
+{
+	switch ( algorithm )
+	{
+	case KernelRegistry::CRC32:		return Crc32( buffer, size ).ToString();
+	case KernelRegistry::MD5:		return Md5( buffer, size ).ToString();
+	case KernelRegistry::SHA1:		return Sha1( buffer, size ).ToString();
+	case KernelRegistry::SHA256:	return Sha256( buffer, size ).ToString();
+	case KernelRegistry::HEX:		return BinaryToHex( buffer, size );
+	case KernelRegistry::BASE64:	return Base64::Encode( buffer, size );
+	case KernelRegistry::SHA1X8:	return DeriveBatch( Pbkdf2::SHA1, buffer, size );
+	case KernelRegistry::SHA256X8:	return DeriveBatch( Pbkdf2::SHA256, buffer, size );
+	case KernelRegistry::SCRYPT:	return DeriveScrypt( buffer, size );
+	default:						return std::string();
+	}
+}
@@ -0,0 +1,45 @@
+/********************************************************************************************************************
+
+                                                 KernelRegistryTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/KernelRegistryTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../KernelRegistry.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class KernelRegistryTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( KernelRegistryTest );
+	CPPUNIT_TEST( TestActiveIsAvailable );
+	CPPUNIT_TEST( TestForce );
+	CPPUNIT_TEST( TestForceUnknown );
+	CPPUNIT_TEST( TestRejectedOverride );
+	CPPUNIT_TEST( TestKernelsAgree );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestActiveIsAvailable();
+	void TestForce();
+	void TestForceUnknown();
+	void TestRejectedOverride();
+	void TestKernelsAgree();
+
+private:
+
+	std::string Calculate( Crypto::KernelRegistry::Algorithm algorithm, unsigned char const * buffer, size_t size );
+};
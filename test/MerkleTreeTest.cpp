@@ -0,0 +1,235 @@
+/********************************************************************************************************************
+
+                                                  MerkleTreeTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/MerkleTreeTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "MerkleTreeTest.h"
+
+#include "../KernelRegistry.h"
+#include "../MerkleTree.h"
+
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( MerkleTreeTest );
+
+namespace
+{
+	// Returns the hashes of leaves whose records are the single bytes 0, 1, 2, ...
+
+	std::vector< Sha256 > Leaves( size_t count )
+	{
+		std::vector< Sha256 >	leaves( count );
+
+		for ( size_t i = 0; i < count; ++i )
+		{
+			uint8_t const	record	= uint8_t( i );
+
+			leaves[i] = MerkleTree::HashLeaf( &record, 1 );
+		}
+
+		return leaves;
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void MerkleTreeTest::setUp()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void MerkleTreeTest::tearDown()
+{
+	KernelRegistry::Automatic( KernelRegistry::SHA256 );
+	KernelRegistry::Automatic( KernelRegistry::SHA256X8 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void MerkleTreeTest::TestRoots()
+{
+	// The roots match the recursive definition of RFC 6962, including sizes that are not powers of 2
+
+	struct Case
+	{
+		size_t			size;
+		char const *	root;
+	};
+
+	Case const	cases[]	=
+	{
+		{ 0, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+		{ 1, "96a296d224f285c67bee93c30f8a309157f0daa35dc5b87e410b78630a09cfc7" },
+		{ 3, "3b6cccd7e3e023ff393006f030315ee7ad9eb111b022b41fba7e5b7a3973f688" },
+		{ 7, "3560191803028444b232018ac047fdb561c09c23a7a6876c85e08b5e4d48e9f3" },
+		{ 8, "ef7f49b620f6c7ea9b963a214da34b5021c6ded8ed57734380a311ab726aa907" }
+	};
+
+	for ( Case const & c : cases )
+	{
+		std::vector< Sha256 > const	leaves	= Leaves( c.size );
+		MerkleTree					tree;
+
+		tree.Build( leaves.data(), leaves.size() );
+		CPPUNIT_ASSERT_EQUAL( c.size, tree.Size() );
+		CPPUNIT_ASSERT( tree.Root() == Sha256( c.root ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void MerkleTreeTest::TestProofs()
+{
+	for ( size_t size = 1; size <= 33; ++size )
+	{
+		std::vector< Sha256 > const	leaves	= Leaves( size );
+		MerkleTree					tree;
+		std::vector< Sha256 >		proof;
+
+		tree.Build( leaves.data(), leaves.size() );
+
+		for ( size_t i = 0; i < size; ++i )
+		{
+			CPPUNIT_ASSERT( tree.Prove( i, proof ) );
+			CPPUNIT_ASSERT( MerkleTree::Verify( tree.Root(), size, i, leaves[i], proof.data(), proof.size() ) );
+
+			// The proof does not hold for another leaf or another position
+
+			if ( size > 1 )
+			{
+				Sha256 const &	other	= leaves[ ( i + 1 ) % size ];
+
+				CPPUNIT_ASSERT( !MerkleTree::Verify( tree.Root(), size, i, other, proof.data(), proof.size() ) );
+				CPPUNIT_ASSERT( !MerkleTree::Verify( tree.Root(), size, ( i + 1 ) % size, leaves[i], proof.data(),
+													 proof.size() ) );
+			}
+		}
+
+		CPPUNIT_ASSERT( !tree.Prove( size, proof ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void MerkleTreeTest::TestUpdate()
+{
+	size_t const			SIZE	= 1001;
+	std::vector< Sha256 >	leaves	= Leaves( SIZE );
+	MerkleTree				tree;
+	std::vector< Sha256 >	proof;
+
+	tree.Build( leaves.data(), leaves.size() );
+
+	// Changing leaves and updating gives the same tree as building it again
+
+	size_t const	changed[]	= { 0, 1, 17, 500, 501, 999, 1000, 17 };
+
+	for ( size_t i : changed )
+	{
+		uint8_t const	record[]	= { 0xff, uint8_t( i ) };
+
+		leaves[i] = MerkleTree::HashLeaf( record, sizeof( record ) );
+		tree.SetLeaf( i, record, sizeof( record ) );
+	}
+
+	// Proofs are not available until the tree is updated
+
+	CPPUNIT_ASSERT( !tree.Prove( 0, proof ) );
+
+	tree.Update();
+
+	MerkleTree	rebuilt;
+
+	rebuilt.Build( leaves.data(), leaves.size() );
+	CPPUNIT_ASSERT( tree.Root() == rebuilt.Root() );
+
+	CPPUNIT_ASSERT( tree.Prove( 501, proof ) );
+	CPPUNIT_ASSERT( MerkleTree::Verify( tree.Root(), SIZE, 501, leaves[501], proof.data(), proof.size() ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Leaves hashed in a batch match the ones hashed one at a time, with each combination of the single-message and x8
+// kernels and records whose padding does and does not fit in their last block
+
+void MerkleTreeTest::TestHashLeaves()
+{
+	size_t const						COUNT	= 150;
+	std::vector< std::string > const	singles	= KernelRegistry::Available( KernelRegistry::SHA256 );
+	std::vector< std::string > const	x8s		= KernelRegistry::Available( KernelRegistry::SHA256X8 );
+	std::vector< uint8_t >				records( COUNT );
+	std::vector< uint8_t const * >		data( COUNT );
+	std::vector< size_t >				sizes( COUNT );
+	std::vector< Sha256 >				expected( COUNT );
+
+	for ( size_t i = 0; i < COUNT; ++i )
+	{
+		records[i] = uint8_t( i * 7 + 3 );
+	}
+
+	// Record i starts at byte i / 2, so the records overlap
+
+	for ( size_t i = 0; i < COUNT; ++i )
+	{
+		data[i]		= records.data() + i / 2;
+		sizes[i]	= ( i < COUNT / 2 ) ? i : COUNT - i;
+		expected[i]	= MerkleTree::HashLeaf( data[i], sizes[i] );
+	}
+
+	// RFC 6962 leaves of an empty record and of the record 0x00
+
+	CPPUNIT_ASSERT( MerkleTree::HashLeaf( nullptr, 0 ) ==
+					Sha256( "6e340b9cffb37a989ca544e6bb780a2c78901d3fb33738768511a30617afa01d" ) );
+	CPPUNIT_ASSERT( Leaves( 1 )[0] == Sha256( "96a296d224f285c67bee93c30f8a309157f0daa35dc5b87e410b78630a09cfc7" ) );
+
+	for ( size_t s = 0; s < singles.size(); ++s )
+	{
+		for ( size_t x = 0; x < x8s.size(); ++x )
+		{
+			CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::SHA256, singles[s].c_str() ) );
+			CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::SHA256X8, x8s[x].c_str() ) );
+
+			for ( size_t count = 0; count <= COUNT; count += ( count < 17 ) ? 1 : 19 )
+			{
+				std::vector< Sha256 >	leaves( count );
+
+				MerkleTree::HashLeaves( data.data(), sizes.data(), count, leaves.data() );
+				for ( size_t i = 0; i < count; ++i )
+				{
+					CPPUNIT_ASSERT( leaves[i] == expected[i] );
+				}
+			}
+		}
+	}
+}
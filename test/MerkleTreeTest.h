@@ -0,0 +1,37 @@
+/********************************************************************************************************************
+
+                                                   MerkleTreeTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/MerkleTreeTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class MerkleTreeTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( MerkleTreeTest );
+	CPPUNIT_TEST( TestRoots );
+	CPPUNIT_TEST( TestProofs );
+	CPPUNIT_TEST( TestUpdate );
+	CPPUNIT_TEST( TestHashLeaves );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestRoots();
+	void TestProofs();
+	void TestUpdate();
+	void TestHashLeaves();
+};
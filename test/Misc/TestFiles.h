@@ -0,0 +1,138 @@
+/********************************************************************************************************************
+
+                                                     TestFiles.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/Misc/TestFiles.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "Misc/Random.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+
+// Helpers for the tests that work with files
+namespace TestFiles
+{
+
+// A directory that holds the files of one test. It is created by Create() and deleted with everything in it by
+// Remove() or the destructor.
+
+class TemporaryDirectory
+{
+public:
+
+	~TemporaryDirectory()								{ Remove(); }
+
+	// Creates a new empty directory in the system's temporary directory
+	void Create()
+	{
+		std::filesystem::path const	base	= std::filesystem::temp_directory_path();
+		std::random_device			random;
+		std::error_code				error;
+
+		Remove();
+		do
+		{
+			m_path = ( base / ( "CryptoTest-" + std::to_string( random() ) ) ).string();
+			CPPUNIT_ASSERT( !error );
+		} while ( !std::filesystem::create_directory( m_path, error ) );
+	}
+
+	// Deletes the directory and the files in it
+	void Remove()
+	{
+		std::error_code	error;
+
+		if ( !m_path.empty() )
+			std::filesystem::remove_all( m_path, error );
+		m_path.clear();
+	}
+
+	// Returns the path of the directory
+	char const * Path() const							{ return m_path.c_str(); }
+
+	// Returns the path of a file in the directory
+	std::string Path( std::string const & name ) const	{ return m_path + "/" + name; }
+
+private:
+
+	std::string	m_path;		// Path of the directory, or empty if there is none
+};
+
+// Returns the size of a file, or -1 if it does not exist
+inline long FileSize( std::string const & path )
+{
+	FILE *	file	= fopen( path.c_str(), "rb" );
+
+	if ( file == nullptr )
+		return -1;
+
+	fseek( file, 0, SEEK_END );
+
+	long const	size	= ftell( file );
+
+	fclose( file );
+	return size;
+}
+
+// Writes a file with the given contents
+inline void WriteFile( std::string const & path, void const * data, size_t size )
+{
+	FILE *	file	= fopen( path.c_str(), "wb" );
+
+	CPPUNIT_ASSERT( file != nullptr );
+	CPPUNIT_ASSERT( size == 0 || fwrite( data, 1, size, file ) == size );
+	fclose( file );
+}
+
+// Flips the bits of a byte of a file
+inline void Corrupt( std::string const & path, long offset )
+{
+	FILE *	file	= fopen( path.c_str(), "r+b" );
+
+	CPPUNIT_ASSERT( file != nullptr );
+	fseek( file, offset, SEEK_SET );
+
+	int const	c	= fgetc( file );
+
+	CPPUNIT_ASSERT( c != EOF );
+	fseek( file, offset, SEEK_SET );
+	fputc( c ^ 0xff, file );
+	fclose( file );
+}
+
+// Returns count buffers of random data, each 1 to maxSize bytes long
+inline std::vector< std::vector< uint8_t > > RandomBuffers( int count, size_t maxSize, uint32_t seed )
+{
+	std::vector< std::vector< uint8_t > >	buffers( count );
+	Random									rng( seed );
+
+	for ( int i = 0; i < count; ++i )
+	{
+		buffers[i].resize( 1 + rng.Get() % maxSize );
+		for ( size_t j = 0; j < buffers[i].size(); ++j )
+		{
+			buffers[i][j] = uint8_t( rng.Get() );
+		}
+	}
+
+	return buffers;
+}
+
+} // namespace TestFiles
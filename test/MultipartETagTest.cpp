@@ -0,0 +1,241 @@
+/********************************************************************************************************************
+
+                                                MultipartETagTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/MultipartETagTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "MultipartETagTest.h"
+
+#include "../Crc32Calculator.h"
+#include "../Md5Calculator.h"
+#include "../MultipartETag.h"
+
+#include "Misc/Etc.h"
+
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( MultipartETagTest );
+
+namespace
+{
+	// An object of three parts. The first two are larger than the slice hashed at a time, and the last part is shorter.
+	size_t const	PART_SIZES[]	= { 100000, 70000, 30001 };
+	size_t const	OBJECT_SIZE		= 200001;
+
+	// The ETag, CRC-32 and MD5 digest of each part of the object, as computed by Python's hashlib and zlib
+	char const		ETAG[]			= "587bbf3366a99dea28e3876ed705d716-3";
+	uint32_t const	CRC				= 0x0eaa60d8;
+	char const * const	PART_MD5S[]	=
+	{
+		"6b1237bb4c34b3268422138306a9da00",
+		"9a8a5daad122178df7ad2ac8e520c9ee",
+		"cfe3a77bade92cfdfaa4402cf3dae4d8",
+	};
+
+	// Numbers of threads in the pool
+	unsigned const	THREADS[]		= { 1, 4 };
+
+	// Returns the object. Byte j is bits 13-20 of j * 2654435761, so no two parts are the same.
+	std::vector< uint8_t > Object()
+	{
+		std::vector< uint8_t >	object( OBJECT_SIZE );
+
+		for ( size_t j = 0; j < object.size(); ++j )
+		{
+			object[j] = uint8_t( ( j * 2654435761ull ) >> 13 );
+		}
+
+		return object;
+	}
+
+	// Returns the MD5 digest of data
+	Md5 Md5Of( uint8_t const * data, size_t size )
+	{
+		Md5	digest;
+
+		Md5Calculator().Calculate( data, size, digest.m_digest );
+		return digest;
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void MultipartETagTest::setUp()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void MultipartETagTest::tearDown()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The ETag is the MD5 digest of the MD5 digests of the parts in order of part number, followed by "-" and the number
+// of parts, however the parts are added
+
+void MultipartETagTest::TestETag()
+{
+	std::vector< uint8_t > const	object	= Object();
+	uint8_t const * const			parts[]	= { object.data(), object.data() + PART_SIZES[0],
+												object.data() + PART_SIZES[0] + PART_SIZES[1] };
+
+	for ( size_t t = 0; t < elementsof( THREADS ); ++t )
+	{
+		MultipartETag	etag( THREADS[t] );
+
+		CPPUNIT_ASSERT( etag.AddPart( 3, parts[2], PART_SIZES[2] ) );
+		CPPUNIT_ASSERT( etag.AddPart( 1, parts[0], PART_SIZES[0] ) );
+		CPPUNIT_ASSERT( etag.AddPart( 2, parts[1], PART_SIZES[1] ) );
+
+		CPPUNIT_ASSERT_EQUAL( std::string( ETAG ), etag.ETag() );
+		CPPUNIT_ASSERT_EQUAL( uint32_t( 3 ), etag.PartCount() );
+		CPPUNIT_ASSERT_EQUAL( uint64_t( OBJECT_SIZE ), etag.Size() );
+
+		Md5Calculator	calculator;
+		Md5				digest;
+
+		for ( uint32_t i = 0; i < 3; ++i )
+		{
+			Md5	md5;
+
+			CPPUNIT_ASSERT( etag.PartMd5( i + 1, md5 ) );
+			CPPUNIT_ASSERT_EQUAL( std::string( PART_MD5S[i] ), md5.ToString() );
+			CPPUNIT_ASSERT_EQUAL( Md5Of( parts[i], PART_SIZES[i] ).ToString(), md5.ToString() );
+			calculator.Process( md5.m_digest, Md5::SIZE );
+		}
+		calculator.Finalize( digest.m_digest );
+		CPPUNIT_ASSERT_EQUAL( digest.ToString() + "-3", etag.ETag() );
+
+		// The same parts added in order after a reset give the same ETag
+
+		etag.Reset();
+		for ( uint32_t i = 0; i < 3; ++i )
+		{
+			CPPUNIT_ASSERT( etag.AddPart( i + 1, parts[i], PART_SIZES[i] ) );
+		}
+		CPPUNIT_ASSERT_EQUAL( std::string( ETAG ), etag.ETag() );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The combined CRC-32 is the CRC-32 of the whole object, with parts added out of order, part numbers that are not
+// consecutive and an empty part
+
+void MultipartETagTest::TestCrc32()
+{
+	std::vector< uint8_t > const	object	= Object();
+	uint32_t const					whole	= Crc32Calculator().Calculate( object.data(), object.size() );
+
+	CPPUNIT_ASSERT_EQUAL( CRC, whole );
+
+	for ( size_t t = 0; t < elementsof( THREADS ); ++t )
+	{
+		MultipartETag	etag( THREADS[t] );
+
+		CPPUNIT_ASSERT( etag.AddPart( 2, object.data() + PART_SIZES[0], PART_SIZES[1] ) );
+		CPPUNIT_ASSERT( etag.AddPart( 3, object.data() + PART_SIZES[0] + PART_SIZES[1], PART_SIZES[2] ) );
+		CPPUNIT_ASSERT( etag.AddPart( 1, object.data(), PART_SIZES[0] ) );
+		CPPUNIT_ASSERT_EQUAL( whole, etag.Crc32() );
+
+		etag.Reset();
+		CPPUNIT_ASSERT( etag.AddPart( 9, object.data() + 150000, OBJECT_SIZE - 150000 ) );
+		CPPUNIT_ASSERT( etag.AddPart( 4, object.data() + 1, 149999 ) );
+		CPPUNIT_ASSERT( etag.AddPart( 7, object.data() + 150000, 0 ) );
+		CPPUNIT_ASSERT( etag.AddPart( 2, object.data(), 1 ) );
+		CPPUNIT_ASSERT_EQUAL( whole, etag.Crc32() );
+		CPPUNIT_ASSERT_EQUAL( uint32_t( 4 ), etag.PartCount() );
+		CPPUNIT_ASSERT_EQUAL( uint64_t( OBJECT_SIZE ), etag.Size() );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Part numbers that are 0, larger than the largest part number or already added are refused, and a refused part does
+// not change the result
+
+void MultipartETagTest::TestPartNumbers()
+{
+	std::vector< uint8_t > const	object	= Object();
+	MultipartETag					etag( 2 );
+	Md5								md5;
+
+	CPPUNIT_ASSERT( !etag.AddPart( 0, object.data(), 100 ) );
+	CPPUNIT_ASSERT( !etag.AddPart( MultipartETag::MAX_PART_NUMBER + 1, object.data(), 100 ) );
+	CPPUNIT_ASSERT( etag.AddPart( MultipartETag::MAX_PART_NUMBER, object.data() + 100, 100 ) );
+	CPPUNIT_ASSERT( etag.AddPart( 1, object.data(), 100 ) );
+	CPPUNIT_ASSERT( !etag.AddPart( 1, object.data() + 200, 100 ) );
+	CPPUNIT_ASSERT( !etag.AddPart( MultipartETag::MAX_PART_NUMBER, object.data() + 200, 100 ) );
+
+	CPPUNIT_ASSERT_EQUAL( uint32_t( 2 ), etag.PartCount() );
+	CPPUNIT_ASSERT_EQUAL( uint64_t( 200 ), etag.Size() );
+	CPPUNIT_ASSERT_EQUAL( Crc32Calculator().Calculate( object.data(), 200 ), etag.Crc32() );
+
+	CPPUNIT_ASSERT( etag.PartMd5( 1, md5 ) );
+	CPPUNIT_ASSERT_EQUAL( Md5Of( object.data(), 100 ).ToString(), md5.ToString() );
+	CPPUNIT_ASSERT( !etag.PartMd5( 0, md5 ) );
+	CPPUNIT_ASSERT( !etag.PartMd5( 2, md5 ) );
+	CPPUNIT_ASSERT( !etag.PartMd5( MultipartETag::MAX_PART_NUMBER + 1, md5 ) );
+
+	Md5Calculator	calculator;
+	Md5				digest;
+
+	calculator.Process( Md5Of( object.data(), 100 ).m_digest, Md5::SIZE );
+	calculator.Process( Md5Of( object.data() + 100, 100 ).m_digest, Md5::SIZE );
+	calculator.Finalize( digest.m_digest );
+	CPPUNIT_ASSERT_EQUAL( digest.ToString() + "-2", etag.ETag() );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// An object with no parts has no ETag
+
+void MultipartETagTest::TestNoParts()
+{
+	std::vector< uint8_t > const	object	= Object();
+	MultipartETag					etag( 2 );
+
+	CPPUNIT_ASSERT_EQUAL( std::string(), etag.ETag() );
+	CPPUNIT_ASSERT_EQUAL( uint32_t( 0 ), etag.PartCount() );
+	CPPUNIT_ASSERT_EQUAL( uint32_t( 0 ), etag.Crc32() );
+
+	CPPUNIT_ASSERT( !etag.AddPart( 0, object.data(), 100 ) );
+	CPPUNIT_ASSERT_EQUAL( std::string(), etag.ETag() );
+
+	CPPUNIT_ASSERT( etag.AddPart( 1, object.data(), 0 ) );
+	CPPUNIT_ASSERT_EQUAL( std::string( "59adb24ef3cdbe0297f05b395827453f-1" ), etag.ETag() );
+
+	etag.Reset();
+	CPPUNIT_ASSERT_EQUAL( std::string(), etag.ETag() );
+}
@@ -0,0 +1,37 @@
+/********************************************************************************************************************
+
+                                                 MultipartETagTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/MultipartETagTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class MultipartETagTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( MultipartETagTest );
+	CPPUNIT_TEST( TestETag );
+	CPPUNIT_TEST( TestCrc32 );
+	CPPUNIT_TEST( TestPartNumbers );
+	CPPUNIT_TEST( TestNoParts );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestETag();
+	void TestCrc32();
+	void TestPartNumbers();
+	void TestNoParts();
+};
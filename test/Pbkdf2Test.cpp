@@ -0,0 +1,242 @@
+/********************************************************************************************************************
+
+                                                   Pbkdf2Test.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/Pbkdf2Test.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "Pbkdf2Test.h"
+
+#include "../Common.h"
+#include "../KernelRegistry.h"
+#include "../Pbkdf2.h"
+#include "Misc/Etc.h"
+#include "Misc/Random.h"
+
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Pbkdf2Test );
+
+namespace
+{
+	// A known answer. The strings are given with their sizes because some of them contain 0's.
+
+	struct Vector
+	{
+		char const *	password;
+		size_t			passwordSize;
+		char const *	salt;
+		size_t			saltSize;
+		uint32_t		iterations;
+		char const *	expected;		// Derived key in hex
+	};
+
+	// RFC 6070, except for the one with 16777216 iterations
+
+	Vector const	RFC6070[]	=
+	{
+		{ "password", 8, "salt", 4, 1,		"0c60c80f961f0e71f3a9b524af6012062fe037a6" },
+		{ "password", 8, "salt", 4, 2,		"ea6c014dc72d6f8ccd1ed92ace1d41f0d8de8957" },
+		{ "password", 8, "salt", 4, 4096,	"4b007901b765489abead49d926f721d065a429c1" },
+		{ "passwordPASSWORDpassword", 24, "saltSALTsaltSALTsaltSALTsaltSALTsalt", 36, 4096,
+		  "3d2eec4fe41c849b80c8d83662c0e44a8b291a964cf2f07038" },
+		{ "pass\0word", 9, "sa\0lt", 5, 4096,	"56fa6aa75548099dcc37d7f03425e0c3" },
+	};
+
+	// RFC 7914, section 11
+
+	Vector const	RFC7914[]	=
+	{
+		{ "passwd", 6, "salt", 4, 1,
+		  "55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+		  "49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783" },
+		{ "Password", 8, "NaCl", 4, 80000,
+		  "4ddcd8f60b98be21830cee5ef22701f9641a4418d04c0414aeff08876b34ab56"
+		  "a1d425a1225833549adb841b51c9b3176a272bdebba1d078478f62b397f33c8d" },
+	};
+
+	// Returns the derived key of a request in hex
+
+	std::string Hex( Pbkdf2::Request const & request )
+	{
+		return BinaryToHex( request.key, request.keySize );
+	}
+
+	// Derives the keys of the vectors with each combination of the single-message and x8 kernels, first one at a time
+	// and then in batches of five copies of the vectors with the same number of iterations, which fill the lanes
+
+	void Check( Pbkdf2::Hash hash, KernelRegistry::Algorithm single, KernelRegistry::Algorithm lanes,
+				Vector const * vectors, size_t count )
+	{
+		std::vector< std::string > const	singles	= KernelRegistry::Available( single );
+		std::vector< std::string > const	x8s		= KernelRegistry::Available( lanes );
+
+		for ( size_t s = 0; s < singles.size(); ++s )
+		{
+			for ( size_t x = 0; x < x8s.size(); ++x )
+			{
+				CPPUNIT_ASSERT( KernelRegistry::Force( single, singles[s].c_str() ) );
+				CPPUNIT_ASSERT( KernelRegistry::Force( lanes, x8s[x].c_str() ) );
+
+				std::vector< Pbkdf2::Request >			requests;
+				std::vector< std::vector< uint8_t > >	keys;
+
+				for ( size_t i = 0; i < count; ++i )
+				{
+					Vector const &	v	= vectors[i];
+
+					keys.emplace_back( strlen( v.expected ) / 2 );
+					requests.push_back( { reinterpret_cast< uint8_t const * >( v.password ), v.passwordSize,
+										  reinterpret_cast< uint8_t const * >( v.salt ), v.saltSize,
+										  keys.back().data(), keys.back().size() } );
+					Pbkdf2::Derive( hash, requests.back().password, v.passwordSize, requests.back().salt, v.saltSize,
+									v.iterations, keys.back().data(), keys.back().size() );
+					CPPUNIT_ASSERT_EQUAL( std::string( v.expected ), Hex( requests.back() ) );
+				}
+
+				for ( size_t i = 0; i < count; ++i )
+				{
+					std::vector< Pbkdf2::Request >	batch;
+					std::vector< uint8_t >			storage( count * 5 * 64 );
+					bool							first	= true;
+
+					for ( size_t j = 0; j < i; ++j )
+					{
+						first = first && vectors[j].iterations != vectors[i].iterations;
+					}
+
+					if ( !first )
+						continue;
+
+					for ( size_t j = 0; j < count * 5; ++j )
+					{
+						if ( vectors[ j % count ].iterations == vectors[i].iterations )
+						{
+							batch.push_back( requests[ j % count ] );
+							batch.back().key = storage.data() + j * 64;
+						}
+					}
+
+					Pbkdf2::DeriveBatch( hash, batch.data(), batch.size(), vectors[i].iterations );
+					for ( size_t j = 0, k = 0; j < count * 5; ++j )
+					{
+						if ( vectors[ j % count ].iterations == vectors[i].iterations )
+							CPPUNIT_ASSERT_EQUAL( std::string( vectors[ j % count ].expected ), Hex( batch[ k++ ] ) );
+					}
+				}
+			}
+		}
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Pbkdf2Test::setUp()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Pbkdf2Test::tearDown()
+{
+	KernelRegistry::Automatic( KernelRegistry::SHA1 );
+	KernelRegistry::Automatic( KernelRegistry::SHA256 );
+	KernelRegistry::Automatic( KernelRegistry::SHA1X8 );
+	KernelRegistry::Automatic( KernelRegistry::SHA256X8 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Pbkdf2Test::TestRfc6070()
+{
+	Check( Pbkdf2::SHA1, KernelRegistry::SHA1, KernelRegistry::SHA1X8, RFC6070, elementsof( RFC6070 ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void Pbkdf2Test::TestRfc7914()
+{
+	Check( Pbkdf2::SHA256, KernelRegistry::SHA256, KernelRegistry::SHA256X8, RFC7914, elementsof( RFC7914 ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Batches of each size up to 17 requests, with keys of up to three digests, give the same keys as deriving them one at
+// a time. Each single-message kernel is used, so SHA-256 is also checked without the SHA extensions, which turn its
+// lanes off.
+
+void Pbkdf2Test::TestBatch()
+{
+	size_t const				COUNT	= 17;
+	Pbkdf2::Hash const			HASHES[]	= { Pbkdf2::SHA1, Pbkdf2::SHA256 };
+	KernelRegistry::Algorithm const	SINGLES[]	= { KernelRegistry::SHA1, KernelRegistry::SHA256 };
+	uint8_t						passwords[ COUNT ][ 70 ];
+	Random						rng( 5 );
+
+	for ( size_t i = 0; i < COUNT; ++i )
+	{
+		for ( size_t j = 0; j < sizeof( passwords[i] ); ++j )
+		{
+			passwords[i][j] = uint8_t( rng.Get() );
+		}
+	}
+
+	for ( size_t h = 0; h < elementsof( HASHES ); ++h )
+	{
+		std::vector< std::string > const	kernels	= KernelRegistry::Available( SINGLES[h] );
+
+		for ( size_t k = 0; k < kernels.size(); ++k )
+		{
+			CPPUNIT_ASSERT( KernelRegistry::Force( SINGLES[h], kernels[k].c_str() ) );
+
+			for ( size_t n = 1; n <= COUNT; ++n )
+			{
+				std::vector< Pbkdf2::Request >	requests( n );
+				std::vector< uint8_t >			keys( n * 96 );
+				std::vector< uint8_t >			expected( 96 );
+
+				for ( size_t i = 0; i < n; ++i )
+				{
+					requests[i] = { passwords[i], ( i * 13 ) % sizeof( passwords[i] ), passwords[ ( i + 1 ) % COUNT ],
+									i % 20, keys.data() + i * 96, 1 + ( i * 29 + n ) % 96 };
+				}
+
+				Pbkdf2::DeriveBatch( HASHES[h], requests.data(), n, 3 );
+
+				for ( size_t i = 0; i < n; ++i )
+				{
+					Pbkdf2::Request const &	r	= requests[i];
+
+					Pbkdf2::Derive( HASHES[h], r.password, r.passwordSize, r.salt, r.saltSize, 3, expected.data(),
+									r.keySize );
+					CPPUNIT_ASSERT_EQUAL( BinaryToHex( expected.data(), r.keySize ), Hex( r ) );
+				}
+			}
+		}
+	}
+}
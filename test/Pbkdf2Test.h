@@ -0,0 +1,35 @@
+/********************************************************************************************************************
+
+                                                    Pbkdf2Test.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/Pbkdf2Test.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class Pbkdf2Test : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( Pbkdf2Test );
+	CPPUNIT_TEST( TestRfc6070 );
+	CPPUNIT_TEST( TestRfc7914 );
+	CPPUNIT_TEST( TestBatch );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestRfc6070();
+	void TestRfc7914();
+	void TestBatch();
+};
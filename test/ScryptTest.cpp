@@ -0,0 +1,228 @@
+/********************************************************************************************************************
+
+                                                   ScryptTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/ScryptTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "ScryptTest.h"
+
+#include "../Common.h"
+#include "../KernelRegistry.h"
+#include "../Pbkdf2.h"
+#include "../Scrypt.h"
+#include "Misc/Etc.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ScryptTest );
+
+namespace
+{
+	// A known answer
+
+	struct Vector
+	{
+		char const *	password;
+		char const *	salt;
+		uint64_t		n;
+		uint32_t		r;
+		uint32_t		p;
+		char const *	expected;		// Derived key in hex
+	};
+
+	// RFC 7914, section 12, except for the one with n = 1048576, which needs 1 GB
+
+	Vector const	RFC7914[]	=
+	{
+		{ "", "", 16, 1, 1,
+		  "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442"
+		  "fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906" },
+		{ "password", "NaCl", 1024, 8, 16,
+		  "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b373162"
+		  "2eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640" },
+		{ "pleaseletmein", "SodiumChloride", 16384, 8, 1,
+		  "7023bdcb3afd7348461c06cd81fd38ebfda8fbba904f8e3ea9b543f6545da1f2"
+		  "d5432955613f0fcf62d49705242a9af9e61e85dc0d651e40dfcf017b45575887" },
+	};
+
+	// Derives a key from a vector and returns it in hex, or an empty string if the parameters are refused
+
+	std::string Derive( Scrypt & scrypt, Vector const & v )
+	{
+		uint8_t	key[ 64 ];
+
+		if ( !scrypt.Derive( reinterpret_cast< uint8_t const * >( v.password ), strlen( v.password ),
+							 reinterpret_cast< uint8_t const * >( v.salt ), strlen( v.salt ), v.n, v.r, v.p, key,
+							 sizeof( key ) ) )
+		{
+			return std::string();
+		}
+
+		return BinaryToHex( key, sizeof( key ) );
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ScryptTest::setUp()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void ScryptTest::tearDown()
+{
+	KernelRegistry::Automatic( KernelRegistry::SCRYPT );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Each ROMix kernel gives the known answers with one thread and with four, and the arena is reused between calls
+
+void ScryptTest::TestRfc7914()
+{
+	std::vector< std::string > const	kernels	= KernelRegistry::Available( KernelRegistry::SCRYPT );
+
+	for ( size_t k = 0; k < kernels.size(); ++k )
+	{
+		CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::SCRYPT, kernels[k].c_str() ) );
+
+		for ( unsigned threads = 1; threads <= 4; threads += 3 )
+		{
+			Scrypt	scrypt( Scrypt::DEFAULT_MAX_MEMORY, threads );
+
+			for ( size_t i = 0; i < elementsof( RFC7914 ); ++i )
+			{
+				CPPUNIT_ASSERT_EQUAL( std::string( RFC7914[i].expected ), Derive( scrypt, RFC7914[i] ) );
+			}
+		}
+	}
+
+	// The last vector of RFC 7914 needs more than the default limit
+
+	Scrypt			scrypt;
+	Vector const	big	= { "pleaseletmein", "SodiumChloride", 1048576, 8, 1, "" };
+
+	CPPUNIT_ASSERT_EQUAL( std::string(), Derive( scrypt, big ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), scrypt.ArenaSize() );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// n must be a power of 2 greater than 1 and less than 2^( 16 * r ), and r and p must not be 0
+
+void ScryptTest::TestParameters()
+{
+	CPPUNIT_ASSERT_EQUAL( size_t( 128 * 18 ), Scrypt::MemoryPerBlock( 16, 1 ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), Scrypt::MemoryPerBlock( 0, 1 ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), Scrypt::MemoryPerBlock( 1, 1 ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), Scrypt::MemoryPerBlock( 24, 1 ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), Scrypt::MemoryPerBlock( 16, 0 ) );
+
+	CPPUNIT_ASSERT( Scrypt::MemoryPerBlock( 32768, 1 ) != 0 );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), Scrypt::MemoryPerBlock( 65536, 1 ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), Scrypt::MemoryPerBlock( uint64_t( 1 ) << 32, 2 ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), Scrypt::MemoryPerBlock( uint64_t( 1 ) << 48, 3 ) );
+
+	Scrypt	scrypt;
+
+	CPPUNIT_ASSERT_EQUAL( std::string(), Derive( scrypt, { "password", "NaCl", 65536, 1, 1, "" } ) );
+	CPPUNIT_ASSERT_EQUAL( std::string(), Derive( scrypt, { "password", "NaCl", 1000, 1, 1, "" } ) );
+	CPPUNIT_ASSERT_EQUAL( std::string(), Derive( scrypt, { "password", "NaCl", 16, 0, 1, "" } ) );
+	CPPUNIT_ASSERT_EQUAL( std::string(), Derive( scrypt, { "password", "NaCl", 16, 1, 0, "" } ) );
+	CPPUNIT_ASSERT_EQUAL( std::string(), Derive( scrypt, { "password", "NaCl", 16, 1u << 15, 1u << 15, "" } ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The limit covers the arena, the 256 * r * p bytes of the blocks and the scratch space of PBKDF2. With n = 16, r = 1
+// and p = 4, each block being mixed needs 2304 bytes and the blocks need 1024.
+
+void ScryptTest::TestMemoryLimit()
+{
+	Vector const		v			= { "password", "NaCl", 16, 1, 4, "" };
+	size_t const		fixed		= 1024 + std::max( Pbkdf2::ScratchSize( Pbkdf2::SHA256, 4, 512 ),
+													   Pbkdf2::ScratchSize( Pbkdf2::SHA256, 512, 64 ) );
+	std::string			expected;
+
+	{
+		Scrypt	scrypt( 2304 + fixed, 4 );
+
+		expected = Derive( scrypt, v );
+		CPPUNIT_ASSERT( !expected.empty() );
+		CPPUNIT_ASSERT_EQUAL( size_t( 2304 ), scrypt.ArenaSize() );
+	}
+
+	{
+		Scrypt	scrypt( 2304 + fixed - 1, 4 );
+
+		CPPUNIT_ASSERT_EQUAL( std::string(), Derive( scrypt, v ) );
+		CPPUNIT_ASSERT_EQUAL( size_t( 0 ), scrypt.ArenaSize() );
+	}
+
+	{
+		Scrypt	scrypt( 3 * 2304 + fixed, 4 );
+
+		CPPUNIT_ASSERT_EQUAL( expected, Derive( scrypt, v ) );
+		CPPUNIT_ASSERT_EQUAL( size_t( 3 * 2304 ), scrypt.ArenaSize() );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// An arena kept from an earlier call is made smaller when the blocks of a later call would not fit along with it. With
+// n = 16, r = 1 and p = 16, the blocks need 4096 bytes.
+
+void ScryptTest::TestArenaShrinks()
+{
+	Vector const	few		= { "password", "NaCl", 16, 1, 4, "" };
+	Vector const	many	= { "password", "NaCl", 16, 1, 16, "" };
+	size_t const	fixed	= 4096 + std::max( Pbkdf2::ScratchSize( Pbkdf2::SHA256, 4, 2048 ),
+											   Pbkdf2::ScratchSize( Pbkdf2::SHA256, 2048, 64 ) );
+	size_t const	limit	= 4 * 2304 + fixed - 2304;
+	Scrypt			scrypt( limit, 4 );
+	Scrypt			unlimited( Scrypt::DEFAULT_MAX_MEMORY, 1 );
+
+	CPPUNIT_ASSERT_EQUAL( Derive( unlimited, few ), Derive( scrypt, few ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 4 * 2304 ), scrypt.ArenaSize() );
+
+	CPPUNIT_ASSERT_EQUAL( Derive( unlimited, many ), Derive( scrypt, many ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 3 * 2304 ), scrypt.ArenaSize() );
+	CPPUNIT_ASSERT( scrypt.ArenaSize() + fixed <= limit );
+
+	// With the smaller blocks there is room for all four threads again
+
+	CPPUNIT_ASSERT_EQUAL( Derive( unlimited, few ), Derive( scrypt, few ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 4 * 2304 ), scrypt.ArenaSize() );
+}
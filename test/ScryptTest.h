@@ -0,0 +1,37 @@
+/********************************************************************************************************************
+
+                                                    ScryptTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/ScryptTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class ScryptTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( ScryptTest );
+	CPPUNIT_TEST( TestRfc7914 );
+	CPPUNIT_TEST( TestParameters );
+	CPPUNIT_TEST( TestMemoryLimit );
+	CPPUNIT_TEST( TestArenaShrinks );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestRfc7914();
+	void TestParameters();
+	void TestMemoryLimit();
+	void TestArenaShrinks();
+};
@@ -0,0 +1,325 @@
+/********************************************************************************************************************
+
+                                                TorrentPiecesTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/TorrentPiecesTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "TorrentPiecesTest.h"
+
+#include "../KernelRegistry.h"
+#include "../TorrentPieces.h"
+
+#include "Misc/Etc.h"
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TorrentPiecesTest );
+
+namespace
+{
+	size_t const	PIECE_SIZE		= 32 * 1024;
+
+	// Sizes of the files. The first spans a piece boundary within a block and ends in a short block, the second ends
+	// in the middle of its second piece, the third is empty, the fourth is larger than a block but no larger than a
+	// piece, and the last fits in one block.
+	uint64_t const	SIZES[]	= { 100000, 50000, 0, 20000, 1000 };
+
+	// SHA-1 of each v1 piece of the files (BEP 3)
+	char const * const	V1_PIECES[]	=
+	{
+		"8202d7172a441517d8b68d3ba116ef8a2b31e821",
+		"f5e6b690bdbbe349a33fdcf024c27bf9917732f1",
+		"af6676c3541c7332d03b7a15e60a8d74cf42fdf7",
+		"decac2a42a0e5bad344c7827817e1ef5ec92bc2e",
+		"5477607e17cae78331a433c077a229d441622f2b",
+		"143e367df0d5cf2fc59f3c7aba1eaac6f7838462",
+	};
+
+	// Pieces root of each file (BEP 52). The root of a one-block file is the SHA-256 of its contents.
+	char const * const	V2_ROOTS[]	=
+	{
+		"32f76a3baa0b28ef9abc83eb2f40452addcd832731c9b6b2e976cdf61658f86d",
+		"08625a0122e41bf0027445c203be70d723fced445143eecf2923cf7dc158e652",
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"6769bd8f1e290cdbf286249e650f2f937c00fc6de151b14bf37ba3eabab130ab",
+		"c0c24331e58b8c2c7fe9f66de8a8e9106662983d4e4363b4f69e35d2d3f39589",
+	};
+
+	// Piece layers of the first two files. The others are no larger than a piece, so they have none.
+	char const * const	V2_LAYER_0[]	=
+	{
+		"aa5d801c5e3091f538a7b41ff7a52021bafd53da214effd66ce1fdd557d4da63",
+		"e8752a8addc748568d63c64cbe76ffb07027e21a0c8fd441f4f6939e25152d2f",
+		"15b5eb63ee41b17b921998dccb19f4d4c4b4132393eb394318ef6014751325f4",
+		"cf31591eda4a039a9175537e67bd7ab4adcac4a7d810083e0909cb7318fda16f",
+	};
+	char const * const	V2_LAYER_1[]	=
+	{
+		"887ee7ff8575d1bbd24ad4f08d55961883a495e8e98125f419549cae797a3ecb",
+		"13ce8dba33048e97b79490f12c6069e2cfbf5de48f37d3bd5196bfaa214f565a",
+	};
+
+	// Returns the v2 hashes given above
+	std::vector< TorrentPieces::FileHashes > ExpectedV2()
+	{
+		std::vector< TorrentPieces::FileHashes >	files( elementsof( SIZES ) );
+
+		for ( size_t i = 0; i < files.size(); ++i )
+		{
+			files[i].root = Sha256( V2_ROOTS[i] );
+		}
+		for ( size_t i = 0; i < elementsof( V2_LAYER_0 ); ++i )
+		{
+			files[0].layer.push_back( Sha256( V2_LAYER_0[i] ) );
+		}
+		for ( size_t i = 0; i < elementsof( V2_LAYER_1 ); ++i )
+		{
+			files[1].layer.push_back( Sha256( V2_LAYER_1[i] ) );
+		}
+
+		return files;
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void TorrentPiecesTest::setUp()
+{
+	m_directory.Create();
+	WriteFiles();
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void TorrentPiecesTest::tearDown()
+{
+	m_directory.Remove();
+
+	KernelRegistry::Automatic( KernelRegistry::SHA1 );
+	KernelRegistry::Automatic( KernelRegistry::SHA256 );
+	KernelRegistry::Automatic( KernelRegistry::SHA1X8 );
+	KernelRegistry::Automatic( KernelRegistry::SHA256X8 );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The v1 pieces span the files and the last one is short, with each combination of the single-message and x8 kernels
+
+void TorrentPiecesTest::TestV1()
+{
+	std::vector< std::string > const	singles	= KernelRegistry::Available( KernelRegistry::SHA1 );
+	std::vector< std::string > const	x8s		= KernelRegistry::Available( KernelRegistry::SHA1X8 );
+
+	for ( size_t s = 0; s < singles.size(); ++s )
+	{
+		for ( size_t x = 0; x < x8s.size(); ++x )
+		{
+			CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::SHA1, singles[s].c_str() ) );
+			CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::SHA1X8, x8s[x].c_str() ) );
+
+			TorrentPieces		torrent( PIECE_SIZE );
+			std::vector< Sha1 >	pieces;
+
+			for ( size_t k = 0; k < elementsof( SIZES ); ++k )
+			{
+				CPPUNIT_ASSERT( torrent.AddFile( FileName( k ) ) );
+			}
+
+			CPPUNIT_ASSERT_EQUAL( elementsof( V1_PIECES ), torrent.PieceCount( TorrentPieces::V1 ) );
+			CPPUNIT_ASSERT( torrent.HashV1( pieces ) );
+			CPPUNIT_ASSERT_EQUAL( elementsof( V1_PIECES ), pieces.size() );
+			for ( size_t i = 0; i < pieces.size(); ++i )
+			{
+				CPPUNIT_ASSERT_EQUAL( std::string( V1_PIECES[i] ), pieces[i].ToString() );
+			}
+		}
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The pieces roots and piece layers, with each combination of the single-message and x8 kernels. The leaves past the
+// end of a file are 0's, and the empty file has no root.
+
+void TorrentPiecesTest::TestV2()
+{
+	std::vector< TorrentPieces::FileHashes > const	expected	= ExpectedV2();
+	std::vector< std::string > const				singles		= KernelRegistry::Available( KernelRegistry::SHA256 );
+	std::vector< std::string > const				x8s			= KernelRegistry::Available( KernelRegistry::SHA256X8 );
+
+	for ( size_t s = 0; s < singles.size(); ++s )
+	{
+		for ( size_t x = 0; x < x8s.size(); ++x )
+		{
+			CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::SHA256, singles[s].c_str() ) );
+			CPPUNIT_ASSERT( KernelRegistry::Force( KernelRegistry::SHA256X8, x8s[x].c_str() ) );
+
+			TorrentPieces								torrent( PIECE_SIZE );
+			std::vector< TorrentPieces::FileHashes >	files;
+
+			AddFiles( torrent );
+
+			CPPUNIT_ASSERT_EQUAL( size_t( 8 ), torrent.PieceCount( TorrentPieces::V2 ) );
+			CPPUNIT_ASSERT( torrent.HashV2( files ) );
+			CPPUNIT_ASSERT_EQUAL( expected.size(), files.size() );
+			for ( size_t i = 0; i < files.size(); ++i )
+			{
+				CPPUNIT_ASSERT_EQUAL( expected[i].root.ToString(), files[i].root.ToString() );
+				CPPUNIT_ASSERT_EQUAL( expected[i].layer.size(), files[i].layer.size() );
+				for ( size_t j = 0; j < files[i].layer.size(); ++j )
+				{
+					CPPUNIT_ASSERT_EQUAL( expected[i].layer[j].ToString(), files[i].layer[j].ToString() );
+				}
+			}
+		}
+	}
+
+	// A v2 piece is a power of two at least as large as a block
+
+	TorrentPieces								odd( PIECE_SIZE + 1 );
+	TorrentPieces								small( TorrentPieces::BLOCK_SIZE / 2 );
+	std::vector< TorrentPieces::FileHashes >	files;
+
+	AddFiles( odd );
+	AddFiles( small );
+	CPPUNIT_ASSERT( !odd.HashV2( files ) );
+	CPPUNIT_ASSERT( !small.HashV2( files ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Only the pieces with a changed byte or missing data are invalid, in both versions
+
+void TorrentPiecesTest::TestVerify()
+{
+	std::vector< Sha1 >								v1;
+	std::vector< TorrentPieces::FileHashes > const	v2	= ExpectedV2();
+	std::vector< bool >								valid;
+
+	for ( size_t i = 0; i < elementsof( V1_PIECES ); ++i )
+	{
+		v1.push_back( Sha1( V1_PIECES[i] ) );
+	}
+
+	{
+		TorrentPieces	torrent( PIECE_SIZE );
+
+		AddFiles( torrent );
+		CPPUNIT_ASSERT( torrent.VerifyV1( v1, valid ) );
+		CPPUNIT_ASSERT( valid == std::vector< bool >( 6, true ) );
+		CPPUNIT_ASSERT( torrent.VerifyV2( v2, valid ) );
+		CPPUNIT_ASSERT( valid == std::vector< bool >( 8, true ) );
+	}
+
+	// Byte 40000 of the first file is in the second piece of both versions. Byte 5 of the fourth file is at 150005 in
+	// the set, which is in the fifth v1 piece, and it is in the seventh v2 piece. The last file is in the last piece of
+	// both versions.
+
+	TestFiles::Corrupt( FileName( 0 ), 40000 );
+	TestFiles::Corrupt( FileName( 3 ), 5 );
+	remove( FileName( 4 ).c_str() );
+
+	{
+		TorrentPieces		torrent( PIECE_SIZE );
+		bool const			v1Valid[]	= { true, false, true, true, false, false };
+		bool const			v2Valid[]	= { true, false, true, true, true, true, false, false };
+		std::vector< Sha1 >	pieces;
+
+		AddFiles( torrent );
+		CPPUNIT_ASSERT( !torrent.HashV1( pieces ) );
+		CPPUNIT_ASSERT( !torrent.VerifyV1( v1, valid ) );
+		CPPUNIT_ASSERT( valid == std::vector< bool >( v1Valid, v1Valid + elementsof( v1Valid ) ) );
+		CPPUNIT_ASSERT( !torrent.VerifyV2( v2, valid ) );
+		CPPUNIT_ASSERT( valid == std::vector< bool >( v2Valid, v2Valid + elementsof( v2Valid ) ) );
+	}
+
+	// A piece layer that does not match the root makes all of the file's pieces invalid
+
+	WriteFiles();
+
+	{
+		TorrentPieces								torrent( PIECE_SIZE );
+		std::vector< TorrentPieces::FileHashes >	wrong	= v2;
+		bool const									v2Valid[]	= { true, true, true, true, false, false, true, true };
+
+		std::swap( wrong[1].layer[0], wrong[1].layer[1] );
+		AddFiles( torrent );
+		CPPUNIT_ASSERT( !torrent.VerifyV2( wrong, valid ) );
+		CPPUNIT_ASSERT( valid == std::vector< bool >( v2Valid, v2Valid + elementsof( v2Valid ) ) );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+std::string TorrentPiecesTest::FileName( size_t file ) const
+{
+	char	name[ 32 ];
+
+	snprintf( name, sizeof( name ), "piece-%u.bin", unsigned( file ) );
+	return m_directory.Path( name );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Byte j of file k is bits 13-20 of ( j + k * 1000003 ) * 2654435761, so no two pieces are the same.
+
+void TorrentPiecesTest::WriteFiles() const
+{
+	for ( size_t k = 0; k < elementsof( SIZES ); ++k )
+	{
+		std::vector< uint8_t >	data( size_t( SIZES[k] ) );
+
+		for ( size_t j = 0; j < data.size(); ++j )
+		{
+			data[j] = uint8_t( ( ( j + k * 1000003ull ) * 2654435761ull ) >> 13 );
+		}
+		TestFiles::WriteFile( FileName( k ), data.data(), data.size() );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void TorrentPiecesTest::AddFiles( TorrentPieces & torrent ) const
+{
+	for ( size_t k = 0; k < elementsof( SIZES ); ++k )
+	{
+		torrent.AddFile( FileName( k ), SIZES[k] );
+	}
+}
@@ -0,0 +1,53 @@
+/********************************************************************************************************************
+
+                                                 TorrentPiecesTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/TorrentPiecesTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+#include "../TorrentPieces.h"
+#include "Misc/TestFiles.h"
+
+#include <string>
+
+class TorrentPiecesTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( TorrentPiecesTest );
+	CPPUNIT_TEST( TestV1 );
+	CPPUNIT_TEST( TestV2 );
+	CPPUNIT_TEST( TestVerify );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestV1();
+	void TestV2();
+	void TestVerify();
+
+private:
+
+	// Returns the name of a file
+	std::string FileName( size_t file ) const;
+
+	// Writes the files
+	void WriteFiles() const;
+
+	// Adds the files to a torrent with their sizes
+	void AddFiles( Crypto::TorrentPieces & torrent ) const;
+
+	TestFiles::TemporaryDirectory	m_directory;	// Holds the files of the torrent
+};
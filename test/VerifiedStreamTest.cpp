@@ -0,0 +1,385 @@
+/********************************************************************************************************************
+
+                                               VerifiedStreamTest.cpp
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/VerifiedStreamTest.cpp#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#include "VerifiedStreamTest.h"
+
+#include "../VerifiedStream.h"
+
+#include "Misc/Random.h"
+#include "Misc/Etc.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace Crypto;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( VerifiedStreamTest );
+
+namespace
+{
+	size_t const	CHUNK	= VerifiedStream::CHUNK_SIZE;
+	size_t const	NODE	= VerifiedStream::NODE_SIZE;
+	size_t const	HEADER	= VerifiedStream::HEADER_SIZE;
+
+	// Sizes of objects around the boundaries of chunks and subtrees
+	size_t const	SIZES[]	= { 0, 1, CHUNK - 1, CHUNK, CHUNK + 1, 3 * CHUNK, 4 * CHUNK, 4 * CHUNK + 100 };
+
+	// The object of 4 * CHUNK + 100 bytes has 5 chunks. Its root's left subtree has chunks 0 to 3 and its right subtree
+	// is chunk 4, so the combined encoding is: the root, the node of chunks 0 to 3, the node of chunks 0 and 1, chunks 0
+	// and 1, the node of chunks 2 and 3, chunks 2 and 3, and chunk 4.
+	size_t const	FIVE_CHUNKS	= 4 * CHUNK + 100;
+	size_t const	NODE_23		= HEADER + 3 * NODE + 2 * CHUNK;	// Offset of the node of chunks 2 and 3
+	size_t const	CHUNK_2		= NODE_23 + NODE;					// Offset of chunk 2
+
+	// Returns an object of random bytes
+	std::vector< uint8_t > Object( size_t size, uint32_t seed )
+	{
+		std::vector< uint8_t >	object( size );
+		Random					rng( seed );
+
+		for ( size_t i = 0; i < size; ++i )
+		{
+			object[i] = uint8_t( rng.Get() );
+		}
+
+		return object;
+	}
+
+	// Collects the verified chunks, and checks that they arrive in order
+
+	struct Collector
+	{
+		std::vector< uint8_t >	data;
+
+		VerifiedStream::Receiver Receiver()
+		{
+			return [ this ] ( uint64_t offset, uint8_t const * chunk, size_t size )
+				   {
+					   CPPUNIT_ASSERT_EQUAL( uint64_t( data.size() ), offset );
+					   data.insert( data.end(), chunk, chunk + size );
+				   };
+		}
+	};
+
+	// Writes a stream in pieces of a given size. Returns false as soon as a write fails.
+	bool Write( VerifiedStream & stream, std::vector< uint8_t > const & encoded, size_t piece )
+	{
+		for ( size_t i = 0; i < encoded.size(); i += piece )
+		{
+			if ( !stream.Write( encoded.data() + i, std::min( piece, encoded.size() - i ) ) )
+				return false;
+		}
+
+		return true;
+	}
+
+} // anonymous namespace
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void VerifiedStreamTest::setUp()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+void VerifiedStreamTest::tearDown()
+{
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Each object is encoded and streamed back in pieces of several sizes, including pieces that split the header, the
+// nodes and the chunks
+
+void VerifiedStreamTest::TestRoundTrip()
+{
+	size_t const	PIECES[]	= { 1, 7, NODE + 1, CHUNK - 3, size_t( 1 ) << 30 };
+
+	for ( size_t s = 0; s < elementsof( SIZES ); ++s )
+	{
+		std::vector< uint8_t > const	object	= Object( SIZES[s], uint32_t( s ) );
+		std::vector< uint8_t >			encoded( size_t( VerifiedStream::EncodedSize( object.size() ) ) );
+		Sha256 const					hash	= VerifiedStream::Encode( object.data(), object.size(), encoded.data() );
+
+		CPPUNIT_ASSERT( hash == VerifiedStream::Hash( object.data(), object.size() ) );
+
+		for ( size_t p = 0; p < elementsof( PIECES ); ++p )
+		{
+			Collector		collector;
+			VerifiedStream	stream( hash, collector.Receiver() );
+
+			CPPUNIT_ASSERT( !stream.Finish() );
+			CPPUNIT_ASSERT( Write( stream, encoded, PIECES[p] ) );
+			CPPUNIT_ASSERT( stream.Finish() );
+			CPPUNIT_ASSERT( !stream.Failed() );
+			CPPUNIT_ASSERT_EQUAL( uint64_t( object.size() ), stream.Verified() );
+			CPPUNIT_ASSERT( collector.data == object );
+		}
+
+		// A different object does not match the hash
+
+		if ( !object.empty() )
+		{
+			std::vector< uint8_t >	other	= object;
+			Collector				collector;
+			VerifiedStream			stream( hash, collector.Receiver() );
+
+			other.back() ^= 1;
+			VerifiedStream::Encode( other.data(), other.size(), encoded.data() );
+			CPPUNIT_ASSERT( !Write( stream, encoded, encoded.size() ) );
+			CPPUNIT_ASSERT( stream.Failed() );
+		}
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// The object is streamed against its outboard tree, which has the same hash as the combined encoding
+
+void VerifiedStreamTest::TestOutboard()
+{
+	for ( size_t s = 0; s < elementsof( SIZES ); ++s )
+	{
+		std::vector< uint8_t > const	object	= Object( SIZES[s], uint32_t( s ) );
+		std::vector< uint8_t >			outboard( size_t( VerifiedStream::OutboardSize( object.size() ) ) );
+		Sha256 const					hash	= VerifiedStream::EncodeOutboard( object.data(), object.size(),
+																				  outboard.data() );
+		Collector						collector;
+		VerifiedStream					stream( hash, outboard.data(), outboard.size(), collector.Receiver() );
+
+		CPPUNIT_ASSERT( hash == VerifiedStream::Hash( object.data(), object.size() ) );
+		CPPUNIT_ASSERT( Write( stream, object, 1000 ) );
+		CPPUNIT_ASSERT( stream.Finish() );
+		CPPUNIT_ASSERT( collector.data == object );
+	}
+
+	// A corrupt node of the outboard tree is detected before the chunks under it are passed on
+
+	std::vector< uint8_t > const	object	= Object( FIVE_CHUNKS, 10 );
+	std::vector< uint8_t >			outboard( size_t( VerifiedStream::OutboardSize( object.size() ) ) );
+	Sha256 const					hash	= VerifiedStream::EncodeOutboard( object.data(), object.size(),
+																			  outboard.data() );
+	Collector						collector;
+
+	outboard[ HEADER + 3 * NODE ] ^= 1;
+
+	VerifiedStream	stream( hash, outboard.data(), outboard.size(), collector.Receiver() );
+
+	CPPUNIT_ASSERT( !Write( stream, object, 1000 ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 2 * CHUNK ), collector.data.size() );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// Ranges that start, end and lie within chunks are read from both encodings, and a corrupt chunk only affects the
+// ranges that overlap it
+
+void VerifiedStreamTest::TestRead()
+{
+	std::vector< uint8_t > const	object	= Object( FIVE_CHUNKS, 11 );
+	std::vector< uint8_t >			encoded( size_t( VerifiedStream::EncodedSize( object.size() ) ) );
+	std::vector< uint8_t >			outboard( size_t( VerifiedStream::OutboardSize( object.size() ) ) );
+	Sha256 const					hash	= VerifiedStream::Encode( object.data(), object.size(), encoded.data() );
+	std::vector< uint8_t >			output( object.size() );
+	uint64_t const					ranges[][ 2 ]	=
+	{
+		{ 0, FIVE_CHUNKS }, { 0, 1 }, { CHUNK - 1, 2 }, { 2 * CHUNK, CHUNK }, { 3 * CHUNK + 5, CHUNK + 50 }, { FIVE_CHUNKS, 0 }
+	};
+
+	VerifiedStream::EncodeOutboard( object.data(), object.size(), outboard.data() );
+
+	for ( size_t i = 0; i < elementsof( ranges ); ++i )
+	{
+		uint64_t const	offset	= ranges[i][0];
+		size_t const	size	= size_t( ranges[i][1] );
+
+		CPPUNIT_ASSERT( VerifiedStream::Read( hash, encoded.data(), encoded.size(), offset, size, output.data() ) );
+		CPPUNIT_ASSERT( std::equal( output.begin(), output.begin() + size, object.begin() + offset ) );
+		CPPUNIT_ASSERT( VerifiedStream::ReadOutboard( hash, outboard.data(), outboard.size(), object.data(), offset, size,
+													  output.data() ) );
+		CPPUNIT_ASSERT( std::equal( output.begin(), output.begin() + size, object.begin() + offset ) );
+	}
+
+	CPPUNIT_ASSERT( !VerifiedStream::Read( hash, encoded.data(), encoded.size(), FIVE_CHUNKS, 1, output.data() ) );
+
+	encoded[ CHUNK_2 + 10 ] ^= 1;
+	CPPUNIT_ASSERT( !VerifiedStream::Read( hash, encoded.data(), encoded.size(), 0, FIVE_CHUNKS, output.data() ) );
+	CPPUNIT_ASSERT( !VerifiedStream::Read( hash, encoded.data(), encoded.size(), 2 * CHUNK + 100, 1, output.data() ) );
+	CPPUNIT_ASSERT( VerifiedStream::Read( hash, encoded.data(), encoded.size(), 0, 2 * CHUNK, output.data() ) );
+	CPPUNIT_ASSERT( VerifiedStream::Read( hash, encoded.data(), encoded.size(), 3 * CHUNK, CHUNK + 100, output.data() ) );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A corrupt chunk is detected when it is complete, and none of its data is passed on. The chunks before it have been
+// passed on, and nothing is accepted after it.
+
+void VerifiedStreamTest::TestCorruptChunk()
+{
+	std::vector< uint8_t > const	object	= Object( FIVE_CHUNKS, 12 );
+	std::vector< uint8_t >			encoded( size_t( VerifiedStream::EncodedSize( object.size() ) ) );
+	Sha256 const					hash	= VerifiedStream::Encode( object.data(), object.size(), encoded.data() );
+	size_t const					changes[]	= { CHUNK_2, CHUNK_2 + 1000, CHUNK_2 + CHUNK - 1 };
+
+	for ( size_t c = 0; c < elementsof( changes ); ++c )
+	{
+		std::vector< uint8_t >	corrupt	= encoded;
+		Collector				collector;
+		VerifiedStream			stream( hash, collector.Receiver() );
+		size_t					i		= 0;
+
+		corrupt[ changes[c] ] ^= 0x40;
+
+		while ( i < corrupt.size() && stream.Write( &corrupt[i], 1 ) )
+		{
+			++i;
+		}
+
+		CPPUNIT_ASSERT_EQUAL( CHUNK_2 + CHUNK - 1, i );
+		CPPUNIT_ASSERT( stream.Failed() );
+		CPPUNIT_ASSERT( !stream.Finish() );
+		CPPUNIT_ASSERT_EQUAL( uint64_t( 2 * CHUNK ), stream.Verified() );
+		CPPUNIT_ASSERT( collector.data == std::vector< uint8_t >( object.begin(), object.begin() + 2 * CHUNK ) );
+
+		CPPUNIT_ASSERT( !stream.Write( &encoded[ i + 1 ], corrupt.size() - i - 1 ) );
+		CPPUNIT_ASSERT_EQUAL( size_t( 2 * CHUNK ), collector.data.size() );
+	}
+
+	// The last chunk, which is shorter, is checked the same way
+
+	std::vector< uint8_t >	corrupt	= encoded;
+	Collector				collector;
+	VerifiedStream			stream( hash, collector.Receiver() );
+
+	corrupt.back() ^= 1;
+	CPPUNIT_ASSERT( !Write( stream, corrupt, corrupt.size() ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 4 * CHUNK ), collector.data.size() );
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A corrupt interior node is detected as soon as the node is complete, before any chunk under it is passed on. A
+// corrupt root or size is detected before anything is passed on.
+
+void VerifiedStreamTest::TestCorruptNode()
+{
+	std::vector< uint8_t > const	object	= Object( FIVE_CHUNKS, 13 );
+	std::vector< uint8_t >			encoded( size_t( VerifiedStream::EncodedSize( object.size() ) ) );
+	Sha256 const					hash	= VerifiedStream::Encode( object.data(), object.size(), encoded.data() );
+
+	struct Change
+	{
+		size_t	offset;		// Offset of the byte changed
+		size_t	end;		// Offset of the end of the node that holds it
+		size_t	released;	// Number of bytes of the object passed on before the failure
+	};
+
+	Change const	changes[]	=
+	{
+		{ HEADER, HEADER + NODE, 0 },
+		{ HEADER + NODE + NODE - 1, HEADER + 2 * NODE, 0 },
+		{ NODE_23, NODE_23 + NODE, 2 * CHUNK },
+		{ NODE_23 + NODE - 1, NODE_23 + NODE, 2 * CHUNK },
+	};
+
+	for ( size_t c = 0; c < elementsof( changes ); ++c )
+	{
+		std::vector< uint8_t >	corrupt	= encoded;
+		Collector				collector;
+		VerifiedStream			stream( hash, collector.Receiver() );
+		size_t					i		= 0;
+
+		corrupt[ changes[c].offset ] ^= 0x80;
+
+		while ( i < corrupt.size() && stream.Write( &corrupt[i], 1 ) )
+		{
+			++i;
+		}
+
+		CPPUNIT_ASSERT_EQUAL( changes[c].end - 1, i );
+		CPPUNIT_ASSERT( stream.Failed() );
+		CPPUNIT_ASSERT_EQUAL( changes[c].released, collector.data.size() );
+	}
+
+	// A different size changes the hash and the shape of the tree
+
+	for ( size_t b = 0; b < HEADER; ++b )
+	{
+		std::vector< uint8_t >	corrupt	= encoded;
+		Collector				collector;
+		VerifiedStream			stream( hash, collector.Receiver() );
+
+		corrupt[b] ^= 1;
+		CPPUNIT_ASSERT( !Write( stream, corrupt, 100 ) );
+		CPPUNIT_ASSERT( collector.data.empty() );
+	}
+}
+
+
+/********************************************************************************************************************/
+/*																													*/
+/********************************************************************************************************************/
+
+// A stream that ends early is not complete, but everything before the missing part is verified and passed on. A stream
+// with extra data fails.
+
+void VerifiedStreamTest::TestTruncated()
+{
+	std::vector< uint8_t > const	object	= Object( FIVE_CHUNKS, 14 );
+	std::vector< uint8_t >			encoded( size_t( VerifiedStream::EncodedSize( object.size() ) ) );
+	Sha256 const					hash	= VerifiedStream::Encode( object.data(), object.size(), encoded.data() );
+	size_t const					ends[]	= { 0, HEADER - 1, HEADER + NODE - 1, CHUNK_2 + CHUNK, encoded.size() - 1 };
+	size_t const					released[]	= { 0, 0, 0, 3 * CHUNK, 4 * CHUNK };
+
+	for ( size_t e = 0; e < elementsof( ends ); ++e )
+	{
+		Collector		collector;
+		VerifiedStream	stream( hash, collector.Receiver() );
+
+		CPPUNIT_ASSERT( Write( stream, std::vector< uint8_t >( encoded.begin(), encoded.begin() + ends[e] ), 999 ) );
+		CPPUNIT_ASSERT( !stream.Failed() );
+		CPPUNIT_ASSERT( !stream.Finish() );
+		CPPUNIT_ASSERT_EQUAL( released[e], collector.data.size() );
+		CPPUNIT_ASSERT_EQUAL( uint64_t( released[e] ), stream.Verified() );
+	}
+
+	Collector				collector;
+	VerifiedStream			stream( hash, collector.Receiver() );
+	std::vector< uint8_t >	longer	= encoded;
+
+	longer.push_back( 0 );
+	CPPUNIT_ASSERT( !Write( stream, longer, longer.size() ) );
+	CPPUNIT_ASSERT( !stream.Finish() );
+}
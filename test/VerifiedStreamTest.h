@@ -0,0 +1,41 @@
+/********************************************************************************************************************
+
+                                                VerifiedStreamTest.h
+
+						                    Copyright 2026, John J. Bolton
+	--------------------------------------------------------------------------------------------------------------
+
+	$Header: //depot/Libraries/Crypto/Test/VerifiedStreamTest.h#1 $
+
+	$NoKeywords: $
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class VerifiedStreamTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( VerifiedStreamTest );
+	CPPUNIT_TEST( TestRoundTrip );
+	CPPUNIT_TEST( TestOutboard );
+	CPPUNIT_TEST( TestRead );
+	CPPUNIT_TEST( TestCorruptChunk );
+	CPPUNIT_TEST( TestCorruptNode );
+	CPPUNIT_TEST( TestTruncated );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void setUp();
+	void tearDown();
+
+	void TestRoundTrip();
+	void TestOutboard();
+	void TestRead();
+	void TestCorruptChunk();
+	void TestCorruptNode();
+	void TestTruncated();
+};